@@ -93,5 +93,154 @@ cpp2::ErrorCode GraphClient::execute(folly::StringPiece stmt,
     return resp.get_error_code();
 }
 
+
+cpp2::ErrorCode GraphClient::prepare(folly::StringPiece stmt,
+                                     cpp2::PrepareResponse& resp) {
+    if (!client_) {
+        LOG(ERROR) << "Disconnected from the server";
+        return cpp2::ErrorCode::E_DISCONNECTED;
+    }
+
+    try {
+        client_->sync_prepare(resp, sessionId_, stmt.toString());
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+        return cpp2::ErrorCode::E_RPC_FAILURE;
+    }
+
+    auto* msg = resp.get_error_msg();
+    if (msg != nullptr) {
+        LOG(WARNING) << *msg;
+    }
+    return resp.get_error_code();
+}
+
+
+cpp2::ErrorCode GraphClient::executePrepared(int64_t statementId,
+                                             const std::vector<cpp2::ColumnValue>& params,
+                                             cpp2::ExecutionResponse& resp) {
+    if (!client_) {
+        LOG(ERROR) << "Disconnected from the server";
+        return cpp2::ErrorCode::E_DISCONNECTED;
+    }
+
+    try {
+        client_->sync_executePrepared(resp, sessionId_, statementId, params);
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+        return cpp2::ErrorCode::E_RPC_FAILURE;
+    }
+
+    auto* msg = resp.get_error_msg();
+    if (msg != nullptr) {
+        LOG(WARNING) << *msg;
+    }
+    return resp.get_error_code();
+}
+
+
+cpp2::ErrorCode GraphClient::executeWithCursor(folly::StringPiece stmt,
+                                               int32_t chunkSize,
+                                               cpp2::ExecutionResponse& resp) {
+    if (!client_) {
+        LOG(ERROR) << "Disconnected from the server";
+        return cpp2::ErrorCode::E_DISCONNECTED;
+    }
+
+    try {
+        client_->sync_executeWithCursor(resp, sessionId_, stmt.toString(), chunkSize);
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+        return cpp2::ErrorCode::E_RPC_FAILURE;
+    }
+
+    auto* msg = resp.get_error_msg();
+    if (msg != nullptr) {
+        LOG(WARNING) << *msg;
+    }
+    return resp.get_error_code();
+}
+
+
+cpp2::ErrorCode GraphClient::fetch(int64_t cursorId, cpp2::ExecutionResponse& resp) {
+    if (!client_) {
+        LOG(ERROR) << "Disconnected from the server";
+        return cpp2::ErrorCode::E_DISCONNECTED;
+    }
+
+    try {
+        client_->sync_fetch(resp, sessionId_, cursorId);
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+        return cpp2::ErrorCode::E_RPC_FAILURE;
+    }
+
+    auto* msg = resp.get_error_msg();
+    if (msg != nullptr) {
+        LOG(WARNING) << *msg;
+    }
+    return resp.get_error_code();
+}
+
+
+cpp2::ErrorCode GraphClient::executeInChunks(folly::StringPiece stmt,
+                                             int32_t chunkSize,
+                                             OnChunk onChunk,
+                                             cpp2::ExecutionResponse& resp) {
+    auto res = executeWithCursor(stmt, chunkSize, resp);
+    if (res != cpp2::ErrorCode::SUCCEEDED) {
+        return res;
+    }
+    auto *cursorId = resp.get_cursor_id();
+    if (!onChunk(resp) || cursorId == nullptr) {
+        if (cursorId != nullptr) {
+            closeCursor(*cursorId);
+        }
+        return res;
+    }
+
+    // The next chunk is fetched after the current one is consumed
+    auto id = *cursorId;
+    while (true) {
+        cpp2::ExecutionResponse chunk;
+        res = fetch(id, chunk);
+        if (res != cpp2::ErrorCode::SUCCEEDED) {
+            closeCursor(id);
+            resp.set_error_code(res);
+            auto *msg = chunk.get_error_msg();
+            if (msg != nullptr) {
+                resp.set_error_msg(*msg);
+            }
+            return res;
+        }
+        if (resp.get_column_names() != nullptr) {
+            chunk.set_column_names(*resp.get_column_names());
+        }
+        auto more = chunk.get_cursor_id() != nullptr;
+        if (!onChunk(chunk)) {
+            if (more) {
+                closeCursor(id);
+            }
+            break;
+        }
+        if (!more) {
+            break;
+        }
+    }
+    return res;
+}
+
+
+void GraphClient::closeCursor(int64_t cursorId) {
+    if (!client_) {
+        return;
+    }
+    try {
+        client_->sync_closeCursor(sessionId_, cursorId);
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+    }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -26,6 +26,36 @@ public:
     cpp2::ErrorCode execute(folly::StringPiece stmt,
                             cpp2::ExecutionResponse& resp);
 
+    // Prepare a statement with placeholders `?', which could be executed
+    // later with different parameters
+    cpp2::ErrorCode prepare(folly::StringPiece stmt,
+                            cpp2::PrepareResponse& resp);
+
+    cpp2::ErrorCode executePrepared(int64_t statementId,
+                                    const std::vector<cpp2::ColumnValue>& params,
+                                    cpp2::ExecutionResponse& resp);
+
+    // Execute a statement, returning at most `chunkSize' rows. If there are more,
+    // `resp.cursor_id' is set, the rest could be fetched by `fetch' chunk by chunk.
+    cpp2::ErrorCode executeWithCursor(folly::StringPiece stmt,
+                                      int32_t chunkSize,
+                                      cpp2::ExecutionResponse& resp);
+
+    cpp2::ErrorCode fetch(int64_t cursorId, cpp2::ExecutionResponse& resp);
+
+    // Execute a statement, and pass its results to `onChunk' as soon as each chunk of
+    // at most `chunkSize' rows arrives, so that the rows are never held all at once.
+    // The rest are released once `onChunk' returns false. `resp' is the first response,
+    // or carries the error if any chunk fails to be fetched.
+    using OnChunk = std::function<bool(const cpp2::ExecutionResponse&)>;
+    cpp2::ErrorCode executeInChunks(folly::StringPiece stmt,
+                                    int32_t chunkSize,
+                                    OnChunk onChunk,
+                                    cpp2::ExecutionResponse& resp);
+
+    // Release the rows not fetched yet
+    void closeCursor(int64_t cursorId);
+
 private:
     std::unique_ptr<cpp2::GraphServiceAsyncClient> client_;
     const std::string addr_;
@@ -0,0 +1,157 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_FINGERPRINTSET_H_
+#define COMMON_BASE_FINGERPRINTSET_H_
+
+#include "base/Base.h"
+#include <folly/hash/SpookyHashV2.h>
+
+namespace nebula {
+
+/**
+ * A set of byte strings, e.g. the encoded rows, kept as an open-addressing table of
+ * their 128-bit fingerprints. The strings themselves are appended to an arena, and
+ * the bytes are compared whenever two fingerprints match, so a fingerprint collision
+ * never drops a distinct string. The table costs 32 bytes * capacity, and the arena
+ * the total length of the distinct strings.
+ *
+ * It's not thread safe.
+ * */
+class FingerprintSet final {
+public:
+    using Hasher = void (*)(const void* data, size_t size, uint64_t* hi, uint64_t* lo);
+
+    explicit FingerprintSet(size_t expectedSize = 0, Hasher hasher = &spookyHash)
+        : hasher_(hasher) {
+        size_t capacity = kMinCapacity;
+        while (capacity < expectedSize * 2) {
+            capacity <<= 1;
+        }
+        table_.resize(capacity);
+    }
+
+    /**
+     * Return true if the key is inserted, false if it has been in the set.
+     * */
+    bool insert(folly::StringPiece key) {
+        Fingerprint fp;
+        hasher_(key.data(), key.size(), &fp.hi, &fp.lo);
+        if (fp.empty()) {
+            // The zero fingerprint is reserved for empty slots
+            fp.lo = 1;
+        }
+        return insert(fp, key);
+    }
+
+    /**
+     * Insert all the keys in the other set, which must use the same hasher.
+     * */
+    void merge(const FingerprintSet& other) {
+        DCHECK(hasher_ == other.hasher_);
+        for (auto& fp : other.table_) {
+            if (fp.empty()) {
+                continue;
+            }
+            insert(fp, other.keyOf(fp));
+        }
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_t memoryUsage() const {
+        return table_.size() * sizeof(Fingerprint) + arena_.capacity();
+    }
+
+    void clear() {
+        std::vector<Fingerprint>(kMinCapacity).swap(table_);
+        std::string().swap(arena_);
+        size_ = 0;
+    }
+
+private:
+    struct Fingerprint {
+        uint64_t hi = 0;
+        uint64_t lo = 0;
+        // Where the key is in the arena
+        uint64_t offset = 0;
+        uint64_t length = 0;
+
+        bool empty() const {
+            return hi == 0 && lo == 0;
+        }
+
+        bool sameHash(const Fingerprint& rhs) const {
+            return hi == rhs.hi && lo == rhs.lo;
+        }
+    };
+
+    static constexpr size_t kMinCapacity = 16;
+
+    static void spookyHash(const void* data, size_t size, uint64_t* hi, uint64_t* lo) {
+        folly::hash::SpookyHashV2::Hash128(data, size, hi, lo);
+    }
+
+    folly::StringPiece keyOf(const Fingerprint& fp) const {
+        return folly::StringPiece(arena_.data() + fp.offset, fp.length);
+    }
+
+    // Linear probing, the capacity of the table is always the power of 2.
+    // A slot with the same fingerprint but a different key is probed over.
+    bool insert(Fingerprint fp, folly::StringPiece key) {
+        if ((size_ + 1) * 2 > table_.size()) {
+            grow();
+        }
+        auto mask = table_.size() - 1;
+        for (auto i = fp.hi & mask; ; i = (i + 1) & mask) {
+            auto& slot = table_[i];
+            if (slot.empty()) {
+                fp.offset = arena_.size();
+                fp.length = key.size();
+                arena_.append(key.data(), key.size());
+                slot = fp;
+                size_++;
+                return true;
+            }
+            if (slot.sameHash(fp) && keyOf(slot) == key) {
+                return false;
+            }
+        }
+    }
+
+    // The keys have been verified distinct, so only an empty slot is looked for
+    void grow() {
+        std::vector<Fingerprint> table(table_.size() * 2);
+        auto mask = table.size() - 1;
+        for (auto& fp : table_) {
+            if (fp.empty()) {
+                continue;
+            }
+            auto i = fp.hi & mask;
+            while (!table[i].empty()) {
+                i = (i + 1) & mask;
+            }
+            table[i] = fp;
+        }
+        table_.swap(table);
+    }
+
+private:
+    Hasher                      hasher_;
+    std::vector<Fingerprint>    table_;
+    // All the distinct keys, back to back
+    std::string                 arena_;
+    size_t                      size_{0};
+};
+
+}  // namespace nebula
+#endif  // COMMON_BASE_FINGERPRINTSET_H_
@@ -10,17 +10,18 @@ namespace nebula {
 
 // static
 std::string NebulaKeyUtils::vertexKey(PartitionID partId, VertexID vId,
-                                      TagID tagId, TagVersion tv) {
+                                      TagID tagId, TagVersion tv,
+                                      NebulaKeyFormat format) {
     constexpr uint32_t tagMask = 0xBFFFFFFF;
     tagId &= tagMask;
     int32_t item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
 
     std::string key;
     key.reserve(kVertexLen);
-    key.append(reinterpret_cast<const char*>(&item), sizeof(int32_t))
-       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&tagId), sizeof(TagID))
-       .append(reinterpret_cast<const char*>(&tv), sizeof(TagVersion));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(int32_t));
+    encodeInt(key, vId, format);
+    encodeInt(key, tagId, format);
+    key.append(reinterpret_cast<const char*>(&tv), sizeof(TagVersion));
     return key;
 }
 
@@ -30,22 +31,39 @@ std::string NebulaKeyUtils::edgeKey(PartitionID partId,
                                     EdgeType type,
                                     EdgeRanking rank,
                                     VertexID dstId,
-                                    EdgeVersion ev) {
+                                    EdgeVersion ev,
+                                    NebulaKeyFormat format) {
     constexpr uint32_t edgeMask = 0x40000000;
     type |= edgeMask;
     int32_t item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
 
     std::string key;
     key.reserve(kEdgeLen);
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&srcId), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType))
-       .append(reinterpret_cast<const char*>(&rank), sizeof(EdgeRanking))
-       .append(reinterpret_cast<const char*>(&dstId), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&ev), sizeof(EdgeVersion));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, srcId, format);
+    encodeInt(key, type, format);
+    encodeInt(key, rank, format);
+    encodeInt(key, dstId, format);
+    key.append(reinterpret_cast<const char*>(&ev), sizeof(EdgeVersion));
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::vertexKey(PartitionID partId, VertexID vId, TagID tagId,
+                                      NebulaKeyFormat format) {
+    return vertexPrefix(partId, vId, tagId, format);
+}
+
+// static
+std::string NebulaKeyUtils::edgeKey(PartitionID partId,
+                                    VertexID srcId,
+                                    EdgeType type,
+                                    EdgeRanking rank,
+                                    VertexID dstId,
+                                    NebulaKeyFormat format) {
+    return prefix(partId, srcId, type, rank, dstId, format);
+}
+
 // static
 std::string NebulaKeyUtils::systemCommitKey(PartitionID partId) {
     int32_t item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kSystem);
@@ -68,6 +86,17 @@ std::string NebulaKeyUtils::systemPartKey(PartitionID partId) {
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::systemKeyFormatKey() {
+    uint32_t item = static_cast<uint32_t>(NebulaKeyType::kSystem);
+    uint32_t type = static_cast<uint32_t>(NebulaSystemKeyType::kSystemKeyFormat);
+    std::string key;
+    key.reserve(kSystemLen);
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+       .append(reinterpret_cast<const char*>(&type), sizeof(NebulaSystemKeyType));
+    return key;
+}
+
 // static
 std::string NebulaKeyUtils::uuidKey(PartitionID partId, const folly::StringPiece& name) {
     std::string key;
@@ -89,30 +118,32 @@ std::string NebulaKeyUtils::kvKey(PartitionID partId, const folly::StringPiece&
 }
 
 // static
-std::string NebulaKeyUtils::vertexPrefix(PartitionID partId, VertexID vId, TagID tagId) {
+std::string NebulaKeyUtils::vertexPrefix(PartitionID partId, VertexID vId, TagID tagId,
+                                         NebulaKeyFormat format) {
     constexpr uint32_t tagMask = 0xBFFFFFFF;
     tagId &= tagMask;
     PartitionID item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
 
     std::string key;
     key.reserve(kVertexLen);
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&tagId), sizeof(TagID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, vId, format);
+    encodeInt(key, tagId, format);
     return key;
 }
 
 // static
-std::string NebulaKeyUtils::edgePrefix(PartitionID partId, VertexID srcId, EdgeType type) {
+std::string NebulaKeyUtils::edgePrefix(PartitionID partId, VertexID srcId, EdgeType type,
+                                       NebulaKeyFormat format) {
     constexpr uint32_t edgeMask = 0x40000000;
     type |= edgeMask;
     PartitionID item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
 
     std::string key;
     key.reserve(sizeof(PartitionID) + sizeof(VertexID) + sizeof(EdgeType));
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&srcId), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, srcId, format);
+    encodeInt(key, type, format);
     return key;
 }
 
@@ -126,22 +157,24 @@ std::string NebulaKeyUtils::prefix(PartitionID partId) {
 }
 
 // static
-std::string NebulaKeyUtils::vertexPrefix(PartitionID partId, VertexID vId) {
+std::string NebulaKeyUtils::vertexPrefix(PartitionID partId, VertexID vId,
+                                         NebulaKeyFormat format) {
     PartitionID item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
     std::string key;
     key.reserve(sizeof(PartitionID) + sizeof(VertexID));
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, vId, format);
     return key;
 }
 
 // static
-std::string NebulaKeyUtils::edgePrefix(PartitionID partId, VertexID vId) {
+std::string NebulaKeyUtils::edgePrefix(PartitionID partId, VertexID vId,
+                                       NebulaKeyFormat format) {
     PartitionID item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
     std::string key;
     key.reserve(sizeof(PartitionID) + sizeof(VertexID));
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, vId, format);
     return key;
 }
 
@@ -156,7 +189,8 @@ std::string NebulaKeyUtils::systemPrefix() {
 
 // static
 std::string NebulaKeyUtils::prefix(PartitionID partId, VertexID src, EdgeType type,
-                                   EdgeRanking ranking, VertexID dst) {
+                                   EdgeRanking ranking, VertexID dst,
+                                   NebulaKeyFormat format) {
     constexpr uint32_t edgeMask = 0x40000000;
     type |= edgeMask;
     PartitionID item = (partId << 8) | static_cast<uint32_t>(NebulaKeyType::kData);
@@ -164,11 +198,11 @@ std::string NebulaKeyUtils::prefix(PartitionID partId, VertexID src, EdgeType ty
     std::string key;
     key.reserve(sizeof(PartitionID) + sizeof(VertexID) + sizeof(EdgeType)
                 + sizeof(VertexID) + sizeof(EdgeRanking));
-    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
-       .append(reinterpret_cast<const char*>(&src), sizeof(VertexID))
-       .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType))
-       .append(reinterpret_cast<const char*>(&ranking), sizeof(EdgeRanking))
-       .append(reinterpret_cast<const char*>(&dst), sizeof(VertexID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    encodeInt(key, src, format);
+    encodeInt(key, type, format);
+    encodeInt(key, ranking, format);
+    encodeInt(key, dst, format);
     return key;
 }
 
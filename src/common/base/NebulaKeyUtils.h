@@ -8,6 +8,7 @@
 #define COMMON_BASE_NEBULAKEYUTILS_H_
 
 #include "base/Base.h"
+#include <folly/lang/Bits.h>
 
 namespace nebula {
 
@@ -18,8 +19,22 @@ namespace nebula {
  * EdgeKeyUtils:
  * type(1) + partId(3) + srcId(8) + edgeType(4) + edgeRank(8) + dstId(8) + version(8)
  *
+ * The keys of single version spaces have no version suffix.
+ *
+ * In NebulaKeyFormat::kOrdered, vertexId, tagId, edgeType, edgeRank and dstId are
+ * stored in big-endian with the sign bit flipped, so the bytewise order of keys
+ * in one part follows the numeric order of ids. The version is always stored as
+ * passed in by the caller.
+ *
+ * The format is configured per kvstore (see KVOptions::keyFormat_), so the methods
+ * depending on it take the format of the store the key belongs to.
  * */
 
+enum class NebulaKeyFormat : uint32_t {
+    kNative            = 0x00000001,
+    kOrdered           = 0x00000002,
+};
+
 enum class NebulaKeyType : uint32_t {
     kData              = 0x00000001,
     kIndex             = 0x00000002,
@@ -30,6 +45,7 @@ enum class NebulaKeyType : uint32_t {
 enum class NebulaSystemKeyType : uint32_t {
     kSystemCommit      = 0x00000001,
     kSystemPart        = 0x00000002,
+    kSystemKeyFormat   = 0x00000003,
 };
 
 /**
@@ -42,19 +58,40 @@ public:
      * Generate vertex key for kv store
      * */
     static std::string vertexKey(PartitionID partId, VertexID vId,
-                                 TagID tagId, TagVersion tv);
+                                 TagID tagId, TagVersion tv,
+                                 NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
     /**
      * Generate edge key for kv store
      * */
     static std::string edgeKey(PartitionID partId, VertexID srcId,
                                EdgeType type, EdgeRanking rank,
-                               VertexID dstId, EdgeVersion ev);
+                               VertexID dstId, EdgeVersion ev,
+                               NebulaKeyFormat format = NebulaKeyFormat::kNative);
+
+    /**
+     * Generate vertex key without version, for single version spaces
+     * */
+    static std::string vertexKey(PartitionID partId, VertexID vId, TagID tagId,
+                                 NebulaKeyFormat format = NebulaKeyFormat::kNative);
+
+    /**
+     * Generate edge key without version, for single version spaces
+     * */
+    static std::string edgeKey(PartitionID partId, VertexID srcId,
+                               EdgeType type, EdgeRanking rank,
+                               VertexID dstId,
+                               NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
     static std::string systemCommitKey(PartitionID partId);
 
     static std::string systemPartKey(PartitionID partId);
 
+    /**
+     * The key recording which NebulaKeyFormat the engine is written in.
+     * */
+    static std::string systemKeyFormatKey();
+
     static std::string uuidKey(PartitionID partId, const folly::StringPiece& name);
 
     static std::string kvKey(PartitionID partId, const folly::StringPiece& name);
@@ -62,25 +99,31 @@ public:
     /**
      * Prefix for
      * */
-    static std::string vertexPrefix(PartitionID partId, VertexID vId, TagID tagId);
+    static std::string vertexPrefix(PartitionID partId, VertexID vId, TagID tagId,
+                                    NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
     /**
      * Prefix for srcId edges with some edgeType
      * */
-    static std::string edgePrefix(PartitionID partId, VertexID srcId, EdgeType type);
+    static std::string edgePrefix(PartitionID partId, VertexID srcId, EdgeType type,
+                                  NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
-    static std::string vertexPrefix(PartitionID partId, VertexID vId);
+    static std::string vertexPrefix(PartitionID partId, VertexID vId,
+                                    NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
-    static std::string edgePrefix(PartitionID partId, VertexID vId);
+    static std::string edgePrefix(PartitionID partId, VertexID vId,
+                                  NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
     static std::string systemPrefix();
 
     static std::string prefix(PartitionID partId, VertexID src, EdgeType type,
-                              EdgeRanking ranking, VertexID dst);
+                              EdgeRanking ranking, VertexID dst,
+                              NebulaKeyFormat format = NebulaKeyFormat::kNative);
 
     static std::string prefix(PartitionID partId);
 
-    static bool isVertex(const folly::StringPiece& rawKey) {
+    static bool isVertex(const folly::StringPiece& rawKey,
+                         NebulaKeyFormat format = NebulaKeyFormat::kNative) {
         constexpr uint32_t tagMask  = 0x40000000;
         constexpr uint32_t typeMask = 0x000000FF;
         constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
@@ -89,17 +132,19 @@ public:
             return false;
         }
         auto offset = sizeof(PartitionID) + sizeof(VertexID);
-        TagID tagId =  readInt<TagID>(rawKey.data() + offset, sizeof(TagID));
+        TagID tagId = decodeInt<TagID>(rawKey.data() + offset, format);
         return !(tagId & tagMask);
     }
 
-    static TagID getTagId(const folly::StringPiece& rawKey) {
-        CHECK_EQ(rawKey.size(), kVertexLen);
+    static TagID getTagId(const folly::StringPiece& rawKey,
+                          NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        CHECK(rawKey.size() == kVertexLen || rawKey.size() == kVertexLen - kVersionLen);
         auto offset = sizeof(PartitionID) + sizeof(VertexID);
-        return readInt<TagID>(rawKey.data() + offset, sizeof(TagID));
+        return decodeInt<TagID>(rawKey.data() + offset, format);
     }
 
-    static bool isEdge(const folly::StringPiece& rawKey) {
+    static bool isEdge(const folly::StringPiece& rawKey,
+                       NebulaKeyFormat format = NebulaKeyFormat::kNative) {
         constexpr uint32_t edgeMask = 0x40000000;
         constexpr uint32_t typeMask = 0x000000FF;
         constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
@@ -108,7 +153,7 @@ public:
             return false;
         }
         auto offset = sizeof(PartitionID) + sizeof(VertexID);
-        EdgeType etype = readInt<EdgeType>(rawKey.data() + offset, sizeof(EdgeType));
+        EdgeType etype = decodeInt<EdgeType>(rawKey.data() + offset, format);
         return etype & edgeMask;
     }
 
@@ -132,30 +177,44 @@ public:
         return static_cast<uint32_t>(NebulaSystemKeyType::kSystemPart) == type;
     }
 
-    static VertexID getSrcId(const folly::StringPiece& rawKey) {
-        CHECK_EQ(rawKey.size(), kEdgeLen);
-        return readInt<VertexID>(rawKey.data() + sizeof(PartitionID), sizeof(VertexID));
+    static bool isSystemKeyFormat(const folly::StringPiece& rawKey) {
+        if (rawKey.size() != kSystemLen) {
+            return false;
+        }
+        auto position = rawKey.data() + sizeof(PartitionID);
+        auto len = sizeof(NebulaSystemKeyType);
+        auto type = readInt<uint32_t>(position, len);
+        return static_cast<uint32_t>(NebulaSystemKeyType::kSystemKeyFormat) == type;
     }
 
-    static VertexID getDstId(const folly::StringPiece& rawKey) {
-        CHECK_EQ(rawKey.size(), kEdgeLen);
+    static VertexID getSrcId(const folly::StringPiece& rawKey,
+                             NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        CHECK(rawKey.size() == kEdgeLen || rawKey.size() == kEdgeLen - kVersionLen);
+        return decodeInt<VertexID>(rawKey.data() + sizeof(PartitionID), format);
+    }
+
+    static VertexID getDstId(const folly::StringPiece& rawKey,
+                             NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        CHECK(rawKey.size() == kEdgeLen || rawKey.size() == kEdgeLen - kVersionLen);
         auto offset = sizeof(PartitionID) + sizeof(VertexID) +
                       sizeof(EdgeType) + sizeof(EdgeRanking);
-        return readInt<VertexID>(rawKey.data() + offset, sizeof(VertexID));
+        return decodeInt<VertexID>(rawKey.data() + offset, format);
     }
 
-    static EdgeType getEdgeType(const folly::StringPiece& rawKey) {
-        CHECK_EQ(rawKey.size(), kEdgeLen);
+    static EdgeType getEdgeType(const folly::StringPiece& rawKey,
+                                NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        CHECK(rawKey.size() == kEdgeLen || rawKey.size() == kEdgeLen - kVersionLen);
         constexpr int32_t edgeMask = 0xBFFFFFFF;
         auto offset = sizeof(PartitionID) + sizeof(VertexID);
-        EdgeType type = readInt<EdgeType>(rawKey.data() + offset, sizeof(EdgeType));
+        EdgeType type = decodeInt<EdgeType>(rawKey.data() + offset, format);
         return type > 0 ? type & edgeMask : type;
     }
 
-    static EdgeRanking getRank(const folly::StringPiece& rawKey) {
-        CHECK_EQ(rawKey.size(), kEdgeLen);
+    static EdgeRanking getRank(const folly::StringPiece& rawKey,
+                               NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        CHECK(rawKey.size() == kEdgeLen || rawKey.size() == kEdgeLen - kVersionLen);
         auto offset = sizeof(PartitionID) + sizeof(VertexID) + sizeof(EdgeType);
-        return readInt<EdgeRanking>(rawKey.data() + offset, sizeof(EdgeRanking));
+        return decodeInt<EdgeRanking>(rawKey.data() + offset, format);
     }
 
     template<typename T>
@@ -185,14 +244,59 @@ public:
         return static_cast<uint32_t>(NebulaKeyType::kUUID) == type;
     }
 
+    /**
+     * Whether the vertex/edge key has a version suffix, the keys of single version
+     * spaces are kVersionLen shorter.
+     * */
+    static bool hasVersion(const folly::StringPiece& rawKey,
+                           NebulaKeyFormat format = NebulaKeyFormat::kNative) {
+        if (isVertex(rawKey, format)) {
+            return rawKey.size() == kVertexLen;
+        }
+        if (isEdge(rawKey, format)) {
+            return rawKey.size() == kEdgeLen;
+        }
+        return false;
+    }
+
     static folly::StringPiece keyWithNoVersion(const folly::StringPiece& rawKey) {
         // TODO(heng) We should change the method if varint data version supportted.
         return rawKey.subpiece(0, rawKey.size() - sizeof(int64_t));
     }
 
+    /**
+     * Append the integer field of vertex/edge keys in the given format.
+     * */
+    template<typename T>
+    static void encodeInt(std::string& key, T v, NebulaKeyFormat format) {
+        static_assert(std::is_integral<T>::value && std::is_signed<T>::value,
+                      "Only signed integer fields are supported");
+        if (format == NebulaKeyFormat::kOrdered) {
+            using U = typename std::make_unsigned<T>::type;
+            U u = folly::Endian::big(static_cast<U>(v) ^ kSignBit<U>);
+            key.append(reinterpret_cast<const char*>(&u), sizeof(U));
+        } else {
+            key.append(reinterpret_cast<const char*>(&v), sizeof(T));
+        }
+    }
+
+    template<typename T>
+    static T decodeInt(const char* data, NebulaKeyFormat format) {
+        using U = typename std::make_unsigned<T>::type;
+        U u;
+        memcpy(&u, data, sizeof(U));
+        if (format == NebulaKeyFormat::kOrdered) {
+            return static_cast<T>(folly::Endian::big(u) ^ kSignBit<U>);
+        }
+        return static_cast<T>(u);
+    }
+
 private:
     NebulaKeyUtils() = delete;
 
+    template<typename U>
+    static constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+
 private:
     static constexpr int32_t kVertexLen = sizeof(PartitionID) + sizeof(VertexID)
                                         + sizeof(TagID) + sizeof(TagVersion);
@@ -201,6 +305,8 @@ private:
                                       + sizeof(EdgeType) + sizeof(VertexID)
                                       + sizeof(EdgeRanking) + sizeof(EdgeVersion);
 
+    static constexpr int32_t kVersionLen = sizeof(int64_t);
+
     static constexpr int32_t kSystemLen = sizeof(PartitionID) + sizeof(NebulaSystemKeyType);
 };
 
@@ -0,0 +1,46 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "base/Partitioner.h"
+
+namespace nebula {
+
+// static
+std::shared_ptr<const Partitioner> Partitioner::hash(int32_t partsNum) {
+    CHECK_GT(partsNum, 0);
+    return std::shared_ptr<const Partitioner>(new Partitioner(Strategy::HASH, partsNum, {}));
+}
+
+
+// static
+StatusOr<std::shared_ptr<const Partitioner>>
+Partitioner::range(int32_t partsNum, std::vector<int64_t> bounds) {
+    if (partsNum <= 0) {
+        return Status::Error("Invalid parts number %d", partsNum);
+    }
+    if (bounds.empty()) {
+        auto start = static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
+        auto total = static_cast<unsigned __int128>(1) << 64;
+        for (int32_t i = 1; i < partsNum; i++) {
+            auto offset = static_cast<uint64_t>(total * i / partsNum);
+            bounds.emplace_back(static_cast<int64_t>(start + offset));
+        }
+    }
+    if (bounds.size() != static_cast<size_t>(partsNum - 1)) {
+        return Status::Error("Expect %d range bounds, but got %lu",
+                             partsNum - 1, bounds.size());
+    }
+    for (size_t i = 1; i < bounds.size(); i++) {
+        if (bounds[i - 1] >= bounds[i]) {
+            return Status::Error("The range bounds should be ascending");
+        }
+    }
+    return std::shared_ptr<const Partitioner>(
+        new Partitioner(Strategy::RANGE, partsNum, std::move(bounds)));
+}
+
+}  // namespace nebula
@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_PARTITIONER_H_
+#define COMMON_BASE_PARTITIONER_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+
+namespace nebula {
+
+/**
+ * Maps an id, e.g. a vertex id, to the part it belongs to, parts are numbered from 1.
+ *
+ * HASH spreads the ids uniformly over the parts. RANGE keeps the adjacent ids in the
+ * same part, so that a graph whose vertices are numbered by community keeps most
+ * of its edges inside a part.
+ */
+class Partitioner final {
+public:
+    enum class Strategy : uint8_t {
+        HASH  = 0,
+        RANGE = 1,
+    };
+
+    static std::shared_ptr<const Partitioner> hash(int32_t partsNum);
+
+    /**
+     * bounds[i] is the first id of the part (i + 2), so there should be (partsNum - 1)
+     * ascending bounds. If empty, the whole id space is split evenly.
+     */
+    static StatusOr<std::shared_ptr<const Partitioner>> range(int32_t partsNum,
+                                                              std::vector<int64_t> bounds);
+
+    PartitionID partId(int64_t id) const {
+        if (strategy_ == Strategy::HASH) {
+            return static_cast<uint64_t>(id) % partsNum_ + 1;
+        }
+        auto it = std::upper_bound(bounds_.begin(), bounds_.end(), id);
+        return static_cast<PartitionID>(it - bounds_.begin()) + 1;
+    }
+
+    Strategy strategy() const {
+        return strategy_;
+    }
+
+    int32_t partsNum() const {
+        return partsNum_;
+    }
+
+    const std::vector<int64_t>& bounds() const {
+        return bounds_;
+    }
+
+private:
+    Partitioner(Strategy strategy, int32_t partsNum, std::vector<int64_t> bounds)
+        : strategy_(strategy)
+        , partsNum_(partsNum)
+        , bounds_(std::move(bounds)) {}
+
+private:
+    const Strategy              strategy_;
+    const int32_t               partsNum_;
+    const std::vector<int64_t>  bounds_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_BASE_PARTITIONER_H_
@@ -0,0 +1,88 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "base/FingerprintSet.h"
+#include <gtest/gtest.h>
+
+namespace nebula {
+
+TEST(FingerprintSetTest, SimpleTest) {
+    FingerprintSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert("abc"));
+    EXPECT_FALSE(set.insert("abc"));
+    EXPECT_TRUE(set.insert("abd"));
+    EXPECT_TRUE(set.insert(""));
+    EXPECT_FALSE(set.insert(""));
+    EXPECT_EQ(3, set.size());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert("abc"));
+}
+
+TEST(FingerprintSetTest, GrowTest) {
+    FingerprintSet set;
+    auto initMemory = set.memoryUsage();
+    for (auto i = 0; i < 100000; i++) {
+        EXPECT_TRUE(set.insert(folly::stringPrintf("row_%d", i)));
+    }
+    EXPECT_EQ(100000, set.size());
+    EXPECT_LT(initMemory, set.memoryUsage());
+    // Each key costs at most 4 slots, and twice its length in the arena
+    EXPECT_GE(100000 * (32 * 4 + 2 * 9), set.memoryUsage());
+    for (auto i = 0; i < 100000; i++) {
+        EXPECT_FALSE(set.insert(folly::stringPrintf("row_%d", i)));
+    }
+    EXPECT_EQ(100000, set.size());
+
+    FingerprintSet reserved(100000);
+    EXPECT_LE(100000 * 32 * 2, reserved.memoryUsage());
+}
+
+TEST(FingerprintSetTest, MergeTest) {
+    FingerprintSet left;
+    FingerprintSet right;
+    for (auto i = 0; i < 1000; i++) {
+        left.insert(folly::stringPrintf("row_%d", i));
+        right.insert(folly::stringPrintf("row_%d", i + 500));
+    }
+    left.merge(right);
+    EXPECT_EQ(1500, left.size());
+    EXPECT_FALSE(left.insert("row_0"));
+    EXPECT_FALSE(left.insert("row_1499"));
+    EXPECT_TRUE(left.insert("row_1500"));
+}
+
+// All the keys have the same fingerprint
+static void collide(const void*, size_t, uint64_t* hi, uint64_t* lo) {
+    *hi = 42;
+    *lo = 42;
+}
+
+TEST(FingerprintSetTest, CollisionTest) {
+    FingerprintSet set(0, &collide);
+    for (auto i = 0; i < 100; i++) {
+        EXPECT_TRUE(set.insert(folly::stringPrintf("row_%d", i)));
+    }
+    EXPECT_EQ(100, set.size());
+    for (auto i = 0; i < 100; i++) {
+        EXPECT_FALSE(set.insert(folly::stringPrintf("row_%d", i)));
+    }
+    EXPECT_EQ(100, set.size());
+
+    FingerprintSet other(0, &collide);
+    for (auto i = 50; i < 150; i++) {
+        other.insert(folly::stringPrintf("row_%d", i));
+    }
+    set.merge(other);
+    EXPECT_EQ(150, set.size());
+    EXPECT_FALSE(set.insert("row_149"));
+    EXPECT_TRUE(set.insert("row_150"));
+}
+
+}  // namespace nebula
@@ -33,6 +33,82 @@ TEST(NebulaKeyUtilsTest, SimpleTest) {
     ASSERT_TRUE(NebulaKeyUtils::isUUIDKey(uuidKey));
 }
 
+TEST(NebulaKeyUtilsTest, SingleVersionTest) {
+    PartitionID partId = 15;
+    VertexID srcId = 1001L, dstId = 2001L;
+    TagID tagId = 1001;
+    EdgeType type = 101;
+    EdgeRanking rank = 10L;
+
+    auto vertexKey = NebulaKeyUtils::vertexKey(partId, srcId, tagId, 20L);
+    ASSERT_TRUE(NebulaKeyUtils::hasVersion(vertexKey));
+    auto svVertexKey = NebulaKeyUtils::vertexKey(partId, srcId, tagId);
+    ASSERT_TRUE(NebulaKeyUtils::isVertex(svVertexKey));
+    ASSERT_FALSE(NebulaKeyUtils::hasVersion(svVertexKey));
+
+    auto edgeKey = NebulaKeyUtils::edgeKey(partId, srcId, type, rank, dstId, 20L);
+    ASSERT_TRUE(NebulaKeyUtils::hasVersion(edgeKey));
+    auto svEdgeKey = NebulaKeyUtils::edgeKey(partId, srcId, type, rank, dstId);
+    ASSERT_TRUE(NebulaKeyUtils::isEdge(svEdgeKey));
+    ASSERT_FALSE(NebulaKeyUtils::hasVersion(svEdgeKey));
+}
+
+TEST(NebulaKeyUtilsTest, OrderedFormatTest) {
+    auto format = NebulaKeyFormat::kOrdered;
+    PartitionID partId = 15;
+    TagID tagId = 1001;
+    TagVersion tagVersion = folly::Endian::big(20L);
+    EdgeRanking rank = -10L;
+    EdgeVersion edgeVersion = folly::Endian::big(20L);
+
+    std::vector<VertexID> ids = {std::numeric_limits<VertexID>::min(), -256L, -1L,
+                                 0L, 1L, 255L, 256L, std::numeric_limits<VertexID>::max()};
+    std::string prev;
+    for (auto vId : ids) {
+        auto vertexKey = NebulaKeyUtils::vertexKey(partId, vId, tagId, tagVersion, format);
+        ASSERT_TRUE(NebulaKeyUtils::isVertex(vertexKey, format));
+        ASSERT_FALSE(NebulaKeyUtils::isEdge(vertexKey, format));
+        ASSERT_EQ(tagId, NebulaKeyUtils::getTagId(vertexKey, format));
+        ASSERT_EQ(0, vertexKey.find(NebulaKeyUtils::vertexPrefix(partId, vId, format)));
+        // Keys are sorted by the vertex id
+        ASSERT_LT(prev, vertexKey);
+        prev = vertexKey;
+
+        for (auto type : {101, -101}) {
+            auto edgeKey = NebulaKeyUtils::edgeKey(partId, vId, type, rank, ~vId, edgeVersion,
+                                                   format);
+            ASSERT_TRUE(NebulaKeyUtils::isEdge(edgeKey, format));
+            ASSERT_FALSE(NebulaKeyUtils::isVertex(edgeKey, format));
+            ASSERT_EQ(vId, NebulaKeyUtils::getSrcId(edgeKey, format));
+            ASSERT_EQ(~vId, NebulaKeyUtils::getDstId(edgeKey, format));
+            ASSERT_EQ(type, NebulaKeyUtils::getEdgeType(edgeKey, format));
+            ASSERT_EQ(rank, NebulaKeyUtils::getRank(edgeKey, format));
+            ASSERT_EQ(0, edgeKey.find(NebulaKeyUtils::edgePrefix(partId, vId, type, format)));
+        }
+    }
+
+    // The edges of one vertex are sorted by the rank
+    auto edgeKey1 = NebulaKeyUtils::edgeKey(partId, 1, 101, -1, 2, edgeVersion, format);
+    auto edgeKey2 = NebulaKeyUtils::edgeKey(partId, 1, 101, 1, 2, edgeVersion, format);
+    ASSERT_LT(edgeKey1, edgeKey2);
+}
+
+TEST(NebulaKeyUtilsTest, EncodeIntTest) {
+    for (auto format : {NebulaKeyFormat::kNative, NebulaKeyFormat::kOrdered}) {
+        for (int64_t v : {std::numeric_limits<int64_t>::min(), -1L, 0L, 1L,
+                          std::numeric_limits<int64_t>::max()}) {
+            std::string encoded;
+            NebulaKeyUtils::encodeInt(encoded, v, format);
+            ASSERT_EQ(sizeof(int64_t), encoded.size());
+            ASSERT_EQ(v, NebulaKeyUtils::decodeInt<int64_t>(encoded.data(), format));
+        }
+    }
+    auto key = NebulaKeyUtils::systemKeyFormatKey();
+    ASSERT_TRUE(NebulaKeyUtils::isSystemKeyFormat(key));
+    ASSERT_FALSE(NebulaKeyUtils::isSystemPart(key));
+    ASSERT_FALSE(NebulaKeyUtils::isSystemCommit(key));
+}
+
 }  // namespace nebula
 
 
@@ -0,0 +1,52 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "base/Partitioner.h"
+
+namespace nebula {
+
+TEST(PartitionerTest, HashTest) {
+    auto partitioner = Partitioner::hash(10);
+    EXPECT_EQ(Partitioner::Strategy::HASH, partitioner->strategy());
+    EXPECT_EQ(1, partitioner->partId(0));
+    EXPECT_EQ(2, partitioner->partId(1));
+    EXPECT_EQ(10, partitioner->partId(19));
+    EXPECT_EQ(static_cast<uint64_t>(-1) % 10 + 1, partitioner->partId(-1));
+}
+
+
+TEST(PartitionerTest, RangeTest) {
+    auto ret = Partitioner::range(3, {100, 200});
+    ASSERT_TRUE(ret.ok());
+    auto partitioner = ret.value();
+    EXPECT_EQ(Partitioner::Strategy::RANGE, partitioner->strategy());
+    EXPECT_EQ(1, partitioner->partId(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ(1, partitioner->partId(99));
+    EXPECT_EQ(2, partitioner->partId(100));
+    EXPECT_EQ(2, partitioner->partId(199));
+    EXPECT_EQ(3, partitioner->partId(200));
+    EXPECT_EQ(3, partitioner->partId(std::numeric_limits<int64_t>::max()));
+
+    EXPECT_FALSE(Partitioner::range(3, {100}).ok());
+    EXPECT_FALSE(Partitioner::range(3, {200, 100}).ok());
+    EXPECT_FALSE(Partitioner::range(0, {}).ok());
+}
+
+
+TEST(PartitionerTest, EvenRangeTest) {
+    auto ret = Partitioner::range(4, {});
+    ASSERT_TRUE(ret.ok());
+    auto partitioner = ret.value();
+    EXPECT_EQ(3, partitioner->bounds().size());
+    EXPECT_EQ(1, partitioner->partId(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ(2, partitioner->partId(-1));
+    EXPECT_EQ(3, partitioner->partId(0));
+    EXPECT_EQ(4, partitioner->partId(std::numeric_limits<int64_t>::max()));
+}
+
+}  // namespace nebula
@@ -0,0 +1,511 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/small_vector.h>
+#include "filter/CompiledExpression.h"
+
+namespace nebula {
+
+TypedValue TypedValue::ofVariant(const VariantType &v) {
+    switch (v.which()) {
+        case VAR_INT64:
+            return ofInt(boost::get<int64_t>(v));
+        case VAR_DOUBLE:
+            return ofDouble(boost::get<double>(v));
+        case VAR_BOOL:
+            return ofBool(boost::get<bool>(v));
+        case VAR_STR:
+            return ofString(boost::get<std::string>(v));
+        default:
+            DCHECK(false);
+    }
+    return TypedValue();
+}
+
+
+VariantType TypedValue::toVariant() const {
+    switch (type) {
+        case Type::kInt:
+            return intVal;
+        case Type::kDouble:
+            return doubleVal;
+        case Type::kBool:
+            return boolVal;
+        case Type::kString:
+            return strVal.str();
+        case Type::kNull:
+            break;
+    }
+    LOG(FATAL) << "Null value can't be converted to a variant";
+}
+
+
+// static
+StatusOr<std::unique_ptr<CompiledExpression>>
+CompiledExpression::compile(const Expression *expr) {
+    if (expr == nullptr) {
+        return Status::Error("Empty expression");
+    }
+    std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+    auto status = compiled->compileExpr(expr);
+    if (!status.ok()) {
+        return status;
+    }
+    DCHECK_EQ(1UL, compiled->depth_);
+    return std::move(compiled);
+}
+
+
+Status CompiledExpression::push() {
+    if (++depth_ > kMaxStackDepth) {
+        return Status::Error("Expression is too deep to compile");
+    }
+    return Status::OK();
+}
+
+
+uint32_t CompiledExpression::addSlot(Expression::Kind kind,
+                                     const std::string &alias,
+                                     const std::string &prop) {
+    for (uint32_t i = 0; i < slots_.size(); i++) {
+        auto &slot = slots_[i];
+        if (slot.kind == kind && slot.alias == alias && slot.prop == prop) {
+            return i;
+        }
+    }
+    slots_.emplace_back(Slot{kind, alias, prop});
+    return slots_.size() - 1;
+}
+
+
+Status CompiledExpression::compileExpr(const Expression *expr) {
+    switch (expr->kind()) {
+        case Expression::kPrimary:
+        case Expression::kEdgeType: {
+            // Both of them are evaluated without any getter
+            Getters getters;
+            auto value = expr->eval(getters);
+            if (!value.ok()) {
+                return value.status();
+            }
+            if (value.value().which() == VAR_STR) {
+                strings_.emplace_back(boost::get<std::string>(value.value()));
+                constants_.emplace_back(TypedValue::ofString(strings_.back()));
+            } else {
+                constants_.emplace_back(TypedValue::ofVariant(value.value()));
+            }
+            program_.emplace_back(Instruction{OpCode::kConstant, 0,
+                                              static_cast<uint32_t>(constants_.size() - 1)});
+            return push();
+        }
+        case Expression::kEdgeSrcId:
+        case Expression::kEdgeDstId:
+        case Expression::kEdgeRank:
+        case Expression::kAliasProp:
+        case Expression::kSourceProp:
+        case Expression::kDestProp:
+        case Expression::kInputProp:
+        case Expression::kVariableProp: {
+            auto *propExpr = static_cast<const AliasPropertyExpression*>(expr);
+            auto kind = expr->kind();
+            if (kind == Expression::kEdgeSrcId
+                    || kind == Expression::kEdgeDstId
+                    || kind == Expression::kEdgeRank) {
+                kind = Expression::kAliasProp;
+            }
+            auto *alias = propExpr->alias();
+            auto *prop = propExpr->prop();
+            auto index = addSlot(kind,
+                                 alias == nullptr ? "" : *alias,
+                                 prop == nullptr ? "" : *prop);
+            program_.emplace_back(Instruction{OpCode::kLoadSlot, 0, index});
+            lastSlot_ = index;
+            return push();
+        }
+        case Expression::kUnary: {
+            auto *unaryExpr = static_cast<const UnaryExpression*>(expr);
+            auto status = compileExpr(unaryExpr->operand());
+            if (!status.ok()) {
+                return status;
+            }
+            program_.emplace_back(Instruction{OpCode::kUnary,
+                                              static_cast<uint8_t>(unaryExpr->op()), 0});
+            return Status::OK();
+        }
+        case Expression::kArithmetic:
+        case Expression::kRelational:
+        case Expression::kLogical: {
+            const Expression *left = nullptr;
+            const Expression *right = nullptr;
+            Instruction inst;
+            if (expr->kind() == Expression::kArithmetic) {
+                auto *arith = static_cast<const ArithmeticExpression*>(expr);
+                left = arith->left();
+                right = arith->right();
+                inst = Instruction{OpCode::kArithmetic, static_cast<uint8_t>(arith->op()), 0};
+            } else if (expr->kind() == Expression::kRelational) {
+                auto *rel = static_cast<const RelationalExpression*>(expr);
+                left = rel->left();
+                right = rel->right();
+                inst = Instruction{OpCode::kRelational, static_cast<uint8_t>(rel->op()), 0};
+            } else {
+                auto *logic = static_cast<const LogicalExpression*>(expr);
+                left = logic->left();
+                right = logic->right();
+                inst = Instruction{OpCode::kLogical, static_cast<uint8_t>(logic->op()), 0};
+            }
+            auto status = compileExpr(left);
+            if (!status.ok()) {
+                return status;
+            }
+            status = compileExpr(right);
+            if (!status.ok()) {
+                return status;
+            }
+            program_.emplace_back(inst);
+            depth_--;
+            return Status::OK();
+        }
+        default:
+            break;
+    }
+    return Status::Error("Expression `%s' is not compilable", expr->toString().c_str());
+}
+
+
+CompiledExpression::FilterResult CompiledExpression::filter(const TypedValue *slots) const {
+    TypedValue result;
+    std::list<std::string> strings;
+    if (!run(slots, result, strings)) {
+        return FilterResult::kError;
+    }
+    return toBool(result) ? FilterResult::kTrue : FilterResult::kFalse;
+}
+
+
+OptVariantType CompiledExpression::eval(const TypedValue *slots) const {
+    TypedValue result;
+    std::list<std::string> strings;
+    if (!run(slots, result, strings)) {
+        return Status::Error("Failed to evaluate the compiled expression");
+    }
+    return result.toVariant();
+}
+
+
+OptVariantType CompiledExpression::eval(Getters &getters) const {
+    folly::small_vector<VariantType, 8> values;
+    values.reserve(slots_.size());
+    for (auto &slot : slots_) {
+        OptVariantType value;
+        switch (slot.kind) {
+            case Expression::kAliasProp:
+                value = getters.getAliasProp(slot.alias, slot.prop);
+                break;
+            case Expression::kSourceProp:
+                value = getters.getSrcTagProp(slot.alias, slot.prop);
+                break;
+            case Expression::kDestProp:
+                value = getters.getDstTagProp(slot.alias, slot.prop);
+                break;
+            case Expression::kInputProp:
+                value = getters.getInputProp(slot.prop);
+                break;
+            case Expression::kVariableProp:
+                value = getters.getVariableProp(slot.prop);
+                break;
+            default:
+                LOG(FATAL) << "Unexpected slot kind " << static_cast<int32_t>(slot.kind);
+        }
+        if (!value.ok()) {
+            return value;
+        }
+        values.emplace_back(std::move(value).value());
+    }
+
+    // The strings in TypedValue refer to the ones in values, which won't be moved any more
+    folly::small_vector<TypedValue, 8> typed;
+    typed.reserve(values.size());
+    for (auto &value : values) {
+        typed.emplace_back(TypedValue::ofVariant(value));
+    }
+    return eval(typed.data());
+}
+
+
+bool CompiledExpression::run(const TypedValue *slots,
+                             TypedValue &result,
+                             std::list<std::string> &strings) const {
+    TypedValue stack[kMaxStackDepth];
+    size_t top = 0;
+    for (auto &inst : program_) {
+        switch (inst.code) {
+            case OpCode::kConstant:
+                stack[top++] = constants_[inst.index];
+                break;
+            case OpCode::kLoadSlot:
+                if (slots[inst.index].type == TypedValue::Type::kNull) {
+                    return false;
+                }
+                stack[top++] = slots[inst.index];
+                break;
+            case OpCode::kUnary:
+                if (!unary(inst.op, stack[top - 1])) {
+                    return false;
+                }
+                break;
+            case OpCode::kArithmetic:
+                top--;
+                if (!arithmetic(inst.op, stack[top - 1], stack[top], strings)) {
+                    return false;
+                }
+                break;
+            case OpCode::kRelational:
+                top--;
+                if (!relational(inst.op, stack[top - 1], stack[top])) {
+                    return false;
+                }
+                break;
+            case OpCode::kLogical:
+                top--;
+                logical(inst.op, stack[top - 1], stack[top]);
+                break;
+        }
+    }
+    DCHECK_EQ(1UL, top);
+    result = stack[0];
+    return true;
+}
+
+
+// static
+bool CompiledExpression::toBool(const TypedValue &value) {
+    // Keep the same as Expression::asBool
+    switch (value.type) {
+        case TypedValue::Type::kInt:
+            return value.intVal != 0;
+        case TypedValue::Type::kDouble:
+            return value.doubleVal != 0.0;
+        case TypedValue::Type::kBool:
+            return value.boolVal;
+        case TypedValue::Type::kString:
+            return value.strVal.empty();
+        case TypedValue::Type::kNull:
+            break;
+    }
+    return false;
+}
+
+
+// static
+bool CompiledExpression::unary(uint8_t op, TypedValue &value) {
+    switch (op) {
+        case UnaryExpression::PLUS:
+            return true;
+        case UnaryExpression::NEGATE:
+            if (value.type == TypedValue::Type::kInt) {
+                value.intVal = -value.intVal;
+                return true;
+            } else if (value.type == TypedValue::Type::kDouble) {
+                value.doubleVal = -value.doubleVal;
+                return true;
+            }
+            return false;
+        case UnaryExpression::NOT:
+            value = TypedValue::ofBool(!toBool(value));
+            return true;
+    }
+    return false;
+}
+
+
+namespace {
+
+bool isArithmetic(const TypedValue &value) {
+    return value.type == TypedValue::Type::kInt || value.type == TypedValue::Type::kDouble;
+}
+
+double asDouble(const TypedValue &value) {
+    switch (value.type) {
+        case TypedValue::Type::kInt:
+            return static_cast<double>(value.intVal);
+        case TypedValue::Type::kDouble:
+            return value.doubleVal;
+        case TypedValue::Type::kBool:
+            return value.boolVal ? 1.0 : 0.0;
+        default:
+            DCHECK(false);
+    }
+    return 0.0;
+}
+
+int64_t asInt(const TypedValue &value) {
+    switch (value.type) {
+        case TypedValue::Type::kInt:
+            return value.intVal;
+        case TypedValue::Type::kDouble:
+            return static_cast<int64_t>(value.doubleVal);
+        case TypedValue::Type::kBool:
+            return value.boolVal ? 1 : 0;
+        default:
+            DCHECK(false);
+    }
+    return 0;
+}
+
+template <typename T>
+bool compare(uint8_t op, const T &left, const T &right) {
+    switch (op) {
+        case RelationalExpression::LT:
+            return left < right;
+        case RelationalExpression::LE:
+            return left <= right;
+        case RelationalExpression::GT:
+            return left > right;
+        case RelationalExpression::GE:
+            return left >= right;
+        case RelationalExpression::EQ:
+            return left == right;
+        case RelationalExpression::NE:
+            return left != right;
+    }
+    return false;
+}
+
+}   // namespace
+
+
+// static
+bool CompiledExpression::arithmetic(uint8_t op,
+                                    TypedValue &left,
+                                    const TypedValue &right,
+                                    std::list<std::string> &strings) {
+    if (op == ArithmeticExpression::ADD
+            && left.type == TypedValue::Type::kString
+            && right.type == TypedValue::Type::kString) {
+        strings.emplace_back();
+        auto &concat = strings.back();
+        concat.reserve(left.strVal.size() + right.strVal.size());
+        concat.append(left.strVal.data(), left.strVal.size());
+        concat.append(right.strVal.data(), right.strVal.size());
+        left = TypedValue::ofString(concat);
+        return true;
+    }
+    if (!isArithmetic(left) || !isArithmetic(right)) {
+        return false;
+    }
+
+    if (left.type == TypedValue::Type::kDouble || right.type == TypedValue::Type::kDouble) {
+        auto l = asDouble(left);
+        auto r = asDouble(right);
+        switch (op) {
+            case ArithmeticExpression::ADD:
+                left = TypedValue::ofDouble(l + r);
+                return true;
+            case ArithmeticExpression::SUB:
+                left = TypedValue::ofDouble(l - r);
+                return true;
+            case ArithmeticExpression::MUL:
+                left = TypedValue::ofDouble(l * r);
+                return true;
+            case ArithmeticExpression::DIV:
+                left = TypedValue::ofDouble(l / r);
+                return true;
+            case ArithmeticExpression::MOD:
+                left = TypedValue::ofDouble(fmod(l, r));
+                return true;
+            case ArithmeticExpression::XOR:
+                left = TypedValue::ofInt(static_cast<int64_t>(std::round(l))
+                                            ^ static_cast<int64_t>(std::round(r)));
+                return true;
+        }
+        return false;
+    }
+
+    auto l = left.intVal;
+    auto r = right.intVal;
+    switch (op) {
+        case ArithmeticExpression::ADD:
+            left.intVal = l + r;
+            return true;
+        case ArithmeticExpression::SUB:
+            left.intVal = l - r;
+            return true;
+        case ArithmeticExpression::MUL:
+            left.intVal = l * r;
+            return true;
+        case ArithmeticExpression::DIV:
+            // Integer division by zero is an error rather than a crash
+            if (r == 0) {
+                return false;
+            }
+            left.intVal = l / r;
+            return true;
+        case ArithmeticExpression::MOD:
+            if (r == 0) {
+                return false;
+            }
+            left.intVal = l % r;
+            return true;
+        case ArithmeticExpression::XOR:
+            left.intVal = l ^ r;
+            return true;
+    }
+    return false;
+}
+
+
+// static
+bool CompiledExpression::relational(uint8_t op, TypedValue &left, TypedValue right) {
+    // The implicit casting rule is the same as RelationalExpression: bool -> int64_t -> double
+    auto ltype = left.type;
+    auto rtype = right.type;
+    bool result = false;
+    if (ltype == TypedValue::Type::kString || rtype == TypedValue::Type::kString) {
+        if (ltype != rtype) {
+            return false;
+        }
+        result = compare(op, left.strVal, right.strVal);
+    } else if (ltype == TypedValue::Type::kDouble || rtype == TypedValue::Type::kDouble) {
+        auto l = asDouble(left);
+        auto r = asDouble(right);
+        if (op == RelationalExpression::EQ) {
+            result = Expression::almostEqual(l, r);
+        } else if (op == RelationalExpression::NE) {
+            result = !Expression::almostEqual(l, r);
+        } else {
+            result = compare(op, l, r);
+        }
+    } else if (ltype == TypedValue::Type::kInt || rtype == TypedValue::Type::kInt) {
+        result = compare(op, asInt(left), asInt(right));
+    } else {
+        result = compare(op, left.boolVal, right.boolVal);
+    }
+    left = TypedValue::ofBool(result);
+    return true;
+}
+
+
+// static
+void CompiledExpression::logical(uint8_t op, TypedValue &left, const TypedValue &right) {
+    // Both sides have been evaluated, just the same as LogicalExpression
+    auto l = toBool(left);
+    auto r = toBool(right);
+    switch (op) {
+        case LogicalExpression::AND:
+            left = TypedValue::ofBool(l && r);
+            break;
+        case LogicalExpression::OR:
+            left = TypedValue::ofBool(l || r);
+            break;
+        default:
+            left = TypedValue::ofBool(l != r);
+            break;
+    }
+}
+
+}   // namespace nebula
@@ -0,0 +1,252 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+#ifndef COMMON_FILTER_COMPILEDEXPRESSION_H_
+#define COMMON_FILTER_COMPILEDEXPRESSION_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "dataman/RowReader.h"
+#include "filter/Expressions.h"
+
+namespace nebula {
+
+/**
+ * The value type used by CompiledExpression, the string is not owned.
+ */
+struct TypedValue {
+    enum class Type : uint8_t {
+        // A missing value, evaluating on which is an error
+        kNull = 0,
+        kInt,
+        kDouble,
+        kBool,
+        kString,
+    };
+
+    TypedValue() : type(Type::kNull), intVal(0) {}
+
+    static TypedValue ofInt(int64_t v) {
+        TypedValue value;
+        value.type = Type::kInt;
+        value.intVal = v;
+        return value;
+    }
+
+    static TypedValue ofDouble(double v) {
+        TypedValue value;
+        value.type = Type::kDouble;
+        value.doubleVal = v;
+        return value;
+    }
+
+    static TypedValue ofBool(bool v) {
+        TypedValue value;
+        value.type = Type::kBool;
+        value.boolVal = v;
+        return value;
+    }
+
+    static TypedValue ofString(folly::StringPiece v) {
+        TypedValue value;
+        value.type = Type::kString;
+        value.strVal = v;
+        return value;
+    }
+
+    // The variant must outlive the returned value if it is a string
+    static TypedValue ofVariant(const VariantType &v);
+
+    // Read the field by its type directly, the string refers to the row.
+    // A null value is returned if the field can't be read.
+    static TypedValue ofField(const RowReader *reader, int64_t index) {
+        if (reader == nullptr || index < 0) {
+            return TypedValue();
+        }
+        auto ret = ResultType::E_DATA_INVALID;
+        switch (reader->getSchema()->getFieldType(index).get_type()) {
+            case nebula::cpp2::SupportedType::BOOL: {
+                bool v;
+                ret = reader->getBool(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofBool(v);
+                }
+                break;
+            }
+            case nebula::cpp2::SupportedType::INT:
+            case nebula::cpp2::SupportedType::TIMESTAMP: {
+                int64_t v;
+                ret = reader->getInt(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofInt(v);
+                }
+                break;
+            }
+            case nebula::cpp2::SupportedType::VID: {
+                VertexID v;
+                ret = reader->getVid(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofInt(v);
+                }
+                break;
+            }
+            case nebula::cpp2::SupportedType::FLOAT: {
+                float v;
+                ret = reader->getFloat(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofDouble(v);
+                }
+                break;
+            }
+            case nebula::cpp2::SupportedType::DOUBLE: {
+                double v;
+                ret = reader->getDouble(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofDouble(v);
+                }
+                break;
+            }
+            case nebula::cpp2::SupportedType::STRING: {
+                folly::StringPiece v;
+                ret = reader->getString(index, v);
+                if (ret == ResultType::SUCCEEDED) {
+                    return ofString(v);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return TypedValue();
+    }
+
+    VariantType toVariant() const;
+
+    Type                    type;
+    union {
+        int64_t             intVal;
+        double              doubleVal;
+        bool                boolVal;
+    };
+    folly::StringPiece      strVal;
+};
+
+
+/**
+ * CompiledExpression flattens an expression tree into a postfix program, which runs
+ * on a stack of TypedValue, without any allocation or variant boxing except for
+ * the string concatenation.
+ *
+ * All the properties referred by the expression are resolved to slots at compile time.
+ * The caller loads the value of each slot, e.g. by the field index in a row,
+ * and then runs the program on the slots.
+ *
+ * Only the literals, properties, unary, arithmetic, relational and logical expressions
+ * could be compiled, the others should fall back to Expression::eval.
+ * The program is immutable after compiled, so it could be run concurrently.
+ */
+class CompiledExpression final {
+public:
+    struct Slot {
+        // One of kAliasProp, kSourceProp, kDestProp, kInputProp and kVariableProp.
+        // kEdgeSrcId, kEdgeDstId and kEdgeRank are taken as kAliasProp
+        Expression::Kind    kind;
+        std::string         alias;
+        std::string         prop;
+    };
+
+    enum class FilterResult : uint8_t {
+        kTrue,
+        kFalse,
+        kError,
+    };
+
+    static constexpr size_t kMaxStackDepth = 32;
+
+    static StatusOr<std::unique_ptr<CompiledExpression>> compile(const Expression *expr);
+
+    const std::vector<Slot>& slots() const {
+        return slots_;
+    }
+
+    /**
+     * The slot loaded last by the program, -1 if there is none. The getters are
+     * called in the same order, so it's the slot deciding the type of a yield column.
+     */
+    int32_t lastSlot() const {
+        return lastSlot_;
+    }
+
+    /**
+     * Run the program on the values of all slots, and convert the result to bool.
+     */
+    FilterResult filter(const TypedValue *slots) const;
+
+    OptVariantType eval(const TypedValue *slots) const;
+
+    /**
+     * Load the value of each slot by the getters, then run the program.
+     * It's a drop-in replacement of Expression::eval, except that each property
+     * is fetched only once.
+     */
+    OptVariantType eval(Getters &getters) const;
+
+private:
+    CompiledExpression() = default;
+
+    enum class OpCode : uint8_t {
+        kConstant,
+        kLoadSlot,
+        kUnary,
+        kArithmetic,
+        kRelational,
+        kLogical,
+    };
+
+    struct Instruction {
+        OpCode              code;
+        // The operator of unary, arithmetic, relational and logical expressions
+        uint8_t             op;
+        // Index of the constant or slot
+        uint32_t            index;
+    };
+
+    Status compileExpr(const Expression *expr);
+
+    Status push();
+
+    uint32_t addSlot(Expression::Kind kind, const std::string &alias, const std::string &prop);
+
+    bool run(const TypedValue *slots,
+             TypedValue &result,
+             std::list<std::string> &strings) const;
+
+    static bool toBool(const TypedValue &value);
+
+    static bool unary(uint8_t op, TypedValue &value);
+
+    static bool arithmetic(uint8_t op,
+                           TypedValue &left,
+                           const TypedValue &right,
+                           std::list<std::string> &strings);
+
+    static bool relational(uint8_t op, TypedValue &left, TypedValue right);
+
+    static void logical(uint8_t op, TypedValue &left, const TypedValue &right);
+
+private:
+    std::vector<Instruction>                    program_;
+    std::vector<TypedValue>                     constants_;
+    // Holds the string constants
+    std::list<std::string>                      strings_;
+    std::vector<Slot>                           slots_;
+    int32_t                                     lastSlot_{-1};
+    // Only used while compiling
+    size_t                                      depth_{0};
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_FILTER_COMPILEDEXPRESSION_H_
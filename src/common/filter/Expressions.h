@@ -620,6 +620,11 @@ public:
         operand_ = std::move(val);
     }
 
+    // To bind the value of the placeholder `?' in prepared statements
+    void setOperand(VariantType operand) {
+        operand_ = std::move(operand);
+    }
+
     std::string toString() const override;
 
     OptVariantType eval(Getters &getters) const override;
@@ -773,6 +778,10 @@ public:
         return operand_.get();
     }
 
+    Operator op() const {
+        return op_;
+    }
+
 private:
     void encode(Cord &cord) const override;
 
@@ -868,6 +877,10 @@ public:
         return right_.get();
     }
 
+    Operator op() const {
+        return op_;
+    }
+
 private:
     void encode(Cord &cord) const override;
 
@@ -919,6 +932,10 @@ public:
         return right_.get();
     }
 
+    Operator op() const {
+        return op_;
+    }
+
 private:
     void encode(Cord &cord) const override;
 
@@ -0,0 +1,124 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include "filter/CompiledExpression.h"
+#include "parser/GQLParser.h"
+
+using nebula::CompiledExpression;
+using nebula::Expression;
+using nebula::GQLParser;
+using nebula::Getters;
+using nebula::GoSentence;
+using nebula::OptVariantType;
+using nebula::SequentialSentences;
+using nebula::StatusOr;
+using nebula::TypedValue;
+
+static Expression* getFilterExpr(SequentialSentences *sentences) {
+    auto *go = dynamic_cast<GoSentence*>(sentences->sentences().front());
+    return go->whereClause()->filter();
+}
+
+// alias.propN is (N * 10)
+static int64_t propValue(const std::string &prop) {
+    return folly::to<int64_t>(prop.substr(4)) * 10;
+}
+
+static std::unordered_map<std::string, int64_t> props = {
+    {"prop1", propValue("prop1")},
+    {"prop2", propValue("prop2")},
+    {"prop3", propValue("prop3")},
+    {"prop4", propValue("prop4")},
+    {"prop5", propValue("prop5")},
+    {"prop6", propValue("prop6")},
+};
+
+size_t Interpret(size_t iters, std::string query) {
+    constexpr size_t ops = 1000000UL;
+
+    query = "GO FROM 1 AS p OVER q WHERE " + query;
+    Expression *expr;
+    Getters getters;
+    StatusOr<std::unique_ptr<SequentialSentences>> result;
+    BENCHMARK_SUSPEND {
+        GQLParser parser;
+        result = parser.parse(query);
+        if (!result.ok()) {
+             return 0;
+        }
+        expr = getFilterExpr(result.value().get());
+        // Look up the prop by name, as storage reads the row by getPropByName
+        getters.getAliasProp = [] (const std::string&,
+                                   const std::string &prop) -> OptVariantType {
+            return props[prop];
+        };
+    }
+
+    auto i = 0UL;
+    while (i++ < ops * iters) {
+        auto value = expr->eval(getters);
+        folly::doNotOptimizeAway(value);
+    }
+
+    return iters * ops;
+}
+
+size_t Compiled(size_t iters, std::string query) {
+    constexpr size_t ops = 1000000UL;
+
+    query = "GO FROM 1 AS p OVER q WHERE " + query;
+    std::unique_ptr<CompiledExpression> compiled;
+    std::vector<int64_t> values;
+    std::vector<TypedValue> slots;
+    BENCHMARK_SUSPEND {
+        GQLParser parser;
+        auto result = parser.parse(query);
+        if (!result.ok()) {
+             return 0;
+        }
+        auto ret = CompiledExpression::compile(getFilterExpr(result.value().get()));
+        if (!ret.ok()) {
+            return 0;
+        }
+        compiled = std::move(ret).value();
+        for (auto &slot : compiled->slots()) {
+            values.emplace_back(props[slot.prop]);
+        }
+        slots.resize(values.size());
+    }
+
+    auto i = 0UL;
+    while (i++ < ops * iters) {
+        // Load the slots by index as storage does for each edge
+        for (size_t j = 0; j < slots.size(); j++) {
+            slots[j] = TypedValue::ofInt(values[j]);
+        }
+        auto value = compiled->filter(slots.data());
+        folly::doNotOptimizeAway(value);
+    }
+
+    return iters * ops;
+}
+
+auto simpleQuery =  "123 + 123 - 123 * 123 / 123";
+auto complexQuery =  "alias.prop1 + alias.prop2 * alias.prop3 > alias.prop4 && "
+                     "alias.prop5 == alias.prop6";
+
+BENCHMARK_NAMED_PARAM_MULTI(Interpret, Simple, simpleQuery);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(Compiled, Simple, simpleQuery);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(Interpret, Complex, complexQuery);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(Compiled, Complex, complexQuery);
+
+int
+main(int argc, char **argv) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include <gtest/gtest.h>
+#include "filter/CompiledExpression.h"
 #include "filter/FunctionManager.h"
 #include "parser/GQLParser.h"
 #include "parser/SequentialSentences.h"
@@ -800,6 +801,111 @@ TEST_F(ExpressionTest, InvalidExpressionTest) {
 }
 
 
+TEST_F(ExpressionTest, CompiledExpression) {
+    GQLParser parser;
+    Getters getters;
+    getters.getAliasProp = [] (const std::string &alias,
+                               const std::string &prop) -> OptVariantType {
+        if (alias != "follow") {
+            return Status::Error("Ignore this edge");
+        }
+        if (prop == "name") {
+            return std::string("Tony");
+        } else if (prop == "likeness") {
+            return 90.5;
+        } else if (prop == "start") {
+            return 2010L;
+        }
+        return Status::Error("Invalid Prop");
+    };
+    getters.getSrcTagProp = [] (const std::string &tag,
+                                const std::string &prop) -> OptVariantType {
+        UNUSED(tag);
+        UNUSED(prop);
+        return true;
+    };
+    // The compiled one should be the same as the interpreted one
+#define TEST_EXPR(expr_arg)                                                     \
+    do {                                                                        \
+        std::string query = "GO FROM 1 OVER follow WHERE " expr_arg;            \
+        auto parsed = parser.parse(query);                                      \
+        ASSERT_TRUE(parsed.ok()) << parsed.status();                            \
+        auto *expr = getFilterExpr(parsed.value().get());                       \
+        auto compiled = CompiledExpression::compile(expr);                      \
+        ASSERT_TRUE(compiled.ok()) << compiled.status();                        \
+        auto expected = expr->eval(getters);                                    \
+        auto value = compiled.value()->eval(getters);                           \
+        ASSERT_EQ(expected.ok(), value.ok()) << expr_arg;                       \
+        if (expected.ok()) {                                                    \
+            ASSERT_EQ(expected.value(), value.value()) << expr_arg;             \
+        }                                                                       \
+    } while (false)
+
+    TEST_EXPR("1 + 2 * 3 - 4 / 2 % 3");
+    TEST_EXPR("1 + 2.5 * 3 - 4.0 / 2");
+    TEST_EXPR("5.5 % 2");
+    TEST_EXPR("3 ^ 5");
+    TEST_EXPR("3.4 ^ 5.6");
+    TEST_EXPR("\"abc\" + \"def\" + \"g\"");
+    TEST_EXPR("-(1 + 2)");
+    TEST_EXPR("!(1 + 2)");
+    TEST_EXPR("!\"\"");
+    TEST_EXPR("1 < 2.5 && 2 == 2.0 && 3.0 != 3");
+    TEST_EXPR("true == 1 && false < 1.0");
+    TEST_EXPR("\"abc\" < \"abd\" || \"abc\" == \"abc\"");
+    TEST_EXPR("1 > 2 XOR 2 > 1");
+    TEST_EXPR("\"123\" > 123");
+    TEST_EXPR("-\"A\"");
+    TEST_EXPR("TRUE + FALSE");
+    TEST_EXPR("follow.name == \"Tony\" && follow.likeness > 90");
+    TEST_EXPR("follow.start + 10 > follow.likeness * 20");
+    TEST_EXPR("follow.name + \"Parker\" == \"TonyParker\"");
+    TEST_EXPR("follow._type == follow._type");
+    TEST_EXPR("$^.person.male && follow.start >= 2010");
+    TEST_EXPR("follow.age > 10");
+    TEST_EXPR("serve.start > 10 || follow.start > 10");
+#undef TEST_EXPR
+
+    // Each prop is loaded into one slot
+    {
+        auto query = "GO FROM 1 OVER follow WHERE "
+                     "follow.start > 1 && follow.start < 3000 && follow.likeness > 1.0";
+        auto parsed = parser.parse(query);
+        ASSERT_TRUE(parsed.ok()) << parsed.status();
+        auto compiled = CompiledExpression::compile(getFilterExpr(parsed.value().get()));
+        ASSERT_TRUE(compiled.ok()) << compiled.status();
+        auto &slots = compiled.value()->slots();
+        ASSERT_EQ(2UL, slots.size());
+        ASSERT_EQ("start", slots[0].prop);
+        ASSERT_EQ("likeness", slots[1].prop);
+
+        TypedValue values[2];
+        values[0] = TypedValue::ofInt(2019);
+        values[1] = TypedValue::ofDouble(0.5);
+        ASSERT_EQ(CompiledExpression::FilterResult::kFalse,
+                  compiled.value()->filter(values));
+        values[1] = TypedValue::ofDouble(1.5);
+        ASSERT_EQ(CompiledExpression::FilterResult::kTrue,
+                  compiled.value()->filter(values));
+        values[1] = TypedValue::ofString("1.5");
+        ASSERT_EQ(CompiledExpression::FilterResult::kError,
+                  compiled.value()->filter(values));
+        // Missing value
+        values[1] = TypedValue();
+        ASSERT_EQ(CompiledExpression::FilterResult::kError,
+                  compiled.value()->filter(values));
+    }
+    // Function call is not compilable
+    {
+        auto query = "GO FROM 1 OVER follow WHERE abs(follow.start) > 1";
+        auto parsed = parser.parse(query);
+        ASSERT_TRUE(parsed.ok()) << parsed.status();
+        auto compiled = CompiledExpression::compile(getFilterExpr(parsed.value().get()));
+        ASSERT_FALSE(compiled.ok());
+    }
+}
+
+
 TEST_F(ExpressionTest, StringLengthLimitTest) {
     constexpr auto MAX = (1UL<<20);
     std::string str(MAX, 'X');
@@ -6,6 +6,81 @@
 
 #include "base/Base.h"
 #include "thrift/ThriftClientManager.h"
+#include <thrift/lib/cpp/transport/THeader.h>
+#include "stats/StatsManager.h"
 
 DEFINE_int32(conn_timeout_ms, 1000,
              "Connection timeout in milliseconds");
+DEFINE_int32(rpc_connections_per_host, 1,
+             "The max connections to a host from each IO thread");
+DEFINE_int32(rpc_scan_connections_per_host, 0,
+             "The max connections to a host from each IO thread for the scan requests, "
+             "0 means sharing the connections of the other requests");
+DEFINE_string(rpc_compression, "none",
+              "Compression of the storage and raft RPCs, none, zlib or zstd");
+DEFINE_int32(rpc_compression_min_bytes, 16384,
+             "The responses smaller than it are not compressed, "
+             "even if the request asks for the compression");
+
+namespace nebula {
+namespace thrift {
+
+folly::Optional<uint16_t> compressionTransform() {
+    using apache::thrift::transport::THeader;
+    if (FLAGS_rpc_compression == "zlib") {
+        return THeader::ZLIB_TRANSFORM;
+    } else if (FLAGS_rpc_compression == "zstd") {
+        return THeader::ZSTD_TRANSFORM;
+    } else if (FLAGS_rpc_compression != "none") {
+        LOG(WARNING) << "Unknown rpc_compression " << FLAGS_rpc_compression;
+    }
+    return folly::none;
+}
+
+
+void WireStats::setSocket(const std::shared_ptr<apache::thrift::async::TAsyncSocket>& socket) {
+    // Report the bytes of the last connection if it's still alive
+    report();
+    socket_ = socket;
+    sent_ = 0;
+    received_ = 0;
+}
+
+
+void WireStats::report() {
+    auto socket = socket_.lock();
+    if (socket == nullptr) {
+        return;
+    }
+    auto sent = socket->getRawBytesWritten();
+    auto received = socket->getRawBytesReceived();
+    if (sent > sent_) {
+        stats::StatsManager::addValue(sentStatId_, sent - sent_);
+    }
+    if (received > received_) {
+        stats::StatsManager::addValue(receivedStatId_, received - received_);
+    }
+    sent_ = sent;
+    received_ = received;
+}
+
+
+// static
+void WireStats::reportPeriodically(std::weak_ptr<WireStats> stats, folly::EventBase* evb) {
+    evb->runInEventBaseThread([stats = std::move(stats), evb] () mutable {
+        evb->runAfterDelay([stats = std::move(stats), evb] () mutable {
+            {
+                auto s = stats.lock();
+                if (s == nullptr) {
+                    // The last bytes are reported on tearing down the channel
+                    return;
+                }
+                s->report();
+            }
+            reportPeriodically(std::move(stats), evb);
+        }, kReportIntervalMs);
+    });
+}
+
+}  // namespace thrift
+}  // namespace nebula
@@ -8,34 +8,119 @@
 #define COMMON_THRIFT_THRIFTCLIENTMANAGER_H_
 
 #include "base/Base.h"
+#include <folly/Optional.h>
 #include <folly/io/async/EventBaseManager.h>
+#include <thrift/lib/cpp/async/TAsyncSocket.h>
 
 namespace nebula {
 namespace thrift {
 
+/**
+ * The header transform of FLAGS_rpc_compression, none if there is no compression.
+ */
+folly::Optional<uint16_t> compressionTransform();
+
+/**
+ * The bytes on the wire of one connection, i.e. after the compression,
+ * which are read from its socket in the event base thread.
+ */
+class WireStats final {
+public:
+    WireStats(int32_t sentStatId, int32_t receivedStatId)
+        : sentStatId_(sentStatId), receivedStatId_(receivedStatId) {}
+
+    // Called in the event base thread, each time the connection is created
+    void setSocket(const std::shared_ptr<apache::thrift::async::TAsyncSocket>& socket);
+
+    // Add the bytes since the last report to the stats, in the event base thread
+    void report();
+
+    // Report every second in the event base thread until the stats are released,
+    // i.e. the channel is torn down, could be called in any thread
+    static void reportPeriodically(std::weak_ptr<WireStats> stats, folly::EventBase* evb);
+
+private:
+    static constexpr uint32_t kReportIntervalMs = 1000;
+
+    const int32_t sentStatId_;
+    const int32_t receivedStatId_;
+    // Owned by the channel
+    std::weak_ptr<apache::thrift::async::TAsyncSocket> socket_;
+    size_t sent_{0};
+    size_t received_{0};
+};
+
+/**
+ * The requests to a host from an event base go through a pool of at most
+ * rpc_connections_per_host connections. Each request picks the connection with the
+ * least outstanding requests, which are counted by the callers of `pick()' from sending
+ * the requests until their completion, and a new connection is only opened if all of
+ * them are busy. If rpc_scan_connections_per_host is not 0, the scan requests, i.e. the
+ * ones with large responses, use a separate pool of connections.
+ */
 template<class ClientType>
 class ThriftClientManager final {
 public:
+    struct Client {
+        std::shared_ptr<ClientType>             client;
+        // Number of the requests outstanding on the connection
+        std::shared_ptr<std::atomic<int64_t>>   outstanding;
+    };
+
+    /**
+     * Pick a connection for a request. The caller should increase `outstanding' when
+     * the request is sent, and decrease it when the request is completed.
+     */
+    Client pick(const HostAddr& host,
+                folly::EventBase* evb = nullptr,
+                bool compatibility = false,
+                uint32_t timeout = 0,
+                bool scan = false);
+
+    /**
+     * Same as `pick()', for the callers not tracking their requests.
+     */
     std::shared_ptr<ClientType> client(const HostAddr& host,
                                        folly::EventBase* evb = nullptr,
                                        bool compatibility = false,
-                                       uint32_t timeout = 0);
+                                       uint32_t timeout = 0,
+                                       bool scan = false) {
+        return pick(host, evb, compatibility, timeout, scan).client;
+    }
 
     ~ThriftClientManager() {
         VLOG(3) << "~ThriftClientManager";
     }
 
-    ThriftClientManager() {
-        VLOG(3) << "ThriftClientManager";
-    }
+    /**
+     * If the name is given, the bytes on the wire are exported as
+     * <name>_bytes_sent and <name>_bytes_received, and the outstanding requests
+     * of the connection picked as <name>_channel_queue_depth. If `compression' is true,
+     * the requests ask for the compression of FLAGS_rpc_compression.
+     */
+    explicit ThriftClientManager(const std::string& name = "", bool compression = false);
 
 private:
+    struct ClientPool {
+        std::vector<Client>             point;
+        std::vector<Client>             scan;
+    };
+
     using ClientMap = std::unordered_map<
         std::pair<HostAddr, folly::EventBase*>,     // <ip, port> pair
-        std::shared_ptr<ClientType>                 // Async thrift client
+        ClientPool                                  // Async thrift clients
     >;
 
+    Client newClient(const HostAddr& host,
+                     folly::EventBase* evb,
+                     bool compatibility,
+                     uint32_t timeout);
+
     folly::ThreadLocal<ClientMap> clientMap_;
+    const bool compression_;
+    int32_t sentStatId_{-1};
+    int32_t receivedStatId_{-1};
+    int32_t queueDepthStatId_{-1};
 };
 
 }  // namespace thrift
@@ -9,15 +9,33 @@
 #include <thrift/lib/cpp/async/TAsyncSocket.h>
 #include <folly/system/ThreadName.h>
 #include "network/NetworkUtils.h"
+#include "stats/StatsManager.h"
 
 DECLARE_int32(conn_timeout_ms);
+DECLARE_int32(rpc_connections_per_host);
+DECLARE_int32(rpc_scan_connections_per_host);
 
 namespace nebula {
 namespace thrift {
 
 template<class ClientType>
-std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(
-        const HostAddr& host, folly::EventBase* evb, bool compatibility, uint32_t timeout) {
+ThriftClientManager<ClientType>::ThriftClientManager(const std::string& name, bool compression)
+        : compression_(compression) {
+    VLOG(3) << "ThriftClientManager";
+    if (!name.empty()) {
+        sentStatId_ = stats::StatsManager::registerStats(name + "_bytes_sent");
+        receivedStatId_ = stats::StatsManager::registerStats(name + "_bytes_received");
+        queueDepthStatId_ = stats::StatsManager::registerStats(name + "_channel_queue_depth");
+    }
+}
+
+template<class ClientType>
+typename ThriftClientManager<ClientType>::Client ThriftClientManager<ClientType>::pick(
+        const HostAddr& host,
+        folly::EventBase* evb,
+        bool compatibility,
+        uint32_t timeout,
+        bool scan) {
     VLOG(2) << "Getting a client to "
             << network::NetworkUtils::intToIPv4(host.first)
             << ":" << host.second;
@@ -26,27 +44,61 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(
         evb = folly::EventBaseManager::get()->getEventBase();
     }
 
-    auto it = clientMap_->find(std::make_pair(host, evb));
-    if (it != clientMap_->end()) {
-        return it->second;
+    auto& pool = (*clientMap_)[std::make_pair(host, evb)];
+    scan = scan && FLAGS_rpc_scan_connections_per_host > 0;
+    auto& clients = scan ? pool.scan : pool.point;
+    size_t maxSize = std::max(scan ? FLAGS_rpc_scan_connections_per_host
+                                   : FLAGS_rpc_connections_per_host, 1);
+
+    Client* picked = nullptr;
+    int64_t outstanding = 0;
+    for (auto& c : clients) {
+        auto count = c.outstanding->load(std::memory_order_relaxed);
+        if (picked == nullptr || count < outstanding) {
+            picked = &c;
+            outstanding = count;
+        }
+    }
+    if (picked == nullptr || (outstanding > 0 && clients.size() < maxSize)) {
+        clients.emplace_back(newClient(host, evb, compatibility, timeout));
+        picked = &clients.back();
+        outstanding = 0;
     }
 
-    // Need to create a new client
+    if (queueDepthStatId_ >= 0) {
+        stats::StatsManager::addValue(queueDepthStatId_, outstanding);
+    }
+    return *picked;
+}
+
+template<class ClientType>
+typename ThriftClientManager<ClientType>::Client ThriftClientManager<ClientType>::newClient(
+        const HostAddr& host, folly::EventBase* evb, bool compatibility, uint32_t timeout) {
     auto ipAddr = network::NetworkUtils::intToIPv4(host.first);
     auto port = host.second;
-    VLOG(2) << "There is no existing client to "
-            << ipAddr << ":" << port
-            << ", trying to create one";
+    VLOG(2) << "Creating a new client to " << ipAddr << ":" << port;
+    std::shared_ptr<WireStats> stats;
+    if (sentStatId_ >= 0) {
+        stats = std::make_shared<WireStats>(sentStatId_, receivedStatId_);
+    }
+    folly::Optional<uint16_t> transform;
+    if (compression_ && !compatibility) {
+        transform = compressionTransform();
+    }
     auto channel = apache::thrift::ReconnectingRequestChannel::newChannel(
-        *evb, [compatibility, ipAddr, port, timeout] (folly::EventBase& eb) mutable {
+        *evb, [compatibility, ipAddr, port, timeout, stats, transform] (folly::EventBase& eb)
+                mutable {
             static thread_local int connectionCount = 0;
             VLOG(2) << "Connecting to " << ipAddr << ":" << port
                     << " for " << ++connectionCount << " times";
             std::shared_ptr<apache::thrift::async::TAsyncSocket> socket;
             eb.runImmediatelyOrRunInEventBaseThreadAndWait(
-                [&socket, &eb, ipAddr, port]() {
+                [&socket, &eb, &stats, ipAddr, port]() {
                     socket = apache::thrift::async::TAsyncSocket::newSocket(
                         &eb, ipAddr, port, FLAGS_conn_timeout_ms);
+                    if (stats != nullptr) {
+                        stats->setSocket(socket);
+                    }
                 });
             auto headerClientChannel =  apache::thrift::HeaderClientChannel::newChannel(socket);
             if (timeout > 0) {
@@ -56,15 +108,26 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(
                 headerClientChannel->setProtocolId(apache::thrift::protocol::T_BINARY_PROTOCOL);
                 headerClientChannel->setClientType(THRIFT_UNFRAMED_DEPRECATED);
             }
+            if (transform.hasValue()) {
+                // The server replies with the same transform, if the response
+                // is larger than its rpc_compression_min_bytes.
+                headerClientChannel->setTransform(transform.value());
+            }
             return headerClientChannel;
         });
-    std::shared_ptr<ClientType> client(new ClientType(std::move(channel)), [evb](auto* p) {
-        evb->runImmediatelyOrRunInEventBaseThreadAndWait([p] {
+    if (stats != nullptr) {
+        WireStats::reportPeriodically(stats, evb);
+    }
+    std::shared_ptr<ClientType> client(new ClientType(std::move(channel)), [evb, stats](auto* p) {
+        evb->runImmediatelyOrRunInEventBaseThreadAndWait([p, &stats] {
+            if (stats != nullptr) {
+                // Report the bytes since the last period, before the socket is gone
+                stats->report();
+            }
             delete p;
         });
     });
-    clientMap_->emplace(std::make_pair(host, evb), client);
-    return client;
+    return Client{std::move(client), std::make_shared<std::atomic<int64_t>>(0)};
 }
 
 }  // namespace thrift
@@ -0,0 +1,266 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <thrift/lib/cpp2/server/ThriftServer.h>
+#include "thrift/ThriftClientManager.h"
+#include "thread/NamedThread.h"
+#include "stats/StatsManager.h"
+#include "gen-cpp2/StorageService.h"
+#include "gen-cpp2/StorageServiceAsyncClient.h"
+
+DECLARE_int32(rpc_connections_per_host);
+DECLARE_int32(rpc_scan_connections_per_host);
+DECLARE_string(rpc_compression);
+
+namespace nebula {
+namespace thrift {
+
+using ClientManager = ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>;
+
+// The clients only connect on the first request, so no server is needed
+static const HostAddr kHost = {0x7F000001, 1};
+
+TEST(ThriftClientManager, ReuseIdleConnection) {
+    gflags::FlagSaver saver;
+    FLAGS_rpc_connections_per_host = 4;
+    folly::ScopedEventBaseThread thread;
+    auto* evb = thread.getEventBase();
+    ClientManager manager;
+    evb->runInEventBaseThreadAndWait([&] {
+        auto first = manager.pick(kHost, evb);
+        // No request is outstanding, so the same connection is picked again
+        for (auto i = 0; i < 10; i++) {
+            auto conn = manager.pick(kHost, evb);
+            EXPECT_EQ(first.client, conn.client);
+            EXPECT_EQ(first.outstanding, conn.outstanding);
+        }
+        // Also for the requests sent and completed one after another
+        for (auto i = 0; i < 10; i++) {
+            auto conn = manager.pick(kHost, evb);
+            EXPECT_EQ(first.client, conn.client);
+            ++(*conn.outstanding);
+            --(*conn.outstanding);
+        }
+        // Holding the client doesn't make the connection busy
+        auto held = manager.client(kHost, evb);
+        EXPECT_EQ(first.client, held);
+        EXPECT_EQ(first.client, manager.pick(kHost, evb).client);
+        // Another host has its own connection
+        auto other = manager.pick({0x7F000001, 2}, evb);
+        EXPECT_NE(first.client, other.client);
+    });
+}
+
+TEST(ThriftClientManager, PoolSizeLimit) {
+    gflags::FlagSaver saver;
+    FLAGS_rpc_connections_per_host = 3;
+    folly::ScopedEventBaseThread thread;
+    auto* evb = thread.getEventBase();
+    ClientManager manager;
+    evb->runInEventBaseThreadAndWait([&] {
+        // A new connection is opened for each request while all the others are busy
+        std::vector<ClientManager::Client> conns;
+        for (auto i = 0; i < 3; i++) {
+            auto conn = manager.pick(kHost, evb);
+            for (auto& c : conns) {
+                EXPECT_NE(c.client, conn.client);
+            }
+            ++(*conn.outstanding);
+            conns.emplace_back(std::move(conn));
+        }
+        // No more than rpc_connections_per_host, the least busy one is picked
+        ++(*conns[0].outstanding);
+        ++(*conns[2].outstanding);
+        auto conn = manager.pick(kHost, evb);
+        EXPECT_EQ(conns[1].client, conn.client);
+        ++(*conn.outstanding);
+        ++(*conn.outstanding);
+        EXPECT_EQ(conns[0].client, manager.pick(kHost, evb).client);
+        // The connection becomes idle once its requests are completed
+        *conns[2].outstanding = 0;
+        EXPECT_EQ(conns[2].client, manager.pick(kHost, evb).client);
+    });
+}
+
+TEST(ThriftClientManager, SingleConnection) {
+    gflags::FlagSaver saver;
+    FLAGS_rpc_connections_per_host = 1;
+    folly::ScopedEventBaseThread thread;
+    auto* evb = thread.getEventBase();
+    ClientManager manager;
+    evb->runInEventBaseThreadAndWait([&] {
+        auto first = manager.pick(kHost, evb);
+        ++(*first.outstanding);
+        auto conn = manager.pick(kHost, evb);
+        EXPECT_EQ(first.client, conn.client);
+        ++(*conn.outstanding);
+        EXPECT_EQ(2, first.outstanding->load());
+    });
+}
+
+TEST(ThriftClientManager, ScanPool) {
+    gflags::FlagSaver saver;
+    FLAGS_rpc_connections_per_host = 1;
+    {
+        // The scan requests share the connections by default
+        FLAGS_rpc_scan_connections_per_host = 0;
+        folly::ScopedEventBaseThread thread;
+        auto* evb = thread.getEventBase();
+        ClientManager manager;
+        evb->runInEventBaseThreadAndWait([&] {
+            auto point = manager.pick(kHost, evb);
+            ++(*point.outstanding);
+            auto scan = manager.pick(kHost, evb, false, 0, true);
+            EXPECT_EQ(point.client, scan.client);
+        });
+    }
+    {
+        FLAGS_rpc_scan_connections_per_host = 2;
+        folly::ScopedEventBaseThread thread;
+        auto* evb = thread.getEventBase();
+        ClientManager manager;
+        evb->runInEventBaseThreadAndWait([&] {
+            auto point = manager.pick(kHost, evb);
+            auto scan1 = manager.pick(kHost, evb, false, 0, true);
+            EXPECT_NE(point.client, scan1.client);
+            ++(*scan1.outstanding);
+            auto scan2 = manager.pick(kHost, evb, false, 0, true);
+            EXPECT_NE(point.client, scan2.client);
+            EXPECT_NE(scan1.client, scan2.client);
+            ++(*scan2.outstanding);
+            // The scan pool is full, and the point requests don't go through it
+            auto scan3 = manager.pick(kHost, evb, false, 0, true);
+            EXPECT_TRUE(scan3.client == scan1.client || scan3.client == scan2.client);
+            EXPECT_EQ(point.client, manager.pick(kHost, evb).client);
+        });
+    }
+}
+
+// Reply with a compressible blob, of the size given by the space id of the request
+class TestStorageService : public storage::cpp2::StorageServiceSvIf {
+public:
+    folly::Future<storage::cpp2::QueryResponse>
+    future_getBound(const storage::cpp2::GetNeighborsRequest& req) override {
+        storage::cpp2::TagData tag;
+        tag.set_tag_id(1);
+        tag.set_data(std::string(req.get_space_id(), 'a'));
+        storage::cpp2::VertexData vertex;
+        vertex.set_vertex_id(1);
+        vertex.tag_data.emplace_back(std::move(tag));
+        storage::cpp2::QueryResponse resp;
+        resp.set_result(storage::cpp2::ResponseCommon());
+        resp.set_vertices({std::move(vertex)});
+        return folly::makeFuture(std::move(resp));
+    }
+};
+
+class TestServer final {
+public:
+    explicit TestServer(uint32_t minCompressBytes) {
+        server_ = std::make_unique<apache::thrift::ThriftServer>();
+        server_->setInterface(std::make_shared<TestStorageService>());
+        server_->setPort(0);
+        server_->setMinCompressBytes(minCompressBytes);
+        thread_ = std::make_unique<thread::NamedThread>("test-server", [this] {
+            server_->serve();
+        });
+        while (!server_->getServeEventBase() ||
+               !server_->getServeEventBase()->isRunning()) {
+            usleep(10000);
+        }
+    }
+
+    ~TestServer() {
+        server_->stop();
+        thread_->join();
+    }
+
+    HostAddr host() const {
+        return {0x7F000001, server_->getAddress().getPort()};
+    }
+
+private:
+    std::unique_ptr<apache::thrift::ThriftServer>   server_;
+    std::unique_ptr<thread::NamedThread>            thread_;
+};
+
+int64_t fetch(ClientManager& manager, folly::EventBase* evb, const HostAddr& host, int32_t size) {
+    auto client = manager.client(host, evb);
+    storage::cpp2::GetNeighborsRequest req;
+    req.set_space_id(size);
+    auto resp = folly::via(evb, [&] {
+        return client->future_getBound(req);
+    }).get();
+    return resp.get_vertices()->front().tag_data.front().get_data().size();
+}
+
+int64_t bytesReceived(const std::string& name) {
+    return stats::StatsManager::readValue(name + "_bytes_received.sum.60").value();
+}
+
+TEST(ThriftClientManager, CompressionNegotiation) {
+    gflags::FlagSaver saver;
+    TestServer server(1024);
+    folly::ScopedEventBaseThread thread;
+    auto* evb = thread.getEventBase();
+    // Returns the bytes received on the wire, reported on tearing down the connection
+    auto receive = [&] (const std::string& name, bool compression, int32_t size) {
+        {
+            ClientManager manager(name, compression);
+            EXPECT_EQ(size, fetch(manager, evb, server.host(), size));
+        }
+        return bytesReceived(name);
+    };
+
+    FLAGS_rpc_compression = "none";
+    auto plain = receive("plain", true, 100000);
+    EXPECT_LT(100000, plain);
+    FLAGS_rpc_compression = "zstd";
+    auto zstd = receive("zstd", true, 100000);
+    EXPECT_LT(0, zstd);
+    EXPECT_LT(zstd * 10, plain);
+    FLAGS_rpc_compression = "zlib";
+    auto zlib = receive("zlib", true, 100000);
+    EXPECT_LT(0, zlib);
+    EXPECT_LT(zlib * 10, plain);
+    // Only the managers enabling it ask for the compression
+    EXPECT_LT(100000, receive("disabled", false, 100000));
+    // The server doesn't compress the small responses
+    EXPECT_LT(512, receive("small", true, 512));
+}
+
+TEST(ThriftClientManager, WireStatsReportedPeriodically) {
+    TestServer server(1024);
+    folly::ScopedEventBaseThread thread;
+    auto* evb = thread.getEventBase();
+    ClientManager manager("periodic");
+    EXPECT_EQ(4096, fetch(manager, evb, server.host(), 4096));
+    // Reported while the connection is still open and idle
+    for (auto i = 0; i < 30 && bytesReceived("periodic") == 0; i++) {
+        usleep(100000);
+    }
+    EXPECT_LT(4096, bytesReceived("periodic"));
+    EXPECT_LT(0, stats::StatsManager::readValue("periodic_bytes_sent.sum.60").value());
+    // No more bytes are reported without any request
+    auto received = bytesReceived("periodic");
+    usleep(1500000);
+    EXPECT_EQ(received, bytesReceived("periodic"));
+}
+
+}  // namespace thrift
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -8,6 +8,9 @@
 #include "console/CmdProcessor.h"
 #include "time/Duration.h"
 
+DEFINE_int32(fetch_size, 1000,
+             "Number of rows fetched from the server each time, 0 for fetching all at once");
+
 namespace nebula {
 namespace graph {
 
@@ -401,7 +404,18 @@ bool CmdProcessor::processClientCmd(folly::StringPiece cmd,
 void CmdProcessor::processServerCmd(folly::StringPiece cmd) {
     time::Duration dur;
     cpp2::ExecutionResponse resp;
-    cpp2::ErrorCode res = client_->execute(cmd, resp);
+    // Print each chunk once it's fetched
+    size_t total = 0;
+    auto onChunk = [this, &total] (const cpp2::ExecutionResponse& chunk) {
+        if (chunk.get_rows() != nullptr && !chunk.get_rows()->empty()) {
+            printResult(chunk);
+            total += chunk.get_rows()->size();
+        }
+        return true;
+    };
+    cpp2::ErrorCode res = FLAGS_fetch_size > 0
+                        ? client_->executeInChunks(cmd, FLAGS_fetch_size, onChunk, resp)
+                        : client_->execute(cmd, resp);
     if (res == cpp2::ErrorCode::SUCCEEDED) {
         // Succeeded
         auto *spaceName = resp.get_space_name();
@@ -410,10 +424,11 @@ void CmdProcessor::processServerCmd(folly::StringPiece cmd) {
         } else {
             curSpaceName_ = "(none)";
         }
-        if (resp.get_rows() && !resp.get_rows()->empty()) {
-            printResult(resp);
-            std::cout << "Got " << resp.get_rows()->size()
-                      << " rows (Time spent: ";
+        if (FLAGS_fetch_size <= 0) {
+            onChunk(resp);
+        }
+        if (total > 0) {
+            std::cout << "Got " << total << " rows (Time spent: ";
         } else if (resp.get_rows()) {
             std::cout << "Empty set (Time spent: ";
         } else {
@@ -0,0 +1,439 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/AggregateHashTable.h"
+#include "graph/AggregateFunction.h"
+#include <folly/hash/SpookyHashV2.h>
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+constexpr size_t kMinSlots = 16;
+
+bool isNumeric(const cpp2::ColumnValue &value) {
+    return value.getType() == ColumnType::int_type
+        || value.getType() == ColumnType::double_type
+        || value.getType() == ColumnType::id_type
+        || value.getType() == ColumnType::timestamp_type;
+}
+
+double toDouble(const cpp2::ColumnValue &value) {
+    switch (value.getType()) {
+        case ColumnType::int_type:
+            return static_cast<double>(value.get_integer());
+        case ColumnType::id_type:
+            return static_cast<double>(value.get_id());
+        case ColumnType::timestamp_type:
+            return static_cast<double>(value.get_timestamp());
+        case ColumnType::double_type:
+            return value.get_double_precision();
+        default:
+            break;
+    }
+    return 0.0;
+}
+
+// The sum of the values with the same type as the first one
+void applySum(AggState &state, const cpp2::ColumnValue &value) {
+    if (!isNumeric(value)) {
+        return;
+    }
+    if (!state.has) {
+        state.value = value;
+        state.has = true;
+        return;
+    }
+    if (state.value.getType() != value.getType()) {
+        return;
+    }
+    switch (state.value.getType()) {
+        case ColumnType::int_type:
+            state.value.set_integer(state.value.get_integer() + value.get_integer());
+            break;
+        case ColumnType::id_type:
+            state.value.set_id(state.value.get_id() + value.get_id());
+            break;
+        case ColumnType::double_type:
+            state.value.set_double_precision(state.value.get_double_precision()
+                                             + value.get_double_precision());
+            break;
+        case ColumnType::timestamp_type:
+            state.value.set_timestamp(state.value.get_timestamp() + value.get_timestamp());
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename Op>
+void applyBits(AggState &state, const cpp2::ColumnValue &value, Op op) {
+    if (value.getType() != ColumnType::int_type) {
+        return;
+    }
+    if (!state.has) {
+        state.value = value;
+        state.has = true;
+        return;
+    }
+    state.value.set_integer(op(state.value.get_integer(), value.get_integer()));
+}
+
+// Welford's online algorithm
+void applyStd(AggState &state, double value) {
+    state.n++;
+    auto delta = value - state.mean;
+    state.mean += delta / state.n;
+    state.m2 += delta * (value - state.mean);
+}
+
+}   // namespace
+
+
+AggregateHashTable::AggregateHashTable(std::vector<AggKind> kinds)
+    : kinds_(std::move(kinds)) {
+    slots_.resize(kMinSlots);
+}
+
+
+// static
+StatusOr<AggKind> AggregateHashTable::toAggKind(const std::string &funName) {
+    static const std::unordered_map<std::string, AggKind> kinds = {
+        {"", AggKind::GROUP},
+        {kCount, AggKind::COUNT},
+        {kCountDist, AggKind::COUNT_DISTINCT},
+        {kSum, AggKind::SUM},
+        {kAvg, AggKind::AVG},
+        {kMax, AggKind::MAX},
+        {kMin, AggKind::MIN},
+        {kStd, AggKind::STD},
+        {kBitAnd, AggKind::BIT_AND},
+        {kBitOr, AggKind::BIT_OR},
+        {kBitXor, AggKind::BIT_XOR},
+    };
+    auto it = kinds.find(funName);
+    if (it == kinds.end()) {
+        return Status::SyntaxError("Unknown aggregate function `%s'", funName.c_str());
+    }
+    return it->second;
+}
+
+
+// static
+void AggregateHashTable::encodeValue(const cpp2::ColumnValue &value, std::string &key) {
+    auto type = static_cast<char>(value.getType());
+    key.append(&type, 1);
+    switch (value.getType()) {
+        case ColumnType::bool_type: {
+            key.append(1, value.get_bool_val() ? '\1' : '\0');
+            break;
+        }
+        case ColumnType::int_type: {
+            auto v = value.get_integer();
+            key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+            break;
+        }
+        case ColumnType::id_type: {
+            auto v = value.get_id();
+            key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+            break;
+        }
+        case ColumnType::timestamp_type: {
+            auto v = value.get_timestamp();
+            key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+            break;
+        }
+        case ColumnType::float_type: {
+            // +0.0 and -0.0 are equal
+            double v = value.get_single_precision() + 0.0;
+            key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+            break;
+        }
+        case ColumnType::double_type: {
+            double v = value.get_double_precision() + 0.0;
+            key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+            break;
+        }
+        case ColumnType::str_type: {
+            auto &v = value.get_str();
+            uint32_t len = v.size();
+            key.append(reinterpret_cast<const char*>(&len), sizeof(len));
+            key.append(v);
+            break;
+        }
+        case ColumnType::empty_type: {
+            break;
+        }
+        default: {
+            LOG(FATAL) << "Untreated value type: " << static_cast<int32_t>(value.getType());
+        }
+    }
+}
+
+
+folly::StringPiece AggregateHashTable::keyOf(uint32_t group) const {
+    auto begin = keyOffsets_[group];
+    auto end = group + 1 < keyOffsets_.size() ? keyOffsets_[group + 1] : keys_.size();
+    return folly::StringPiece(keys_.data() + begin, end - begin);
+}
+
+
+uint32_t AggregateHashTable::findOrInsertGroup(folly::StringPiece key) {
+    if ((keyOffsets_.size() + 1) * 2 > slots_.size()) {
+        grow();
+    }
+    auto hash = folly::hash::SpookyHashV2::Hash64(key.data(), key.size(), 0);
+    auto mask = slots_.size() - 1;
+    for (auto i = hash & mask; ; i = (i + 1) & mask) {
+        auto &slot = slots_[i];
+        if (slot.group == kEmpty) {
+            slot.hash = hash;
+            slot.group = keyOffsets_.size();
+            keyOffsets_.emplace_back(keys_.size());
+            keys_.append(key.data(), key.size());
+            states_.resize(states_.size() + kinds_.size());
+            return slot.group;
+        }
+        if (slot.hash == hash && keyOf(slot.group) == key) {
+            return slot.group;
+        }
+    }
+}
+
+
+void AggregateHashTable::grow() {
+    std::vector<Slot> slots(slots_.size() * 2);
+    auto mask = slots.size() - 1;
+    for (auto &slot : slots_) {
+        if (slot.group == kEmpty) {
+            continue;
+        }
+        auto i = slot.hash & mask;
+        while (slots[i].group != kEmpty) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+    slots_.swap(slots);
+}
+
+
+AggState* AggregateHashTable::findOrInsert(folly::StringPiece key) {
+    auto group = findOrInsertGroup(key);
+    return &states_[group * kinds_.size()];
+}
+
+
+void AggregateHashTable::apply(AggState *states, size_t i, const cpp2::ColumnValue &value) const {
+    auto &state = states[i];
+    switch (kinds_[i]) {
+        case AggKind::GROUP:
+            state.value = value;
+            state.has = true;
+            break;
+        case AggKind::COUNT:
+            state.count++;
+            break;
+        case AggKind::COUNT_DISTINCT: {
+            if (state.distinct == nullptr) {
+                state.distinct = std::make_unique<FingerprintSet>();
+            }
+            std::string encoded;
+            encodeValue(value, encoded);
+            state.distinct->insert(encoded);
+            break;
+        }
+        case AggKind::SUM:
+            applySum(state, value);
+            break;
+        case AggKind::AVG:
+            applySum(state, value);
+            state.count++;
+            break;
+        case AggKind::MAX:
+            if (!state.has || state.value < value) {
+                state.value = value;
+                state.has = true;
+            }
+            break;
+        case AggKind::MIN:
+            if (!state.has || value < state.value) {
+                state.value = value;
+                state.has = true;
+            }
+            break;
+        case AggKind::STD:
+            if (value.getType() == ColumnType::int_type
+                    || value.getType() == ColumnType::double_type) {
+                applyStd(state, toDouble(value));
+            }
+            break;
+        case AggKind::BIT_AND:
+            applyBits(state, value, [] (int64_t l, int64_t r) { return l & r; });
+            break;
+        case AggKind::BIT_OR:
+            applyBits(state, value, [] (int64_t l, int64_t r) { return l | r; });
+            break;
+        case AggKind::BIT_XOR:
+            applyBits(state, value, [] (int64_t l, int64_t r) { return l ^ r; });
+            break;
+    }
+}
+
+
+// static
+void AggregateHashTable::mergeState(AggKind kind, AggState &state, AggState &&other) {
+    switch (kind) {
+        case AggKind::GROUP:
+            if (!state.has) {
+                state.value = std::move(other.value);
+                state.has = other.has;
+            }
+            break;
+        case AggKind::COUNT:
+            state.count += other.count;
+            break;
+        case AggKind::COUNT_DISTINCT:
+            if (state.distinct == nullptr) {
+                state.distinct = std::move(other.distinct);
+            } else if (other.distinct != nullptr) {
+                state.distinct->merge(*other.distinct);
+            }
+            break;
+        case AggKind::SUM:
+        case AggKind::AVG:
+            if (other.has) {
+                applySum(state, other.value);
+            }
+            state.count += other.count;
+            break;
+        case AggKind::MAX:
+            if (other.has && (!state.has || state.value < other.value)) {
+                state.value = std::move(other.value);
+                state.has = true;
+            }
+            break;
+        case AggKind::MIN:
+            if (other.has && (!state.has || other.value < state.value)) {
+                state.value = std::move(other.value);
+                state.has = true;
+            }
+            break;
+        case AggKind::STD: {
+            if (other.n == 0) {
+                break;
+            }
+            if (state.n == 0) {
+                state.n = other.n;
+                state.mean = other.mean;
+                state.m2 = other.m2;
+                break;
+            }
+            // Chan's parallel algorithm
+            auto n = state.n + other.n;
+            auto delta = other.mean - state.mean;
+            state.m2 += other.m2 + delta * delta * state.n * other.n / n;
+            state.mean += delta * other.n / n;
+            state.n = n;
+            break;
+        }
+        case AggKind::BIT_AND:
+            if (other.has) {
+                applyBits(state, other.value, [] (int64_t l, int64_t r) { return l & r; });
+            }
+            break;
+        case AggKind::BIT_OR:
+            if (other.has) {
+                applyBits(state, other.value, [] (int64_t l, int64_t r) { return l | r; });
+            }
+            break;
+        case AggKind::BIT_XOR:
+            if (other.has) {
+                applyBits(state, other.value, [] (int64_t l, int64_t r) { return l ^ r; });
+            }
+            break;
+    }
+}
+
+
+void AggregateHashTable::merge(AggregateHashTable &&other) {
+    DCHECK(kinds_ == other.kinds_);
+    auto num = kinds_.size();
+    for (uint32_t group = 0; group < other.size(); group++) {
+        auto *states = findOrInsert(other.keyOf(group));
+        for (size_t i = 0; i < num; i++) {
+            mergeState(kinds_[i], states[i], std::move(other.states_[group * num + i]));
+        }
+    }
+    other.slots_.clear();
+    other.keys_.clear();
+    other.keyOffsets_.clear();
+    other.states_.clear();
+}
+
+
+// static
+cpp2::ColumnValue AggregateHashTable::getResult(AggKind kind, const AggState &state) {
+    cpp2::ColumnValue result;
+    switch (kind) {
+        case AggKind::GROUP:
+        case AggKind::MAX:
+        case AggKind::MIN:
+            result = state.value;
+            break;
+        case AggKind::COUNT:
+            result.set_integer(state.count);
+            break;
+        case AggKind::COUNT_DISTINCT:
+            result.set_integer(state.distinct == nullptr ? 0 : state.distinct->size());
+            break;
+        case AggKind::SUM:
+        case AggKind::BIT_AND:
+        case AggKind::BIT_OR:
+        case AggKind::BIT_XOR:
+            if (state.has) {
+                result = state.value;
+            } else {
+                result.set_integer(0);
+            }
+            break;
+        case AggKind::AVG:
+            result.set_double_precision(state.count == 0
+                                            ? 0.0
+                                            : toDouble(state.value) / state.count);
+            break;
+        case AggKind::STD:
+            if (state.n == 0) {
+                result.set_integer(0);
+            } else {
+                result.set_double_precision(std::sqrt(state.m2 / state.n));
+            }
+            break;
+    }
+    return result;
+}
+
+
+std::vector<cpp2::RowValue> AggregateHashTable::getRows() const {
+    std::vector<cpp2::RowValue> rows;
+    rows.reserve(size());
+    auto num = kinds_.size();
+    for (size_t group = 0; group < size(); group++) {
+        std::vector<cpp2::ColumnValue> columns;
+        columns.reserve(num);
+        for (size_t i = 0; i < num; i++) {
+            columns.emplace_back(getResult(kinds_[i], states_[group * num + i]));
+        }
+        rows.emplace_back();
+        rows.back().set_columns(std::move(columns));
+    }
+    return rows;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,125 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_AGGREGATEHASHTABLE_H_
+#define GRAPH_AGGREGATEHASHTABLE_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "base/FingerprintSet.h"
+#include "gen-cpp2/graph_types.h"
+
+namespace nebula {
+namespace graph {
+
+enum class AggKind : uint8_t {
+    // The group column without any aggregate function
+    GROUP,
+    COUNT,
+    COUNT_DISTINCT,
+    SUM,
+    AVG,
+    MAX,
+    MIN,
+    STD,
+    BIT_AND,
+    BIT_OR,
+    BIT_XOR,
+};
+
+/**
+ * The state of one aggregate function in one group. It's shared by all the functions,
+ * so that the states of a group could be stored inline in the AggregateHashTable.
+ */
+struct AggState {
+    bool                                has{false};
+    // Number of the applied values for COUNT and AVG
+    uint64_t                            count{0};
+    // The value of GROUP, SUM, MAX, MIN and the bit operations
+    cpp2::ColumnValue                   value;
+    // Number, mean and sum of squares of differences of the numeric values for STD
+    uint64_t                            n{0};
+    double                              mean{0.0};
+    double                              m2{0.0};
+    std::unique_ptr<FingerprintSet>     distinct;
+};
+
+/**
+ * A hash table from the group keys to the aggregate states, for GROUP BY.
+ *
+ * The keys are the column values normalized to binary by encodeValue, and kept in
+ * an arena. The states of each group are stored continuously in a flat array,
+ * which is indexed by an open-addressing table.
+ *
+ * The tables built on different parts of the input could be merged into one.
+ * It's not thread safe.
+ */
+class AggregateHashTable final {
+public:
+    explicit AggregateHashTable(std::vector<AggKind> kinds);
+
+    static StatusOr<AggKind> toAggKind(const std::string &funName);
+
+    /**
+     * Append the binary form of the value to the key, the values of different types
+     * are always different.
+     */
+    static void encodeValue(const cpp2::ColumnValue &value, std::string &key);
+
+    /**
+     * Return the states of the group, which is created if not found.
+     * The returned pointer is invalidated by the next insertion.
+     */
+    AggState* findOrInsert(folly::StringPiece key);
+
+    /**
+     * Apply the value of the i-th column on the states of a group.
+     */
+    void apply(AggState *states, size_t i, const cpp2::ColumnValue &value) const;
+
+    void merge(AggregateHashTable &&other);
+
+    size_t size() const {
+        return keyOffsets_.size();
+    }
+
+    /**
+     * Generate the result rows, one for each group.
+     */
+    std::vector<cpp2::RowValue> getRows() const;
+
+private:
+    static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        uint64_t        hash{0};
+        uint32_t        group{kEmpty};
+    };
+
+    uint32_t findOrInsertGroup(folly::StringPiece key);
+
+    folly::StringPiece keyOf(uint32_t group) const;
+
+    void grow();
+
+    static void mergeState(AggKind kind, AggState &state, AggState &&other);
+
+    static cpp2::ColumnValue getResult(AggKind kind, const AggState &state);
+
+private:
+    std::vector<AggKind>                kinds_;
+    std::vector<Slot>                   slots_;
+    // Keys of all groups, the key of the i-th group starts at keyOffsets_[i]
+    std::string                         keys_;
+    std::vector<size_t>                 keyOffsets_;
+    // kinds_.size() states for each group
+    std::vector<AggState>               states_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_AGGREGATEHASHTABLE_H_
@@ -23,6 +23,7 @@ AssignmentExecutor::AssignmentExecutor(Sentence *sentence,
 Status AssignmentExecutor::prepare() {
     var_ = sentence_->var();
     executor_ = TraverseExecutor::makeTraverseExecutor(sentence_->sentence(), ectx());
+    executor_->setupProfile(this, sentence_->sentence());
 
     auto onError = [this] (Status s) {
         doError(std::move(s));
@@ -54,7 +55,7 @@ void AssignmentExecutor::execute() {
         doError(std::move(status));
         return;
     }
-    executor_->execute();
+    executor_->run();
 }
 
 
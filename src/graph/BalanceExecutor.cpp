@@ -5,6 +5,7 @@
  */
 
 #include "graph/BalanceExecutor.h"
+#include "time/WallClock.h"
 
 namespace nebula {
 namespace graph {
@@ -119,7 +120,9 @@ void BalanceExecutor::showBalancePlan() {
         }
         auto tasks = std::move(resp).value();
         resp_ = std::make_unique<cpp2::ExecutionResponse>();
-        std::vector<std::string> header{"balanceId, spaceId:partId, src->dst", "status"};
+        std::vector<std::string> header{"balanceId, spaceId:partId, src->dst",
+                                        "status",
+                                        "progress"};
         resp_->set_column_names(std::move(header));
 
         std::vector<cpp2::RowValue> rows;
@@ -128,9 +131,30 @@ void BalanceExecutor::showBalancePlan() {
         int32_t failed = 0;
         int32_t inProgress = 0;
         int32_t invalid = 0;
+        // To estimate the remaining time by the rate of the finished tasks
+        int32_t done = 0;
+        int64_t firstStart = 0;
+        auto now = time::WallClock::fastNowInMilliSec();
         for (auto& task : tasks) {
             std::vector<cpp2::ColumnValue> row;
-            row.resize(2);
+            row.resize(3);
+            auto start = task.get_start_time();
+            auto end = task.get_end_time();
+            if (start > 0 && (firstStart == 0 || start < firstStart)) {
+                firstStart = start;
+            }
+            if (start == 0) {
+                row[2].set_str("waiting");
+            } else if (end > 0) {
+                done++;
+                row[2].set_str(folly::stringPrintf("%s, took %lds",
+                                                   task.get_step().c_str(),
+                                                   (end - start) / 1000));
+            } else {
+                row[2].set_str(folly::stringPrintf("%s, elapsed %lds",
+                                                   task.get_step().c_str(),
+                                                   (now - start) / 1000));
+            }
             row[0].set_str(std::move(task.get_id()));
             switch (task.get_result()) {
                 case meta::cpp2::TaskResult::SUCCEEDED:
@@ -155,12 +179,20 @@ void BalanceExecutor::showBalancePlan() {
         }
         int32_t total = static_cast<int32_t>(rows.size());
         std::vector<cpp2::ColumnValue> row;
-        row.resize(2);
+        row.resize(3);
         row[0].set_str(
             folly::stringPrintf("Total:%d, Succeeded:%d, Failed:%d, In Progress:%d, Invalid:%d",
                                 total, succeeded, failed, inProgress, invalid));
         row[1].set_str(folly::stringPrintf("%f%%",
                        total == 0 ? 100 : (100 - static_cast<float>(inProgress) / total * 100)));
+        if (inProgress == 0) {
+            row[2].set_str("ETA:0s");
+        } else if (done == 0 || firstStart == 0) {
+            row[2].set_str("ETA:unknown");
+        } else {
+            auto eta = (now - firstStart) * inProgress / done / 1000;
+            row[2].set_str(folly::stringPrintf("ETA:%lds", eta));
+        }
         rows.emplace_back();
         rows.back().set_columns(std::move(row));
         resp_->set_rows(std::move(rows));
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/ClientSession.h"
+#include "graph/GraphFlags.h"
 
 
 namespace nebula {
@@ -13,6 +14,16 @@ namespace graph {
 
 ClientSession::ClientSession(int64_t id) {
     id_ = id;
+    if (FLAGS_session_sentence_cache_capacity > 0) {
+        sentences_ = std::make_unique<LRU<std::string, std::shared_ptr<SequentialSentences>>>(
+                FLAGS_session_sentence_cache_capacity);
+    }
+}
+
+ClientSession::~ClientSession() {
+    for (auto &cursor : cursors_) {
+        cursor.second.stream->close();
+    }
 }
 
 std::shared_ptr<ClientSession> ClientSession::create(int64_t id) {
@@ -29,5 +40,197 @@ uint64_t ClientSession::idleSeconds() const {
     return idleDuration_.elapsedInSec();
 }
 
+
+std::shared_ptr<SequentialSentences> ClientSession::takeSentences(const std::string &key) {
+    std::lock_guard<std::mutex> g(lock_);
+    if (sentences_ == nullptr) {
+        return nullptr;
+    }
+    auto result = sentences_->get(key);
+    if (!result) {
+        return nullptr;
+    }
+    sentences_->evict(key);
+    return std::move(*result);
+}
+
+
+void ClientSession::putSentences(std::string key,
+                                 std::shared_ptr<SequentialSentences> sentences) {
+    std::lock_guard<std::mutex> g(lock_);
+    if (sentences_ == nullptr || sentences == nullptr) {
+        return;
+    }
+    // If the same query was executed concurrently, just keep one of the trees
+    sentences_->insert(std::move(key), std::move(sentences));
+}
+
+
+StatusOr<int64_t> ClientSession::addPreparedStatement(std::string key) {
+    std::lock_guard<std::mutex> g(lock_);
+    for (auto it = preparedLru_.begin(); it != preparedLru_.end(); ++it) {
+        if (it->second == key) {
+            preparedLru_.splice(preparedLru_.begin(), preparedLru_, it);
+            return it->first;
+        }
+    }
+    if (FLAGS_max_prepared_statements_per_session <= 0) {
+        return Status::Error("Prepared statements are disabled");
+    }
+    while (preparedLru_.size() >= static_cast<size_t>(FLAGS_max_prepared_statements_per_session)) {
+        VLOG(1) << "Too many prepared statements in session " << id_
+                << ", deallocate statement " << preparedLru_.back().first;
+        prepared_.erase(preparedLru_.back().first);
+        preparedLru_.pop_back();
+    }
+    auto id = nextStatementId_++;
+    preparedLru_.emplace_front(id, std::move(key));
+    prepared_.emplace(id, preparedLru_.begin());
+    return id;
+}
+
+
+StatusOr<std::string> ClientSession::findPreparedStatement(int64_t id) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = prepared_.find(id);
+    if (it == prepared_.end()) {
+        return Status::Error("Prepared statement not found, id[%ld]", id);
+    }
+    preparedLru_.splice(preparedLru_.begin(), preparedLru_, it->second);
+    return it->second->second;
+}
+
+
+StatusOr<int64_t> ClientSession::addCursor(std::shared_ptr<ResultStream> stream) {
+    // The rows of the streams are accounted when they are written
+    auto maxBytes = static_cast<int64_t>(FLAGS_max_cursor_memory_mb) * 1024 * 1024;
+    auto numRows = stream->rows();
+    std::lock_guard<std::mutex> g(lock_);
+    auto exceeded = [&] () {
+        return cursors_.size() >= static_cast<size_t>(FLAGS_max_cursors_per_session)
+            || cursorRows() + numRows > FLAGS_max_cursor_rows_per_session
+            || ResultStream::totalBytes() > maxBytes;
+    };
+    while (!cursors_.empty() && exceeded()) {
+        LOG(WARNING) << "Too many cursors in session " << id_
+                     << ", close cursor " << cursors_.begin()->first;
+        eraseCursor(cursors_.begin());
+    }
+    if (numRows > FLAGS_max_cursor_rows_per_session || ResultStream::totalBytes() > maxBytes) {
+        return Status::Error("Too many rows to keep in the cursor, %ld rows of %ld bytes",
+                             numRows, ResultStream::totalBytes());
+    }
+    auto id = nextCursorId_++;
+    cursors_[id].stream = std::move(stream);
+    return id;
+}
+
+
+folly::Future<StatusOr<ResultStream::Chunk>> ClientSession::fetchCursor(int64_t id) {
+    std::shared_ptr<ResultStream> stream;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        auto it = cursors_.find(id);
+        if (it == cursors_.end()) {
+            return folly::makeFuture<StatusOr<ResultStream::Chunk>>(
+                    Status::Error("Cursor not found, id[%ld]", id));
+        }
+        auto &cursor = it->second;
+        if (cursor.idleDuration.elapsedInSec() >= FLAGS_cursor_idle_timeout_secs) {
+            eraseCursor(it);
+            return folly::makeFuture<StatusOr<ResultStream::Chunk>>(
+                    Status::Error("Cursor has expired, id[%ld]", id));
+        }
+        cursor.idleDuration.reset();
+        stream = cursor.stream;
+    }
+    // The rows may be still in production, so it's read out of the lock
+    return stream->read();
+}
+
+
+void ClientSession::closeCursor(int64_t id) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = cursors_.find(id);
+    if (it != cursors_.end()) {
+        eraseCursor(it);
+    }
+}
+
+
+void ClientSession::reclaimCursors() {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = cursors_.begin();
+    while (it != cursors_.end()) {
+        if (it->second.idleDuration.elapsedInSec() < FLAGS_cursor_idle_timeout_secs) {
+            ++it;
+            continue;
+        }
+        VLOG(1) << "Cursor " << it->first << " of session " << id_ << " has expired";
+        it = eraseCursor(it);
+    }
+}
+
+
+std::map<int64_t, ClientSession::Cursor>::iterator
+ClientSession::eraseCursor(std::map<int64_t, Cursor>::iterator it) {
+    // The query still producing the rows fails on its next wait for the room
+    it->second.stream->close();
+    return cursors_.erase(it);
+}
+
+
+int64_t ClientSession::cursorRows() const {
+    int64_t rows = 0;
+    for (auto &cursor : cursors_) {
+        rows += cursor.second.stream->rows();
+    }
+    return rows;
+}
+
+
+std::string ClientSession::normalize(folly::StringPiece query) {
+    std::string normalized;
+    normalized.reserve(query.size());
+    char quote = '\0';
+    bool escaped = false;
+    // The pending separator, '\n' is kept to not break the line comments
+    char separator = '\0';
+    for (auto c : query) {
+        if (quote != '\0') {
+            normalized.push_back(c);
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == quote) {
+                quote = '\0';
+            }
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!normalized.empty() && separator != '\n') {
+                separator = (c == '\n' ? '\n' : ' ');
+            }
+            continue;
+        }
+        if (separator != '\0') {
+            normalized.push_back(separator);
+            separator = '\0';
+        }
+        if (c == '"' || c == '\'') {
+            quote = c;
+        }
+        normalized.push_back(c);
+    }
+    if (quote == '\0') {
+        while (!normalized.empty()
+                && (normalized.back() == ';' || std::isspace(normalized.back()))) {
+            normalized.pop_back();
+        }
+    }
+    return normalized;
+}
+
 }   // namespace graph
 }   // namespace nebula
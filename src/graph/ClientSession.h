@@ -8,7 +8,12 @@
 #define GRAPH_CLIENTSESSION_H_
 
 #include "base/Base.h"
+#include "base/StatusOr.h"
+#include "base/ConcurrentLRUCache.h"
 #include "time/Duration.h"
+#include "parser/SequentialSentences.h"
+#include "gen-cpp2/graph_types.h"
+#include "graph/ResultStream.h"
 
 /**
  * A ClientSession holds the context informations of a session opened by a client.
@@ -19,6 +24,8 @@ namespace graph {
 
 class ClientSession final {
 public:
+    ~ClientSession();
+
     int64_t id() const {
         return id_;
     }
@@ -52,6 +59,54 @@ public:
 
     void charge();
 
+    /**
+     * The parsed sentences are cached per session, keyed by the normalized query.
+     * Since the expressions in a parsing tree are bound to the context of one execution,
+     * a cached tree is taken out of the cache during the execution, and put back
+     * once the execution is done.
+     * Return nullptr if not cached.
+     */
+    std::shared_ptr<SequentialSentences> takeSentences(const std::string &key);
+
+    void putSentences(std::string key, std::shared_ptr<SequentialSentences> sentences);
+
+    /**
+     * Register a prepared statement, return its id.
+     * The least recently used statement is deallocated if there are too many.
+     */
+    StatusOr<int64_t> addPreparedStatement(std::string key);
+
+    /**
+     * Return the normalized query of the prepared statement.
+     */
+    StatusOr<std::string> findPreparedStatement(int64_t id);
+
+    /**
+     * Keep the stream of the rows not sent yet in a new cursor, return its id.
+     * The oldest cursors are closed if there are too many cursors or rows in the session,
+     * fail if the rows still could not be kept within the limits.
+     */
+    StatusOr<int64_t> addCursor(std::shared_ptr<ResultStream> stream);
+
+    /**
+     * Read the next chunk of the cursor, which is fulfilled once the chunk is produced.
+     * The cursor should be closed once all rows are fetched.
+     */
+    folly::Future<StatusOr<ResultStream::Chunk>> fetchCursor(int64_t id);
+
+    void closeCursor(int64_t id);
+
+    /**
+     * Close the cursors not fetched for cursor_idle_timeout_secs.
+     */
+    void reclaimCursors();
+
+    /**
+     * Normalize a query to be used as the cache key, i.e. collapse the
+     * whitespaces out of the quoted strings and strip the trailing semicolons.
+     */
+    static std::string normalize(folly::StringPiece query);
+
 private:
     // ClientSession could only be created via SessionManager
     friend class SessionManager;
@@ -62,11 +117,33 @@ private:
 
 
 private:
+    struct Cursor {
+        std::shared_ptr<ResultStream>   stream;
+        time::Duration                  idleDuration;
+    };
+
+    // Caller should hold `lock_'
+    std::map<int64_t, Cursor>::iterator eraseCursor(std::map<int64_t, Cursor>::iterator it);
+
+    // Caller should hold `lock_'
+    int64_t cursorRows() const;
+
     int64_t             id_{0};
     GraphSpaceID        space_{-1};
     time::Duration      idleDuration_;
     std::string         spaceName_;
     std::string         user_;
+
+    mutable std::mutex                                          lock_;
+    std::unique_ptr<LRU<std::string, std::shared_ptr<SequentialSentences>>> sentences_;
+    // <id, normalized query> of the prepared statements, most recently used first
+    std::list<std::pair<int64_t, std::string>>                  preparedLru_;
+    std::unordered_map<int64_t,
+                       std::list<std::pair<int64_t, std::string>>::iterator> prepared_;
+    int64_t                                                     nextStatementId_{1};
+    // Ordered by the id, so the first one is the oldest
+    std::map<int64_t, Cursor>                                   cursors_;
+    int64_t                                                     nextCursorId_{1};
 };
 
 }   // namespace graph
@@ -32,15 +32,45 @@ Status CreateSpaceExecutor::prepare() {
                     return Status::Error("Replica_factor value should be greater than zero");
                 }
                 break;
+            case SpaceOptItem::SINGLE_VERSION:
+                singleVersion_ = item->get_single_version();
+                break;
+            case SpaceOptItem::PARTITION_STRATEGY: {
+                auto strategy = folly::toLowerAscii(item->get_partition_strategy());
+                if (strategy == "hash") {
+                    strategy_ = meta::cpp2::PartitionStrategy::HASH;
+                } else if (strategy == "range") {
+                    strategy_ = meta::cpp2::PartitionStrategy::RANGE;
+                } else {
+                    return Status::Error("Partition_strategy should be `hash' or `range'");
+                }
+                break;
+            }
+            case SpaceOptItem::RANGE_BOUNDS: {
+                std::vector<folly::StringPiece> bounds;
+                folly::split(",", item->get_range_bounds(), bounds, true);
+                for (auto &bound : bounds) {
+                    auto vid = folly::tryTo<VertexID>(folly::trimWhitespace(bound));
+                    if (!vid.hasValue()) {
+                        return Status::Error("Illegal range bound `%s'", bound.str().c_str());
+                    }
+                    rangeBounds_.emplace_back(vid.value());
+                }
+                break;
+            }
         }
     }
+    if (!rangeBounds_.empty() && strategy_ != meta::cpp2::PartitionStrategy::RANGE) {
+        return Status::Error("Range_bounds is only for the range partition_strategy");
+    }
     return Status::OK();
 }
 
 
 void CreateSpaceExecutor::execute() {
     auto future = ectx()->getMetaClient()->createSpace(
-        *spaceName_, partNum_, replicaFactor_, sentence_->isIfNotExist());
+        *spaceName_, partNum_, replicaFactor_, sentence_->isIfNotExist(), singleVersion_,
+        strategy_, rangeBounds_);
     auto *runner = ectx()->rctx()->runner();
 
     auto cb = [this] (auto &&resp) {
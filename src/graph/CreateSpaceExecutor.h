@@ -32,6 +32,9 @@ private:
     // it's impossible to express *not specified*, so we use 0 to indicate this.
     int32_t                         partNum_{0};
     int32_t                         replicaFactor_{0};
+    bool                            singleVersion_{false};
+    meta::cpp2::PartitionStrategy   strategy_{meta::cpp2::PartitionStrategy::HASH};
+    std::vector<VertexID>           rangeBounds_;
 };
 
 }   // namespace graph
@@ -59,6 +59,7 @@ void DeleteEdgesExecutor::execute() {
 
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
+        invalidateNeighborCache(spaceId_);
         auto completeness = resp.completeness();
         if (completeness != 100) {
             // TODO Need to consider atomic issues
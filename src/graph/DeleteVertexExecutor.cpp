@@ -74,6 +74,7 @@ void DeleteVertexExecutor::deleteEdges(std::vector<storage::cpp2::EdgeKey>* edge
     auto future = ectx()->getStorageClient()->deleteEdges(spaceId_, *edges);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
+        invalidateNeighborCache(spaceId_);
         auto completeness = resp.completeness();
         if (completeness != 100) {
             doError(Status::Error("Internal Error"));
@@ -95,6 +96,7 @@ void DeleteVertexExecutor::deleteVertex() {
     auto future = ectx()->getStorageClient()->deleteVertex(spaceId_, vid_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
+        invalidateNeighborCache(spaceId_);
         if (!resp.ok()) {
             doError(Status::Error("Internal Error"));
             return;
@@ -14,6 +14,8 @@
 #include "meta/SchemaManager.h"
 #include "meta/ClientBasedGflagsManager.h"
 #include "graph/VariableHolder.h"
+#include "graph/Profiler.h"
+#include "graph/NeighborCache.h"
 #include "meta/client/MetaClient.h"
 
 /**
@@ -68,13 +70,33 @@ public:
         return metaClient_;
     }
 
+    void setNeighborCache(NeighborCache *cache) {
+        neighborCache_ = cache;
+    }
+
+    // nullptr if the cache is disabled
+    NeighborCache* neighborCache() const {
+        return neighborCache_;
+    }
+
+    void setProfiler(std::unique_ptr<Profiler> profiler) {
+        profiler_ = std::move(profiler);
+    }
+
+    // nullptr unless the query is EXPLAIN or PROFILE
+    Profiler* profiler() const {
+        return profiler_.get();
+    }
+
 private:
     RequestContextPtr                           rctx_;
     meta::SchemaManager                        *sm_{nullptr};
     meta::ClientBasedGflagsManager             *gflagsManager_{nullptr};
     storage::StorageClient                     *storageClient_{nullptr};
     meta::MetaClient                           *metaClient_{nullptr};
+    NeighborCache                              *neighborCache_{nullptr};
     std::unique_ptr<VariableHolder>             variableHolder_;
+    std::unique_ptr<Profiler>                   profiler_;
 };
 
 }   // namespace graph
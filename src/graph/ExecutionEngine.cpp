@@ -8,6 +8,7 @@
 #include "graph/ExecutionEngine.h"
 #include "graph/ExecutionContext.h"
 #include "graph/ExecutionPlan.h"
+#include "graph/GraphFlags.h"
 #include "storage/client/StorageClient.h"
 
 DECLARE_string(meta_server_addrs);
@@ -50,6 +51,12 @@ Status ExecutionEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExec
     storage_ = std::make_unique<storage::StorageClient>(ioExecutor,
                                                         metaClient_.get(),
                                                         "graph");
+
+    if (FLAGS_enable_neighbor_cache) {
+        neighborCache_ = std::make_unique<NeighborCache>(FLAGS_neighbor_cache_capacity,
+                                                         FLAGS_neighbor_cache_bucket_exp,
+                                                         FLAGS_neighbor_cache_ttl_ms);
+    }
     return Status::OK();
 }
 
@@ -59,6 +66,7 @@ void ExecutionEngine::execute(RequestContextPtr rctx) {
                                                    gflagsManager_.get(),
                                                    storage_.get(),
                                                    metaClient_.get());
+    ectx->setNeighborCache(neighborCache_.get());
     // TODO(dutor) add support to plan cache
     auto plan = new ExecutionPlan(std::move(ectx));
 
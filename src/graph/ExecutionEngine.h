@@ -30,6 +30,8 @@ class StorageClient;
 
 namespace graph {
 
+class NeighborCache;
+
 class ExecutionEngine final : public cpp::NonCopyable, public cpp::NonMovable {
 public:
     ExecutionEngine();
@@ -45,6 +47,7 @@ private:
     std::unique_ptr<meta::ClientBasedGflagsManager>   gflagsManager_;
     std::unique_ptr<storage::StorageClient>           storage_;
     std::unique_ptr<meta::MetaClient>                 metaClient_;
+    std::unique_ptr<NeighborCache>                    neighborCache_;
 };
 
 }   // namespace graph
@@ -7,6 +7,7 @@
 #include "base/Base.h"
 #include "graph/ExecutionPlan.h"
 #include "stats/StatsManager.h"
+#include "time/Duration.h"
 
 namespace nebula {
 namespace graph {
@@ -17,20 +18,46 @@ void ExecutionPlan::execute() {
 
     Status status;
     do {
-        auto result = GQLParser().parse(rctx->query());
-        if (!result.ok()) {
-            status = std::move(result).status();
-            LOG(ERROR) << status;
-            stats::Stats::addStatsValue(parseStats_.get(), false);
+        time::Duration parseDuration;
+        cacheKey_ = ClientSession::normalize(rctx->query());
+        sentences_ = rctx->session()->takeSentences(cacheKey_);
+        if (sentences_ == nullptr) {
+            auto result = GQLParser().parse(rctx->query());
+            if (!result.ok()) {
+                status = std::move(result).status();
+                LOG(ERROR) << status;
+                stats::Stats::addStatsValue(parseStats_.get(), false);
+                break;
+            }
+            sentences_ = std::move(result).value();
+        }
+        status = bindParameters();
+        if (!status.ok()) {
+            // The tree is still reusable
+            rctx->session()->putSentences(std::move(cacheKey_), std::move(sentences_));
             break;
         }
+        stats::Stats::addStatsValue(parseStats_.get(), true, parseDuration.elapsedInUSec());
 
-        sentences_ = std::move(result).value();
+        auto mode = sentences_->mode();
+        if (mode != SequentialSentences::Mode::kNormal) {
+            auto explain = mode == SequentialSentences::Mode::kExplain;
+            ectx()->setProfiler(std::make_unique<Profiler>(explain));
+        }
         executor_ = std::make_unique<SequentialExecutor>(sentences_.get(), ectx());
+        executor_->setupProfile(nullptr, nullptr);
+        std::shared_ptr<ResultStream> stream;
+        if (rctx->chunkSize() > 0 && ectx()->profiler() == nullptr) {
+            stream = std::make_shared<ResultStream>(rctx->chunkSize(), rctx->runner());
+            executor_->setResultStream(stream);
+        }
         status = executor_->prepare();
         if (!status.ok()) {
             break;
         }
+        if (executor_->isStreaming()) {
+            stream_ = std::move(stream);
+        }
     } while (false);
 
     // Prepare failed
@@ -39,6 +66,12 @@ void ExecutionPlan::execute() {
         return;
     }
 
+    // Only the executor tree is needed by EXPLAIN
+    if (ectx()->profiler() != nullptr && ectx()->profiler()->isExplain()) {
+        onFinish();
+        return;
+    }
+
     // Prepared
     auto onFinish = [this] (Executor::ProcessControl ctr) {
         UNUSED(ctr);
@@ -50,42 +83,191 @@ void ExecutionPlan::execute() {
     executor_->setOnFinish(std::move(onFinish));
     executor_->setOnError(std::move(onError));
 
-    executor_->execute();
+    if (stream_ != nullptr) {
+        pending_ = 2;
+        auto onFirstChunk = [this] (StatusOr<ResultStream::Chunk> chunk) {
+            this->onFirstChunk(std::move(chunk));
+        };
+        stream_->read().via(rctx->runner()).thenValue(std::move(onFirstChunk));
+    }
+
+    executor_->run();
+}
+
+
+Status ExecutionPlan::bindParameters() {
+    auto *rctx = ectx()->rctx();
+    auto &placeholders = sentences_->parameters();
+    if (!rctx->isPrepared()) {
+        if (!placeholders.empty()) {
+            return Status::SyntaxError("Placeholder `?' is only allowed in prepared statements");
+        }
+        return Status::OK();
+    }
+
+    auto &params = rctx->parameters();
+    if (params.size() != placeholders.size()) {
+        return Status::Error("%lu parameters expected, but %lu given",
+                             placeholders.size(), params.size());
+    }
+    for (auto i = 0u; i < params.size(); i++) {
+        auto &param = params[i];
+        VariantType value;
+        switch (param.getType()) {
+            case cpp2::ColumnValue::Type::bool_val:
+                value = param.get_bool_val();
+                break;
+            case cpp2::ColumnValue::Type::integer:
+                value = param.get_integer();
+                break;
+            case cpp2::ColumnValue::Type::id:
+                value = param.get_id();
+                break;
+            case cpp2::ColumnValue::Type::timestamp:
+                value = param.get_timestamp();
+                break;
+            case cpp2::ColumnValue::Type::single_precision:
+                value = static_cast<double>(param.get_single_precision());
+                break;
+            case cpp2::ColumnValue::Type::double_precision:
+                value = param.get_double_precision();
+                break;
+            case cpp2::ColumnValue::Type::str:
+                value = param.get_str();
+                break;
+            default:
+                return Status::Error("Unsupported type of parameter %u: %d",
+                                     i, static_cast<int32_t>(param.getType()));
+        }
+        placeholders[i]->setOperand(std::move(value));
+    }
+    return Status::OK();
 }
 
 
 void ExecutionPlan::onFinish() {
     auto *rctx = ectx()->rctx();
-    executor_->setupResponse(rctx->resp());
+    if (stream_ != nullptr) {
+        auto latency = rctx->duration().elapsedInUSec();
+        stats::Stats::addStatsValue(allStats_.get(), true, latency);
+        executor_.reset();
+        rctx->session()->putSentences(std::move(cacheKey_), std::move(sentences_));
+        stream_->finish(Status::OK());
+        release();
+        return;
+    }
+
+    auto *profiler = ectx()->profiler();
+    if (profiler == nullptr || !profiler->isExplain()) {
+        executor_->setupResponse(rctx->resp());
+    }
+    if (profiler != nullptr) {
+        // The statistics of the executors take the place of the results
+        rctx->resp().set_error_code(cpp2::ErrorCode::SUCCEEDED);
+        rctx->resp().set_column_names(profiler->columnNames());
+        rctx->resp().set_rows(profiler->rows());
+    }
+    auto chunkSize = rctx->chunkSize();
+    auto &rows = rctx->resp().rows;
+    if (chunkSize > 0 && rows.size() > static_cast<size_t>(chunkSize)) {
+        // The results are not emitted in batches, so they have been built all at once
+        auto stream = std::make_shared<ResultStream>(chunkSize, rctx->runner());
+        stream->write(std::vector<cpp2::RowValue>(
+                    std::make_move_iterator(rows.begin() + chunkSize),
+                    std::make_move_iterator(rows.end())));
+        stream->finish(Status::OK());
+        rows.resize(chunkSize);
+        auto cursor = rctx->session()->addCursor(std::move(stream));
+        if (cursor.ok()) {
+            rctx->resp().set_cursor_id(cursor.value());
+        } else {
+            rows.clear();
+            rctx->resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+            rctx->resp().set_error_msg(cursor.status().toString());
+        }
+    }
     auto latency = rctx->duration().elapsedInUSec();
     stats::Stats::addStatsValue(allStats_.get(), true, latency);
     rctx->resp().set_latency_in_us(latency);
     auto &spaceName = rctx->session()->spaceName();
     rctx->resp().set_space_name(spaceName);
+    // The execution is done, put the parsing tree back for the later executions
+    executor_.reset();
+    rctx->session()->putSentences(std::move(cacheKey_), std::move(sentences_));
     rctx->finish();
-
-    // The `ExecutionPlan' is the root node holding all resources during the execution.
-    // When the whole query process is done, it's safe to release this object, as long as
-    // no other contexts have chances to access these resources later on,
-    // e.g. previously launched uncompleted async sub-tasks, EVEN on failures.
-    delete this;
+    release();
 }
 
 
-void ExecutionPlan::onError(Status status) {
+void ExecutionPlan::onFirstChunk(StatusOr<ResultStream::Chunk> chunk) {
     auto *rctx = ectx()->rctx();
-    if (status.isSyntaxError()) {
-        rctx->resp().set_error_code(cpp2::ErrorCode::E_SYNTAX_ERROR);
-    } else if (status.isStatementEmpty()) {
-        rctx->resp().set_error_code(cpp2::ErrorCode::E_STATEMENT_EMTPY);
+    auto &resp = rctx->resp();
+    if (!chunk.ok()) {
+        setupError(chunk.status());
     } else {
-        rctx->resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+        resp.set_column_names(stream_->columnNames());
+        auto more = chunk.value().more;
+        if (!chunk.value().rows.empty()) {
+            resp.set_rows(std::move(chunk.value().rows));
+        }
+        if (more) {
+            auto cursor = rctx->session()->addCursor(stream_);
+            if (cursor.ok()) {
+                resp.set_cursor_id(cursor.value());
+            } else {
+                // The execution fails on its next wait for the room
+                stream_->close();
+                resp.rows.clear();
+                resp.set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+                resp.set_error_msg(cursor.status().toString());
+            }
+        }
     }
-    rctx->resp().set_error_msg(status.toString());
+    resp.set_latency_in_us(rctx->duration().elapsedInUSec());
+    resp.set_space_name(rctx->session()->spaceName());
+    rctx->finish();
+    release();
+}
+
+
+void ExecutionPlan::onError(Status status) {
+    auto *rctx = ectx()->rctx();
     auto latency = rctx->duration().elapsedInUSec();
     stats::Stats::addStatsValue(allStats_.get(), false, latency);
+    if (stream_ != nullptr) {
+        // Reported to the client by the response or the cursor, whichever reads it
+        stream_->finish(std::move(status));
+        release();
+        return;
+    }
+    setupError(status);
     rctx->resp().set_latency_in_us(latency);
     rctx->finish();
+    release();
+}
+
+
+void ExecutionPlan::setupError(const Status &status) {
+    auto &resp = ectx()->rctx()->resp();
+    if (status.isSyntaxError()) {
+        resp.set_error_code(cpp2::ErrorCode::E_SYNTAX_ERROR);
+    } else if (status.isStatementEmpty()) {
+        resp.set_error_code(cpp2::ErrorCode::E_STATEMENT_EMTPY);
+    } else {
+        resp.set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+    }
+    resp.set_error_msg(status.toString());
+}
+
+
+void ExecutionPlan::release() {
+    if (--pending_ != 0) {
+        return;
+    }
+    // The `ExecutionPlan' is the root node holding all resources during the execution.
+    // When the whole query process is done, it's safe to release this object, as long as
+    // no other contexts have chances to access these resources later on,
+    // e.g. previously launched uncompleted async sub-tasks, EVEN on failures.
     delete this;
 }
 
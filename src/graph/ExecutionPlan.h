@@ -39,9 +39,16 @@ public:
      * If the whole execution was done, `onFinish' would be invoked.
      * All `onFinish' should do is to ask `executor_' to fill the `ectx()->rctx()->resp()',
      * which in turn asks the last sub-executor to do the actual job.
+     * In the streaming mode, the results have been written into `stream_' instead.
      */
     void onFinish();
 
+    /**
+     * In the streaming mode, the response is sent once the first chunk is read from
+     * `stream_', and the rest of the stream is left to a cursor of the session.
+     */
+    void onFirstChunk(StatusOr<ResultStream::Chunk> chunk);
+
     /**
      * If any error occurred during the execution, `onError' should
      * be invoked with a status to indicate the reason.
@@ -53,11 +60,30 @@ public:
     }
 
 private:
-    std::unique_ptr<SequentialSentences>        sentences_;
+    /**
+     * Bind the parameters of a prepared statement to the placeholders.
+     */
+    Status bindParameters();
+
+    void setupError(const Status &status);
+
+    /**
+     * The plan is released once both the execution and the response are done,
+     * they are done at the same time unless in the streaming mode.
+     */
+    void release();
+
+private:
+    // Key of `sentences_' in the session's cache
+    std::string                                 cacheKey_;
+    std::shared_ptr<SequentialSentences>        sentences_;
     std::unique_ptr<ExecutionContext>           ectx_;
     std::unique_ptr<SequentialExecutor>         executor_;
     std::unique_ptr<stats::Stats>               allStats_;
     std::unique_ptr<stats::Stats>               parseStats_;
+    // The results of the execution, if they are passed to the client in chunks while executing
+    std::shared_ptr<ResultStream>               stream_;
+    std::atomic<int32_t>                        pending_{1};
 };
 
 }   // namespace graph
@@ -182,6 +182,7 @@ std::unique_ptr<Executor> Executor::makeExecutor(Sentence *sentence) {
             LOG(ERROR) << "Sentence kind illegal: " << kind;
             return nullptr;
     }
+    executor->setupProfile(this, sentence);
     return executor;
 }
 
@@ -390,6 +391,50 @@ StatusOr<VariantType> Executor::transformDefaultValue(nebula::cpp2::SupportedTyp
     return Status::OK();
 }
 
+void Executor::run() {
+    if (profile_ != nullptr) {
+        profile_->start();
+    }
+    execute();
+}
+
+void Executor::setOnFinish(std::function<void(ProcessControl)> onFinish) {
+    if (profile_ == nullptr) {
+        onFinish_ = std::move(onFinish);
+        return;
+    }
+    auto *profile = profile_;
+    onFinish_ = [profile, onFinish = std::move(onFinish)] (ProcessControl ctr) {
+        profile->finish();
+        onFinish(ctr);
+    };
+}
+
+void Executor::setOnError(std::function<void(Status)> onError) {
+    if (profile_ == nullptr) {
+        onError_ = std::move(onError);
+        return;
+    }
+    auto *profile = profile_;
+    onError_ = [profile, onError = std::move(onError)] (Status status) {
+        profile->finish();
+        onError(std::move(status));
+    };
+}
+
+void Executor::setupProfile(const Executor *parent, const Sentence *sentence) {
+    auto *profiler = ectx()->profiler();
+    if (profiler == nullptr) {
+        return;
+    }
+    profile_ = profiler->getOrAdd(parent == nullptr ? nullptr : parent->profile(),
+                                  sentence,
+                                  name());
+    if (sentence != nullptr) {
+        profile_->setDescription(sentence->toString());
+    }
+}
+
 void Executor::doError(Status status, uint32_t count) const {
     stats::Stats::addStatsValue(stats_.get(), false, duration().elapsedInUSec(), count);
     DCHECK(onError_);
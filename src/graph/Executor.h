@@ -48,6 +48,12 @@ public:
 
     virtual void execute() = 0;
 
+    /**
+     * Start the execution, which should be used instead of calling `execute' directly,
+     * so that the start time is recorded when profiling.
+     */
+    void run();
+
     virtual const char* name() const = 0;
 
     enum ProcessControl : uint8_t {
@@ -58,9 +64,8 @@ public:
     /**
      * Set callback to be invoked when this executor is finished(normally).
      */
-    void setOnFinish(std::function<void(ProcessControl)> onFinish) {
-        onFinish_ = onFinish;
-    }
+    void setOnFinish(std::function<void(ProcessControl)> onFinish);
+
     /**
      * When some error happens during an executor's execution, it should invoke its
      * `onError_' with a Status that indicates the reason.
@@ -68,9 +73,8 @@ public:
      * An executor terminates its execution via invoking either `onFinish_' or `onError_',
      * but should never call them both.
      */
-    void setOnError(std::function<void(Status)> onError) {
-        onError_ = onError;
-    }
+    void setOnError(std::function<void(Status)> onError);
+
     /**
      * Upon finished successfully, `setupResponse' would be invoked on the last executor.
      * Any Executor implementation, which wants to send its meaningful result to the client,
@@ -88,6 +92,17 @@ public:
         return duration_;
     }
 
+    /**
+     * Attach the executor to the profile tree if the query is profiled,
+     * which must be done before setting the callbacks.
+     */
+    void setupProfile(const Executor *parent, const Sentence *sentence);
+
+    // nullptr if the query is not profiled
+    ExecutorProfile* profile() const {
+        return profile_;
+    }
+
 protected:
     std::unique_ptr<Executor> makeExecutor(Sentence *sentence);
 
@@ -113,6 +128,14 @@ protected:
 
     StatusOr<VariantType> transformDefaultValue(nebula::cpp2::SupportedType type,
                                                 std::string& originalValue);
+    // Called once the space may have been modified
+    void invalidateNeighborCache(GraphSpaceID space) const {
+        auto *cache = ectx()->neighborCache();
+        if (cache != nullptr) {
+            cache->invalidate(space);
+        }
+    }
+
     void doError(Status status, uint32_t count = 1) const;
     void doFinish(ProcessControl pro, uint32_t count = 1) const;
 
@@ -122,6 +145,7 @@ protected:
     std::function<void(Status)>                 onError_;
     time::Duration                              duration_;
     std::unique_ptr<stats::Stats>               stats_;
+    ExecutorProfile                            *profile_{nullptr};
 };
 
 }   // namespace graph
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/FetchEdgesExecutor.h"
+#include "base/FingerprintSet.h"
 
 namespace nebula {
 namespace graph {
@@ -273,6 +274,7 @@ void FetchEdgesExecutor::fetchEdges() {
     auto future = ectx()->getStorageClient()->getEdgeProps(spaceId_, edgeKeys_, std::move(props));
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (RpcResponse &&result) mutable {
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get props failed"));
@@ -312,10 +314,10 @@ Status FetchEdgesExecutor::getPropNames(std::vector<storage::cpp2::PropDef> &pro
 }
 
 void FetchEdgesExecutor::processResult(RpcResponse &&result) {
-    auto all = result.responses();
+    auto &all = result.responses();
     std::shared_ptr<SchemaWriter> outputSchema;
     std::unique_ptr<RowSetWriter> rsWriter;
-    auto uniqResult = std::make_unique<std::unordered_set<std::string>>();
+    FingerprintSet uniqResult;
     Getters getters;
     for (auto &resp : all) {
         if (!resp.__isset.schema || !resp.__isset.data
@@ -363,8 +365,7 @@ void FetchEdgesExecutor::processResult(RpcResponse &&result) {
             // TODO Consider float/double, and need to reduce mem copy.
             std::string encode = writer->encode();
             if (distinct_) {
-                auto ret = uniqResult->emplace(encode);
-                if (ret.second) {
+                if (uniqResult.insert(encode)) {
                     rsWriter->addRow(std::move(encode));
                 }
             } else {
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/FetchVerticesExecutor.h"
+#include "base/FingerprintSet.h"
 #include "meta/SchemaProviderIf.h"
 #include "dataman/SchemaWriter.h"
 
@@ -113,6 +114,7 @@ void FetchVerticesExecutor::fetchVertices() {
     auto future = ectx()->getStorageClient()->getVertexProps(spaceId_, vids_, std::move(props));
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (RpcResponse &&result) mutable {
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get props failed"));
@@ -148,10 +150,10 @@ std::vector<storage::cpp2::PropDef> FetchVerticesExecutor::getPropNames() {
 }
 
 void FetchVerticesExecutor::processResult(RpcResponse &&result) {
-    auto all = result.responses();
+    auto &all = result.responses();
     std::shared_ptr<SchemaWriter> outputSchema;
     std::unique_ptr<RowSetWriter> rsWriter;
-    auto uniqResult = std::make_unique<std::unordered_set<std::string>>();
+    FingerprintSet uniqResult;
     Getters getters;
     for (auto &resp : all) {
         if (!resp.__isset.vertices) {
@@ -162,21 +164,20 @@ void FetchVerticesExecutor::processResult(RpcResponse &&result) {
         if (schema == nullptr) {
             continue;
         }
-
-        std::unordered_map<TagID, std::shared_ptr<ResultSchemaProvider>> tagSchema;
-        std::transform(schema->cbegin(), schema->cend(),
-                       std::inserter(tagSchema, tagSchema.begin()), [](auto &s) {
-                           return std::make_pair(
-                               s.first, std::make_shared<ResultSchemaProvider>(s.second));
-                       });
+        // Only the fetched tag is decoded, whose schema only has the requested props
+        auto it = schema->find(tagID_);
+        if (it == schema->end()) {
+            continue;
+        }
+        auto vschema = std::make_shared<ResultSchemaProvider>(it->second);
 
         for (auto &vdata : resp.vertices) {
             std::unique_ptr<RowReader> vreader;
-            if (!vdata.__isset.tag_data || vdata.tag_data.empty()) {
+            if (!vdata.__isset.tag_data || vdata.tag_data.empty()
+                    || vdata.tag_data[0].tag_id != tagID_) {
                 continue;
             }
 
-            auto vschema = tagSchema[vdata.tag_data[0].tag_id];
             vreader = RowReader::getRowReader(vdata.tag_data[0].data, vschema);
             if (outputSchema == nullptr) {
                 outputSchema = std::make_shared<SchemaWriter>();
@@ -212,8 +213,7 @@ void FetchVerticesExecutor::processResult(RpcResponse &&result) {
             // TODO Consider float/double, and need to reduce mem copy.
             std::string encode = writer->encode();
             if (distinct_) {
-                auto ret = uniqResult->emplace(encode);
-                if (ret.second) {
+                if (uniqResult.insert(encode)) {
                     rsWriter->addRow(std::move(encode));
                 }
             } else {
@@ -461,6 +461,7 @@ void FindPathExecutor::getFromFrontiers(
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
         Frontiers frontiers;
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             fStatus_ = Status::Error("Get neighbors failed.");
@@ -499,6 +500,7 @@ void FindPathExecutor::getToFrontiers(
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
         Frontiers frontiers;
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             tStatus_ = Status::Error("Get neighbors failed.");
@@ -0,0 +1,40 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_FLOWCONTROL_H_
+#define GRAPH_FLOWCONTROL_H_
+
+#include "base/Base.h"
+#include "base/Status.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * FlowControl lets the consumer of the batches emitted by an executor hold back the producer.
+ * Before emitting a batch, the producer asks `room()' for the number of rows the consumer
+ * could take, and waits by `waitRoom()' if there is no room at all.
+ */
+class FlowControl {
+public:
+    virtual ~FlowControl() = default;
+
+    /**
+     * The number of rows the consumer could take now, -1 for no limit.
+     */
+    virtual int64_t room() const = 0;
+
+    /**
+     * `ready' is called back once there is room again, or with an error if the consumer
+     * has gone. It's never called on the stack of `waitRoom'.
+     */
+    virtual void waitRoom(std::function<void(Status)> ready) = 0;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_FLOWCONTROL_H_
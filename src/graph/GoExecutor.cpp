@@ -6,7 +6,9 @@
 
 #include "base/Base.h"
 #include "graph/GoExecutor.h"
+#include "base/FingerprintSet.h"
 #include "graph/SchemaHelper.h"
+#include "graph/GraphFlags.h"
 #include "dataman/RowReader.h"
 #include "dataman/RowSetReader.h"
 #include "dataman/ResultSchemaProvider.h"
@@ -29,6 +31,16 @@ GoExecutor::GoExecutor(Sentence *sentence, ExecutionContext *ectx)
 
 
 Status GoExecutor::prepare() {
+    if (profile_ != nullptr) {
+        // The clauses are prepared at execution, so describe the filter in advance
+        auto desc = sentence_->toString();
+        auto where = WhereWrapper(sentence_->whereClause()).explain();
+        if (!where.empty()) {
+            desc += "; ";
+            desc += where;
+        }
+        profile_->setDescription(std::move(desc));
+    }
     return Status::OK();
 }
 
@@ -116,6 +128,23 @@ void GoExecutor::feedResult(std::unique_ptr<InterimResult> result) {
 }
 
 
+bool GoExecutor::canEmitBatches() const {
+    // The distinct and the columns of `OVER *' are applied on the whole results
+    auto *clause = sentence_->yieldClause();
+    return clause != nullptr && !clause->isDistinct();
+}
+
+
+bool GoExecutor::canConsumeBatches() const {
+    auto *clause = sentence_->yieldClause();
+    if (clause != nullptr && clause->isDistinct()) {
+        return false;
+    }
+    auto *from = sentence_->fromClause();
+    return from->isRef() && from->ref()->isInputExpression();
+}
+
+
 Status GoExecutor::prepareStep() {
     auto *clause = sentence_->stepClause();
     if (clause != nullptr) {
@@ -321,12 +350,15 @@ Status GoExecutor::prepareYield() {
 Status GoExecutor::prepareNeededProps() {
     auto status = Status::OK();
     do {
+        compiledYields_.clear();
         for (auto *col : yields_) {
             col->expr()->setContext(expCtx_.get());
             status = col->expr()->prepare();
             if (!status.ok()) {
                 break;
             }
+            auto compiled = CompiledExpression::compile(col->expr());
+            compiledYields_.emplace_back(compiled.ok() ? std::move(compiled).value() : nullptr);
         }
         if (!status.ok()) {
             break;
@@ -379,14 +411,33 @@ Status GoExecutor::prepareDistinct() {
     auto *clause = sentence_->yieldClause();
     if (clause != nullptr) {
         distinct_ = clause->isDistinct();
-        // TODO Consider distinct pushdown later, depends on filter and some other clause pushdown.
-        distinctPushDown_ =
-            !((expCtx_->hasSrcTagProp() || expCtx_->hasEdgeProp()) && expCtx_->hasDstTagProp());
+        distinctPushDown_ = distinct_ && canPushdownDistinct();
     }
     return Status::OK();
 }
 
 
+bool GoExecutor::canPushdownDistinct() const {
+    if (yields_.empty() || isReversely()) {
+        return false;
+    }
+    for (auto *col : yields_) {
+        if (!col->getFunName().empty() || col->expr()->kind() != Expression::kEdgeDstId) {
+            return false;
+        }
+    }
+    // Otherwise, the edge kept by storage might be filtered out in graphd,
+    // while the dropped ones to the same dst might not.
+    auto *filter = whereWrapper_->filter_;
+    if (filter == nullptr) {
+        return true;
+    }
+    return FLAGS_filter_pushdown
+        && !whereWrapper_->filterPushdown_.empty()
+        && whereWrapper_->filterPushdown_ == Expression::encode(filter);
+}
+
+
 Status GoExecutor::setupStarts() {
     // Literal vertex ids
     if (!starts_.empty()) {
@@ -433,7 +484,6 @@ void GoExecutor::setupResponse(cpp2::ExecutionResponse &resp) {
 
 
 void GoExecutor::stepOut() {
-    auto spaceId = ectx()->rctx()->session()->space();
     auto status = getStepOutProps();
     if (!status.ok()) {
         doError(Status::Error("Get step out props failed"));
@@ -445,13 +495,18 @@ void GoExecutor::stepOut() {
         // TODO: not support filter pushdown in reversely traversal now.
         filterPushdown = whereWrapper_->filterPushdown_;
     }
-    auto future  = ectx()->getStorageClient()->getNeighbors(spaceId,
-                                                   starts_,
-                                                   edgeTypes_,
-                                                   filterPushdown,
-                                                   std::move(returns));
+    if (isFinalStep() && emitBatches_ && FLAGS_pipe_batch_size > 0
+            && starts_.size() > static_cast<size_t>(FLAGS_pipe_batch_size)) {
+        stepOutInBatches(std::move(returns), std::move(filterPushdown));
+        return;
+    }
+    auto future = getNeighbors(starts_,
+                               std::move(returns),
+                               std::move(filterPushdown),
+                               isFinalStep() && distinctPushDown_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get neighbors failed"));
@@ -477,6 +532,115 @@ void GoExecutor::stepOut() {
 }
 
 
+void GoExecutor::stepOutInBatches(std::vector<storage::cpp2::PropDef> returns,
+                                  std::string filter) {
+    batchReturns_ = std::move(returns);
+    batchFilter_ = std::move(filter);
+    nextBatch_ = 0;
+    pendingBatch_ = stepOutNextBatch();
+    waitNextBatch();
+}
+
+
+folly::SemiFuture<GoExecutor::RpcResponse> GoExecutor::stepOutNextBatch() {
+    auto begin = nextBatch_;
+    auto end = std::min(starts_.size(), begin + FLAGS_pipe_batch_size);
+    nextBatch_ = end;
+    std::vector<VertexID> ids(starts_.begin() + begin, starts_.begin() + end);
+    return getNeighbors(std::move(ids), batchReturns_, batchFilter_, false);
+}
+
+
+folly::SemiFuture<GoExecutor::RpcResponse>
+GoExecutor::getNeighbors(std::vector<VertexID> ids,
+                         std::vector<storage::cpp2::PropDef> returns,
+                         std::string filter,
+                         bool dedup) {
+    auto spaceId = ectx()->rctx()->session()->space();
+    auto *cache = ectx()->neighborCache();
+    // The dedup is applied across the vertices, so the results of each one are not cacheable
+    if (cache == nullptr || dedup) {
+        return ectx()->getStorageClient()->getNeighbors(spaceId,
+                                                        ids,
+                                                        edgeTypes_,
+                                                        filter,
+                                                        std::move(returns),
+                                                        nullptr,
+                                                        dedup);
+    }
+
+    auto signature = NeighborCache::signature(edgeTypes_, filter, returns);
+    // Taken before sending the request, so that the results are not cached
+    // if the space is modified meanwhile
+    auto version = cache->version(spaceId);
+    std::vector<VertexID> misses;
+    auto hits = cache->get(spaceId, signature, ids, misses);
+    if (misses.empty()) {
+        RpcResponse rpcResp(0);
+        rpcResp.responses() = std::move(hits);
+        return folly::makeFuture<RpcResponse>(std::move(rpcResp));
+    }
+
+    auto future = ectx()->getStorageClient()->getNeighbors(spaceId,
+                                                           misses,
+                                                           edgeTypes_,
+                                                           filter,
+                                                           std::move(returns));
+    auto cb = [cache, spaceId, version, signature = std::move(signature),
+               hits = std::move(hits)] (RpcResponse &&rpcResp) mutable {
+        cache->put(spaceId, signature, version, rpcResp.responses());
+        for (auto &resp : hits) {
+            rpcResp.responses().emplace_back(std::move(resp));
+        }
+        return std::move(rpcResp);
+    };
+    return std::move(future).via(ectx()->rctx()->runner()).thenValue(std::move(cb));
+}
+
+
+void GoExecutor::waitNextBatch() {
+    DCHECK(pendingBatch_.hasValue());
+    auto future = std::move(pendingBatch_).value();
+    pendingBatch_.clear();
+    auto *runner = ectx()->rctx()->runner();
+    auto cb = [this] (auto &&result) {
+        profileStorageResponse(result);
+        auto completeness = result.completeness();
+        if (completeness == 0) {
+            doError(Status::Error("Get neighbors failed"));
+            return;
+        } else if (completeness != 100) {
+            LOG(INFO) << "Get neighbors partially failed: "  << completeness << "%";
+            for (auto &error : result.failedParts()) {
+                LOG(ERROR) << "part: " << error.first
+                           << "error code: " << static_cast<int>(error.second);
+            }
+        }
+        // Overlap the request of the next batch with processing this one
+        if (nextBatch_ < starts_.size()) {
+            pendingBatch_ = stepOutNextBatch();
+        }
+        // The properties of the destination vertices are only needed by this batch
+        vertexHolder_.reset();
+        maybeFinishExecution(std::move(result));
+    };
+    auto error = [this] (auto &&e) {
+        LOG(ERROR) << "Exception caught: " << e.what();
+        doError(Status::Error("Exeception when handle out-bounds/in-bounds."));
+    };
+    std::move(future).via(runner).thenValue(cb).thenError(error);
+}
+
+
+bool GoExecutor::maybeContinueBatches() {
+    if (!pendingBatch_.hasValue()) {
+        return false;
+    }
+    waitNextBatch();
+    return true;
+}
+
+
 void GoExecutor::onStepOutResponse(RpcResponse &&rpcResp) {
     if (isFinalStep()) {
         maybeFinishExecution(std::move(rpcResp));
@@ -612,6 +776,7 @@ void GoExecutor::maybeFinishExecution(RpcResponse &&rpcResp) {
                 return;
             }
             auto resp = std::move(t).value();
+            profileStorageResponse(resp);
             for (auto &edgePropResp : resp.responses()) {
                 auto status = edgeHolder_->add(edgePropResp);
                 if (!status.ok()) {
@@ -723,13 +888,23 @@ void GoExecutor::finishExecution(RpcResponse &&rpcResp) {
         }
     }
 
+    if (onResult_ && emitBatches_ && flowControl_ != nullptr && yc.empty()) {
+        chunkResp_ = std::make_unique<RpcResponse>(std::move(rpcResp));
+        chunkPos_ = FinalPosition();
+        emitChunks();
+        return;
+    }
+
     std::unique_ptr<InterimResult> outputs;
-    if (!setupInterimResult(std::move(rpcResp), outputs)) {
+    if (!setupInterimResult(rpcResp, outputs)) {
         return;
     }
 
     if (onResult_) {
         onResult_(std::move(outputs));
+        if (maybeContinueBatches()) {
+            return;
+        }
     } else {
         resp_ = std::make_unique<cpp2::ExecutionResponse>();
         resp_->set_column_names(getResultColumnNames());
@@ -746,6 +921,44 @@ void GoExecutor::finishExecution(RpcResponse &&rpcResp) {
     doFinish(Executor::ProcessControl::kNext);
 }
 
+
+void GoExecutor::emitChunks() {
+    while (true) {
+        auto room = flowControl_->room();
+        if (room == 0) {
+            flowControl_->waitRoom([this] (Status status) {
+                if (!status.ok()) {
+                    doError(std::move(status));
+                    return;
+                }
+                emitChunks();
+            });
+            return;
+        }
+
+        std::unique_ptr<InterimResult> outputs;
+        auto maxRows = room < 0 ? 0UL : static_cast<size_t>(room);
+        if (!setupInterimResult(*chunkResp_, outputs, &chunkPos_, maxRows)) {
+            return;
+        }
+        auto done = chunkPos_.done;
+        if (outputs->hasData() || done) {
+            onResult_(std::move(outputs));
+        }
+        if (done) {
+            break;
+        }
+    }
+
+    chunkPos_ = FinalPosition();
+    chunkResp_.reset();
+    if (maybeContinueBatches()) {
+        return;
+    }
+    doFinish(Executor::ProcessControl::kNext);
+}
+
+
 StatusOr<std::vector<storage::cpp2::PropDef>> GoExecutor::getStepOutProps() {
     std::vector<storage::cpp2::PropDef> props;
     for (auto &e : edgeTypes_) {
@@ -835,6 +1048,7 @@ void GoExecutor::fetchVertexProps(std::vector<VertexID> ids, RpcResponse &&rpcRe
     auto future = ectx()->getStorageClient()->getVertexProps(spaceId, ids, returns);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this, stepOutResp = std::move(rpcResp)] (auto &&result) mutable {
+        profileStorageResponse(result);
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get dest props failed"));
@@ -877,12 +1091,16 @@ std::vector<std::string> GoExecutor::getResultColumnNames() const {
 }
 
 
-bool GoExecutor::setupInterimResult(RpcResponse &&rpcResp, std::unique_ptr<InterimResult> &result) {
+bool GoExecutor::setupInterimResult(RpcResponse &rpcResp,
+                                    std::unique_ptr<InterimResult> &result,
+                                    FinalPosition *pos,
+                                    size_t maxRows) {
     // Generic results
     result = std::make_unique<InterimResult>(getResultColumnNames());
     std::shared_ptr<SchemaWriter> schema;
     std::unique_ptr<RowSetWriter> rsWriter;
-    auto uniqResult = std::make_unique<std::unordered_set<std::string>>();
+    // The rows are deduplicated by the fingerprints of their encoded bytes
+    FingerprintSet uniqResult;
     auto cb = [&] (std::vector<VariantType> record,
                        std::vector<nebula::cpp2::SupportedType> colTypes) {
         if (schema == nullptr) {
@@ -942,15 +1160,14 @@ bool GoExecutor::setupInterimResult(RpcResponse &&rpcResp, std::unique_ptr<Inter
         // TODO Consider float/double, and need to reduce mem copy.
         std::string encode = writer.encode();
         if (distinct_) {
-            auto ret = uniqResult->emplace(encode);
-            if (ret.second) {
+            if (uniqResult.insert(encode)) {
                 rsWriter->addRow(std::move(encode));
             }
         } else {
             rsWriter->addRow(std::move(encode));
         }
     };  // cb
-    if (!processFinalResult(rpcResp, cb)) {
+    if (!processFinalResult(rpcResp, cb, pos, maxRows)) {
         return false;
     }
 
@@ -966,6 +1183,9 @@ void GoExecutor::onEmptyInputs() {
     auto outputs = std::make_unique<InterimResult>(std::move(resultColNames));
     if (onResult_) {
         onResult_(std::move(outputs));
+        if (maybeContinueBatches()) {
+            return;
+        }
     } else if (resp_ == nullptr) {
         resp_ = std::make_unique<cpp2::ExecutionResponse>();
     }
@@ -973,14 +1193,38 @@ void GoExecutor::onEmptyInputs() {
 }
 
 
-bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
-    auto all = rpcResp.responses();
-    for (auto &resp : all) {
+bool GoExecutor::processFinalResult(RpcResponse &rpcResp,
+                                    Callback cb,
+                                    FinalPosition *pos,
+                                    size_t maxRows) const {
+    // The WHERE and YIELD expressions are evaluated in the compiled form if possible
+    std::unique_ptr<CompiledColumn> where;
+    if (whereWrapper_->filter_ != nullptr && whereWrapper_->compiled_ != nullptr) {
+        where = std::make_unique<CompiledColumn>(this, whereWrapper_->compiled_.get(), false);
+    }
+    std::vector<std::unique_ptr<CompiledColumn>> columns(yields_.size());
+    for (auto i = 0u; i < yields_.size() && i < compiledYields_.size(); i++) {
+        if (compiledYields_[i] != nullptr) {
+            columns[i] = std::make_unique<CompiledColumn>(this, compiledYields_[i].get(), true);
+        }
+    }
+    auto compiledAll = (whereWrapper_->filter_ == nullptr || where != nullptr)
+                        && std::all_of(columns.begin(), columns.end(),
+                                       [] (auto &column) { return column != nullptr; });
+
+    FinalPosition whole;
+    if (pos == nullptr) {
+        pos = &whole;
+    }
+    size_t rows = 0;
+    auto &all = rpcResp.responses();
+    for (; pos->resp < all.size(); pos->resp++, pos->vertex = 0) {
+        auto &resp = all[pos->resp];
         if (resp.get_vertices() == nullptr) {
             continue;
         }
 
-        std::unordered_map<TagID, std::shared_ptr<ResultSchemaProvider>> tagSchema;
+        TagSchemas tagSchema;
         auto *vschema = resp.get_vertex_schema();
         if (vschema != nullptr) {
             std::transform(vschema->cbegin(), vschema->cend(),
@@ -991,7 +1235,7 @@ bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
                            });
         }
 
-        std::unordered_map<EdgeType, std::shared_ptr<ResultSchemaProvider>> edgeSchema;
+        EdgeSchemas edgeSchema;
         auto *eschema = resp.get_edge_schema();
         if (eschema != nullptr) {
             std::transform(eschema->cbegin(), eschema->cend(),
@@ -1006,19 +1250,44 @@ bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
             continue;
         }
 
-        for (auto &vdata : resp.vertices) {
+        for (; pos->vertex < resp.vertices.size(); pos->vertex++, pos->edge = 0) {
+            auto &vdata = resp.vertices[pos->vertex];
             DCHECK(vdata.__isset.edge_data);
             auto tagData = vdata.get_tag_data();
-            for (auto &edata : vdata.edge_data) {
+            // The tag rows of the src, read by the compiled expressions
+            TagReaders srcTags;
+            if (where != nullptr || !columns.empty()) {
+                for (auto &td : tagData) {
+                    auto it = tagSchema.find(td.tag_id);
+                    if (it != tagSchema.end() && td.__isset.data) {
+                        srcTags.emplace(td.tag_id, RowReader::getRowReader(td.data, it->second));
+                    }
+                }
+            }
+            for (; pos->edge < vdata.edge_data.size(); pos->edge++) {
+                auto &edata = vdata.edge_data[pos->edge];
                 auto it = edgeSchema.find(edata.type);
                 DCHECK(it != edgeSchema.end());
-                RowSetReader rsReader(it->second, edata.data);
-                auto iter = rsReader.begin();
+                if (pos->iter == nullptr) {
+                    pos->reader = std::make_unique<RowSetReader>(it->second, edata.data);
+                    pos->iter = std::make_unique<RowSetReader::Iterator>(pos->reader->begin());
+                }
+                auto &iter = *pos->iter;
                 auto edgeType = edata.type;
-                while (iter) {
-                    std::vector<SupportedType> colTypes;
-                    bool saveTypeFlag = false;
-                    Getters getters;
+                if (where != nullptr) {
+                    where->bind(edgeType, it->second.get(), edgeSchema, tagSchema);
+                }
+                for (auto &column : columns) {
+                    if (column != nullptr) {
+                        column->bind(edgeType, it->second.get(), edgeSchema, tagSchema);
+                    }
+                }
+
+                // The getters are only needed by the expressions not compiled
+                std::vector<SupportedType> colTypes;
+                bool saveTypeFlag = false;
+                Getters getters;
+                if (!compiledAll) {
                     getters.getAliasProp = [&iter,
                                             &edgeType,
                                             &saveTypeFlag,
@@ -1141,9 +1410,31 @@ bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
                         }
                         return getPropFromInterim(vdata.get_vertex_id(), prop);
                     };
+                }
 
+                while (iter) {
+                    if (maxRows > 0 && rows >= maxRows) {
+                        return true;
+                    }
+                    colTypes.clear();
+                    saveTypeFlag = false;
                     // Evaluate filter
-                    if (whereWrapper_->filter_ != nullptr) {
+                    if (where != nullptr) {
+                        auto status = where->load(vdata.get_vertex_id(), &*iter, srcTags);
+                        if (!status.ok()) {
+                            doError(std::move(status));
+                            return false;
+                        }
+                        auto result = where->filter();
+                        if (result == CompiledExpression::FilterResult::kError) {
+                            doError(Status::Error("Failed to evaluate the compiled expression"));
+                            return false;
+                        }
+                        if (result == CompiledExpression::FilterResult::kFalse) {
+                            ++iter;
+                            continue;
+                        }
+                    } else if (whereWrapper_->filter_ != nullptr) {
                         auto value = whereWrapper_->filter_->eval(getters);
                         if (!value.ok()) {
                             doError(std::move(value).status());
@@ -1157,10 +1448,23 @@ bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
                     std::vector<VariantType> record;
                     record.reserve(yields_.size());
                     saveTypeFlag = true;
-                    for (auto *column : yields_) {
+                    for (auto i = 0u; i < yields_.size(); i++) {
+                        auto *column = yields_[i];
                         colTypes.emplace_back(SupportedType::UNKNOWN);
-                        auto *expr = column->expr();
-                        auto value = expr->eval(getters);
+                        OptVariantType value;
+                        if (columns[i] != nullptr) {
+                            auto status = columns[i]->load(vdata.get_vertex_id(),
+                                                           &*iter,
+                                                           srcTags);
+                            if (!status.ok()) {
+                                doError(std::move(status));
+                                return false;
+                            }
+                            value = columns[i]->eval();
+                            colTypes.back() = columns[i]->type();
+                        } else {
+                            value = column->expr()->eval(getters);
+                        }
                         if (!value.ok()) {
                             doError(std::move(value).status());
                             return false;
@@ -1173,14 +1477,266 @@ bool GoExecutor::processFinalResult(RpcResponse &rpcResp, Callback cb) const {
                         record.emplace_back(std::move(value.value()));
                     }
                     cb(std::move(record), std::move(colTypes));
+                    rows++;
                     ++iter;
                 }  // while `iter'
+                pos->iter.reset();
+                pos->reader.reset();
             }
         }   // for `vdata'
     }   // for `resp'
+    pos->done = true;
     return true;
 }
 
+
+GoExecutor::CompiledColumn::CompiledColumn(const GoExecutor *executor,
+                                           const CompiledExpression *compiled,
+                                           bool trackType)
+    : executor_(executor), compiled_(compiled), trackType_(trackType) {
+    bindings_.resize(compiled_->slots().size());
+    slots_.resize(compiled_->slots().size());
+    for (auto i = 0u; i < bindings_.size(); i++) {
+        bindings_[i].slot = &compiled_->slots()[i];
+    }
+}
+
+
+void GoExecutor::CompiledColumn::bind(EdgeType edgeType,
+                                      const ResultSchemaProvider *edgeSchema,
+                                      const EdgeSchemas &edgeSchemas,
+                                      const TagSchemas &tagSchemas) {
+    auto *expCtx = executor_->expCtx_.get();
+    edgeSchema_ = edgeSchema;
+    dstIndex_ = edgeSchema->getFieldIndex(_DST);
+    for (auto &binding : bindings_) {
+        auto &slot = *binding.slot;
+        binding.type = Binding::Type::kError;
+        binding.index = -1;
+        binding.schema = nullptr;
+        binding.hasDefault = false;
+        binding.srcMissing = false;
+        binding.loaded = false;
+        binding.propType = SupportedType::UNKNOWN;
+        switch (slot.kind) {
+            case Expression::kAliasProp: {
+                EdgeType type;
+                if (!expCtx->getEdgeType(slot.alias, type)) {
+                    binding.status = Status::Error("Get edge type for `%s' failed in getters.",
+                                                   slot.alias.c_str());
+                    break;
+                }
+                if (executor_->isReversely()) {
+                    binding.edgeType = std::abs(edgeType);
+                    if (std::abs(edgeType) != std::abs(type)) {
+                        binding.value = executor_->edgeHolder_->getDefaultProp(std::abs(type),
+                                                                               slot.prop);
+                        binding.hasDefault = true;
+                    }
+                    binding.type = Binding::Type::kReverseEdgeProp;
+                    break;
+                }
+                binding.propType = edgeSchema->getFieldType(slot.prop).type;
+                if (std::abs(edgeType) != std::abs(type)) {
+                    auto sit = edgeSchemas.find(type);
+                    if (sit == edgeSchemas.end()) {
+                        binding.status = Status::Error("get schema failed");
+                        break;
+                    }
+                    binding.type = Binding::Type::kConstant;
+                    binding.value = RowReader::getDefaultProp(sit->second.get(), slot.prop);
+                    break;
+                }
+                binding.index = edgeSchema->getFieldIndex(slot.prop);
+                if (binding.index < 0) {
+                    binding.status = Status::Error(folly::sformat("get prop({}.{}) failed",
+                                                                  slot.alias, slot.prop));
+                    break;
+                }
+                binding.type = Binding::Type::kEdgeProp;
+                break;
+            }
+            case Expression::kSourceProp: {
+                if (!expCtx->getTagId(slot.alias, binding.tagId)) {
+                    binding.status = Status::Error("Get tag id for `%s' failed in getters.",
+                                                   slot.alias.c_str());
+                    break;
+                }
+                auto sit = tagSchemas.find(binding.tagId);
+                if (sit != tagSchemas.end()) {
+                    binding.index = sit->second->getFieldIndex(slot.prop);
+                    binding.propType = sit->second->getFieldType(slot.prop).type;
+                }
+                binding.type = Binding::Type::kSrcTagProp;
+                break;
+            }
+            case Expression::kDestProp: {
+                if (!expCtx->getTagId(slot.alias, binding.tagId)) {
+                    binding.status = Status::Error("Get tag id for `%s' failed in getters.",
+                                                   slot.alias.c_str());
+                    break;
+                }
+                binding.type = Binding::Type::kDstTagProp;
+                break;
+            }
+            case Expression::kInputProp:
+            case Expression::kVariableProp: {
+                binding.propType = executor_->getPropTypeFromInterim(slot.prop);
+                binding.type = Binding::Type::kInterimProp;
+                break;
+            }
+            default:
+                binding.status = Status::Error("Unexpected slot kind %d",
+                                               static_cast<int32_t>(slot.kind));
+                break;
+        }
+    }
+}
+
+
+Status GoExecutor::CompiledColumn::load(VertexID srcId,
+                                        const RowReader *edge,
+                                        const TagReaders &srcTags) {
+    for (auto i = 0u; i < bindings_.size(); i++) {
+        auto status = loadSlot(bindings_[i], slots_[i], srcId, edge, srcTags);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+
+StatusOr<VertexID> GoExecutor::CompiledColumn::dstId(const RowReader *edge) const {
+    VertexID dst;
+    if (dstIndex_ < 0 || edge->getVid(dstIndex_, dst) != ResultType::SUCCEEDED) {
+        return Status::Error("Get the dst of the edge failed");
+    }
+    return dst;
+}
+
+
+Status GoExecutor::CompiledColumn::loadSlot(Binding &binding,
+                                            TypedValue &slot,
+                                            VertexID srcId,
+                                            const RowReader *edge,
+                                            const TagReaders &srcTags) {
+    auto &prop = binding.slot->prop;
+    switch (binding.type) {
+        case Binding::Type::kError:
+            return binding.status;
+        case Binding::Type::kConstant:
+            if (!binding.value.ok()) {
+                return binding.value.status();
+            }
+            slot = TypedValue::ofVariant(binding.value.value());
+            return Status::OK();
+        case Binding::Type::kEdgeProp:
+            slot = TypedValue::ofField(edge, binding.index);
+            break;
+        case Binding::Type::kReverseEdgeProp: {
+            auto dst = dstId(edge);
+            if (!dst.ok()) {
+                return dst.status();
+            }
+            if (trackType_) {
+                binding.propType = executor_->edgeHolder_->getType(dst.value(), srcId,
+                                                                   binding.edgeType, prop);
+            }
+            if (!binding.hasDefault) {
+                // The props of the reversely traversed edges are fetched into edgeHolder_
+                binding.value = executor_->edgeHolder_->get(dst.value(), srcId,
+                                                            binding.edgeType, prop);
+            }
+            if (!binding.value.ok()) {
+                return binding.value.status();
+            }
+            slot = TypedValue::ofVariant(binding.value.value());
+            return Status::OK();
+        }
+        case Binding::Type::kSrcTagProp: {
+            auto it = srcTags.find(binding.tagId);
+            binding.srcMissing = it == srcTags.end();
+            if (binding.srcMissing) {
+                // Same as the getters, the default value is taken from the edge schema
+                if (!binding.hasDefault) {
+                    binding.value = RowReader::getDefaultProp(edgeSchema_, prop);
+                    binding.hasDefault = true;
+                }
+                if (!binding.value.ok()) {
+                    return binding.value.status();
+                }
+                slot = TypedValue::ofVariant(binding.value.value());
+                return Status::OK();
+            }
+            slot = TypedValue::ofField(it->second.get(), binding.index);
+            break;
+        }
+        case Binding::Type::kDstTagProp: {
+            auto dst = dstId(edge);
+            if (!dst.ok()) {
+                return dst.status();
+            }
+            auto *vdata = executor_->vertexHolder_->find(dst.value(), binding.tagId);
+            if (vdata == nullptr) {
+                if (!binding.hasDefault) {
+                    binding.value = executor_->vertexHolder_->getDefaultProp(binding.tagId, prop);
+                    binding.hasDefault = true;
+                }
+                if (trackType_) {
+                    binding.propType = executor_->vertexHolder_->getDefaultPropType(
+                                            binding.tagId, prop);
+                }
+                if (!binding.value.ok()) {
+                    return binding.value.status();
+                }
+                slot = TypedValue::ofVariant(binding.value.value());
+                return Status::OK();
+            }
+            auto &schema = std::get<0>(*vdata);
+            if (schema.get() != binding.schema) {
+                // The vertices from different responses have their own schemas
+                binding.schema = schema.get();
+                binding.index = schema->getFieldIndex(prop);
+                binding.propType = schema->getFieldType(prop).type;
+            }
+            auto reader = RowReader::getRowReader(std::get<1>(*vdata), schema);
+            slot = TypedValue::ofField(reader.get(), binding.index);
+            break;
+        }
+        case Binding::Type::kInterimProp:
+            // The value is the same for all edges of the src
+            if (!binding.loaded || binding.srcId != srcId) {
+                binding.value = executor_->getPropFromInterim(srcId, prop);
+                binding.srcId = srcId;
+                binding.loaded = true;
+            }
+            if (!binding.value.ok()) {
+                return binding.value.status();
+            }
+            slot = TypedValue::ofVariant(binding.value.value());
+            return Status::OK();
+    }
+    if (slot.type == TypedValue::Type::kNull) {
+        return Status::Error(folly::sformat("get prop({}.{}) failed", binding.slot->alias, prop));
+    }
+    return Status::OK();
+}
+
+
+SupportedType GoExecutor::CompiledColumn::type() const {
+    auto last = compiled_->lastSlot();
+    if (last < 0) {
+        return SupportedType::UNKNOWN;
+    }
+    auto &binding = bindings_[last];
+    if (binding.type == Binding::Type::kSrcTagProp && binding.srcMissing) {
+        // The getters don't track the type of the default value
+        return SupportedType::UNKNOWN;
+    }
+    return binding.propType;
+}
+
 OptVariantType GoExecutor::VertexHolder::getDefaultProp(TagID tid, const std::string &prop) const {
     for (auto it = data_.cbegin(); it != data_.cend(); ++it) {
         auto it2 = it->second.find(tid);
@@ -1225,6 +1781,19 @@ OptVariantType GoExecutor::VertexHolder::get(VertexID id, TagID tid,
     return value(std::move(res));
 }
 
+const GoExecutor::VertexHolder::VData* GoExecutor::VertexHolder::find(VertexID id,
+                                                                     TagID tid) const {
+    auto iter = data_.find(id);
+    if (iter == data_.end()) {
+        return nullptr;
+    }
+    auto iter2 = iter->second.find(tid);
+    if (iter2 == iter->second.end()) {
+        return nullptr;
+    }
+    return &iter2->second;
+}
+
 SupportedType GoExecutor::VertexHolder::getType(VertexID id, TagID tid, const std::string &prop) {
     auto iter = data_.find(id);
     if (iter == data_.end()) {
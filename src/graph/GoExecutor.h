@@ -8,7 +8,9 @@
 #define GRAPH_GOEXECUTOR_H_
 
 #include "base/Base.h"
+#include <folly/Optional.h>
 #include "graph/TraverseExecutor.h"
+#include "dataman/RowSetReader.h"
 #include "storage/client/StorageClient.h"
 
 DECLARE_bool(filter_pushdown);
@@ -39,6 +41,10 @@ public:
 
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
+    bool canEmitBatches() const override;
+
+    bool canConsumeBatches() const override;
+
 private:
     /**
      * To do some preparing works on the clauses
@@ -59,6 +65,12 @@ private:
 
     Status prepareDistinct();
 
+    /**
+     * Check if storage could dedup the edges by their dst, i.e. only the dst of edges
+     * is yielded, and the filter has been pushed down entirely.
+     */
+    bool canPushdownDistinct() const;
+
     Status prepareOverAll();
 
     /**
@@ -92,6 +104,32 @@ private:
     void stepOut();
 
     using RpcResponse = storage::StorageRpcResponse<storage::cpp2::QueryResponse>;
+
+    /**
+     * Get the neighbors of the vertices, through the neighbor cache if it's enabled.
+     */
+    folly::SemiFuture<RpcResponse> getNeighbors(std::vector<VertexID> ids,
+                                                std::vector<storage::cpp2::PropDef> returns,
+                                                std::string filter,
+                                                bool dedup);
+
+    /**
+     * To step out the final step in batches of the starting vertices, in the streaming mode.
+     * The request of the next batch is sent once the response of the current one arrives,
+     * and the results of each batch are emitted before handling the next one.
+     */
+    void stepOutInBatches(std::vector<storage::cpp2::PropDef> returns, std::string filter);
+
+    folly::SemiFuture<RpcResponse> stepOutNextBatch();
+
+    void waitNextBatch();
+
+    /**
+     * Continue with the next batch if there is any, after the results of
+     * the current batch have been emitted.
+     */
+    bool maybeContinueBatches();
+
     /**
      * Callback invoked upon the response of stepping out arrives.
      */
@@ -133,11 +171,35 @@ private:
      */
     void finishExecution(RpcResponse &&rpcResp);
 
+    /**
+     * Where the iteration on the final data collection stops, so that
+     * it could be resumed to produce the rows chunk by chunk.
+     */
+    struct FinalPosition {
+        size_t                                      resp{0};
+        size_t                                      vertex{0};
+        size_t                                      edge{0};
+        // The edge rows being iterated
+        std::unique_ptr<RowSetReader>               reader;
+        std::unique_ptr<RowSetReader::Iterator>     iter;
+        bool                                        done{false};
+    };
+
+    /**
+     * To emit the results of `chunkResp_' in chunks, as many rows at a time as
+     * the `flowControl_' has room for, waiting for the room if there is none.
+     */
+    void emitChunks();
+
     /**
      * To setup an intermediate representation of the execution result,
      * which is about to be piped to the next executor.
+     * If `pos' is given, it's resumed from and at most `maxRows' rows are set up if not 0.
      */
-    bool setupInterimResult(RpcResponse &&rpcResp, std::unique_ptr<InterimResult> &result);
+    bool setupInterimResult(RpcResponse &rpcResp,
+                            std::unique_ptr<InterimResult> &result,
+                            FinalPosition *pos = nullptr,
+                            size_t maxRows = 0);
 
     /**
      * To setup the header of the execution result, i.e. the column names.
@@ -152,10 +214,15 @@ private:
     /**
      * To iterate on the final data collection, and evaluate the filter and yield columns.
      * For each row that matches the filter, `cb' would be invoked.
+     * If `pos' is given, the iteration is resumed from it, and stops there again once
+     * `maxRows' rows are produced if `maxRows' is not 0, or sets `pos->done' at the end.
      */
     using Callback = std::function<void(std::vector<VariantType>,
                                    std::vector<nebula::cpp2::SupportedType>)>;
-    bool processFinalResult(RpcResponse &rpcResp, Callback cb) const;
+    bool processFinalResult(RpcResponse &rpcResp,
+                            Callback cb,
+                            FinalPosition *pos = nullptr,
+                            size_t maxRows = 0) const;
 
     /**
      * A container to hold the mapping from vertex id to its properties, used for lookups
@@ -163,14 +230,17 @@ private:
      */
     class VertexHolder final {
     public:
+        using VData = std::tuple<std::shared_ptr<ResultSchemaProvider>, std::string>;
+
         OptVariantType getDefaultProp(TagID tid, const std::string &prop) const;
         OptVariantType get(VertexID id, TagID tid, const std::string &prop) const;
+        // The schema and the row of the tag, nullptr if the vertex has no such tag
+        const VData* find(VertexID id, TagID tid) const;
         void add(const storage::cpp2::QueryResponse &resp);
         nebula::cpp2::SupportedType getDefaultPropType(TagID tid, const std::string &prop) const;
         nebula::cpp2::SupportedType getType(VertexID id, TagID tid, const std::string &prop);
 
     private:
-        using VData = std::tuple<std::shared_ptr<ResultSchemaProvider>, std::string>;
         std::unordered_map<VertexID, std::unordered_map<TagID, VData>> data_;
     };
 
@@ -216,6 +286,101 @@ private:
         std::unordered_map<EdgeType, std::shared_ptr<ResultSchemaProvider>> schemas_;
     };
 
+    using TagSchemas = std::unordered_map<TagID, std::shared_ptr<ResultSchemaProvider>>;
+    using EdgeSchemas = std::unordered_map<EdgeType, std::shared_ptr<ResultSchemaProvider>>;
+    using TagReaders = std::unordered_map<TagID, std::unique_ptr<RowReader>>;
+
+    /**
+     * A WHERE or YIELD expression in the compiled form. Its slots are bound to where the
+     * props are read from, i.e. the fields of the edge row, the tag rows of the src and dst,
+     * or the interim result. The bindings are resolved once for the edges of each type in
+     * a response, so that no getter is called and no field is boxed into a variant per row,
+     * except for the interim results and the reversely traversed edges.
+     */
+    class CompiledColumn final {
+    public:
+        // The types of the props are tracked for yield columns only
+        CompiledColumn(const GoExecutor *executor,
+                       const CompiledExpression *compiled,
+                       bool trackType);
+
+        void bind(EdgeType edgeType,
+                  const ResultSchemaProvider *edgeSchema,
+                  const EdgeSchemas &edgeSchemas,
+                  const TagSchemas &tagSchemas);
+
+        /**
+         * Load all slots for the edge row of srcId, srcTags are the tag rows of srcId.
+         */
+        Status load(VertexID srcId, const RowReader *edge, const TagReaders &srcTags);
+
+        CompiledExpression::FilterResult filter() const {
+            return compiled_->filter(slots_.data());
+        }
+
+        OptVariantType eval() const {
+            return compiled_->eval(slots_.data());
+        }
+
+        /**
+         * The type of the column, i.e. the one of the prop loaded last, same as the getters.
+         */
+        nebula::cpp2::SupportedType type() const;
+
+    private:
+        struct Binding {
+            enum class Type : uint8_t {
+                kError,
+                // The value is fixed, e.g. the default value of a missing prop
+                kConstant,
+                kEdgeProp,
+                kReverseEdgeProp,
+                kSrcTagProp,
+                kDstTagProp,
+                kInterimProp,
+            };
+
+            Type                            type{Type::kError};
+            const CompiledExpression::Slot *slot{nullptr};
+            TagID                           tagId{0};
+            EdgeType                        edgeType{0};
+            // The field index in the row, for the dst tag props it's resolved on `schema'
+            int64_t                         index{-1};
+            const meta::SchemaProviderIf   *schema{nullptr};
+            Status                          status;
+            // The constant, or the value loaded for the current row if it's not read from
+            // a row directly, the slot refers to it
+            OptVariantType                  value;
+            // If the default value of the prop has been loaded into `value'
+            bool                            hasDefault{false};
+            // If the src tag prop of the current row is the default value
+            bool                            srcMissing{false};
+            // For the interim props, the src the value is loaded for
+            VertexID                        srcId{0};
+            bool                            loaded{false};
+            nebula::cpp2::SupportedType     propType{nebula::cpp2::SupportedType::UNKNOWN};
+        };
+
+        Status loadSlot(Binding &binding,
+                        TypedValue &slot,
+                        VertexID srcId,
+                        const RowReader *edge,
+                        const TagReaders &srcTags);
+
+        StatusOr<VertexID> dstId(const RowReader *edge) const;
+
+    private:
+        const GoExecutor               *executor_{nullptr};
+        const CompiledExpression       *compiled_{nullptr};
+        bool                            trackType_{false};
+        std::vector<Binding>            bindings_;
+        std::vector<TypedValue>         slots_;
+        // The index of _dst in the edge row
+        int64_t                         dstIndex_{-1};
+        // The edge schema, to get the default value of the src tag props which are missing
+        const ResultSchemaProvider     *edgeSchema_{nullptr};
+    };
+
     OptVariantType getPropFromInterim(VertexID id, const std::string &prop) const;
 
     nebula::cpp2::SupportedType getPropTypeFromInterim(const std::string &prop) const;
@@ -238,6 +403,8 @@ private:
     std::string                                *colname_{nullptr};
     std::unique_ptr<WhereWrapper>               whereWrapper_;
     std::vector<YieldColumn*>                   yields_;
+    // The compiled yields_, nullptr for the ones not compilable
+    std::vector<std::unique_ptr<CompiledExpression>> compiledYields_;
     std::unique_ptr<YieldClauseWrapper>         yieldClauseWrapper_;
     bool                                        distinct_{false};
     bool                                        distinctPushDown_{false};
@@ -250,6 +417,14 @@ private:
     std::unique_ptr<EdgeHolder>                 edgeHolder_;
     std::unique_ptr<VertexBackTracker>          backTracker_;
     std::unique_ptr<cpp2::ExecutionResponse>    resp_;
+    // States for stepping out in batches
+    std::vector<storage::cpp2::PropDef>         batchReturns_;
+    std::string                                 batchFilter_;
+    size_t                                      nextBatch_{0};
+    folly::Optional<folly::SemiFuture<RpcResponse>> pendingBatch_;
+    // States for emitting the results of a response in chunks
+    std::unique_ptr<RpcResponse>                chunkResp_;
+    FinalPosition                               chunkPos_;
     // The name of Tag or Edge, index of prop in data
     using SchemaPropIndex = std::unordered_map<std::pair<std::string, std::string>, int64_t>;
 };
@@ -13,6 +13,22 @@ DEFINE_int32(client_idle_timeout_secs, 0,
 DEFINE_int32(session_idle_timeout_secs, 600,
                 "Seconds before we expire the idle sessions, 0 for infinite");
 DEFINE_int32(session_reclaim_interval_secs, 10, "Period we try to reclaim expired sessions");
+DEFINE_int32(session_sentence_cache_capacity, 64,
+                "Number of parsed queries cached in each session, 0 to disable the cache");
+DEFINE_int32(max_prepared_statements_per_session, 1024,
+                "Max number of prepared statements in each session, "
+                "the least recently used one is deallocated when exceeded");
+DEFINE_int32(max_cursors_per_session, 16,
+                "Max number of open result cursors in each session, "
+                "the oldest one is closed when exceeded");
+DEFINE_int32(max_cursor_rows_per_session, 1000000,
+                "Max number of rows kept by the cursors of each session, "
+                "the oldest cursors are closed when exceeded");
+DEFINE_int32(max_cursor_memory_mb, 1024,
+                "Approximate max memory held by the cursors of all sessions, "
+                "a query fails if its rows could not be kept within it");
+DEFINE_int32(cursor_idle_timeout_secs, 600,
+                "Cursors not fetched for so long are closed");
 DEFINE_int32(num_netio_threads, 0,
                 "Number of networking threads, 0 for number of physical CPU cores");
 DEFINE_int32(num_accept_threads, 1, "Number of threads to accept incoming connections");
@@ -22,6 +38,23 @@ DEFINE_int32(listen_backlog, 1024, "Backlog of the listen socket");
 DEFINE_string(listen_netdev, "any", "The network device to listen on");
 DEFINE_string(pid_file, "pids/nebula-graphd.pid", "File to hold the process id");
 
+DEFINE_bool(enable_concurrent_sentences, true,
+                "Whether to execute the independent sentences of a query concurrently");
+DEFINE_int32(pipe_batch_size, 0,
+                "Number of starting vertices per batch when streaming results "
+                "through the pipes, 0 to disable the streaming");
+DEFINE_int32(group_by_partitions, 4,
+                "Max number of partitions aggregated in parallel by GROUP BY");
+DEFINE_int32(min_rows_per_group_by_partition, 100000,
+                "Min number of input rows of each partition aggregated by GROUP BY");
+DEFINE_bool(enable_neighbor_cache, false,
+                "Whether to cache the neighbors of the vertices expanded by GO");
+DEFINE_int32(neighbor_cache_capacity, 100000, "Max number of vertices in the neighbor cache");
+DEFINE_int32(neighbor_cache_bucket_exp, 4, "Exponent of the number of the cache buckets");
+DEFINE_int32(neighbor_cache_ttl_ms, 1000,
+                "Time to live of the cached neighbors, which bounds the staleness "
+                "of the changes made through the other graphd");
+
 DEFINE_bool(redirect_stdout, true, "Whether to redirect stdout and stderr to separate files");
 DEFINE_string(stdout_log_file, "graphd-stdout.log", "Destination filename of stdout");
 DEFINE_string(stderr_log_file, "graphd-stderr.log", "Destination filename of stderr");
@@ -13,6 +13,12 @@ DECLARE_int32(port);
 DECLARE_int32(client_idle_timeout_secs);
 DECLARE_int32(session_idle_timeout_secs);
 DECLARE_int32(session_reclaim_interval_secs);
+DECLARE_int32(session_sentence_cache_capacity);
+DECLARE_int32(max_prepared_statements_per_session);
+DECLARE_int32(max_cursors_per_session);
+DECLARE_int32(max_cursor_rows_per_session);
+DECLARE_int32(max_cursor_memory_mb);
+DECLARE_int32(cursor_idle_timeout_secs);
 DECLARE_int32(num_netio_threads);
 DECLARE_int32(num_accept_threads);
 DECLARE_int32(num_worker_threads);
@@ -20,6 +26,14 @@ DECLARE_bool(reuse_port);
 DECLARE_int32(listen_backlog);
 DECLARE_string(listen_netdev);
 DECLARE_string(pid_file);
+DECLARE_bool(enable_concurrent_sentences);
+DECLARE_int32(pipe_batch_size);
+DECLARE_int32(group_by_partitions);
+DECLARE_int32(min_rows_per_group_by_partition);
+DECLARE_bool(enable_neighbor_cache);
+DECLARE_int32(neighbor_cache_capacity);
+DECLARE_int32(neighbor_cache_bucket_exp);
+DECLARE_int32(neighbor_cache_ttl_ms);
 
 DECLARE_bool(redirect_stdout);
 DECLARE_string(stdout_log_file);
@@ -10,6 +10,7 @@
 #include "graph/RequestContext.h"
 #include "graph/SimpleAuthenticator.h"
 #include "storage/client/StorageClient.h"
+#include "parser/GQLParser.h"
 
 namespace nebula {
 namespace graph {
@@ -77,6 +78,167 @@ GraphService::future_execute(int64_t sessionId, const std::string& query) {
 }
 
 
+folly::Future<cpp2::PrepareResponse>
+GraphService::future_prepare(int64_t sessionId, const std::string& query) {
+    RequestContext<cpp2::PrepareResponse> ctx;
+    ctx.setQuery(query);
+    auto future = ctx.future();
+    do {
+        auto session = sessionManager_->findSession(sessionId);
+        if (!session.ok()) {
+            FLOG_ERROR("Session not found, id[%ld]", sessionId);
+            ctx.resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+            ctx.resp().set_error_msg(session.status().toString());
+            break;
+        }
+        ctx.setSession(std::move(session).value());
+
+        // Parse the statement once here, the tree would be reused by the executions
+        auto key = ClientSession::normalize(query);
+        auto sentences = ctx.session()->takeSentences(key);
+        if (sentences == nullptr) {
+            auto result = GQLParser().parse(query);
+            if (!result.ok()) {
+                auto status = std::move(result).status();
+                ctx.resp().set_error_code(status.isStatementEmpty()
+                                          ? cpp2::ErrorCode::E_STATEMENT_EMTPY
+                                          : cpp2::ErrorCode::E_SYNTAX_ERROR);
+                ctx.resp().set_error_msg(status.toString());
+                break;
+            }
+            sentences = std::move(result).value();
+        }
+        auto paramNum = sentences->parameters().size();
+        ctx.session()->putSentences(key, std::move(sentences));
+
+        auto id = ctx.session()->addPreparedStatement(std::move(key));
+        if (!id.ok()) {
+            ctx.resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+            ctx.resp().set_error_msg(id.status().toString());
+            break;
+        }
+        ctx.resp().set_error_code(cpp2::ErrorCode::SUCCEEDED);
+        ctx.resp().set_statement_id(id.value());
+        ctx.resp().set_param_num(paramNum);
+    } while (false);
+
+    ctx.resp().set_latency_in_us(ctx.duration().elapsedInUSec());
+    ctx.finish();
+    return future;
+}
+
+
+folly::Future<cpp2::ExecutionResponse>
+GraphService::future_executePrepared(int64_t sessionId,
+                                     int64_t statementId,
+                                     const std::vector<cpp2::ColumnValue>& params) {
+    auto ctx = std::make_unique<RequestContext<cpp2::ExecutionResponse>>();
+    ctx->setRunner(getThreadManager());
+    auto future = ctx->future();
+    {
+        auto result = sessionManager_->findSession(sessionId);
+        if (!result.ok()) {
+            FLOG_ERROR("Session not found, id[%ld]", sessionId);
+            ctx->resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+            ctx->resp().set_error_msg(result.status().toString());
+            ctx->finish();
+            return future;
+        }
+        ctx->setSession(std::move(result).value());
+    }
+    auto query = ctx->session()->findPreparedStatement(statementId);
+    if (!query.ok()) {
+        ctx->resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+        ctx->resp().set_error_msg(query.status().toString());
+        ctx->finish();
+        return future;
+    }
+    ctx->setQuery(std::move(query).value());
+    ctx->setParameters(params);
+    executionEngine_->execute(std::move(ctx));
+
+    return future;
+}
+
+
+folly::Future<cpp2::ExecutionResponse>
+GraphService::future_executeWithCursor(int64_t sessionId,
+                                       const std::string& query,
+                                       int32_t chunkSize) {
+    auto ctx = std::make_unique<RequestContext<cpp2::ExecutionResponse>>();
+    ctx->setQuery(query);
+    ctx->setRunner(getThreadManager());
+    ctx->setChunkSize(chunkSize);
+    auto future = ctx->future();
+    {
+        auto result = sessionManager_->findSession(sessionId);
+        if (!result.ok()) {
+            FLOG_ERROR("Session not found, id[%ld]", sessionId);
+            ctx->resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+            ctx->resp().set_error_msg(result.status().toString());
+            ctx->finish();
+            return future;
+        }
+        ctx->setSession(std::move(result).value());
+    }
+    executionEngine_->execute(std::move(ctx));
+
+    return future;
+}
+
+
+folly::Future<cpp2::ExecutionResponse>
+GraphService::future_fetch(int64_t sessionId, int64_t cursorId) {
+    auto ctx = std::make_shared<RequestContext<cpp2::ExecutionResponse>>();
+    ctx->setRunner(getThreadManager());
+    auto future = ctx->future();
+    auto session = sessionManager_->findSession(sessionId);
+    if (!session.ok()) {
+        FLOG_ERROR("Session not found, id[%ld]", sessionId);
+        ctx->resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+        ctx->resp().set_error_msg(session.status().toString());
+        ctx->resp().set_latency_in_us(ctx->duration().elapsedInUSec());
+        ctx->finish();
+        return future;
+    }
+    ctx->setSession(std::move(session).value());
+
+    // The chunk may be still in production, wait for it without blocking the thread
+    auto cb = [ctx, cursorId] (StatusOr<ResultStream::Chunk> chunk) {
+        auto &resp = ctx->resp();
+        if (!chunk.ok()) {
+            ctx->session()->closeCursor(cursorId);
+            resp.set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+            resp.set_error_msg(chunk.status().toString());
+        } else {
+            resp.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+            if (!chunk.value().rows.empty()) {
+                resp.set_rows(std::move(chunk.value().rows));
+            }
+            if (chunk.value().more) {
+                resp.set_cursor_id(cursorId);
+            } else {
+                ctx->session()->closeCursor(cursorId);
+            }
+        }
+        resp.set_latency_in_us(ctx->duration().elapsedInUSec());
+        ctx->finish();
+    };
+    ctx->session()->fetchCursor(cursorId).via(ctx->runner()).thenValue(std::move(cb));
+    return future;
+}
+
+
+void GraphService::closeCursor(int64_t sessionId, int64_t cursorId) {
+    VLOG(2) << "Close cursor " << cursorId << " of session " << sessionId;
+    auto session = sessionManager_->findSession(sessionId);
+    if (!session.ok()) {
+        return;
+    }
+    session.value()->closeCursor(cursorId);
+}
+
+
 const char* GraphService::getErrorStr(cpp2::ErrorCode result) {
     switch (result) {
     case cpp2::ErrorCode::SUCCEEDED:
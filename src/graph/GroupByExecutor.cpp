@@ -7,6 +7,7 @@
 #include "base/Base.h"
 #include "graph/GroupByExecutor.h"
 #include "graph/AggregateFunction.h"
+#include "graph/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -65,6 +66,11 @@ Status GroupByExecutor::prepareYield() {
             LOG(ERROR) << status;
             return status;
         }
+        auto kind = AggregateHashTable::toAggKind(col->getFunName());
+        if (!kind.ok()) {
+            return kind.status();
+        }
+        aggKinds_.emplace_back(kind.value());
         yieldCols_.emplace_back(col);
 
         if (col->alias() != nullptr) {
@@ -174,6 +180,24 @@ Status GroupByExecutor::checkAll() {
             return Status::SyntaxError("Can't support variableExpression");
         }
     }
+
+    // The input properties are read from the rows directly, without evaluation
+    auto toIndex = [this] (YieldColumn *col) -> int64_t {
+        if (!col->expr()->isInputExpression()) {
+            return -1;
+        }
+        auto *prop = static_cast<InputPropertyExpression*>(col->expr())->prop();
+        auto findIt = schemaMap_.find(*prop);
+        return findIt == schemaMap_.end() ? -1 : findIt->second;
+    };
+    groupIndexes_.clear();
+    for (auto *col : groupCols_) {
+        groupIndexes_.emplace_back(toIndex(col));
+    }
+    yieldIndexes_.clear();
+    for (auto *col : yieldCols_) {
+        yieldIndexes_.emplace_back(toIndex(col));
+    }
     return Status::OK();
 }
 
@@ -192,126 +216,142 @@ void GroupByExecutor::execute() {
         return;
     }
 
-    status = groupingData();
-    if (!status.ok()) {
-        doError(std::move(status));
+    size_t partitions = std::min<size_t>(
+            std::max(FLAGS_group_by_partitions, 1),
+            rows_.size() / std::max(FLAGS_min_rows_per_group_by_partition, 1));
+    if (partitions <= 1) {
+        AggregateHashTable table(aggKinds_);
+        status = aggregate(0, rows_.size(), table);
+        if (!status.ok()) {
+            doError(std::move(status));
+            return;
+        }
+        finishAggregate(table);
         return;
     }
 
-    status = generateOutputSchema();
-    if (!status.ok()) {
-        doError(std::move(status));
-        return;
+    // Aggregate the partitions in parallel, then merge the partial results
+    using PartialResult = StatusOr<std::unique_ptr<AggregateHashTable>>;
+    auto *runner = ectx()->rctx()->runner();
+    std::vector<folly::Future<PartialResult>> futures;
+    auto step = (rows_.size() + partitions - 1) / partitions;
+    for (size_t begin = 0; begin < rows_.size(); begin += step) {
+        auto end = std::min(begin + step, rows_.size());
+        futures.emplace_back(folly::via(runner, [this, begin, end] () -> PartialResult {
+            auto table = std::make_unique<AggregateHashTable>(aggKinds_);
+            auto ret = aggregate(begin, end, *table);
+            if (!ret.ok()) {
+                return ret;
+            }
+            return std::move(table);
+        }));
     }
 
-    if (onResult_) {
-        auto ret = setupInterimResult();
-        if (!ret.ok()) {
-            doError(std::move(ret).status());
-            return;
+    auto cb = [this] (auto &&results) {
+        std::unique_ptr<AggregateHashTable> table;
+        for (auto &result : results) {
+            if (result.hasException()) {
+                LOG(ERROR) << "Exception caught: " << result.exception().what();
+                doError(Status::Error("Internal error."));
+                return;
+            }
+            auto &partial = result.value();
+            if (!partial.ok()) {
+                doError(partial.status());
+                return;
+            }
+            if (table == nullptr) {
+                table = std::move(partial).value();
+            } else {
+                table->merge(std::move(*partial.value()));
+            }
         }
-        onResult_(std::move(ret).value());
-    }
-
-    doFinish(Executor::ProcessControl::kNext);
+        finishAggregate(*table);
+    };
+    auto error = [this] (auto &&e) {
+        LOG(ERROR) << "Exception caught: " << e.what();
+        doError(Status::Error("Internal error."));
+    };
+    folly::collectAll(std::move(futures)).via(runner).thenValue(cb).thenError(error);
 }
 
 
-Status GroupByExecutor::groupingData() {
-    using FunCols = std::vector<std::shared_ptr<AggFun>>;
-    // key : the column values of group by, val: function table of aggregated columns
-    using GroupData = std::unordered_map<ColVals, FunCols, ColsHasher>;
-
-    GroupData data;
+Status GroupByExecutor::aggregate(size_t begin, size_t end, AggregateHashTable &table) const {
     Getters getters;
-    for (auto& it : rows_) {
-        ColVals groupVals;
-        FunCols calVals;
-
-        // Firstly: group the cols
-        for (auto &col : groupCols_) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string & prop) -> OptVariantType {
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-
-            auto eval = col->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
+    const cpp2::RowValue *row = nullptr;
+    cpp2::ColumnValue::Type valType;
+    getters.getInputProp = [&] (const std::string &prop) -> OptVariantType {
+        auto indexIt = schemaMap_.find(prop);
+        if (indexIt == schemaMap_.end()) {
+            LOG(ERROR) << prop <<  " is nonexistent";
+            return Status::Error("%s is nonexistent", prop.c_str());
+        }
+        auto &val = row->columns[indexIt->second];
+        valType = val.getType();
+        return toVariantType(val);
+    };
+    auto evalColumn = [&] (YieldColumn *col) -> StatusOr<cpp2::ColumnValue> {
+        valType = cpp2::ColumnValue::Type::__EMPTY__;
+        auto eval = col->expr()->eval(getters);
+        if (!eval.ok()) {
+            return eval.status();
+        }
+        return toColumnValue(eval.value(), valType);
+    };
+
+    std::string key;
+    for (auto i = begin; i < end; i++) {
+        row = &rows_[i];
+        key.clear();
+        for (auto j = 0u; j < groupCols_.size(); j++) {
+            if (groupIndexes_[j] >= 0) {
+                AggregateHashTable::encodeValue(row->columns[groupIndexes_[j]], key);
+                continue;
             }
-
-            auto cVal = toColumnValue(eval.value(), valType);
+            auto cVal = evalColumn(groupCols_[j]);
             if (!cVal.ok()) {
                 return cVal.status();
             }
-            groupVals.vec.emplace_back(std::move(cVal).value());
-        }
-
-        auto findIt = data.find(groupVals);
-
-        // Secondly: get the value of the aggregated column
-
-        // Get all aggregation function
-        if (findIt == data.end()) {
-            for (auto &col : yieldCols_) {
-                auto funPtr = funVec[col->getFunName()]();
-                calVals.emplace_back(std::move(funPtr));
-            }
-        } else {
-            calVals = findIt->second;
+            AggregateHashTable::encodeValue(cVal.value(), key);
         }
 
-        // Apply value
-        auto i = 0u;
-        for (auto &col : calVals) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string &prop) -> OptVariantType{
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-            auto eval = yieldCols_[i]->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
+        auto *states = table.findOrInsert(key);
+        for (auto j = 0u; j < yieldCols_.size(); j++) {
+            if (yieldIndexes_[j] >= 0) {
+                table.apply(states, j, row->columns[yieldIndexes_[j]]);
+                continue;
             }
-
-            auto cVal = toColumnValue(std::move(eval).value(), valType);
+            auto cVal = evalColumn(yieldCols_[j]);
             if (!cVal.ok()) {
                 return cVal.status();
             }
-            col->apply(cVal.value());
-            i++;
+            table.apply(states, j, cVal.value());
         }
+    }
 
-        if (findIt == data.end()) {
-            data.emplace(std::move(groupVals), std::move(calVals));
-        }
+    return Status::OK();
+}
+
+
+void GroupByExecutor::finishAggregate(AggregateHashTable &table) {
+    rows_ = table.getRows();
+
+    auto status = generateOutputSchema();
+    if (!status.ok()) {
+        doError(std::move(status));
+        return;
     }
 
-    // Generate result data
-    rows_.clear();
-    for (auto& item : data) {
-        std::vector<cpp2::ColumnValue> row;
-        for (auto& col : item.second) {
-            row.emplace_back(col->getResult());
+    if (onResult_) {
+        auto ret = setupInterimResult();
+        if (!ret.ok()) {
+            doError(std::move(ret).status());
+            return;
         }
-        rows_.emplace_back();
-        rows_.back().set_columns(std::move(row));
+        onResult_(std::move(ret).value());
     }
 
-    return Status::OK();
+    doFinish(Executor::ProcessControl::kNext);
 }
 
 
@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include "graph/TraverseExecutor.h"
+#include "graph/AggregateHashTable.h"
 
 namespace nebula {
 namespace graph {
@@ -34,7 +35,9 @@ private:
     Status prepareYield();
     Status checkAll();
 
-    Status groupingData();
+    // Aggregate rows_[begin, end) into the table
+    Status aggregate(size_t begin, size_t end, AggregateHashTable &table) const;
+    void finishAggregate(AggregateHashTable &table);
     Status generateOutputSchema();
 
     std::vector<std::string> getResultColumnNames() const;
@@ -49,6 +52,10 @@ private:
 
     std::vector<YieldColumn*>                                  groupCols_;
     std::vector<YieldColumn*>                                  yieldCols_;
+    std::vector<AggKind>                                       aggKinds_;
+    // The input column index of each group or yield column, -1 if it's not an input property
+    std::vector<int64_t>                                       groupIndexes_;
+    std::vector<int64_t>                                       yieldIndexes_;
     std::shared_ptr<SchemaWriter>                              resultSchema_{nullptr};
     std::unique_ptr<ExpressionContext>                         expCtx_;
     // key: alias , value input name
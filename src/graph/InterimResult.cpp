@@ -71,6 +71,30 @@ StatusOr<std::vector<VertexID>> InterimResult::getDistinctVIDs(const std::string
     return result;
 }
 
+size_t InterimResult::rowCount() const {
+    if (!vids_.empty()) {
+        return vids_.size();
+    }
+    if (!hasData()) {
+        return 0;
+    }
+    size_t count = 0;
+    auto iter = rsReader_->begin();
+    while (iter) {
+        ++count;
+        ++iter;
+    }
+    return count;
+}
+
+size_t InterimResult::memoryUsage() const {
+    size_t size = vids_.size() * sizeof(VertexID);
+    if (rsWriter_ != nullptr) {
+        size += rsWriter_->data().size();
+    }
+    return size;
+}
+
 StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
     if (!hasData()) {
         return Status::Error("Interim has no data.");
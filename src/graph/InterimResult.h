@@ -73,6 +73,11 @@ public:
 
     StatusOr<std::vector<cpp2::RowValue>> getRows() const;
 
+    size_t rowCount() const;
+
+    // Size of the encoded rows and the vids
+    size_t memoryUsage() const;
+
     class InterimResultIndex;
     StatusOr<std::unique_ptr<InterimResultIndex>>
     buildIndex(const std::string &vidColumn) const;
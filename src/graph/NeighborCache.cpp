@@ -0,0 +1,143 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/NeighborCache.h"
+#include "stats/StatsManager.h"
+#include "time/WallClock.h"
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace nebula {
+namespace graph {
+
+NeighborCache::NeighborCache(size_t capacity, uint32_t bucketsExp, int64_t ttlMs)
+    : cache_(capacity, bucketsExp), ttlMs_(ttlMs) {
+    hitsStatId_ = stats::StatsManager::registerStats("graph_neighbor_cache_hits");
+    missesStatId_ = stats::StatsManager::registerStats("graph_neighbor_cache_misses");
+}
+
+
+// static
+std::string NeighborCache::signature(const std::vector<EdgeType> &edgeTypes,
+                                     const std::string &filter,
+                                     const std::vector<storage::cpp2::PropDef> &returns) {
+    std::string sig;
+    auto edgeNum = static_cast<uint32_t>(edgeTypes.size());
+    sig.append(reinterpret_cast<const char*>(&edgeNum), sizeof(edgeNum));
+    sig.append(reinterpret_cast<const char*>(edgeTypes.data()),
+               edgeTypes.size() * sizeof(EdgeType));
+    auto filterSize = static_cast<uint32_t>(filter.size());
+    sig.append(reinterpret_cast<const char*>(&filterSize), sizeof(filterSize));
+    sig.append(filter);
+    for (auto &prop : returns) {
+        apache::thrift::CompactSerializer::serialize(prop, &sig);
+    }
+    return sig;
+}
+
+
+// static
+std::string NeighborCache::key(GraphSpaceID space, const std::string &signature, VertexID vid) {
+    std::string key;
+    key.reserve(sizeof(GraphSpaceID) + sizeof(VertexID) + signature.size());
+    key.append(reinterpret_cast<const char*>(&space), sizeof(GraphSpaceID));
+    key.append(reinterpret_cast<const char*>(&vid), sizeof(VertexID));
+    key.append(signature);
+    return key;
+}
+
+
+int64_t NeighborCache::version(GraphSpaceID space) const {
+    folly::RWSpinLock::ReadHolder rh(&lock_);
+    auto it = versions_.find(space);
+    return it == versions_.end() ? 0 : it->second;
+}
+
+
+void NeighborCache::invalidate(GraphSpaceID space) {
+    folly::RWSpinLock::WriteHolder wh(&lock_);
+    versions_[space]++;
+}
+
+
+std::vector<storage::cpp2::QueryResponse>
+NeighborCache::get(GraphSpaceID space,
+                   const std::string &signature,
+                   const std::vector<VertexID> &vids,
+                   std::vector<VertexID> &misses) {
+    auto now = time::WallClock::fastNowInMilliSec();
+    auto current = version(space);
+    std::vector<storage::cpp2::QueryResponse> resps;
+    // The response of each schemas
+    std::unordered_map<const storage::cpp2::QueryResponse*, size_t> index;
+    size_t hits = 0;
+    for (auto vid : vids) {
+        auto k = key(space, signature, vid);
+        auto result = cache_.get(k);
+        if (!result.ok()) {
+            misses.emplace_back(vid);
+            continue;
+        }
+        auto neighbors = std::move(result).value();
+        if (neighbors->version != current || neighbors->expireAt <= now) {
+            cache_.evict(k);
+            misses.emplace_back(vid);
+            continue;
+        }
+        hits++;
+        auto it = index.find(neighbors->schemas.get());
+        if (it == index.end()) {
+            it = index.emplace(neighbors->schemas.get(), resps.size()).first;
+            resps.emplace_back(*neighbors->schemas);
+            resps.back().__isset.vertices = true;
+        }
+        resps[it->second].vertices.emplace_back(neighbors->vertex);
+    }
+    stats::StatsManager::addValue(hitsStatId_, hits);
+    stats::StatsManager::addValue(missesStatId_, misses.size());
+    return resps;
+}
+
+
+void NeighborCache::put(GraphSpaceID space,
+                        const std::string &signature,
+                        int64_t version,
+                        const std::vector<storage::cpp2::QueryResponse> &responses) {
+    if (version != this->version(space)) {
+        // The space has been modified since the request was sent
+        return;
+    }
+    auto expireAt = time::WallClock::fastNowInMilliSec() + ttlMs_;
+    for (auto &resp : responses) {
+        if (resp.get_vertices() == nullptr || resp.vertices.empty()) {
+            continue;
+        }
+        auto schemas = std::make_shared<storage::cpp2::QueryResponse>();
+        schemas->set_result(resp.result);
+        schemas->result.failed_codes.clear();
+        schemas->result.set_latency_in_us(0);
+        if (resp.get_vertex_schema() != nullptr) {
+            schemas->set_vertex_schema(resp.vertex_schema);
+        }
+        if (resp.get_edge_schema() != nullptr) {
+            schemas->set_edge_schema(resp.edge_schema);
+        }
+        for (auto &vdata : resp.vertices) {
+            auto neighbors = std::make_shared<Neighbors>();
+            neighbors->version = version;
+            neighbors->expireAt = expireAt;
+            neighbors->schemas = schemas;
+            neighbors->vertex = vdata;
+            // The insertion doesn't replace the stale one
+            auto k = key(space, signature, vdata.get_vertex_id());
+            cache_.evict(k);
+            cache_.insert(std::move(k), std::move(neighbors));
+        }
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
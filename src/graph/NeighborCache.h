@@ -0,0 +1,83 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_NEIGHBORCACHE_H_
+#define GRAPH_NEIGHBORCACHE_H_
+
+#include "base/Base.h"
+#include "base/ConcurrentLRUCache.h"
+#include <folly/RWSpinLock.h>
+#include "gen-cpp2/storage_types.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * A size bounded cache of the getNeighbors results of each vertex in graphd, so that
+ * the repeated expansions of the same vertices, e.g. the hubs, don't go to storage.
+ *
+ * The results of a vertex are cached per request signature, i.e. the edge types,
+ * the returned props and the pushed down filter, and expire after a TTL.
+ * Besides, all the results of a space are invalidated once the space is
+ * modified through this graphd.
+ */
+class NeighborCache final {
+public:
+    NeighborCache(size_t capacity, uint32_t bucketsExp, int64_t ttlMs);
+
+    static std::string signature(const std::vector<EdgeType> &edgeTypes,
+                                 const std::string &filter,
+                                 const std::vector<storage::cpp2::PropDef> &returns);
+
+    /**
+     * The version of the space, which should be taken before sending the request,
+     * and passed to `put' along with the results.
+     */
+    int64_t version(GraphSpaceID space) const;
+
+    /**
+     * Return the cached results of the vertices, which are grouped into the responses
+     * by their schemas. The vertices not cached are put into `misses'.
+     */
+    std::vector<storage::cpp2::QueryResponse> get(GraphSpaceID space,
+                                                  const std::string &signature,
+                                                  const std::vector<VertexID> &vids,
+                                                  std::vector<VertexID> &misses);
+
+    void put(GraphSpaceID space,
+             const std::string &signature,
+             int64_t version,
+             const std::vector<storage::cpp2::QueryResponse> &responses);
+
+    /**
+     * Invalidate all the results of the space, called after the space is modified.
+     */
+    void invalidate(GraphSpaceID space);
+
+private:
+    struct Neighbors {
+        int64_t                                             version;
+        int64_t                                             expireAt;
+        // Only the schemas, shared by the vertices in the same response
+        std::shared_ptr<const storage::cpp2::QueryResponse> schemas;
+        storage::cpp2::VertexData                           vertex;
+    };
+
+    static std::string key(GraphSpaceID space, const std::string &signature, VertexID vid);
+
+private:
+    ConcurrentLRUCache<std::string, std::shared_ptr<const Neighbors>>  cache_;
+    const int64_t                                   ttlMs_;
+    mutable folly::RWSpinLock                       lock_;
+    std::unordered_map<GraphSpaceID, int64_t>       versions_;
+    int32_t                                         hitsStatId_{0};
+    int32_t                                         missesStatId_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_NEIGHBORCACHE_H_
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/PipeExecutor.h"
+#include "graph/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -29,10 +30,8 @@ Status PipeExecutor::prepare() {
 
     auto onError = [this] (Status s) {
         /**
-         * TODO(dutor)
-         * If we allow concurrent execution of both sides, we must wait for all their
-         * internal on-fly async-requests' to arrive before call `onError_'.
-         * For the sake of simplicity, we don't allow the pipeline way for now.
+         * In the streaming mode, errors are reported by `onLeftDone' and `onRightBatchDone',
+         * after all the on-fly executions of both sides are done.
          */
         onError_(std::move(s));
     };
@@ -41,8 +40,12 @@ Status PipeExecutor::prepare() {
     {
         auto onFinish = [this] (Executor::ProcessControl ctr) {
             UNUSED(ctr);
+            if (streaming_) {
+                onLeftDone(Status::OK());
+                return;
+            }
             // Start executing `right_' when `left_' is finished.
-            right_->execute();
+            right_->run();
         };
         left_->setOnFinish(onFinish);
 
@@ -50,11 +53,25 @@ Status PipeExecutor::prepare() {
             // Feed results from `left_' to `right_'
             // result should never be null, it should give the column names at least.
             DCHECK(result != nullptr);
+            if (streaming_) {
+                onLeftBatch(std::move(result));
+                return;
+            }
+            if (right_->profile() != nullptr) {
+                right_->profile()->addInput(*result);
+            }
             right_->feedResult(std::move(result));
         };
         left_->setOnResult(onResult);
 
-        left_->setOnError(onError);
+        auto onLeftError = [this] (Status s) {
+            if (streaming_) {
+                onLeftDone(std::move(s));
+                return;
+            }
+            onError_(std::move(s));
+        };
+        left_->setOnError(onLeftError);
     }
     {
         auto onFinish = [this] (Executor::ProcessControl ctr) {
@@ -93,6 +110,13 @@ Status PipeExecutor::prepare() {
         return status;
     }
 
+    streaming_ = FLAGS_pipe_batch_size > 0
+              && left_->canEmitBatches()
+              && right_->canConsumeBatches();
+    if (streaming_) {
+        left_->setEmitBatches(true);
+        left_->setFlowControl(this);
+    }
 
     return Status::OK();
 }
@@ -113,7 +137,7 @@ Status PipeExecutor::syntaxPreCheck() {
 }
 
 void PipeExecutor::execute() {
-    left_->execute();
+    left_->run();
 }
 
 
@@ -128,8 +152,233 @@ void PipeExecutor::setupResponse(cpp2::ExecutionResponse &resp) {
      * is the right most one, i.e. `onResult_' wasn't set.
      */
     DCHECK(!onResult_);
+    if (streaming_) {
+        resp.set_column_names(std::move(colNames_));
+        if (!rows_.empty()) {
+            resp.set_rows(std::move(rows_));
+        }
+        return;
+    }
     right_->setupResponse(resp);
 }
 
+
+void PipeExecutor::onLeftBatch(std::unique_ptr<InterimResult> result) {
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (!status_.ok()) {
+            // Drop the batches after any failure
+            return;
+        }
+        batches_.emplace_back(std::move(result));
+        if (rightRunning_) {
+            return;
+        }
+        rightRunning_ = true;
+    }
+    executeNextBatch();
+}
+
+
+void PipeExecutor::onLeftDone(Status status) {
+    bool finish = false;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        leftDone_ = true;
+        if (!status.ok() && status_.ok()) {
+            status_ = std::move(status);
+        }
+        // The right side is always running if there are pending batches
+        finish = !rightRunning_;
+    }
+    if (finish) {
+        finishStreaming();
+    }
+}
+
+
+void PipeExecutor::executeNextBatch() {
+    std::unique_ptr<InterimResult> batch;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        DCHECK(!batches_.empty());
+        batch = std::move(batches_.front());
+        batches_.pop_front();
+    }
+    releaseLeft(Status::OK());
+
+    auto right = makeTraverseExecutor(sentence_->right());
+    right->setOnFinish([this] (Executor::ProcessControl ctr) {
+        UNUSED(ctr);
+        onRightBatchDone(Status::OK());
+    });
+    right->setOnError([this] (Status s) {
+        onRightBatchDone(std::move(s));
+    });
+    right->setOnResult([this] (std::unique_ptr<InterimResult> result) {
+        DCHECK(result != nullptr);
+        onRightBatchResult(std::move(result));
+    });
+    if (emitBatches_) {
+        right->setEmitBatches(right->canEmitBatches());
+        right->setFlowControl(flowControl_);
+    }
+
+    auto *executor = right.get();
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        current_ = std::move(right);
+    }
+    auto status = executor->prepare();
+    if (!status.ok()) {
+        onRightBatchDone(std::move(status));
+        return;
+    }
+    if (executor->profile() != nullptr) {
+        executor->profile()->addInput(*batch);
+    }
+    executor->feedResult(std::move(batch));
+    executor->run();
+}
+
+
+void PipeExecutor::onRightBatchResult(std::unique_ptr<InterimResult> result) {
+    if (emitBatches_) {
+        // Only one batch is executed at a time, so the results are emitted in order
+        onResult_(std::move(result));
+        return;
+    }
+
+    std::lock_guard<std::mutex> g(lock_);
+    colNames_ = result->getColNames();
+    if (!result->hasData()) {
+        return;
+    }
+    if (schema_ == nullptr) {
+        schema_ = result->schema();
+    }
+    auto rows = result->getRows();
+    if (!rows.ok()) {
+        if (status_.ok()) {
+            status_ = std::move(rows).status();
+        }
+        return;
+    }
+    rows_.insert(rows_.end(),
+                 std::make_move_iterator(rows.value().begin()),
+                 std::make_move_iterator(rows.value().end()));
+}
+
+
+void PipeExecutor::onRightBatchDone(Status status) {
+    bool next = false;
+    bool finish = false;
+    Status leftStatus;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (!status.ok() && status_.ok()) {
+            status_ = std::move(status);
+        }
+        rightRunning_ = false;
+        // We are probably on the stack of `current_', and we can't tell when the stack
+        // unwinds, so it's kept until the pipe is destroyed
+        retired_.emplace_back(std::move(current_));
+        if (!status_.ok()) {
+            batches_.clear();
+            leftStatus = status_;
+        }
+        if (!batches_.empty()) {
+            rightRunning_ = true;
+            next = true;
+        } else {
+            finish = leftDone_;
+        }
+    }
+    if (!leftStatus.ok()) {
+        releaseLeft(std::move(leftStatus));
+    }
+    if (next) {
+        // Execute the next batch on a new stack
+        ectx()->rctx()->runner()->add([this] () {
+            executeNextBatch();
+        });
+    } else if (finish) {
+        finishStreaming();
+    }
+}
+
+
+int64_t PipeExecutor::room() const {
+    std::lock_guard<std::mutex> g(lock_);
+    if (!status_.ok() || !batches_.empty()) {
+        return 0;
+    }
+    return -1;
+}
+
+
+void PipeExecutor::waitRoom(std::function<void(Status)> ready) {
+    Status status;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (status_.ok() && !batches_.empty()) {
+            DCHECK(!leftWaiter_);
+            leftWaiter_ = std::move(ready);
+            return;
+        }
+        status = status_;
+    }
+    ectx()->rctx()->runner()->add([ready = std::move(ready), status = std::move(status)] () {
+        ready(status);
+    });
+}
+
+
+void PipeExecutor::releaseLeft(Status status) {
+    std::function<void(Status)> waiter;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        waiter = std::move(leftWaiter_);
+        leftWaiter_ = nullptr;
+    }
+    if (!waiter) {
+        return;
+    }
+    ectx()->rctx()->runner()->add([waiter = std::move(waiter), status = std::move(status)] () {
+        waiter(status);
+    });
+}
+
+
+void PipeExecutor::finishStreaming() {
+    if (!status_.ok()) {
+        onError_(std::move(status_));
+        return;
+    }
+    if (emitBatches_) {
+        DCHECK(onFinish_);
+        onFinish_(Executor::ProcessControl::kNext);
+        return;
+    }
+    if (onResult_) {
+        std::unique_ptr<InterimResult> result;
+        if (rows_.empty()) {
+            result = std::make_unique<InterimResult>(std::move(colNames_));
+        } else {
+            auto merged = InterimResult::getInterim(schema_, rows_);
+            if (!merged.ok()) {
+                onError_(std::move(merged).status());
+                return;
+            }
+            result = std::move(merged).value();
+            result->setColNames(std::move(colNames_));
+            rows_.clear();
+        }
+        onResult_(std::move(result));
+    }
+    DCHECK(onFinish_);
+    onFinish_(Executor::ProcessControl::kNext);
+}
+
 }   // namespace graph
 }   // namespace nebula
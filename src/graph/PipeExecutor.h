@@ -13,7 +13,11 @@
 namespace nebula {
 namespace graph {
 
-class PipeExecutor final : public TraverseExecutor {
+/**
+ * In the streaming mode, the pipe is the flow control of `left_', which is held back
+ * while a batch is pending for the right side.
+ */
+class PipeExecutor final : public TraverseExecutor, public FlowControl {
 public:
     PipeExecutor(Sentence *sentence, ExecutionContext *ectx);
 
@@ -29,13 +33,57 @@ public:
 
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
+    bool canEmitBatches() const override {
+        return streaming_;
+    }
+
+    int64_t room() const override;
+
+    void waitRoom(std::function<void(Status)> ready) override;
+
 private:
     Status syntaxPreCheck();
 
+    /**
+     * In the streaming mode, `left_' emits its results in batches, and a new executor of
+     * the right sentence is executed on each batch, one batch at a time.
+     * So the right side could start while the left side is still in progress.
+     */
+    void onLeftBatch(std::unique_ptr<InterimResult> result);
+
+    void onLeftDone(Status status);
+
+    void executeNextBatch();
+
+    void onRightBatchResult(std::unique_ptr<InterimResult> result);
+
+    void onRightBatchDone(Status status);
+
+    void finishStreaming();
+
+    // Let `left_' go on if it's waiting for room
+    void releaseLeft(Status status);
+
 private:
     PipedSentence                              *sentence_{nullptr};
     std::unique_ptr<TraverseExecutor>           left_;
     std::unique_ptr<TraverseExecutor>           right_;
+    bool                                        streaming_{false};
+    // States of the streaming mode
+    mutable std::mutex                          lock_;
+    Status                                      status_;
+    bool                                        leftDone_{false};
+    bool                                        rightRunning_{false};
+    std::deque<std::unique_ptr<InterimResult>>  batches_;
+    // `left_' waiting for the pending batch to be taken
+    std::function<void(Status)>                 leftWaiter_;
+    std::unique_ptr<TraverseExecutor>           current_;
+    // The finished executors, kept until the pipe is destroyed since they may be on the stack
+    std::deque<std::unique_ptr<TraverseExecutor>> retired_;
+    // Results of all batches, if they are not emitted in batches
+    std::vector<std::string>                    colNames_;
+    std::shared_ptr<const meta::SchemaProviderIf> schema_;
+    std::vector<cpp2::RowValue>                 rows_;
 };
 
 }   // namespace graph
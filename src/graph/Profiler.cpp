@@ -0,0 +1,143 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/Profiler.h"
+#include "graph/InterimResult.h"
+#include "network/NetworkUtils.h"
+#include "time/WallClock.h"
+
+namespace nebula {
+namespace graph {
+
+void ExecutorProfile::setDescription(std::string description) {
+    std::lock_guard<std::mutex> g(lock_);
+    description_ = std::move(description);
+}
+
+
+void ExecutorProfile::start() {
+    auto now = time::WallClock::fastNowInMicroSec();
+    std::lock_guard<std::mutex> g(lock_);
+    if (startTime_ == 0) {
+        startTime_ = now;
+    }
+}
+
+
+void ExecutorProfile::finish() {
+    auto now = time::WallClock::fastNowInMicroSec();
+    std::lock_guard<std::mutex> g(lock_);
+    finishTime_ = std::max(finishTime_, now);
+}
+
+
+void ExecutorProfile::addInput(const InterimResult &input) {
+    auto rows = input.rowCount();
+    std::lock_guard<std::mutex> g(lock_);
+    rowsIn_ += rows;
+}
+
+
+void ExecutorProfile::addResult(const InterimResult &result) {
+    auto rows = result.rowCount();
+    auto bytes = result.memoryUsage();
+    std::lock_guard<std::mutex> g(lock_);
+    rowsOut_ += rows;
+    resultBytes_ += bytes;
+}
+
+
+void ExecutorProfile::addRowsOut(int64_t rows) {
+    std::lock_guard<std::mutex> g(lock_);
+    rowsOut_ += rows;
+}
+
+
+cpp2::RowValue ExecutorProfile::toRow(bool explain) const {
+    std::lock_guard<std::mutex> g(lock_);
+    std::vector<cpp2::ColumnValue> cols;
+    auto addInt = [&cols] (int64_t value) {
+        cols.emplace_back();
+        cols.back().set_integer(value);
+    };
+    auto addStr = [&cols] (std::string value) {
+        cols.emplace_back();
+        cols.back().set_str(std::move(value));
+    };
+
+    addInt(id_);
+    addInt(parent_);
+    addStr(name_);
+    addStr(description_);
+    if (!explain) {
+        // Not finished if the query failed
+        addInt(finishTime_ >= startTime_ ? finishTime_ - startTime_ : 0);
+        addInt(rowsIn_);
+        addInt(rowsOut_);
+        addInt(resultBytes_);
+        addInt(rpcs_);
+        addInt(bytesReceived_);
+        // The latency on storage / the latency observed by graphd, of each host
+        std::string latency;
+        for (auto &host : hostLatency_) {
+            if (!latency.empty()) {
+                latency += ", ";
+            }
+            latency += folly::stringPrintf("%s:%u: %ld/%ld",
+                                           network::NetworkUtils::intToIPv4(
+                                               host.first.first).c_str(),
+                                           host.first.second,
+                                           host.second.first,
+                                           host.second.second);
+        }
+        addStr(std::move(latency));
+    }
+
+    cpp2::RowValue row;
+    row.set_columns(std::move(cols));
+    return row;
+}
+
+
+ExecutorProfile* Profiler::getOrAdd(const ExecutorProfile *parent,
+                                    const Sentence *sentence,
+                                    std::string name) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = index_.find(sentence);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    auto id = static_cast<int64_t>(profiles_.size());
+    profiles_.emplace_back(id, parent == nullptr ? -1 : parent->id(), std::move(name));
+    auto *profile = &profiles_.back();
+    index_.emplace(sentence, profile);
+    return profile;
+}
+
+
+std::vector<std::string> Profiler::columnNames() const {
+    std::vector<std::string> names = {"id", "parent", "executor", "description"};
+    if (!explain_) {
+        names.insert(names.end(), {"wall_time_us", "rows_in", "rows_out", "result_bytes",
+                                   "storage_rpcs", "storage_bytes", "storage_latency_us"});
+    }
+    return names;
+}
+
+
+std::vector<cpp2::RowValue> Profiler::rows() const {
+    std::lock_guard<std::mutex> g(lock_);
+    std::vector<cpp2::RowValue> rows;
+    rows.reserve(profiles_.size());
+    for (auto &profile : profiles_) {
+        rows.emplace_back(profile.toRow(explain_));
+    }
+    return rows;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,126 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_PROFILER_H_
+#define GRAPH_PROFILER_H_
+
+#include "base/Base.h"
+#include "gen-cpp2/graph_types.h"
+#include "parser/Sentence.h"
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace nebula {
+namespace graph {
+
+class InterimResult;
+
+/**
+ * Statistics of one executor in a profiled query. It's thread safe, since it may be
+ * shared by the executors running concurrently.
+ */
+class ExecutorProfile final {
+public:
+    ExecutorProfile(int64_t id, int64_t parent, std::string name)
+        : id_(id), parent_(parent), name_(std::move(name)) {}
+
+    int64_t id() const {
+        return id_;
+    }
+
+    void setDescription(std::string description);
+
+    void start();
+
+    void finish();
+
+    // The inputs fed by the previous executor
+    void addInput(const InterimResult &input);
+
+    // The results sent to the next executor
+    void addResult(const InterimResult &result);
+
+    // The results sent to the client
+    void addRowsOut(int64_t rows);
+
+    /**
+     * Record a StorageRpcResponse, i.e. the RPCs, the latency of each host,
+     * and the size of the responses.
+     */
+    template <typename RpcResponse>
+    void addStorageResponse(RpcResponse &rpcResp) {
+        int64_t bytes = 0;
+        for (auto &resp : rpcResp.responses()) {
+            std::string buf;
+            apache::thrift::CompactSerializer::serialize(resp, &buf);
+            bytes += buf.size();
+        }
+        std::lock_guard<std::mutex> g(lock_);
+        rpcs_ += rpcResp.totalReqsSent();
+        bytesReceived_ += bytes;
+        for (auto &latency : rpcResp.hostLatency()) {
+            auto &total = hostLatency_[std::get<0>(latency)];
+            total.first += std::get<1>(latency);
+            total.second += std::get<2>(latency);
+        }
+    }
+
+    cpp2::RowValue toRow(bool explain) const;
+
+private:
+    mutable std::mutex                      lock_;
+    const int64_t                           id_;
+    const int64_t                           parent_;
+    const std::string                       name_;
+    std::string                             description_;
+    // The first start and the last finish
+    int64_t                                 startTime_{0};
+    int64_t                                 finishTime_{0};
+    int64_t                                 rowsIn_{0};
+    int64_t                                 rowsOut_{0};
+    int64_t                                 resultBytes_{0};
+    int64_t                                 rpcs_{0};
+    int64_t                                 bytesReceived_{0};
+    // The latency reported by each host, and the one observed by graphd, in us
+    std::map<HostAddr, std::pair<int64_t, int64_t>> hostLatency_;
+};
+
+
+/**
+ * Profiles of all the executors of an EXPLAIN or PROFILE query.
+ */
+class Profiler final {
+public:
+    explicit Profiler(bool explain) : explain_(explain) {}
+
+    bool isExplain() const {
+        return explain_;
+    }
+
+    /**
+     * Return the profile of the executor of a sentence, which is created at the first time.
+     * The executors of the same sentence, e.g. those on the batches of a pipe, share
+     * one profile. Both the parent and the sentence are nullptr for the root.
+     */
+    ExecutorProfile* getOrAdd(const ExecutorProfile *parent,
+                              const Sentence *sentence,
+                              std::string name);
+
+    std::vector<std::string> columnNames() const;
+
+    std::vector<cpp2::RowValue> rows() const;
+
+private:
+    const bool                              explain_;
+    mutable std::mutex                      lock_;
+    // In the order of creation, which is the preorder of the executor tree
+    std::deque<ExecutorProfile>             profiles_;
+    std::unordered_map<const Sentence*, ExecutorProfile*> index_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_PROFILER_H_
@@ -44,6 +44,33 @@ public:
         return query_;
     }
 
+    /**
+     * Parameters to be bound to the placeholders `?' of a prepared statement.
+     */
+    void setParameters(std::vector<cpp2::ColumnValue> params) {
+        params_ = std::move(params);
+        prepared_ = true;
+    }
+
+    const std::vector<cpp2::ColumnValue>& parameters() const {
+        return params_;
+    }
+
+    bool isPrepared() const {
+        return prepared_;
+    }
+
+    /**
+     * Rows beyond the chunk size are kept in a cursor of the session, 0 for no limit.
+     */
+    void setChunkSize(int32_t chunkSize) {
+        chunkSize_ = chunkSize;
+    }
+
+    int32_t chunkSize() const {
+        return chunkSize_;
+    }
+
     Response& resp() {
         return resp_;
     }
@@ -83,6 +110,9 @@ public:
 private:
     time::Duration                              duration_;
     std::string                                 query_;
+    std::vector<cpp2::ColumnValue>              params_;
+    bool                                        prepared_{false};
+    int32_t                                     chunkSize_{0};
     Response                                    resp_;
     folly::Promise<Response>                    promise_;
     std::shared_ptr<ClientSession>              session_;
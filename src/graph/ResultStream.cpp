@@ -0,0 +1,249 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/ResultStream.h"
+
+namespace nebula {
+namespace graph {
+
+std::atomic<int64_t> ResultStream::peakRows_{0};
+std::atomic<int64_t> ResultStream::totalBytes_{0};
+
+namespace {
+
+// An estimation of the memory held by a row
+int64_t rowBytes(const cpp2::RowValue &row) {
+    int64_t bytes = sizeof(cpp2::RowValue);
+    for (auto &col : row.get_columns()) {
+        bytes += sizeof(cpp2::ColumnValue);
+        if (col.getType() == cpp2::ColumnValue::Type::str) {
+            bytes += col.get_str().size();
+        }
+    }
+    return bytes;
+}
+
+}   // namespace
+
+
+ResultStream::ResultStream(int32_t chunkSize, folly::Executor *runner)
+    : chunkSize_(chunkSize), runner_(runner) {
+    DCHECK_GT(chunkSize_, 0);
+    DCHECK(runner_ != nullptr);
+}
+
+
+ResultStream::~ResultStream() {
+    totalBytes_ -= bytes_;
+}
+
+
+void ResultStream::setColumnNames(std::vector<std::string> columnNames) {
+    std::lock_guard<std::mutex> g(lock_);
+    columnNames_ = std::move(columnNames);
+}
+
+
+std::vector<std::string> ResultStream::columnNames() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return columnNames_;
+}
+
+
+void ResultStream::write(std::vector<cpp2::RowValue> rows) {
+    std::unique_ptr<folly::Promise<StatusOr<Chunk>>> reader;
+    StatusOr<Chunk> chunk;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (finished_ || closed_) {
+            return;
+        }
+        int64_t bytes = 0;
+        for (auto &row : rows) {
+            bytes += rowBytes(row);
+            rows_.emplace_back(std::move(row));
+        }
+        bytes_ += bytes;
+        totalBytes_ += bytes;
+        auto numRows = static_cast<int64_t>(rows_.size());
+        auto peak = peakRows_.load();
+        while (peak < numRows && !peakRows_.compare_exchange_weak(peak, numRows)) {
+        }
+        if (reader_ == nullptr || !readable()) {
+            return;
+        }
+        reader = std::move(reader_);
+        chunk = takeChunk();
+    }
+    // The room is back once the chunk is taken, but the producer is writing now
+    reader->setValue(std::move(chunk));
+}
+
+
+void ResultStream::finish(Status status) {
+    std::unique_ptr<folly::Promise<StatusOr<Chunk>>> reader;
+    StatusOr<Chunk> chunk;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        status_ = std::move(status);
+        if (!status_.ok()) {
+            dropRows();
+        }
+        if (reader_ == nullptr) {
+            return;
+        }
+        reader = std::move(reader_);
+        chunk = takeChunk();
+    }
+    reader->setValue(std::move(chunk));
+}
+
+
+int64_t ResultStream::room() const {
+    std::lock_guard<std::mutex> g(lock_);
+    if (finished_ || closed_) {
+        return 0;
+    }
+    return std::max(static_cast<int64_t>(chunkSize_) - static_cast<int64_t>(rows_.size()), 0L);
+}
+
+
+void ResultStream::waitRoom(std::function<void(Status)> ready) {
+    Status status;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (closed_) {
+            status = Status::Error("The cursor is closed");
+        } else if (finished_) {
+            status = Status::Error("The stream is finished");
+        } else if (rows_.size() >= static_cast<size_t>(chunkSize_)) {
+            DCHECK(!writer_);
+            writer_ = std::move(ready);
+            return;
+        }
+    }
+    callback(std::move(ready), std::move(status));
+}
+
+
+folly::Future<StatusOr<ResultStream::Chunk>> ResultStream::read() {
+    std::function<void(Status)> writer;
+    StatusOr<Chunk> chunk;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (closed_) {
+            return folly::makeFuture<StatusOr<Chunk>>(Status::Error("The cursor is closed"));
+        }
+        if (reader_ != nullptr) {
+            return folly::makeFuture<StatusOr<Chunk>>(
+                    Status::Error("The cursor is being fetched"));
+        }
+        if (!readable()) {
+            reader_ = std::make_unique<folly::Promise<StatusOr<Chunk>>>();
+            return reader_->getFuture();
+        }
+        chunk = takeChunk();
+        writer = std::move(writer_);
+    }
+    if (writer) {
+        callback(std::move(writer), Status::OK());
+    }
+    return folly::makeFuture<StatusOr<Chunk>>(std::move(chunk));
+}
+
+
+void ResultStream::close() {
+    std::unique_ptr<folly::Promise<StatusOr<Chunk>>> reader;
+    std::function<void(Status)> writer;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        dropRows();
+        reader = std::move(reader_);
+        writer = std::move(writer_);
+    }
+    if (reader != nullptr) {
+        reader->setValue(Status::Error("The cursor is closed"));
+    }
+    if (writer) {
+        callback(std::move(writer), Status::Error("The cursor is closed"));
+    }
+}
+
+
+int64_t ResultStream::rows() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return rows_.size();
+}
+
+
+// static
+int64_t ResultStream::peakRows() {
+    return peakRows_.load();
+}
+
+
+// static
+void ResultStream::resetPeakRows() {
+    peakRows_ = 0;
+}
+
+
+// static
+int64_t ResultStream::totalBytes() {
+    return totalBytes_.load();
+}
+
+
+bool ResultStream::readable() const {
+    return finished_ || rows_.size() >= static_cast<size_t>(chunkSize_);
+}
+
+
+StatusOr<ResultStream::Chunk> ResultStream::takeChunk() {
+    if (finished_ && !status_.ok()) {
+        return status_;
+    }
+    Chunk chunk;
+    auto num = std::min(rows_.size(), static_cast<size_t>(chunkSize_));
+    chunk.rows.reserve(num);
+    int64_t bytes = 0;
+    for (auto i = 0u; i < num; i++) {
+        // Release the memory of the rows read as soon as possible
+        bytes += rowBytes(rows_.front());
+        chunk.rows.emplace_back(std::move(rows_.front()));
+        rows_.pop_front();
+    }
+    bytes_ -= bytes;
+    totalBytes_ -= bytes;
+    chunk.more = !finished_ || !rows_.empty();
+    return chunk;
+}
+
+
+void ResultStream::dropRows() {
+    totalBytes_ -= bytes_;
+    bytes_ = 0;
+    rows_.clear();
+}
+
+
+void ResultStream::callback(std::function<void(Status)> ready, Status status) const {
+    runner_->add([ready = std::move(ready), status = std::move(status)] () mutable {
+        ready(std::move(status));
+    });
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,119 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_RESULTSTREAM_H_
+#define GRAPH_RESULTSTREAM_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include <folly/futures/Future.h>
+#include "gen-cpp2/graph_types.h"
+#include "graph/FlowControl.h"
+
+/**
+ * A ResultStream passes the rows of a query to a cursor of the client session chunk by chunk,
+ * while the query is still being executed.
+ *
+ * The executors write at most `room()' rows at a time, and wait by `waitRoom()' once the stream
+ * holds a full chunk not read yet. Each read takes a full chunk, or the rest of the rows once
+ * the stream is finished. So a query emitting its results in batches never holds more than
+ * `chunkSize' rows in its stream. The results of the other queries, e.g. ORDER BY, are written
+ * all at once when they are done.
+ */
+
+namespace nebula {
+namespace graph {
+
+class ResultStream final : public FlowControl {
+public:
+    struct Chunk {
+        std::vector<cpp2::RowValue>     rows;
+        // Whether there may be more rows to read
+        bool                            more{false};
+    };
+
+    // The callbacks of `waitRoom' run on `runner'
+    ResultStream(int32_t chunkSize, folly::Executor *runner);
+
+    ~ResultStream();
+
+    int32_t chunkSize() const {
+        return chunkSize_;
+    }
+
+    /**
+     * Producer side
+     */
+    void setColumnNames(std::vector<std::string> columnNames);
+
+    // The rows written after the stream is finished or closed are dropped
+    void write(std::vector<cpp2::RowValue> rows);
+
+    // No rows would be written anymore, the rows not read are dropped on failures
+    void finish(Status status);
+
+    int64_t room() const override;
+
+    void waitRoom(std::function<void(Status)> ready) override;
+
+    /**
+     * Consumer side
+     */
+    std::vector<std::string> columnNames() const;
+
+    // Only one read could be outstanding at a time
+    folly::Future<StatusOr<Chunk>> read();
+
+    // Drop the rows, the producer fails on its next wait
+    void close();
+
+    // Number of the rows not read yet
+    int64_t rows() const;
+
+    // The most rows held by a stream at a time since the last reset, exposed for the tests
+    static int64_t peakRows();
+
+    static void resetPeakRows();
+
+    // Estimated memory held by the rows of all streams
+    static int64_t totalBytes();
+
+private:
+    // Caller should hold `lock_'
+    bool readable() const;
+
+    // Caller should hold `lock_'
+    StatusOr<Chunk> takeChunk();
+
+    // Caller should hold `lock_'
+    void dropRows();
+
+    void callback(std::function<void(Status)> ready, Status status) const;
+
+private:
+    const int32_t                                       chunkSize_;
+    folly::Executor                                    *runner_{nullptr};
+
+    mutable std::mutex                                  lock_;
+    std::vector<std::string>                            columnNames_;
+    std::deque<cpp2::RowValue>                          rows_;
+    int64_t                                             bytes_{0};
+    bool                                                finished_{false};
+    Status                                              status_;
+    bool                                                closed_{false};
+    // The read waiting for a full chunk
+    std::unique_ptr<folly::Promise<StatusOr<Chunk>>>    reader_;
+    // The producer waiting for room
+    std::function<void(Status)>                         writer_;
+
+    static std::atomic<int64_t>                         peakRows_;
+    static std::atomic<int64_t>                         totalBytes_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_RESULTSTREAM_H_
@@ -9,6 +9,7 @@
 #include "graph/GoExecutor.h"
 #include "graph/PipeExecutor.h"
 #include "graph/UseExecutor.h"
+#include "graph/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -26,63 +27,259 @@ Status SequentialExecutor::prepare() {
         if (executor == nullptr) {
             return Status::Error("The statement has not been implemented");
         }
+        TraverseExecutor *traverse = nullptr;
+        if (stream_ != nullptr && sentences_->sentences_.size() == 1
+                && (sentence->kind() == Sentence::Kind::kGo
+                    || sentence->kind() == Sentence::Kind::kPipe)) {
+            // The pipe decides how to pass the results of its right side on preparing
+            traverse = static_cast<TraverseExecutor*>(executor.get());
+            streaming_ = true;
+            setupStream(traverse);
+        }
         auto status = executor->prepare();
         if (!status.ok()) {
             FLOG_ERROR("Prepare executor `%s' failed: %s",
                         executor->name(), status.toString().c_str());
             return status;
         }
+        if (traverse != nullptr && traverse->canEmitBatches()) {
+            traverse->setEmitBatches(true);
+            traverse->setFlowControl(stream_.get());
+        }
         executors_.emplace_back(std::move(executor));
     }
-    /**
-     * For the time being, we execute sentences one by one. We may allow concurrent
-     * or out of order execution in the future.
-     */
-    // For an executor except the last one, it executes the next one on finished.
-    // If any fails, the whole execution would abort.
-    auto onError = [this] (Status status) {
-        DCHECK(onError_);
-        onError_(std::move(status));
+    buildDependencies();
+    respExecutorIndex_ = executors_.size() - 1;
+
+    for (auto i = 0U; i < executors_.size(); i++) {
+        executors_[i]->setOnFinish([this, i] (Executor::ProcessControl ctr) {
+            onExecutorFinish(i, ctr);
+        });
+        executors_[i]->setOnError([this] (Status status) {
+            onExecutorError(std::move(status));
+        });
+    }
+
+    return Status::OK();
+}
+
+
+void SequentialExecutor::setupStream(TraverseExecutor *executor) {
+    auto *stream = stream_.get();
+    executor->setOnResult([stream] (std::unique_ptr<InterimResult> result) {
+        DCHECK(result != nullptr);
+        stream->setColumnNames(result->getColNames());
+        if (!result->hasData()) {
+            return;
+        }
+        auto rows = result->getRows();
+        if (!rows.ok()) {
+            stream->finish(std::move(rows).status());
+            return;
+        }
+        stream->write(std::move(rows).value());
+    });
+}
+
+
+// static
+bool SequentialExecutor::isConcurrent(Sentence *sentence) {
+    switch (sentence->kind()) {
+        case Sentence::Kind::kGo:
+        case Sentence::Kind::kFetchVertices:
+        case Sentence::Kind::kFetchEdges:
+        case Sentence::Kind::kFindPath:
+        case Sentence::Kind::kYield:
+        case Sentence::Kind::kOrderBy:
+        case Sentence::Kind::kLimit:
+        case Sentence::Kind::KGroupBy:
+            return true;
+        case Sentence::Kind::kPipe: {
+            auto *pipe = static_cast<PipedSentence*>(sentence);
+            return isConcurrent(pipe->left()) && isConcurrent(pipe->right());
+        }
+        case Sentence::Kind::kSet: {
+            auto *set = static_cast<SetSentence*>(sentence);
+            return isConcurrent(set->left()) && isConcurrent(set->right());
+        }
+        case Sentence::Kind::kAssignment:
+            return isConcurrent(static_cast<AssignmentSentence*>(sentence)->sentence());
+        default:
+            return false;
+    }
+}
+
+
+// static
+void SequentialExecutor::collectVariables(const Sentence *sentence,
+                                          std::unordered_set<std::string> &vars) {
+    // The variables are always printed as `$var', while `$-', `$^' and `$$' are not
+    // identifiers. A `$var' in a string literal only adds an unnecessary dependency.
+    auto text = sentence->toString();
+    for (auto pos = text.find('$'); pos != std::string::npos; pos = text.find('$', pos)) {
+        auto begin = ++pos;
+        while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos]))
+                                     || text[pos] == '_')) {
+            pos++;
+        }
+        if (pos > begin) {
+            vars.emplace(text.substr(begin, pos - begin));
+        }
+    }
+}
+
+
+void SequentialExecutor::buildDependencies() {
+    auto &sentences = sentences_->sentences_;
+    successors_.resize(sentences.size());
+    waiting_.resize(sentences.size());
+
+    struct Variable {
+        int64_t                 writer{-1};
+        std::vector<uint32_t>   readers;
     };
-    for (auto i = 0U; i < executors_.size() - 1; i++) {
-        auto onFinish = [this, current = i, next = i + 1] (Executor::ProcessControl ctr) {
-            switch (ctr) {
-                case Executor::ProcessControl::kReturn: {
-                    DCHECK(onFinish_);
-                    respExecutorIndex_ = current;
-                    onFinish_(ctr);
-                    break;
+    std::unordered_map<std::string, Variable> variables;
+    // The last sentence which runs exclusively, and the ones following it
+    int64_t barrier = -1;
+    std::vector<uint32_t> followers;
+    for (auto i = 0U; i < sentences.size(); i++) {
+        auto *sentence = sentences[i].get();
+        std::set<uint32_t> deps;
+        if (barrier >= 0) {
+            deps.emplace(barrier);
+        }
+        if (!FLAGS_enable_concurrent_sentences || !isConcurrent(sentence)) {
+            deps.insert(followers.begin(), followers.end());
+            barrier = i;
+            followers.clear();
+            // All the variables are assigned before the barrier
+            variables.clear();
+        } else {
+            const std::string *assigned = nullptr;
+            if (sentence->kind() == Sentence::Kind::kAssignment) {
+                auto *assignment = static_cast<AssignmentSentence*>(sentence);
+                assigned = assignment->var();
+                sentence = assignment->sentence();
+            }
+            std::unordered_set<std::string> reads;
+            collectVariables(sentence, reads);
+            // Read after write
+            for (auto &var : reads) {
+                auto &variable = variables[var];
+                if (variable.writer >= 0) {
+                    deps.emplace(variable.writer);
+                }
+                variable.readers.emplace_back(i);
+            }
+            if (assigned != nullptr) {
+                // Write after write and write after read
+                auto &variable = variables[*assigned];
+                if (variable.writer >= 0) {
+                    deps.emplace(variable.writer);
                 }
-                case Executor::ProcessControl::kNext:
-                default: {
-                    executors_[next]->execute();
-                    break;
+                deps.insert(variable.readers.begin(), variable.readers.end());
+                deps.erase(i);
+                variable.writer = i;
+                variable.readers.clear();
+            }
+            followers.emplace_back(i);
+        }
+        for (auto dep : deps) {
+            successors_[dep].emplace_back(i);
+        }
+        waiting_[i] = deps.size();
+    }
+}
+
+
+void SequentialExecutor::execute() {
+    std::vector<uint32_t> ready;
+    for (auto i = 0U; i < executors_.size(); i++) {
+        if (waiting_[i] == 0) {
+            ready.emplace_back(i);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        running_ = ready.size();
+        launching_++;
+    }
+    for (auto i : ready) {
+        executors_[i]->run();
+    }
+    finishIfDone();
+}
+
+
+void SequentialExecutor::onExecutorFinish(uint32_t index, Executor::ProcessControl ctr) {
+    std::vector<uint32_t> ready;
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        running_--;
+        if (ctr == Executor::ProcessControl::kReturn) {
+            // The RETURN sentence runs exclusively, so nothing else is running
+            returned_ = true;
+            respExecutorIndex_ = index;
+        }
+        if (status_.ok() && !returned_) {
+            for (auto next : successors_[index]) {
+                if (--waiting_[next] == 0) {
+                    ready.emplace_back(next);
                 }
             }
-        };
-        executors_[i]->setOnFinish(onFinish);
-        executors_[i]->setOnError(onError);
+            running_ += ready.size();
+        }
+        launching_++;
     }
-    // The whole execution is done upon the last executor finishes.
-    auto onFinish = [this] (Executor::ProcessControl ctr) {
-        DCHECK(onFinish_);
-        respExecutorIndex_ = executors_.size() - 1;
-        onFinish_(ctr);
-    };
-    executors_.back()->setOnFinish(onFinish);
-    executors_.back()->setOnError(onError);
+    for (auto next : ready) {
+        executors_[next]->run();
+    }
+    finishIfDone();
+}
 
-    return Status::OK();
+
+void SequentialExecutor::onExecutorError(Status status) {
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        running_--;
+        // Report the first error once the running ones are done
+        if (status_.ok()) {
+            status_ = std::move(status);
+        }
+        launching_++;
+    }
+    finishIfDone();
 }
 
 
-void SequentialExecutor::execute() {
-    executors_.front()->execute();
+void SequentialExecutor::finishIfDone() {
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        launching_--;
+        // The plan may be released once done, so wait for the others to return
+        // from launching the executors, even if they have nothing to launch
+        if (running_ != 0 || launching_ != 0 || finished_) {
+            return;
+        }
+        finished_ = true;
+    }
+    if (!status_.ok()) {
+        DCHECK(onError_);
+        onError_(std::move(status_));
+        return;
+    }
+    DCHECK(onFinish_);
+    onFinish_(returned_ ? Executor::ProcessControl::kReturn
+                        : Executor::ProcessControl::kNext);
 }
 
 
 void SequentialExecutor::setupResponse(cpp2::ExecutionResponse &resp) {
-    executors_[respExecutorIndex_]->setupResponse(resp);
+    auto &executor = executors_[respExecutorIndex_];
+    executor->setupResponse(resp);
+    if (executor->profile() != nullptr) {
+        executor->profile()->addRowsOut(resp.rows.size());
+    }
 }
 
 }   // namespace graph
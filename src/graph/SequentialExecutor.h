@@ -9,6 +9,8 @@
 
 #include "base/Base.h"
 #include "graph/Executor.h"
+#include "graph/TraverseExecutor.h"
+#include "graph/ResultStream.h"
 
 
 namespace nebula {
@@ -28,10 +30,72 @@ public:
 
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
+    /**
+     * To write the results into `stream' while executing, must be set before `prepare()'.
+     * It only takes effect if the statement is a single GO or pipe, see `isStreaming()'.
+     */
+    void setResultStream(std::shared_ptr<ResultStream> stream) {
+        stream_ = std::move(stream);
+    }
+
+    /**
+     * Whether the results are written into the stream, instead of set up by `setupResponse()'.
+     * Only valid after `prepare()'.
+     */
+    bool isStreaming() const {
+        return streaming_;
+    }
+
+private:
+    /**
+     * Only the sentences which don't have side effects except assigning variables,
+     * e.g. GO, FETCH and YIELD, could run concurrently. Any other sentence
+     * runs after all its preceding ones, and before all its following ones.
+     */
+    static bool isConcurrent(Sentence *sentence);
+
+    /**
+     * Collect the variables referred by the sentence, i.e. `$var'.
+     */
+    static void collectVariables(const Sentence *sentence,
+                                 std::unordered_set<std::string> &vars);
+
+    /**
+     * Build the dependencies between the sentences by the variables they read and write.
+     */
+    void buildDependencies();
+
+    /**
+     * Write the results of `executor' into `stream_'.
+     */
+    void setupStream(TraverseExecutor *executor);
+
+    void onExecutorFinish(uint32_t index, Executor::ProcessControl ctr);
+
+    void onExecutorError(Status status);
+
+    // Leave the callback, and report the result if no executor is running
+    // and no one else is in the callbacks
+    void finishIfDone();
+
 private:
     SequentialSentences                        *sentences_{nullptr};
     std::vector<std::unique_ptr<Executor>>      executors_;
+    // The executors to run after each executor finishes
+    std::vector<std::vector<uint32_t>>          successors_;
+    // Number of the unfinished executors each executor waits for
+    std::vector<uint32_t>                       waiting_;
+
+    std::mutex                                  lock_;
+    uint32_t                                    running_{0};
+    // Number of the callbacks which are launching executors
+    uint32_t                                    launching_{0};
+    bool                                        finished_{false};
+    bool                                        returned_{false};
+    Status                                      status_;
     uint32_t                                    respExecutorIndex_{0};
+    std::shared_ptr<ResultStream>               stream_;
+    bool                                        streaming_{false};
 };
 
 
@@ -93,6 +93,7 @@ void SessionManager::reclaimExpiredSessions() {
         auto *session = iter->second.get();
         int32_t idleSecs = session->idleSeconds();
         if (idleSecs < FLAGS_session_idle_timeout_secs) {
+            session->reclaimCursors();
             ++iter;
             continue;
         }
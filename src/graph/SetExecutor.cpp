@@ -103,8 +103,8 @@ void SetExecutor::execute() {
     }
 
     auto *runner = ectx()->rctx()->runner();
-    runner->add([this] () mutable { left_->execute(); });
-    runner->add([this] () mutable { right_->execute(); });
+    runner->add([this] () mutable { left_->run(); });
+    runner->add([this] () mutable { right_->run(); });
 
     auto cb = [this] (auto &&result) {
         UNUSED(result);
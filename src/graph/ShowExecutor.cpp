@@ -389,6 +389,14 @@ void ShowExecutor::showCreateSpace() {
         buf += ", ";
         buf += "replica_factor = ";
         buf += folly::to<std::string>(properties.get_replica_factor());
+        if (properties.get_single_version()) {
+            buf += ", single_version = true";
+        }
+        if (properties.get_partition_strategy() == meta::cpp2::PartitionStrategy::RANGE) {
+            buf += ", partition_strategy = \"range\", range_bounds = \"";
+            buf += folly::join(",", properties.get_range_bounds());
+            buf += "\"";
+        }
         buf += ")";
 
         row[1].set_str(buf);;
@@ -28,7 +28,9 @@ namespace nebula {
 namespace graph {
 
 std::unique_ptr<TraverseExecutor> TraverseExecutor::makeTraverseExecutor(Sentence *sentence) {
-    return makeTraverseExecutor(sentence, ectx());
+    auto executor = makeTraverseExecutor(sentence, ectx());
+    executor->setupProfile(this, sentence);
+    return executor;
 }
 
 
@@ -297,26 +299,59 @@ Status WhereWrapper::prepare(ExpressionContext *ectx) {
         if (!status.ok()) {
             return status;
         }
+        auto compiled = CompiledExpression::compile(filter_);
+        if (compiled.ok()) {
+            compiled_ = std::move(compiled).value();
+        }
     }
 
     if (!FLAGS_filter_pushdown) {
         return status;
     }
 
+    auto rewritten = rewriteForPushdown();
+    if (!rewritten.ok()) {
+        return std::move(rewritten).status();
+    }
+    filterRewrite_ = std::move(rewritten).value();
+    if (filterRewrite_ != nullptr) {
+        VLOG(1) << "Filter pushdown: " << filterRewrite_->toString();
+        filterPushdown_ = Expression::encode(filterRewrite_.get());
+    }
+    return status;
+}
+
+StatusOr<std::unique_ptr<Expression>> WhereWrapper::rewriteForPushdown() const {
     auto encode = Expression::encode(where_->filter());
     auto decode = Expression::decode(std::move(encode));
     if (!decode.ok()) {
         return std::move(decode).status();
     }
-    filterRewrite_ = std::move(decode).value();
-    if (!rewrite(filterRewrite_.get())) {
-        filterRewrite_ = nullptr;
+    auto expr = std::move(decode).value();
+    if (!rewrite(expr.get())) {
+        return std::unique_ptr<Expression>();
     }
-    if (filterRewrite_ != nullptr) {
-        VLOG(1) << "Filter pushdown: " << filterRewrite_->toString();
-        filterPushdown_ = Expression::encode(filterRewrite_.get());
+    return std::move(expr);
+}
+
+std::string WhereWrapper::explain() const {
+    if (where_ == nullptr) {
+        return "";
     }
-    return status;
+    std::string buf = "filter: ";
+    buf += where_->filter()->toString();
+    buf += ", pushdown: ";
+    if (!FLAGS_filter_pushdown) {
+        buf += "disabled";
+        return buf;
+    }
+    auto rewritten = rewriteForPushdown();
+    if (!rewritten.ok() || rewritten.value() == nullptr) {
+        buf += "none";
+    } else {
+        buf += rewritten.value()->toString();
+    }
+    return buf;
 }
 
 bool WhereWrapper::rewrite(Expression *expr) const {
@@ -13,6 +13,8 @@
 #include "meta/SchemaProviderIf.h"
 #include "dataman/RowReader.h"
 #include "dataman/RowWriter.h"
+#include "filter/CompiledExpression.h"
+#include "graph/FlowControl.h"
 
 namespace nebula {
 namespace graph {
@@ -108,7 +110,16 @@ public:
         return filterPushdown_;
     }
 
+    /**
+     * Describe the filter and its part pushed down to storage, which doesn't need
+     * the filter to be prepared.
+     */
+    std::string explain() const;
+
 private:
+    // Return the part of the filter which could be pushed down, nullptr if none
+    StatusOr<std::unique_ptr<Expression>> rewriteForPushdown() const;
+
     Status encode();
 
     bool rewrite(Expression *expr) const;
@@ -122,6 +133,8 @@ private:
     const WhereClause              *where_{nullptr};
     std::unique_ptr<Expression>     filterRewrite_;
     Expression                     *filter_{nullptr};
+    // The compiled filter_, nullptr if it is not compilable
+    std::unique_ptr<CompiledExpression> compiled_;
     std::string                     filterPushdown_;
 };
 
@@ -145,7 +158,48 @@ public:
      * upon `setupResponse()'s invoke.
      */
     void setOnResult(OnResult onResult) {
-        onResult_ = std::move(onResult);
+        if (profile_ == nullptr) {
+            onResult_ = std::move(onResult);
+            return;
+        }
+        auto *profile = profile_;
+        onResult_ = [profile, onResult = std::move(onResult)] (
+                std::unique_ptr<InterimResult> result) {
+            profile->addResult(*result);
+            onResult(std::move(result));
+        };
+    }
+
+    /**
+     * Whether this executor is able to emit its results in batches,
+     * i.e. to invoke `onResult_' multiple times before `onFinish_'.
+     */
+    virtual bool canEmitBatches() const {
+        return false;
+    }
+
+    /**
+     * Whether this executor could be executed on each batch of its inputs separately,
+     * i.e. the results on the whole inputs are just the union of those on the batches.
+     */
+    virtual bool canConsumeBatches() const {
+        return false;
+    }
+
+    /**
+     * Ask the executor to emit its results in batches,
+     * only valid if `canEmitBatches()' returns true.
+     */
+    void setEmitBatches(bool emitBatches) {
+        emitBatches_ = emitBatches;
+    }
+
+    /**
+     * Let the consumer of the batches hold back this executor,
+     * only valid along with `setEmitBatches(true)'.
+     */
+    void setFlowControl(FlowControl *flowControl) {
+        flowControl_ = flowControl;
     }
 
     static std::unique_ptr<TraverseExecutor>
@@ -154,8 +208,17 @@ public:
 protected:
     std::unique_ptr<TraverseExecutor> makeTraverseExecutor(Sentence *sentence);
 
+    template <typename RpcResponse>
+    void profileStorageResponse(RpcResponse &rpcResp) const {
+        if (profile_ != nullptr) {
+            profile_->addStorageResponse(rpcResp);
+        }
+    }
+
 protected:
     OnResult                                    onResult_;
+    bool                                        emitBatches_{false};
+    FlowControl                                *flowControl_{nullptr};
 };
 
 }   // namespace graph
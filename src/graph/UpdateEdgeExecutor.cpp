@@ -212,6 +212,7 @@ void UpdateEdgeExecutor::insertReverselyEdge(storage::cpp2::UpdateResponse &&rpc
     auto future = ectx()->getStorageClient()->addEdges(spaceId_, std::move(edges), false);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this, updateResp = std::move(rpcResp)] (auto &&resp) mutable {
+        invalidateNeighborCache(spaceId_);
         auto completeness = resp.completeness();
         if (completeness != 100) {
             // Very bad, it should delete the upsert positive edge!!!
@@ -241,6 +242,7 @@ void UpdateEdgeExecutor::execute() {
                                                          insertable_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
+        invalidateNeighborCache(spaceId_);
         if (!resp.ok()) {
             doError(std::move(resp).status());
             return;
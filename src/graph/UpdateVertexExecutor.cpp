@@ -193,6 +193,7 @@ void UpdateVertexExecutor::execute() {
                                                            insertable_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
+        invalidateNeighborCache(spaceId_);
         if (!resp.ok()) {
             doError(std::move(resp).status());
             return;
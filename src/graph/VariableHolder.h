@@ -13,6 +13,10 @@ namespace nebula {
 namespace graph {
 
 class InterimResult;
+/**
+ * Variables of a query. It's thread safe, since the independent sentences could
+ * assign and read variables concurrently.
+ */
 class VariableHolder final {
 public:
     VariableHolder();
@@ -27,6 +31,7 @@ public:
     const InterimResult* get(const std::string &var, bool *existing = nullptr) const;
 
 private:
+    mutable std::mutex                                              lock_;
     std::unordered_map<std::string, std::unique_ptr<InterimResult>> holder_;
 };
 
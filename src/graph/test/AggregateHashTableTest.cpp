@@ -0,0 +1,147 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "graph/AggregateHashTable.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+cpp2::ColumnValue intValue(int64_t v) {
+    cpp2::ColumnValue value;
+    value.set_integer(v);
+    return value;
+}
+
+cpp2::ColumnValue strValue(std::string v) {
+    cpp2::ColumnValue value;
+    value.set_str(std::move(v));
+    return value;
+}
+
+std::vector<AggKind> allKinds() {
+    return {AggKind::GROUP, AggKind::COUNT, AggKind::COUNT_DISTINCT, AggKind::SUM,
+            AggKind::AVG, AggKind::MAX, AggKind::MIN, AggKind::STD,
+            AggKind::BIT_AND, AggKind::BIT_OR, AggKind::BIT_XOR};
+}
+
+// Group by `v % groups', and apply v on all the functions
+void aggregate(AggregateHashTable &table, int64_t begin, int64_t end, int64_t groups) {
+    std::string key;
+    for (auto v = begin; v < end; v++) {
+        key.clear();
+        AggregateHashTable::encodeValue(strValue(folly::to<std::string>(v % groups)), key);
+        auto *states = table.findOrInsert(key);
+        for (size_t i = 0; i < allKinds().size(); i++) {
+            table.apply(states, i, i == 0 ? strValue(folly::to<std::string>(v % groups))
+                                          : intValue(v));
+        }
+    }
+}
+
+std::map<std::string, std::vector<cpp2::ColumnValue>> toMap(const AggregateHashTable &table) {
+    std::map<std::string, std::vector<cpp2::ColumnValue>> result;
+    for (auto &row : table.getRows()) {
+        result.emplace(row.columns[0].get_str(), row.columns);
+    }
+    return result;
+}
+
+}   // namespace
+
+TEST(AggregateHashTableTest, EncodeValue) {
+    std::string intKey;
+    AggregateHashTable::encodeValue(intValue(1), intKey);
+    std::string idKey;
+    cpp2::ColumnValue id;
+    id.set_id(1);
+    AggregateHashTable::encodeValue(id, idKey);
+    EXPECT_NE(intKey, idKey);
+
+    std::string positive;
+    std::string negative;
+    cpp2::ColumnValue zero;
+    zero.set_double_precision(0.0);
+    AggregateHashTable::encodeValue(zero, positive);
+    zero.set_double_precision(-0.0);
+    AggregateHashTable::encodeValue(zero, negative);
+    EXPECT_EQ(positive, negative);
+
+    // The length prefix keeps ("a", "bc") and ("ab", "c") apart
+    std::string left;
+    AggregateHashTable::encodeValue(strValue("a"), left);
+    AggregateHashTable::encodeValue(strValue("bc"), left);
+    std::string right;
+    AggregateHashTable::encodeValue(strValue("ab"), right);
+    AggregateHashTable::encodeValue(strValue("c"), right);
+    EXPECT_NE(left, right);
+}
+
+TEST(AggregateHashTableTest, Aggregate) {
+    AggregateHashTable table(allKinds());
+    aggregate(table, 0, 10, 2);
+    ASSERT_EQ(2, table.size());
+
+    auto rows = toMap(table);
+    // 0, 2, 4, 6, 8
+    auto &even = rows["0"];
+    EXPECT_EQ("0", even[0].get_str());
+    EXPECT_EQ(5, even[1].get_integer());
+    EXPECT_EQ(5, even[2].get_integer());
+    EXPECT_EQ(20, even[3].get_integer());
+    EXPECT_DOUBLE_EQ(4.0, even[4].get_double_precision());
+    EXPECT_EQ(8, even[5].get_integer());
+    EXPECT_EQ(0, even[6].get_integer());
+    EXPECT_DOUBLE_EQ(std::sqrt(8.0), even[7].get_double_precision());
+    EXPECT_EQ(0, even[8].get_integer());
+    EXPECT_EQ(14, even[9].get_integer());
+    EXPECT_EQ(0 ^ 2 ^ 4 ^ 6 ^ 8, even[10].get_integer());
+
+    // Values of other types are ignored by SUM and the bit operations
+    AggregateHashTable strTable({AggKind::SUM, AggKind::BIT_OR});
+    auto *states = strTable.findOrInsert("");
+    strTable.apply(states, 0, strValue("a"));
+    strTable.apply(states, 1, strValue("a"));
+    auto strRows = strTable.getRows();
+    ASSERT_EQ(1, strRows.size());
+    EXPECT_EQ(0, strRows[0].columns[0].get_integer());
+    EXPECT_EQ(0, strRows[0].columns[1].get_integer());
+}
+
+TEST(AggregateHashTableTest, Merge) {
+    AggregateHashTable expected(allKinds());
+    aggregate(expected, 0, 100000, 97);
+
+    AggregateHashTable merged(allKinds());
+    aggregate(merged, 0, 30000, 97);
+    for (auto begin = 30000; begin < 100000; begin += 35000) {
+        AggregateHashTable partial(allKinds());
+        aggregate(partial, begin, begin + 35000, 97);
+        merged.merge(std::move(partial));
+    }
+    ASSERT_EQ(97, merged.size());
+
+    auto expectedRows = toMap(expected);
+    auto mergedRows = toMap(merged);
+    for (auto &row : expectedRows) {
+        auto &columns = mergedRows[row.first];
+        ASSERT_EQ(row.second.size(), columns.size());
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (allKinds()[i] == AggKind::STD || allKinds()[i] == AggKind::AVG) {
+                EXPECT_NEAR(row.second[i].get_double_precision(),
+                            columns[i].get_double_precision(), 1e-6);
+            } else {
+                EXPECT_EQ(row.second[i], columns[i]);
+            }
+        }
+    }
+}
+
+}  // namespace graph
+}  // namespace nebula
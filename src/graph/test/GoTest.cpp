@@ -12,6 +12,8 @@
 #include "parser/GQLParser.h"
 #include "graph/TraverseExecutor.h"
 #include "graph/GoExecutor.h"
+#include "graph/GraphFlags.h"
+#include "graph/ResultStream.h"
 
 
 namespace nebula {
@@ -150,6 +152,148 @@ TEST_P(GoTest, OneStepOutBound) {
 }
 
 
+TEST_P(GoTest, Cursor) {
+    auto &player = players_["Boris Diaw"];
+    auto *fmt = "GO FROM %ld OVER serve YIELD $^.player.name, serve.start_year, $$.team.name";
+    auto query = folly::stringPrintf(fmt, player.vid());
+    cpp2::ExecutionResponse resp;
+    auto code = client_->executeWithCursor(query, 2, resp);
+    ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    ASSERT_EQ(2, resp.get_rows()->size());
+    ASSERT_NE(nullptr, resp.get_cursor_id());
+    auto cursorId = *resp.get_cursor_id();
+
+    // Fetch the rest chunk by chunk
+    while (resp.get_cursor_id() != nullptr) {
+        cpp2::ExecutionResponse chunk;
+        code = client_->fetch(cursorId, chunk);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_GE(2, chunk.get_rows()->size());
+        for (auto &row : *chunk.get_rows()) {
+            resp.rows.emplace_back(row);
+        }
+        resp.__isset.cursor_id = chunk.get_cursor_id() != nullptr;
+    }
+    std::vector<std::tuple<std::string, int64_t, std::string>> expected = {
+        {player.name(), 2003, "Hawks"},
+        {player.name(), 2005, "Suns"},
+        {player.name(), 2008, "Hornets"},
+        {player.name(), 2012, "Spurs"},
+        {player.name(), 2016, "Jazz"},
+    };
+    ASSERT_TRUE(verifyResult(resp, expected));
+
+    // The cursor is closed once exhausted
+    cpp2::ExecutionResponse chunk;
+    code = client_->fetch(cursorId, chunk);
+    ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+}
+
+
+TEST_P(GoTest, StreamingCursor) {
+    gflags::FlagSaver saver;
+    FLAGS_pipe_batch_size = 1;
+    auto &player = players_["Boris Diaw"];
+    std::vector<std::string> queries = {
+        "GO FROM %ld OVER serve YIELD $^.player.name, serve.start_year, $$.team.name",
+        "GO FROM %ld OVER like YIELD like._dst as id"
+        "| GO FROM $-.id OVER like YIELD like._dst as id | GO FROM $-.id OVER serve",
+    };
+    for (auto *fmt : queries) {
+        auto query = folly::stringPrintf(fmt, player.vid());
+        cpp2::ExecutionResponse expected;
+        auto code = client_->execute(query, expected);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_LT(2, expected.get_rows()->size());
+
+        // The query emits its results chunk by chunk while the client fetches them,
+        // so no more than a chunk of rows is held by the query at a time
+        ResultStream::resetPeakRows();
+        auto colNames = *expected.get_column_names();
+        std::vector<cpp2::RowValue> rows;
+        auto onChunk = [&] (const cpp2::ExecutionResponse &chunk) {
+            EXPECT_TRUE(verifyColNames(chunk, colNames));
+            if (chunk.get_rows() != nullptr) {
+                EXPECT_GE(2, chunk.get_rows()->size());
+                rows.insert(rows.end(), chunk.get_rows()->begin(), chunk.get_rows()->end());
+            }
+            return true;
+        };
+        cpp2::ExecutionResponse resp;
+        code = client_->executeInChunks(query, 2, onChunk, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_TRUE(std::is_permutation(rows.begin(), rows.end(),
+                                        expected.get_rows()->begin(),
+                                        expected.get_rows()->end()));
+        ASSERT_EQ(expected.get_rows()->size(), rows.size());
+        ASSERT_GE(2, ResultStream::peakRows());
+
+        // Stop after the first chunk, the rest are released
+        auto chunks = 0;
+        code = client_->executeInChunks(query, 2, [&] (const cpp2::ExecutionResponse&) {
+            return ++chunks < 1;
+        }, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_EQ(1, chunks);
+    }
+}
+
+
+TEST_P(GoTest, ExplainAndProfile) {
+    auto &player = players_["Boris Diaw"];
+    auto *fmt = "GO FROM %ld OVER serve WHERE serve.start_year > 2005 "
+                "YIELD serve.start_year AS start | ORDER BY $-.start";
+    auto query = folly::stringPrintf(fmt, player.vid());
+    {
+        cpp2::ExecutionResponse resp;
+        auto code = client_->execute("EXPLAIN " + query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::string> expectedColNames{"id", "parent", "executor", "description"};
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+        auto &rows = *resp.get_rows();
+        ASSERT_EQ(4, rows.size());
+        std::vector<std::tuple<int64_t, std::string>> expected = {
+            {-1, "SequentialExecutor"},
+            {0, "PipeExecutor"},
+            {1, "GoExecutor"},
+            {1, "OrderByExecutor"},
+        };
+        for (auto i = 0u; i < rows.size(); i++) {
+            ASSERT_EQ(i, rows[i].columns[0].get_integer());
+            ASSERT_EQ(std::get<0>(expected[i]), rows[i].columns[1].get_integer());
+            ASSERT_EQ(std::get<1>(expected[i]), rows[i].columns[2].get_str());
+        }
+        auto &desc = rows[2].columns[3].get_str();
+        ASSERT_NE(std::string::npos, desc.find("pushdown: "));
+        ASSERT_EQ(std::string::npos, desc.find("pushdown: none"));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto code = client_->execute("PROFILE " + query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::string> expectedColNames{
+            "id", "parent", "executor", "description", "wall_time_us", "rows_in", "rows_out",
+            "result_bytes", "storage_rpcs", "storage_bytes", "storage_latency_us"
+        };
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+        auto &rows = *resp.get_rows();
+        ASSERT_EQ(4, rows.size());
+        auto &pipe = rows[1].columns;
+        auto &go = rows[2].columns;
+        auto &orderBy = rows[3].columns;
+        // Three of the five teams are joined after 2005
+        ASSERT_EQ(3, go[6].get_integer());
+        ASSERT_EQ(3, orderBy[5].get_integer());
+        ASSERT_EQ(3, pipe[6].get_integer());
+        ASSERT_LT(0, go[7].get_integer());
+        ASSERT_LT(0, go[8].get_integer());
+        ASSERT_LT(0, go[9].get_integer());
+        ASSERT_FALSE(go[10].get_str().empty());
+        ASSERT_EQ(0, orderBy[8].get_integer());
+    }
+}
+
+
 TEST_P(GoTest, AssignmentSimple) {
     {
         cpp2::ExecutionResponse resp;
@@ -203,6 +347,64 @@ TEST_P(GoTest, AssignmentPipe) {
 }
 
 
+TEST_P(GoTest, AssignmentConcurrent) {
+    {
+        // `$b' is independent of `$a', and `$a' is reassigned only after being read
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "$a = GO FROM %ld OVER like YIELD like._dst as id;"
+            "$c = GO FROM %ld OVER serve YIELD serve._dst as id;"
+            "$b = GO FROM $a.id OVER like YIELD like._dst as id;"
+            "$a = GO FROM %ld OVER serve YIELD serve._dst as id;"
+            "GO FROM $b.id OVER like";
+        auto query = folly::stringPrintf(fmt,
+                                         players_["Tracy McGrady"].vid(),
+                                         players_["Tim Duncan"].vid(),
+                                         players_["Tim Duncan"].vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::string> expectedColNames{
+            {"like._dst"}
+        };
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+
+        std::vector<std::tuple<uint64_t>> expected = {
+            {players_["Kobe Bryant"].vid()},
+            {players_["Grant Hill"].vid()},
+            {players_["Rudy Gay"].vid()},
+            {players_["Tony Parker"].vid()},
+            {players_["Tim Duncan"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // The error is reported after the concurrent sentences are done,
+        // and the sentences depending on the failed one never run
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "$a = GO FROM %ld OVER like YIELD like._dst as id;"
+            "$b = GO FROM $undefined.id OVER like YIELD like._dst as id;"
+            "INSERT EDGE like(likeness) VALUES %ld->%ld:(1)";
+        auto &player = players_["Tracy McGrady"];
+        auto query = folly::stringPrintf(fmt, player.vid(), player.vid(), player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+        ASSERT_NE(nullptr, resp.get_error_msg());
+        ASSERT_EQ("Variable `undefined' not defined", *resp.get_error_msg());
+
+        cpp2::ExecutionResponse check;
+        query = folly::stringPrintf("GO FROM %ld OVER like WHERE like._dst == %ld",
+                                    player.vid(), player.vid());
+        code = client_->execute(query, check);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<uint64_t>> expected = {
+        };
+        ASSERT_TRUE(verifyResult(check, expected));
+    }
+}
+
+
 TEST_P(GoTest, VariableUndefined) {
     {
         cpp2::ExecutionResponse resp;
@@ -300,6 +502,30 @@ TEST_P(GoTest, Distinct) {
         };
         ASSERT_TRUE(verifyResult(resp, expected));
     }
+    // The distinct of _dst is pushed down to storage, the result should be the same as
+    // the one deduped in graphd only.
+    {
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER like YIELD like._dst as id"
+                    "| GO FROM $-.id OVER like YIELD DISTINCT like._dst%s";
+        auto getIds = [&] (const char *suffix, std::vector<int64_t> &ids) {
+            cpp2::ExecutionResponse resp;
+            auto query = folly::stringPrintf(fmt, player.vid(), suffix);
+            auto code = client_->execute(query, resp);
+            ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+            ASSERT_NE(nullptr, resp.get_rows());
+            for (auto &row : *resp.get_rows()) {
+                ids.emplace_back(convert<int64_t>(row.get_columns()[0]));
+            }
+            std::sort(ids.begin(), ids.end());
+        };
+        std::vector<int64_t> pushedDown;
+        getIds("", pushedDown);
+        std::vector<int64_t> expected;
+        getIds(" + 0", expected);
+        ASSERT_FALSE(expected.empty());
+        ASSERT_EQ(expected, pushedDown);
+    }
 }
 
 
@@ -1901,6 +2127,133 @@ TEST_P(GoTest, FilterPushdown) {
 #undef TEST_FILTER_PUSHDWON_REWRITE
 }
 
+TEST_P(GoTest, CompiledWhereAndYield) {
+    // Edge, source and destination props are bound to the compiled programs
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER serve "
+                    "WHERE serve.start_year > 2005 && $$.team.name != \"Jazz\" "
+                    "YIELD $^.player.name, serve.start_year, serve.end_year + 1, $$.team.name";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t, int64_t, std::string>> expected = {
+            {player.name(), 2008, 2013, "Hornets"},
+            {player.name(), 2012, 2017, "Spurs"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Input props keep their types through the compiled yields
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER like YIELD like._dst AS id, like.likeness AS l "
+                    "| GO FROM $-.id OVER serve "
+                    "WHERE $-.l > 79 && serve.start_year > 2010 "
+                    "YIELD $-.l, $^.player.name, serve.start_year, $$.team.name";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::string> expectedColNames{
+            {"$-.l"}, {"$^.player.name"}, {"serve.start_year"}, {"$$.team.name"}
+        };
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+
+        std::vector<std::tuple<int64_t, std::string, int64_t, std::string>> expected = {
+            {80, "Tony Parker", 2018, "Hornets"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Reversely, the edge props are read from the reverse edges
+    {
+        cpp2::ExecutionResponse resp;
+        auto query = "GO FROM hash('Tim Duncan') OVER like REVERSELY "
+                     "WHERE like.likeness > 90 "
+                     "YIELD $$.player.name, like.likeness + 1";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t>> expected = {
+            {"Tony Parker", 96},
+            {"Dejounte Murray", 100},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Props of the edges not traversed yield their defaults
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER like, serve "
+                    "YIELD like._dst, like.likeness + 1, serve.start_year";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<int64_t, int64_t, int64_t>> expected = {
+            {players_["Tony Parker"].vid(), 81, 0},
+            {players_["Tim Duncan"].vid(), 81, 0},
+            {0, 1, 2003},
+            {0, 1, 2005},
+            {0, 1, 2008},
+            {0, 1, 2012},
+            {0, 1, 2016},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
+
+TEST_P(GoTest, StreamingPipe) {
+    FLAGS_pipe_batch_size = 1;
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER like YIELD like._dst as id"
+                    "| GO FROM $-.id OVER like YIELD like._dst as id | GO FROM $-.id OVER serve";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::string> expectedColNames{
+            {"serve._dst"}
+        };
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+
+        std::vector<std::tuple<int64_t>> expected = {
+            {teams_["Spurs"].vid()},
+            {teams_["Spurs"].vid()},
+            {teams_["Spurs"].vid()},
+            {teams_["Spurs"].vid()},
+            {teams_["Spurs"].vid()},
+            {teams_["Hornets"].vid()},
+            {teams_["Trail Blazers"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // The batches are merged before piped to the executors working on the whole inputs
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto *fmt = "GO FROM %ld OVER like YIELD like._dst as id"
+                    "| GO FROM $-.id OVER like YIELD like._dst as id "
+                    "| GO FROM $-.id OVER serve YIELD DISTINCT serve._dst as id "
+                    "| ORDER BY $-.id";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<int64_t>> expected = {
+            {teams_["Spurs"].vid()},
+            {teams_["Hornets"].vid()},
+            {teams_["Trail Blazers"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    FLAGS_pipe_batch_size = 0;
+}
+
 INSTANTIATE_TEST_CASE_P(IfPushdownFilter, GoTest, ::testing::Bool());
 }   // namespace graph
 }   // namespace nebula
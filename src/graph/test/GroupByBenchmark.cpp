@@ -0,0 +1,148 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include "gen-cpp2/graph_types.h"
+#include "graph/AggregateFunction.h"
+#include "graph/AggregateHashTable.h"
+
+using nebula::graph::AggFun;
+using nebula::graph::AggKind;
+using nebula::graph::AggregateHashTable;
+using nebula::graph::ColVals;
+using nebula::graph::ColsHasher;
+using nebula::graph::cpp2::ColumnValue;
+using nebula::graph::cpp2::RowValue;
+
+// GROUP BY $-.name YIELD $-.name, COUNT(*), SUM($-.value), MAX($-.value)
+const std::vector<AggKind> kinds = {AggKind::GROUP, AggKind::COUNT, AggKind::SUM, AggKind::MAX};
+const std::vector<std::string> funNames = {"", nebula::graph::kCount,
+                                           nebula::graph::kSum, nebula::graph::kMax};
+
+std::vector<RowValue> makeRows(size_t rows, size_t groups) {
+    std::vector<RowValue> result;
+    result.reserve(rows);
+    for (size_t i = 0; i < rows; i++) {
+        std::vector<ColumnValue> columns(2);
+        columns[0].set_str(folly::stringPrintf("name_%lu", folly::Random::rand64(groups)));
+        columns[1].set_integer(folly::Random::rand64(1000));
+        result.emplace_back();
+        result.back().set_columns(std::move(columns));
+    }
+    return result;
+}
+
+size_t aggregate(const std::vector<RowValue> &rows, size_t begin, size_t end,
+                 AggregateHashTable &table) {
+    std::string key;
+    for (auto i = begin; i < end; i++) {
+        auto &columns = rows[i].columns;
+        key.clear();
+        AggregateHashTable::encodeValue(columns[0], key);
+        auto *states = table.findOrInsert(key);
+        table.apply(states, 0, columns[0]);
+        table.apply(states, 1, columns[1]);
+        table.apply(states, 2, columns[1]);
+        table.apply(states, 3, columns[1]);
+    }
+    return table.size();
+}
+
+size_t unorderedMap(size_t iters, size_t rowNum, size_t groups) {
+    std::vector<RowValue> rows;
+    BENCHMARK_SUSPEND {
+        rows = makeRows(rowNum, groups);
+    }
+    size_t size = 0;
+    for (size_t iter = 0; iter < iters; iter++) {
+        std::unordered_map<ColVals, std::vector<std::shared_ptr<AggFun>>, ColsHasher> data;
+        for (auto &row : rows) {
+            ColVals groupVals;
+            groupVals.vec.emplace_back(row.columns[0]);
+            auto findIt = data.find(groupVals);
+            if (findIt == data.end()) {
+                std::vector<std::shared_ptr<AggFun>> funs;
+                for (auto &name : funNames) {
+                    funs.emplace_back(nebula::graph::funVec[name]());
+                }
+                findIt = data.emplace(std::move(groupVals), std::move(funs)).first;
+            }
+            findIt->second[0]->apply(row.columns[0]);
+            for (size_t i = 1; i < funNames.size(); i++) {
+                findIt->second[i]->apply(row.columns[1]);
+            }
+        }
+        size += data.size();
+    }
+    folly::doNotOptimizeAway(size);
+    return iters * rowNum;
+}
+
+size_t hashTable(size_t iters, size_t rowNum, size_t groups) {
+    std::vector<RowValue> rows;
+    BENCHMARK_SUSPEND {
+        rows = makeRows(rowNum, groups);
+    }
+    size_t size = 0;
+    for (size_t iter = 0; iter < iters; iter++) {
+        AggregateHashTable table(kinds);
+        size += aggregate(rows, 0, rows.size(), table);
+    }
+    folly::doNotOptimizeAway(size);
+    return iters * rowNum;
+}
+
+size_t partitionedHashTable(size_t iters, size_t rowNum, size_t groups, size_t partitions) {
+    std::vector<RowValue> rows;
+    std::unique_ptr<folly::CPUThreadPoolExecutor> pool;
+    BENCHMARK_SUSPEND {
+        rows = makeRows(rowNum, groups);
+        pool = std::make_unique<folly::CPUThreadPoolExecutor>(partitions);
+    }
+    size_t size = 0;
+    for (size_t iter = 0; iter < iters; iter++) {
+        std::vector<folly::Future<std::unique_ptr<AggregateHashTable>>> futures;
+        auto step = (rows.size() + partitions - 1) / partitions;
+        for (size_t begin = 0; begin < rows.size(); begin += step) {
+            auto end = std::min(begin + step, rows.size());
+            futures.emplace_back(folly::via(pool.get(), [&rows, begin, end] () {
+                auto table = std::make_unique<AggregateHashTable>(kinds);
+                aggregate(rows, begin, end, *table);
+                return table;
+            }));
+        }
+        auto tables = folly::collectAll(std::move(futures)).get();
+        auto table = std::move(tables[0]).value();
+        for (size_t i = 1; i < tables.size(); i++) {
+            table->merge(std::move(*tables[i].value()));
+        }
+        size += table->size();
+    }
+    folly::doNotOptimizeAway(size);
+    return iters * rowNum;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(unorderedMap, 1M_rows_100_groups, 1000000, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTable, 1M_rows_100_groups, 1000000, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(partitionedHashTable, 1M_rows_100_groups_4_parts,
+                                     1000000, 100, 4)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(unorderedMap, 4M_rows_1M_groups, 4000000, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTable, 4M_rows_1M_groups, 4000000, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(partitionedHashTable, 4M_rows_1M_groups_4_parts,
+                                     4000000, 1000000, 4)
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "graph/NeighborCache.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+storage::cpp2::QueryResponse makeResponse(const std::vector<VertexID> &vids) {
+    storage::cpp2::QueryResponse resp;
+    std::unordered_map<EdgeType, nebula::cpp2::Schema> schemas;
+    schemas.emplace(1, nebula::cpp2::Schema());
+    resp.set_edge_schema(std::move(schemas));
+    std::vector<storage::cpp2::VertexData> vertices;
+    for (auto vid : vids) {
+        storage::cpp2::VertexData vdata;
+        vdata.set_vertex_id(vid);
+        storage::cpp2::EdgeData edge;
+        edge.set_type(1);
+        edge.set_data(folly::to<std::string>(vid));
+        vdata.set_edge_data(std::vector<storage::cpp2::EdgeData>{edge});
+        vertices.emplace_back(std::move(vdata));
+    }
+    resp.set_vertices(std::move(vertices));
+    return resp;
+}
+
+std::vector<VertexID> cachedVids(const std::vector<storage::cpp2::QueryResponse> &resps) {
+    std::vector<VertexID> vids;
+    for (auto &resp : resps) {
+        EXPECT_NE(nullptr, resp.get_edge_schema());
+        for (auto &vdata : resp.vertices) {
+            EXPECT_EQ(folly::to<std::string>(vdata.get_vertex_id()),
+                      vdata.get_edge_data()[0].get_data());
+            vids.emplace_back(vdata.get_vertex_id());
+        }
+    }
+    std::sort(vids.begin(), vids.end());
+    return vids;
+}
+
+}   // namespace
+
+
+TEST(NeighborCacheTest, GetAndPut) {
+    NeighborCache cache(1024, 4, 60 * 1000);
+    auto sig = NeighborCache::signature({1}, "", {});
+    std::vector<VertexID> misses;
+    auto hits = cache.get(1, sig, {1, 2, 3}, misses);
+    EXPECT_TRUE(hits.empty());
+    EXPECT_EQ((std::vector<VertexID>{1, 2, 3}), misses);
+
+    cache.put(1, sig, cache.version(1), {makeResponse({1, 2}), makeResponse({3})});
+    misses.clear();
+    hits = cache.get(1, sig, {1, 2, 3, 4}, misses);
+    EXPECT_EQ(2, hits.size());
+    EXPECT_EQ((std::vector<VertexID>{1, 2, 3}), cachedVids(hits));
+    EXPECT_EQ(std::vector<VertexID>{4}, misses);
+
+    // Different requests or spaces
+    misses.clear();
+    hits = cache.get(1, NeighborCache::signature({1, 2}, "", {}), {1}, misses);
+    EXPECT_TRUE(hits.empty());
+    misses.clear();
+    hits = cache.get(1, NeighborCache::signature({1}, "filter", {}), {1}, misses);
+    EXPECT_TRUE(hits.empty());
+    misses.clear();
+    hits = cache.get(2, sig, {1}, misses);
+    EXPECT_TRUE(hits.empty());
+}
+
+
+TEST(NeighborCacheTest, Invalidate) {
+    NeighborCache cache(1024, 4, 60 * 1000);
+    auto sig = NeighborCache::signature({1}, "", {});
+    auto version = cache.version(1);
+    cache.put(1, sig, version, {makeResponse({1, 2})});
+    cache.put(2, sig, cache.version(2), {makeResponse({1, 2})});
+    cache.invalidate(1);
+
+    std::vector<VertexID> misses;
+    auto hits = cache.get(1, sig, {1, 2}, misses);
+    EXPECT_TRUE(hits.empty());
+    EXPECT_EQ(2, misses.size());
+    misses.clear();
+    hits = cache.get(2, sig, {1, 2}, misses);
+    EXPECT_EQ((std::vector<VertexID>{1, 2}), cachedVids(hits));
+
+    // The results requested before the invalidation are dropped
+    cache.put(1, sig, version, {makeResponse({1, 2})});
+    misses.clear();
+    hits = cache.get(1, sig, {1, 2}, misses);
+    EXPECT_TRUE(hits.empty());
+}
+
+
+TEST(NeighborCacheTest, Expire) {
+    NeighborCache cache(1024, 4, 10);
+    auto sig = NeighborCache::signature({1}, "", {});
+    cache.put(1, sig, cache.version(1), {makeResponse({1})});
+    std::vector<VertexID> misses;
+    auto hits = cache.get(1, sig, {1}, misses);
+    EXPECT_EQ(std::vector<VertexID>{1}, cachedVids(hits));
+
+    usleep(50 * 1000);
+    misses.clear();
+    hits = cache.get(1, sig, {1}, misses);
+    EXPECT_TRUE(hits.empty());
+    EXPECT_EQ(std::vector<VertexID>{1}, misses);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -6,9 +6,12 @@
 
 #include "base/Base.h"
 #include <gtest/gtest.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/synchronization/Baton.h>
 #include "graph/SessionManager.h"
 #include "graph/GraphFlags.h"
 #include "thread/GenericWorker.h"
+#include "parser/GQLParser.h"
 
 using nebula::thread::GenericWorker;
 
@@ -78,5 +81,240 @@ TEST(SessionManager, ExpiredSession) {
     worker->wait();
 }
 
+TEST(SessionManager, SentenceCache) {
+    auto sm = std::make_shared<SessionManager>();
+    auto session = sm->createSession();
+
+    auto key = ClientSession::normalize("GO FROM  ? \n OVER   like ;");
+    ASSERT_EQ("GO FROM ?\nOVER like", key);
+    ASSERT_EQ(key, ClientSession::normalize(key));
+    // The quoted strings are kept as they are
+    ASSERT_EQ("YIELD \"a  b;\"", ClientSession::normalize("  YIELD  \"a  b;\";; "));
+    ASSERT_EQ("YIELD 'a \\'  b'", ClientSession::normalize("YIELD   'a \\'  b'"));
+
+    ASSERT_EQ(nullptr, session->takeSentences(key));
+    auto result = GQLParser().parse(key);
+    ASSERT_TRUE(result.ok());
+    std::shared_ptr<SequentialSentences> sentences = std::move(result).value();
+    auto *ptr = sentences.get();
+    session->putSentences(key, std::move(sentences));
+
+    // Taken out of the cache during the execution
+    auto cached = session->takeSentences(key);
+    ASSERT_EQ(ptr, cached.get());
+    ASSERT_EQ(nullptr, session->takeSentences(key));
+    session->putSentences(key, std::move(cached));
+    ASSERT_EQ(ptr, session->takeSentences(key).get());
+}
+
+TEST(SessionManager, PreparedStatement) {
+    gflags::FlagSaver saver;
+    FLAGS_max_prepared_statements_per_session = 2;
+    auto sm = std::make_shared<SessionManager>();
+    auto session = sm->createSession();
+
+    auto id1 = session->addPreparedStatement("YIELD ?");
+    ASSERT_TRUE(id1.ok());
+    auto id2 = session->addPreparedStatement("YIELD ?+1");
+    ASSERT_TRUE(id2.ok());
+    ASSERT_NE(id1.value(), id2.value());
+    // The same statement is prepared only once
+    auto again = session->addPreparedStatement("YIELD ?");
+    ASSERT_TRUE(again.ok());
+    ASSERT_EQ(id1.value(), again.value());
+
+    auto query = session->findPreparedStatement(id2.value());
+    ASSERT_TRUE(query.ok());
+    ASSERT_EQ("YIELD ?+1", query.value());
+    ASSERT_FALSE(session->findPreparedStatement(id2.value() + 100).ok());
+
+    // The least recently used one is deallocated if there are too many
+    auto id3 = session->addPreparedStatement("YIELD ?+2");
+    ASSERT_TRUE(id3.ok());
+    ASSERT_FALSE(session->findPreparedStatement(id1.value()).ok());
+    ASSERT_TRUE(session->findPreparedStatement(id2.value()).ok());
+    ASSERT_TRUE(session->findPreparedStatement(id3.value()).ok());
+}
+
+namespace {
+
+std::vector<cpp2::RowValue> makeRows(int64_t num, int64_t strSize = 0) {
+    std::vector<cpp2::RowValue> rows(num);
+    for (auto i = 0; i < num; i++) {
+        std::vector<cpp2::ColumnValue> columns(1);
+        if (strSize > 0) {
+            columns[0].set_str(std::string(strSize, 'a'));
+        } else {
+            columns[0].set_integer(i);
+        }
+        rows[i].set_columns(std::move(columns));
+    }
+    return rows;
+}
+
+}   // namespace
+
+TEST(SessionManager, Cursor) {
+    gflags::FlagSaver saver;
+    FLAGS_max_cursors_per_session = 2;
+    auto sm = std::make_shared<SessionManager>();
+    auto session = sm->createSession();
+    folly::CPUThreadPoolExecutor runner(1);
+
+    auto makeStream = [&runner] (int64_t num, int32_t chunkSize) {
+        auto stream = std::make_shared<ResultStream>(chunkSize, &runner);
+        stream->write(makeRows(num));
+        stream->finish(Status::OK());
+        return stream;
+    };
+
+    auto ret = session->addCursor(makeStream(5, 2));
+    ASSERT_TRUE(ret.ok());
+    auto id = ret.value();
+    std::vector<int64_t> fetched;
+    while (true) {
+        auto chunk = session->fetchCursor(id).get();
+        ASSERT_TRUE(chunk.ok());
+        ASSERT_GE(2, chunk.value().rows.size());
+        for (auto &row : chunk.value().rows) {
+            fetched.emplace_back(row.get_columns()[0].get_integer());
+        }
+        if (!chunk.value().more) {
+            break;
+        }
+    }
+    ASSERT_EQ(std::vector<int64_t>({0, 1, 2, 3, 4}), fetched);
+    session->closeCursor(id);
+    ASSERT_FALSE(session->fetchCursor(id).get().ok());
+
+    // The oldest one is closed if there are too many
+    auto id1 = session->addCursor(makeStream(3, 1)).value();
+    auto id2 = session->addCursor(makeStream(3, 1)).value();
+    auto id3 = session->addCursor(makeStream(3, 1)).value();
+    ASSERT_FALSE(session->fetchCursor(id1).get().ok());
+    ASSERT_TRUE(session->fetchCursor(id2).get().ok());
+    session->closeCursor(id3);
+    ASSERT_FALSE(session->fetchCursor(id3).get().ok());
+}
+
+TEST(SessionManager, StreamingCursor) {
+    auto sm = std::make_shared<SessionManager>();
+    auto session = sm->createSession();
+    folly::CPUThreadPoolExecutor runner(1);
+
+    // The first chunk is waited for before any row is produced
+    auto stream = std::make_shared<ResultStream>(2, &runner);
+    auto first = stream->read();
+    ASSERT_EQ(2, stream->room());
+    stream->write(makeRows(1));
+    ASSERT_FALSE(first.isReady());
+    ASSERT_EQ(1, stream->room());
+    stream->write(makeRows(1));
+    ASSERT_TRUE(first.isReady());
+    auto chunk = std::move(first).get();
+    ASSERT_TRUE(chunk.ok());
+    ASSERT_EQ(2, chunk.value().rows.size());
+    ASSERT_TRUE(chunk.value().more);
+
+    // The producer waits while a full chunk is not read
+    stream->write(makeRows(2));
+    ASSERT_EQ(0, stream->room());
+    ASSERT_EQ(2, stream->rows());
+    folly::Baton<> baton;
+    Status waited = Status::Error("Not called");
+    stream->waitRoom([&] (Status status) {
+        waited = std::move(status);
+        baton.post();
+    });
+    ASSERT_FALSE(baton.try_wait_for(std::chrono::milliseconds(10)));
+    auto id = session->addCursor(stream).value();
+    chunk = session->fetchCursor(id).get();
+    ASSERT_TRUE(chunk.ok());
+    ASSERT_EQ(2, chunk.value().rows.size());
+    ASSERT_TRUE(chunk.value().more);
+    baton.wait();
+    ASSERT_TRUE(waited.ok());
+    ASSERT_EQ(2, stream->room());
+
+    // The rest are read once the stream is finished
+    stream->write(makeRows(1));
+    auto next = session->fetchCursor(id);
+    ASSERT_FALSE(next.isReady());
+    // Only one fetch at a time
+    ASSERT_FALSE(session->fetchCursor(id).get().ok());
+    stream->finish(Status::OK());
+    chunk = std::move(next).get();
+    ASSERT_TRUE(chunk.ok());
+    ASSERT_EQ(1, chunk.value().rows.size());
+    ASSERT_FALSE(chunk.value().more);
+    session->closeCursor(id);
+
+    // The producer fails once the cursor is closed
+    stream = std::make_shared<ResultStream>(1, &runner);
+    stream->write(makeRows(1));
+    id = session->addCursor(stream).value();
+    baton.reset();
+    stream->waitRoom([&] (Status status) {
+        waited = std::move(status);
+        baton.post();
+    });
+    session->closeCursor(id);
+    baton.wait();
+    ASSERT_FALSE(waited.ok());
+    ASSERT_EQ(0, stream->rows());
+
+    // The failure of the producer is read by the cursor
+    stream = std::make_shared<ResultStream>(2, &runner);
+    id = session->addCursor(stream).value();
+    next = session->fetchCursor(id);
+    stream->write(makeRows(1));
+    stream->finish(Status::Error("Failed"));
+    ASSERT_FALSE(std::move(next).get().ok());
+}
+
+TEST(SessionManager, CursorLimits) {
+    gflags::FlagSaver saver;
+    FLAGS_max_cursors_per_session = 16;
+    FLAGS_max_cursor_rows_per_session = 5;
+    auto sm = std::make_shared<SessionManager>();
+    auto session = sm->createSession();
+    folly::CPUThreadPoolExecutor runner(1);
+
+    auto makeStream = [&runner] (int64_t num) {
+        auto stream = std::make_shared<ResultStream>(1, &runner);
+        stream->write(makeRows(num, 1024));
+        stream->finish(Status::OK());
+        return stream;
+    };
+
+    // The oldest cursors are closed to keep the rows of the session within the limit
+    auto id1 = session->addCursor(makeStream(3));
+    ASSERT_TRUE(id1.ok());
+    auto id2 = session->addCursor(makeStream(2));
+    ASSERT_TRUE(id2.ok());
+    auto id3 = session->addCursor(makeStream(2));
+    ASSERT_TRUE(id3.ok());
+    ASSERT_FALSE(session->fetchCursor(id1.value()).get().ok());
+    ASSERT_TRUE(session->fetchCursor(id2.value()).get().ok());
+    // Rows could not be kept at all
+    ASSERT_FALSE(session->addCursor(makeStream(6)).ok());
+
+    FLAGS_max_cursor_rows_per_session = 1000;
+    FLAGS_max_cursor_memory_mb = 1;
+    ASSERT_FALSE(session->addCursor(makeStream(1024)).ok());
+    ASSERT_TRUE(session->addCursor(makeStream(100)).ok());
+
+    // Idle cursors are closed
+    auto id4 = session->addCursor(makeStream(2));
+    ASSERT_TRUE(id4.ok());
+    auto id5 = session->addCursor(makeStream(2));
+    ASSERT_TRUE(id5.ok());
+    FLAGS_cursor_idle_timeout_secs = 0;
+    ASSERT_FALSE(session->fetchCursor(id4.value()).get().ok());
+    session->reclaimCursors();
+    FLAGS_cursor_idle_timeout_secs = 600;
+    ASSERT_FALSE(session->fetchCursor(id5.value()).get().ok());
+}
+
 }   // namespace graph
 }   // namespace nebula
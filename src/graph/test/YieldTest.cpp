@@ -651,5 +651,47 @@ TEST_F(YieldTest, EmptyInput) {
         ASSERT_TRUE(verifyResult(resp, expected));
     }
 }
+
+TEST_F(YieldTest, Prepared) {
+    auto client = gEnv->getClient();
+    ASSERT_NE(nullptr, client);
+    cpp2::PrepareResponse prepared;
+    auto code = client->prepare("YIELD ? + 1 AS a, ? AS b", prepared);
+    ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    ASSERT_EQ(2, *prepared.get_param_num());
+    auto id = *prepared.get_statement_id();
+    for (int64_t i = 0; i < 3; i++) {
+        cpp2::ExecutionResponse resp;
+        std::vector<cpp2::ColumnValue> params(2);
+        params[0].set_integer(i);
+        params[1].set_str(folly::to<std::string>("str", i));
+        code = client->executePrepared(id, params, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::string> expectedColNames{
+            {"a"}, {"b"}
+        };
+        ASSERT_TRUE(verifyColNames(resp, expectedColNames));
+        std::vector<std::tuple<int64_t, std::string>> expected{
+            {i + 1, folly::to<std::string>("str", i)}
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // Wrong number of parameters
+        cpp2::ExecutionResponse resp;
+        std::vector<cpp2::ColumnValue> params(1);
+        params[0].set_integer(1);
+        code = client->executePrepared(id, params, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    {
+        // Placeholders are not allowed in ordinary queries
+        cpp2::ExecutionResponse resp;
+        code = client->execute("YIELD ? + 1", resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_SYNTAX_ERROR, code);
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -111,6 +111,8 @@ struct ExecutionResponse {
     4: optional list<binary> column_names;  // Column names
     5: optional list<RowValue> rows;
     6: optional string space_name;
+    // Set if there are more rows to be fetched by the cursor
+    7: optional i64 cursor_id;
 }
 
 
@@ -121,10 +123,38 @@ struct AuthResponse {
 }
 
 
+struct PrepareResponse {
+    1: required ErrorCode error_code;
+    2: required i32 latency_in_us;
+    3: optional string error_msg;
+    4: optional i64 statement_id;
+    // Number of the placeholders `?' in the statement
+    5: optional i32 param_num;
+}
+
+
 service GraphService {
     AuthResponse authenticate(1: string username, 2: string password)
 
     oneway void signout(1: i64 sessionId)
 
     ExecutionResponse execute(1: i64 sessionId, 2: string stmt)
+
+    // Parse the statement with placeholders `?' once, and execute it with
+    // different parameters bound in order.
+    PrepareResponse prepare(1: i64 sessionId, 2: string stmt)
+
+    ExecutionResponse executePrepared(1: i64 sessionId,
+                                      2: i64 statementId,
+                                      3: list<ColumnValue> params)
+
+    // Return at most `chunkSize' rows, the rest are kept in a cursor of the session,
+    // which could be fetched chunk by chunk.
+    ExecutionResponse executeWithCursor(1: i64 sessionId,
+                                        2: string stmt,
+                                        3: i32 chunkSize)
+
+    ExecutionResponse fetch(1: i64 sessionId, 2: i64 cursorId)
+
+    oneway void closeCursor(1: i64 sessionId, 2: i64 cursorId)
 }
@@ -86,10 +86,23 @@ struct IdName {
     2: string name,
 }
 
+// How the vertices are mapped to the parts, see common/base/Partitioner.h
+enum PartitionStrategy {
+    HASH    = 0x00,
+    RANGE   = 0x01,
+} (cpp.enum_strict)
+
 struct SpaceProperties {
     1: string               space_name,
     2: i32                  partition_num,
     3: i32                  replica_factor,
+    // Only keep the latest version of vertices and edges, the version is not
+    // encoded in keys, so a write overwrites the old value in place.
+    4: bool                 single_version = false,
+    5: PartitionStrategy    partition_strategy = PartitionStrategy.HASH,
+    // The first vertex id of each part except the first one for RANGE,
+    // the id space is split evenly if not set.
+    6: list<common.VertexID> range_bounds,
 }
 
 struct SpaceItem {
@@ -200,6 +213,19 @@ struct ListSpacesResp {
     // Valid if ret equals E_LEADER_CHANGED.
     2: common.HostAddr  leader,
     3: list<IdName> spaces,
+    // The catalog versions of the spaces, the spaces without one should always be reloaded
+    4: map<common.GraphSpaceID, i64> (cpp.template = "std::unordered_map") versions,
+}
+
+struct GetCatalogVersionReq {
+}
+
+struct GetCatalogVersionResp {
+    1: ErrorCode code,
+    // Valid if ret equals E_LEADER_CHANGED.
+    2: common.HostAddr  leader,
+    // Bumped on each change of any space's parts or schemas, 0 if never bumped
+    3: i64 version,
 }
 
 struct GetSpaceReq {
@@ -394,9 +420,21 @@ struct HBResp {
     3: common.ClusterID cluster_id,
 }
 
+// The raft status of a part led by the host
+struct LeaderInfo {
+    1: common.PartitionID part_id,
+    2: i64                term,
+    3: i64                committed_log_id,
+    // The requests per second served by the part since the last heartbeat
+    4: i32                read_qps,
+    5: i32                write_qps,
+}
+
 struct HBReq {
     1: common.HostAddr host,
     2: common.ClusterID cluster_id,
+    3: map<common.GraphSpaceID, list<LeaderInfo>>
+        (cpp.template = "std::unordered_map") leader_infos,
 }
 
 struct CreateTagIndexReq {
@@ -548,6 +586,11 @@ enum TaskResult {
 struct BalanceTask {
     1: string id,
     2: TaskResult result,
+    // The current step of the task
+    3: string step,
+    // In milliseconds, 0 if not started or finished yet
+    4: i64 start_time,
+    5: i64 end_time,
 }
 
 struct BalanceResp {
@@ -650,6 +693,7 @@ service MetaService {
     ExecResp dropSpace(1: DropSpaceReq req);
     GetSpaceResp getSpace(1: GetSpaceReq req);
     ListSpacesResp listSpaces(1: ListSpacesReq req);
+    GetCatalogVersionResp getCatalogVersion(1: GetCatalogVersionReq req);
 
     ExecResp createTag(1: CreateTagReq req);
     ExecResp alterTag(1: AlterTagReq req);
@@ -25,6 +25,7 @@ enum ErrorCode {
     E_PART_NOT_FOUND = -14,
     E_KEY_NOT_FOUND = -15,
     E_CONSENSUS_ERROR = -16,
+    E_DEADLINE_EXCEEDED = -17,
 
     // meta failures
     E_EDGE_PROP_NOT_FOUND = -21,
@@ -171,6 +172,13 @@ struct GetNeighborsRequest {
     3: list<common.EdgeType> edge_types,
     4: binary filter,
     5: list<PropDef> return_columns,
+    // Only return the first edge to each dst of each edge type,
+    // which is used when only the _dst of edges is needed
+    6: bool distinct_dst,
+    // The client gives up after it, so the storage stops processing then. 0 for no limit
+    7: i32 timeout_ms,
+    // Could be served by a follower, for the hedged requests
+    8: bool read_follower,
 }
 
 struct VertexPropRequest {
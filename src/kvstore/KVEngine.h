@@ -27,6 +27,9 @@ public:
     // Remove all keys in the range [start, end)
     virtual ResultCode removeRange(folly::StringPiece start,
                                    folly::StringPiece end) = 0;
+
+    // Apply the operand on the key through the merge operator of the engine
+    virtual ResultCode merge(folly::StringPiece key, folly::StringPiece operand) = 0;
 };
 
 
@@ -61,6 +64,11 @@ public:
     virtual ResultCode prefix(const std::string& prefix,
                               std::unique_ptr<KVIterator>* iter) = 0;
 
+    // Get the first key/value with each prefix, the key is left empty if there is none.
+    // As versions are sorted in descending order, it's the latest version of each prefix.
+    virtual ResultCode multiPrefixFirst(const std::vector<std::string>& prefixes,
+                                        std::vector<KV>* kvs) = 0;
+
     // Get all results in range [start, end)
     virtual ResultCode put(std::string key, std::string value) = 0;
 
@@ -17,6 +17,7 @@
 #include "kvstore/CompactionFilter.h"
 #include "meta/SchemaManager.h"
 #include "base/ErrorOr.h"
+#include "base/NebulaKeyUtils.h"
 
 namespace nebula {
 namespace kvstore {
@@ -42,6 +43,9 @@ struct KVOptions {
      * Custom CompactionFilter used in compaction.
      * */
     std::unique_ptr<CompactionFilterFactoryBuilder> cffBuilder_{nullptr};
+
+    // The format of the vertex and edge keys written in this store.
+    NebulaKeyFormat keyFormat_{NebulaKeyFormat::kNative};
 };
 
 
@@ -62,6 +66,10 @@ public:
     // Return bit-OR of StoreCapability values;
     virtual uint32_t capability() const = 0;
 
+    // The format of the vertex and edge keys in the store, all keys passed in
+    // should be generated in it.
+    virtual NebulaKeyFormat keyFormat() const = 0;
+
     // Retrieve the current leader for the given partition. This
     // is usually called when ERR_LEADER_CHANGED result code is
     // returned
@@ -98,23 +106,42 @@ public:
                              std::string&& end,
                              std::unique_ptr<KVIterator>* iter) = delete;
 
-    // Get all results with prefix.
+    // Get all results with prefix. The reads with `canReadFromFollower' could be
+    // served by a running follower which has heard from the leader recently,
+    // so they might be a little behind the leader.
     virtual ResultCode prefix(GraphSpaceID spaceId,
                               PartitionID  partId,
                               const std::string& prefix,
-                              std::unique_ptr<KVIterator>* iter) = 0;
+                              std::unique_ptr<KVIterator>* iter,
+                              bool canReadFromFollower = false) = 0;
 
     // To forbid to pass rvalue via the `prefix' parameter.
     virtual ResultCode prefix(GraphSpaceID spaceId,
                               PartitionID  partId,
                               std::string&& prefix,
-                              std::unique_ptr<KVIterator>* iter) = delete;
+                              std::unique_ptr<KVIterator>* iter,
+                              bool canReadFromFollower = false) = delete;
+
+    // Get the first key/value with each prefix in one batch, instead of one
+    // `prefix' iterator per prefix. The key is left empty if there is none.
+    virtual ResultCode multiPrefixFirst(GraphSpaceID spaceId,
+                                        PartitionID  partId,
+                                        const std::vector<std::string>& prefixes,
+                                        std::vector<KV>* kvs,
+                                        bool canReadFromFollower = false) = 0;
 
     virtual void asyncMultiPut(GraphSpaceID spaceId,
                                PartitionID  partId,
                                std::vector<KV> keyValues,
                                KVCallback cb) = 0;
 
+    // Apply the operands on the keys through the merge operator,
+    // keyOperands is a list of <key, operand>
+    virtual void asyncMultiMerge(GraphSpaceID spaceId,
+                                 PartitionID  partId,
+                                 std::vector<KV> keyOperands,
+                                 KVCallback cb) = 0;
+
     // Asynchronous version of remove methods
     virtual void asyncRemove(GraphSpaceID spaceId,
                              PartitionID partId,
@@ -142,6 +169,14 @@ public:
                                raftex::AtomicOp op,
                                KVCallback cb) = 0;
 
+    // The ops on different conflict keys of one part could be replicated together,
+    // see RaftPart::atomicOpAsync
+    virtual void asyncAtomicOp(GraphSpaceID spaceId,
+                               PartitionID partId,
+                               std::string conflictKey,
+                               raftex::AtomicOp op,
+                               KVCallback cb) = 0;
+
     virtual ResultCode ingest(GraphSpaceID spaceId) = 0;
 
     virtual int32_t allLeader(std::unordered_map<GraphSpaceID,
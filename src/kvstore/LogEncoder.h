@@ -24,12 +24,14 @@ enum LogType : char {
     OP_ADD_PEER       = 0x09,
     OP_REMOVE_PEER    = 0x10,
     OP_BATCH_WRITE    = 0x11,
+    OP_MERGE          = 0x12,
 };
 
 enum BatchLogType : char {
     OP_BATCH_PUT            = 0x1,
     OP_BATCH_REMOVE         = 0x2,
     OP_BATCH_REMOVE_RANGE   = 0x3,
+    OP_BATCH_MERGE          = 0x4,
 };
 
 std::string encodeKV(const folly::StringPiece& key,
@@ -75,6 +77,12 @@ public:
                             std::make_pair(std::forward<std::string>(key), ""));
     }
 
+    void merge(std::string&& key, std::string&& operand) {
+        batch_.emplace_back(BatchLogType::OP_BATCH_MERGE,
+                            std::make_pair(std::forward<std::string>(key),
+                                           std::forward<std::string>(operand)));
+    }
+
     void rangeRemove(std::string&& begin, std::string&& end) {
         batch_.emplace_back(BatchLogType::OP_BATCH_REMOVE_RANGE,
                             std::make_pair(std::forward<std::string>(begin),
@@ -18,6 +18,9 @@ DEFINE_string(engine_type, "rocksdb", "rocksdb, memory...");
 DEFINE_int32(custom_filter_interval_secs, 24 * 3600, "interval to trigger custom compaction");
 DEFINE_int32(num_workers, 4, "Number of worker threads");
 DEFINE_bool(check_leader, true, "Check leader or not");
+DEFINE_int32(follower_read_max_lag_ms, 10000,
+             "Serve the follower reads only if the follower has heard from "
+             "the leader within the time");
 
 namespace nebula {
 namespace kvstore {
@@ -25,17 +28,26 @@ namespace kvstore {
 NebulaStore::~NebulaStore() {
     LOG(INFO) << "Cut off the relationship with meta client";
     options_.partMan_.reset();
-    LOG(INFO) << "Stop the raft service...";
-    raftService_->stop();
-    LOG(INFO) << "Waiting for the raft service stop...";
-    raftService_->waitUntilStop();
+    if (raftService_ != nullptr) {
+        LOG(INFO) << "Stop the raft service...";
+        raftService_->stop();
+        LOG(INFO) << "Waiting for the raft service stop...";
+        raftService_->waitUntilStop();
+    }
     spaces_.clear();
-    bgWorkers_->stop();
-    bgWorkers_->wait();
+    if (bgWorkers_ != nullptr) {
+        bgWorkers_->stop();
+        bgWorkers_->wait();
+    }
     LOG(INFO) << "~NebulaStore()";
 }
 
 bool NebulaStore::init() {
+    if (options_.keyFormat_ != NebulaKeyFormat::kNative
+            && options_.keyFormat_ != NebulaKeyFormat::kOrdered) {
+        LOG(ERROR) << "Unknown key format " << static_cast<uint32_t>(options_.keyFormat_);
+        return false;
+    }
     LOG(INFO) << "Start the raft service...";
     bgWorkers_ = std::make_shared<thread::GenericThreadPool>();
     bgWorkers_->start(FLAGS_num_workers, "nebula-bgworkers");
@@ -80,7 +92,12 @@ bool NebulaStore::init() {
                     KVEngine* enginePtr = nullptr;
                     {
                         folly::RWSpinLock::WriteHolder wh(&lock_);
-                        auto engine = newEngine(spaceId, path);
+                        auto engineRet = newEngine(spaceId, path);
+                        if (!engineRet.ok()) {
+                            LOG(ERROR) << engineRet.status();
+                            return false;
+                        }
+                        auto engine = std::move(engineRet).value();
                         auto spaceIt = this->spaces_.find(spaceId);
                         if (spaceIt == this->spaces_.end()) {
                             LOG(INFO) << "Load space " << spaceId << " from disk";
@@ -168,6 +185,10 @@ bool NebulaStore::init() {
     for (auto& entry : partsMap) {
         auto spaceId = entry.first;
         addSpace(spaceId);
+        if (!ok(space(spaceId))) {
+            LOG(ERROR) << "Failed to add space " << spaceId;
+            return false;
+        }
         std::vector<PartitionID> partIds;
         for (auto it = entry.second.begin(); it != entry.second.end(); it++) {
             partIds.emplace_back(it->first);
@@ -184,24 +205,59 @@ bool NebulaStore::init() {
 }
 
 
-std::unique_ptr<KVEngine> NebulaStore::newEngine(GraphSpaceID spaceId,
-                                                 const std::string& path) {
+StatusOr<std::unique_ptr<KVEngine>> NebulaStore::newEngine(GraphSpaceID spaceId,
+                                                           const std::string& path) {
     if (FLAGS_engine_type == "rocksdb") {
         std::shared_ptr<KVCompactionFilterFactory> cfFactory = nullptr;
         if (options_.cffBuilder_ != nullptr) {
             cfFactory = options_.cffBuilder_->buildCfFactory(spaceId,
                                                              FLAGS_custom_filter_interval_secs);
         }
-        return std::make_unique<RocksEngine>(spaceId,
-                                             path,
-                                             options_.mergeOp_,
-                                             cfFactory);
+        auto engine = std::make_unique<RocksEngine>(spaceId,
+                                                    path,
+                                                    options_.mergeOp_,
+                                                    cfFactory);
+        auto status = checkKeyFormat(spaceId, engine.get());
+        if (!status.ok()) {
+            return Status::Error("Space %d under %s: %s, please run key_format_upgrader first",
+                                 spaceId, path.c_str(), status.toString().c_str());
+        }
+        return std::unique_ptr<KVEngine>(std::move(engine));
     } else {
         LOG(FATAL) << "Unknown engine type " << FLAGS_engine_type;
         return nullptr;
     }
 }
 
+Status NebulaStore::checkKeyFormat(GraphSpaceID spaceId, KVEngine* engine) {
+    auto expected = static_cast<uint32_t>(options_.keyFormat_);
+    auto key = NebulaKeyUtils::systemKeyFormatKey();
+    std::string val;
+    auto ret = engine->get(key, &val);
+    if (ret == ResultCode::ERR_KEY_NOT_FOUND) {
+        if (!engine->allParts().empty()) {
+            // Written before the format is recorded
+            LOG(INFO) << "Space " << spaceId << " has no key format recorded, treat as native";
+            if (expected != static_cast<uint32_t>(NebulaKeyFormat::kNative)) {
+                return Status::Error("key format %u expected, but the data is native", expected);
+            }
+            return Status::OK();
+        }
+        if (engine->put(key, folly::to<std::string>(expected)) != ResultCode::SUCCEEDED) {
+            return Status::Error("failed to record the key format");
+        }
+        return Status::OK();
+    } else if (ret != ResultCode::SUCCEEDED) {
+        return Status::Error("failed to read the key format");
+    }
+    auto actual = folly::tryTo<uint32_t>(val);
+    if (!actual.hasValue() || actual.value() != expected) {
+        return Status::Error("key format %u expected, but the data is in %s",
+                             expected, val.c_str());
+    }
+    return Status::OK();
+}
+
 ErrorOr<ResultCode, HostAddr> NebulaStore::partLeader(GraphSpaceID spaceId, PartitionID partId) {
     folly::RWSpinLock::ReadHolder rh(&lock_);
     auto it = spaces_.find(spaceId);
@@ -223,17 +279,27 @@ void NebulaStore::addSpace(GraphSpaceID spaceId) {
         return;
     }
     LOG(INFO) << "Create space " << spaceId;
-    this->spaces_[spaceId] = std::make_unique<SpacePartInfo>();
+    auto spaceInfo = std::make_unique<SpacePartInfo>();
     for (auto& path : options_.dataPaths_) {
-        this->spaces_[spaceId]->engines_.emplace_back(newEngine(spaceId, path));
+        auto engineRet = newEngine(spaceId, path);
+        if (!engineRet.ok()) {
+            LOG(ERROR) << engineRet.status();
+            return;
+        }
+        spaceInfo->engines_.emplace_back(std::move(engineRet).value());
     }
+    this->spaces_[spaceId] = std::move(spaceInfo);
 }
 
 
 void NebulaStore::addPart(GraphSpaceID spaceId, PartitionID partId, bool asLearner) {
     folly::RWSpinLock::WriteHolder wh(&lock_);
     auto spaceIt = this->spaces_.find(spaceId);
-    CHECK(spaceIt != this->spaces_.end()) << "Space should exist!";
+    if (spaceIt == this->spaces_.end()) {
+        // The space failed to be added, e.g. its data is in another key format
+        LOG(ERROR) << "Space " << spaceId << " does not exist, skip part " << partId;
+        return;
+    }
     if (spaceIt->second->parts_.find(partId) != spaceIt->second->parts_.end()) {
         LOG(INFO) << "[" << spaceId << "," << partId << "] has existed!";
         return;
@@ -355,6 +421,7 @@ ResultCode NebulaStore::get(GraphSpaceID spaceId,
     if (!checkLeader(part)) {
         return ResultCode::ERR_LEADER_CHANGED;
     }
+    part->addRead();
     return part->engine()->get(key, value);
 }
 
@@ -371,6 +438,7 @@ ResultCode NebulaStore::multiGet(GraphSpaceID spaceId,
     if (!checkLeader(part)) {
         return ResultCode::ERR_LEADER_CHANGED;
     }
+    part->addRead();
     return part->engine()->multiGet(keys, values);
 }
 
@@ -388,6 +456,7 @@ ResultCode NebulaStore::range(GraphSpaceID spaceId,
     if (!checkLeader(part)) {
         return ResultCode::ERR_LEADER_CHANGED;
     }
+    part->addRead();
     return part->engine()->range(start, end, iter);
 }
 
@@ -395,18 +464,38 @@ ResultCode NebulaStore::range(GraphSpaceID spaceId,
 ResultCode NebulaStore::prefix(GraphSpaceID spaceId,
                                PartitionID partId,
                                const std::string& prefix,
-                               std::unique_ptr<KVIterator>* iter) {
+                               std::unique_ptr<KVIterator>* iter,
+                               bool canReadFromFollower) {
     auto ret = part(spaceId, partId);
     if (!ok(ret)) {
         return error(ret);
     }
     auto part = nebula::value(ret);
-    if (!checkLeader(part)) {
+    if (canReadFromFollower ? !checkFollower(part) : !checkLeader(part)) {
         return ResultCode::ERR_LEADER_CHANGED;
     }
+    part->addRead();
     return part->engine()->prefix(prefix, iter);
 }
 
+
+ResultCode NebulaStore::multiPrefixFirst(GraphSpaceID spaceId,
+                                         PartitionID partId,
+                                         const std::vector<std::string>& prefixes,
+                                         std::vector<KV>* kvs,
+                                         bool canReadFromFollower) {
+    auto ret = part(spaceId, partId);
+    if (!ok(ret)) {
+        return error(ret);
+    }
+    auto part = nebula::value(ret);
+    if (canReadFromFollower ? !checkFollower(part) : !checkLeader(part)) {
+        return ResultCode::ERR_LEADER_CHANGED;
+    }
+    part->addRead();
+    return part->engine()->multiPrefixFirst(prefixes, kvs);
+}
+
 void NebulaStore::asyncMultiPut(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 std::vector<KV> keyValues,
@@ -417,10 +506,26 @@ void NebulaStore::asyncMultiPut(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncMultiPut(std::move(keyValues), std::move(cb));
 }
 
 
+void NebulaStore::asyncMultiMerge(GraphSpaceID spaceId,
+                                  PartitionID partId,
+                                  std::vector<KV> keyOperands,
+                                  KVCallback cb) {
+    auto ret = part(spaceId, partId);
+    if (!ok(ret)) {
+        cb(error(ret));
+        return;
+    }
+    auto part = nebula::value(ret);
+    part->addWrite();
+    part->asyncMultiMerge(std::move(keyOperands), std::move(cb));
+}
+
+
 void NebulaStore::asyncRemove(GraphSpaceID spaceId,
                               PartitionID partId,
                               const std::string& key,
@@ -431,6 +536,7 @@ void NebulaStore::asyncRemove(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncRemove(key, std::move(cb));
 }
 
@@ -445,6 +551,7 @@ void NebulaStore::asyncMultiRemove(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncMultiRemove(std::move(keys), std::move(cb));
 }
 
@@ -460,6 +567,7 @@ void NebulaStore::asyncRemoveRange(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncRemoveRange(start, end, std::move(cb));
 }
 
@@ -474,6 +582,7 @@ void NebulaStore::asyncRemovePrefix(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncRemovePrefix(prefix, std::move(cb));
 }
 
@@ -487,9 +596,25 @@ void NebulaStore::asyncAtomicOp(GraphSpaceID spaceId,
         return;
     }
     auto part = nebula::value(ret);
+    part->addWrite();
     part->asyncAtomicOp(std::move(op), std::move(cb));
 }
 
+void NebulaStore::asyncAtomicOp(GraphSpaceID spaceId,
+                                PartitionID partId,
+                                std::string conflictKey,
+                                raftex::AtomicOp op,
+                                KVCallback cb) {
+    auto ret = part(spaceId, partId);
+    if (!ok(ret)) {
+        cb(error(ret));
+        return;
+    }
+    auto part = nebula::value(ret);
+    part->addWrite();
+    part->asyncAtomicOp(std::move(conflictKey), std::move(op), std::move(cb));
+}
+
 ErrorOr<ResultCode, std::shared_ptr<Part>> NebulaStore::part(GraphSpaceID spaceId,
                                                              PartitionID partId) {
     folly::RWSpinLock::ReadHolder rh(&lock_);
@@ -753,11 +878,47 @@ int32_t NebulaStore::allLeader(std::unordered_map<GraphSpaceID,
     return count;
 }
 
+int32_t NebulaStore::allLeaderInfo(std::unordered_map<GraphSpaceID,
+                                                      std::vector<meta::cpp2::LeaderInfo>>&
+                                                      leaderInfos) {
+    folly::RWSpinLock::ReadHolder rh(&lock_);
+    int32_t count = 0;
+    for (const auto& spaceIt : spaces_) {
+        auto spaceId = spaceIt.first;
+        for (const auto& partIt : spaceIt.second->parts_) {
+            // Restart the counting on the followers too, for the case they become leaders
+            auto load = partIt.second->takeLoad();
+            if (partIt.second->isLeader()) {
+                meta::cpp2::LeaderInfo info;
+                info.set_part_id(partIt.first);
+                info.set_term(partIt.second->termId());
+                info.set_committed_log_id(partIt.second->committedLogId());
+                info.set_read_qps(load.first);
+                info.set_write_qps(load.second);
+                leaderInfos[spaceId].emplace_back(std::move(info));
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
 bool NebulaStore::checkLeader(std::shared_ptr<Part> part) const {
     return !FLAGS_check_leader || part->isLeader();
 }
 
 
+bool NebulaStore::checkFollower(std::shared_ptr<Part> part) const {
+    if (checkLeader(part)) {
+        return true;
+    }
+    // A learner, or a part catching up by snapshot, could be far behind the leader
+    return part->isRunning()
+        && part->isFollower()
+        && part->lastMsgRecvInMSec() <= static_cast<uint64_t>(FLAGS_follower_read_max_lag_ms);
+}
+
+
 }  // namespace kvstore
 }  // namespace nebula
 
@@ -72,6 +72,10 @@ public:
     // the current store instance
     bool init();
 
+    NebulaKeyFormat keyFormat() const override {
+        return options_.keyFormat_;
+    }
+
     uint32_t capability() const override {
         return 0;
     }
@@ -116,7 +120,14 @@ public:
     ResultCode prefix(GraphSpaceID spaceId,
                       PartitionID  partId,
                       const std::string& prefix,
-                      std::unique_ptr<KVIterator>* iter) override;
+                      std::unique_ptr<KVIterator>* iter,
+                      bool canReadFromFollower = false) override;
+
+    ResultCode multiPrefixFirst(GraphSpaceID spaceId,
+                                PartitionID  partId,
+                                const std::vector<std::string>& prefixes,
+                                std::vector<KV>* kvs,
+                                bool canReadFromFollower = false) override;
 
     // async batch put.
     void asyncMultiPut(GraphSpaceID spaceId,
@@ -124,6 +135,11 @@ public:
                        std::vector<KV> keyValues,
                        KVCallback cb) override;
 
+    void asyncMultiMerge(GraphSpaceID spaceId,
+                         PartitionID  partId,
+                         std::vector<KV> keyOperands,
+                         KVCallback cb) override;
+
     void asyncRemove(GraphSpaceID spaceId,
                      PartitionID partId,
                      const std::string& key,
@@ -150,6 +166,12 @@ public:
                        raftex::AtomicOp op,
                        KVCallback cb) override;
 
+    void asyncAtomicOp(GraphSpaceID spaceId,
+                       PartitionID partId,
+                       std::string conflictKey,
+                       raftex::AtomicOp op,
+                       KVCallback cb) override;
+
     ErrorOr<ResultCode, std::shared_ptr<Part>> part(GraphSpaceID spaceId,
                                                     PartitionID partId) override;
 
@@ -189,6 +211,10 @@ public:
 
     void removePart(GraphSpaceID spaceId, PartitionID partId) override;
 
+    int32_t allLeaderInfo(std::unordered_map<GraphSpaceID,
+                                             std::vector<meta::cpp2::LeaderInfo>>& leaderInfos)
+                                             override;
+
     ErrorOr<ResultCode, std::shared_ptr<SpacePartInfo>> space(GraphSpaceID spaceId);
 
 private:
@@ -196,7 +222,15 @@ private:
                            const std::unordered_map<std::string, std::string>& options,
                            bool isDbOption) override;
 
-    std::unique_ptr<KVEngine> newEngine(GraphSpaceID spaceId, const std::string& path);
+    StatusOr<std::unique_ptr<KVEngine>> newEngine(GraphSpaceID spaceId,
+                                                  const std::string& path);
+
+    /**
+     * Make sure the keys in engine are written in the configured key format.
+     * The format is recorded in a fresh engine, an engine without the record
+     * but with parts is treated as NebulaKeyFormat::kNative.
+     * */
+    Status checkKeyFormat(GraphSpaceID spaceId, KVEngine* engine);
 
     std::shared_ptr<Part> newPart(GraphSpaceID spaceId,
                                   PartitionID partId,
@@ -207,6 +241,9 @@ private:
 
     bool checkLeader(std::shared_ptr<Part> part) const;
 
+    // Whether the part could serve the reads which allow followers
+    bool checkFollower(std::shared_ptr<Part> part) const;
+
 private:
     // The lock used to protect spaces_
     folly::RWSpinLock lock_;
@@ -7,6 +7,7 @@
 #include "kvstore/Part.h"
 #include "kvstore/LogEncoder.h"
 #include "base/NebulaKeyUtils.h"
+#include "time/WallClock.h"
 
 DEFINE_int32(cluster_id, 0, "A unique id for each cluster");
 
@@ -36,7 +37,18 @@ Part::Part(GraphSpaceID spaceId,
         , spaceId_(spaceId)
         , partId_(partId)
         , walPath_(walPath)
-        , engine_(engine) {
+        , engine_(engine)
+        , lastLoadTimeMs_(time::WallClock::fastNowInMilliSec()) {
+}
+
+
+std::pair<int32_t, int32_t> Part::takeLoad() {
+    auto now = time::WallClock::fastNowInMilliSec();
+    auto elapsed = std::max<int64_t>(now - lastLoadTimeMs_.exchange(now), 1000);
+    auto reads = reads_.exchange(0);
+    auto writes = writes_.exchange(0);
+    return std::make_pair(static_cast<int32_t>(reads * 1000 / elapsed),
+                          static_cast<int32_t>(writes * 1000 / elapsed));
 }
 
 
@@ -78,6 +90,16 @@ void Part::asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb) {
 }
 
 
+void Part::asyncMultiMerge(const std::vector<KV>& keyOperands, KVCallback cb) {
+    std::string log = encodeMultiValues(OP_MERGE, keyOperands);
+
+    appendAsync(FLAGS_cluster_id, std::move(log))
+        .thenValue([this, callback = std::move(cb)] (AppendLogResult res) mutable {
+            callback(this->toResultCode(res));
+        });
+}
+
+
 void Part::asyncRemove(folly::StringPiece key, KVCallback cb) {
     std::string log = encodeSingleValue(OP_REMOVE, key);
 
@@ -133,6 +155,13 @@ void Part::asyncAtomicOp(raftex::AtomicOp op, KVCallback cb) {
     });
 }
 
+void Part::asyncAtomicOp(std::string conflictKey, raftex::AtomicOp op, KVCallback cb) {
+    atomicOpAsync(std::move(op), std::move(conflictKey)).thenValue(
+            [this, callback = std::move(cb)] (AppendLogResult res) mutable {
+        callback(this->toResultCode(res));
+    });
+}
+
 void Part::asyncAddLearner(const HostAddr& learner, KVCallback cb) {
     std::string log = encodeHost(OP_ADD_LEARNER, learner);
     sendCommandAsync(std::move(log))
@@ -276,6 +305,8 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                     code = batch->remove(op.second.first);
                 } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
                     code = batch->removeRange(op.second.first, op.second.second);
+                } else if (op.first == BatchLogType::OP_BATCH_MERGE) {
+                    code = batch->merge(op.second.first, op.second.second);
                 }
                 if (code != ResultCode::SUCCEEDED) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch";
@@ -284,6 +315,17 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             }
             break;
         }
+        case OP_MERGE: {
+            auto kvs = decodeMultiValues(log);
+            DCHECK_EQ((kvs.size() + 1) / 2, kvs.size() / 2);
+            for (size_t i = 0; i < kvs.size(); i += 2) {
+                if (batch->merge(kvs[i], kvs[i + 1]) != ResultCode::SUCCEEDED) {
+                    LOG(ERROR) << idStr_ << "Failed to call WriteBatch::merge()";
+                    return false;
+                }
+            }
+            break;
+        }
         case OP_ADD_PEER:
         case OP_ADD_LEARNER: {
             break;
@@ -42,6 +42,7 @@ public:
 
     void asyncPut(folly::StringPiece key, folly::StringPiece value, KVCallback cb);
     void asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb);
+    void asyncMultiMerge(const std::vector<KV>& keyOperands, KVCallback cb);
 
     void asyncRemove(folly::StringPiece key, KVCallback cb);
     void asyncMultiRemove(const std::vector<std::string>& keys, KVCallback cb);
@@ -51,6 +52,7 @@ public:
                           KVCallback cb);
 
     void asyncAtomicOp(raftex::AtomicOp op, KVCallback cb);
+    void asyncAtomicOp(std::string conflictKey, raftex::AtomicOp op, KVCallback cb);
 
     void asyncAddLearner(const HostAddr& learner, KVCallback cb);
 
@@ -73,6 +75,18 @@ public:
         newLeaderCb_ = nullptr;
     }
 
+    // Count the requests served by the part, which are reported to meta as its load
+    void addRead() {
+        reads_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void addWrite() {
+        writes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The read and write requests per second since the last call
+    std::pair<int32_t, int32_t> takeLoad();
+
     // clean up all data about this part.
     void reset() {
         LOG(INFO) << idStr_ << "Clean up all wals";
@@ -133,6 +147,9 @@ protected:
     std::string walPath_;
     KVEngine* engine_ = nullptr;
     NewLeaderCallback newLeaderCb_ = nullptr;
+    std::atomic<int64_t> reads_{0};
+    std::atomic<int64_t> writes_{0};
+    std::atomic<int64_t> lastLoadTimeMs_{0};
 };
 
 }  // namespace kvstore
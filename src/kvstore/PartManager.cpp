@@ -166,5 +166,14 @@ void MetaServerBasedPartManager::onPartUpdated(const PartMeta& partMeta) {
     UNUSED(partMeta);
 }
 
+void MetaServerBasedPartManager::fetchLeaderInfo(
+        std::unordered_map<GraphSpaceID, std::vector<meta::cpp2::LeaderInfo>>& leaderInfos) {
+    if (handler_ != nullptr) {
+        handler_->allLeaderInfo(leaderInfos);
+    } else {
+        VLOG(1) << "handler_ is nullptr!";
+    }
+}
+
 }  // namespace kvstore
 }  // namespace nebula
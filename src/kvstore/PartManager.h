@@ -24,6 +24,8 @@ public:
                                    bool isDbOption) = 0;
     virtual void removeSpace(GraphSpaceID spaceId) = 0;
     virtual void removePart(GraphSpaceID spaceId, PartitionID partId) = 0;
+    virtual int32_t allLeaderInfo(
+        std::unordered_map<GraphSpaceID, std::vector<meta::cpp2::LeaderInfo>>& leaderInfos) = 0;
 };
 
 
@@ -167,6 +169,10 @@ public:
 
      void onPartUpdated(const PartMeta& partMeta) override;
 
+     void fetchLeaderInfo(std::unordered_map<GraphSpaceID,
+                                             std::vector<meta::cpp2::LeaderInfo>>& leaderInfos)
+                                             override;
+
      HostAddr getLocalHost() {
         return localHost_;
      }
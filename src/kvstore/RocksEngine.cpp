@@ -7,6 +7,7 @@
 #include "base/Base.h"
 #include "kvstore/RocksEngine.h"
 #include <folly/String.h>
+#include <numeric>
 #include "fs/FileUtils.h"
 #include "kvstore/KVStore.h"
 #include "kvstore/RocksEngineConfig.h"
@@ -78,6 +79,14 @@ public:
         }
     }
 
+    ResultCode merge(folly::StringPiece key, folly::StringPiece operand) override {
+        if (batch_.Merge(toSlice(key), toSlice(operand)).ok()) {
+            return ResultCode::SUCCEEDED;
+        } else {
+            return ResultCode::ERR_UNKNOWN;
+        }
+    }
+
     rocksdb::WriteBatch* data() {
         return &batch_;
     }
@@ -198,6 +207,44 @@ ResultCode RocksEngine::prefix(const std::string& prefix,
 }
 
 
+ResultCode RocksEngine::multiPrefixFirst(const std::vector<std::string>& prefixes,
+                                         std::vector<KV>* kvs) {
+    kvs->clear();
+    kvs->resize(prefixes.size());
+    // Seek the prefixes in order through one iterator, so it only moves forward
+    std::vector<size_t> order(prefixes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&prefixes] (size_t a, size_t b) {
+        return prefixes[a] < prefixes[b];
+    });
+    rocksdb::ReadOptions options;
+    std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+    if (!iter) {
+        return ResultCode::ERR_UNKNOWN;
+    }
+    for (auto index : order) {
+        rocksdb::Slice prefix(prefixes[index]);
+        // No need to seek if the iterator is already at or beyond the prefix,
+        // since there is no key between the last prefix and the current one.
+        if (!iter->Valid() || iter->key().compare(prefix) < 0) {
+            iter->Seek(prefix);
+        }
+        if (!iter->Valid()) {
+            if (!iter->status().ok()) {
+                VLOG(3) << "MultiPrefixFirst Failed: " << iter->status().ToString();
+                return ResultCode::ERR_UNKNOWN;
+            }
+            // All the remaining prefixes are beyond the last key
+            break;
+        }
+        if (iter->key().starts_with(prefix)) {
+            (*kvs)[index] = std::make_pair(iter->key().ToString(), iter->value().ToString());
+        }
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
 ResultCode RocksEngine::put(std::string key, std::string value) {
     rocksdb::WriteOptions options;
     options.disableWAL = FLAGS_rocksdb_disable_wal;
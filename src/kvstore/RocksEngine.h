@@ -127,6 +127,9 @@ public:
     ResultCode prefix(const std::string& prefix,
                       std::unique_ptr<KVIterator>* iter) override;
 
+    ResultCode multiPrefixFirst(const std::vector<std::string>& prefixes,
+                                std::vector<KV>* kvs) override;
+
     /*********************
      * Data modification
      ********************/
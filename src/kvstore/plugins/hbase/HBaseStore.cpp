@@ -49,14 +49,14 @@ std::shared_ptr<const meta::SchemaProviderIf> HBaseStore::getSchema(GraphSpaceID
                                                                     SchemaVer version) {
     std::shared_ptr<const meta::SchemaProviderIf> schema;
     folly::StringPiece rawKey = key;
-    if (NebulaKeyUtils::isVertex(key)) {
-        TagID tagId = NebulaKeyUtils::getTagId(rawKey);
+    if (NebulaKeyUtils::isVertex(key, options_.keyFormat_)) {
+        TagID tagId = NebulaKeyUtils::getTagId(rawKey, options_.keyFormat_);
         if (version == -1) {
             version = schemaMan_->getNewestTagSchemaVer(spaceId, tagId).value();
         }
         schema = schemaMan_->getTagSchema(spaceId, tagId, version);
-    } else if (NebulaKeyUtils::isEdge(key)) {
-        EdgeType edgeTypeId = NebulaKeyUtils::getEdgeType(rawKey);
+    } else if (NebulaKeyUtils::isEdge(key, options_.keyFormat_)) {
+        EdgeType edgeTypeId = NebulaKeyUtils::getEdgeType(rawKey, options_.keyFormat_);
         if (version == -1) {
             version = schemaMan_->getNewestEdgeSchemaVer(spaceId, edgeTypeId).value();
         }
@@ -272,12 +272,37 @@ ResultCode HBaseStore::range(GraphSpaceID spaceId,
 ResultCode HBaseStore::prefix(GraphSpaceID spaceId,
                               PartitionID partId,
                               const std::string& prefix,
-                              std::unique_ptr<KVIterator>* iter) {
+                              std::unique_ptr<KVIterator>* iter,
+                              bool canReadFromFollower) {
     UNUSED(partId);
+    UNUSED(canReadFromFollower);
     return this->prefix(spaceId, prefix, iter);
 }
 
 
+ResultCode HBaseStore::multiPrefixFirst(GraphSpaceID spaceId,
+                                        PartitionID partId,
+                                        const std::vector<std::string>& prefixes,
+                                        std::vector<KV>* kvs,
+                                        bool canReadFromFollower) {
+    UNUSED(partId);
+    UNUSED(canReadFromFollower);
+    kvs->clear();
+    kvs->resize(prefixes.size());
+    for (size_t index = 0; index < prefixes.size(); index++) {
+        std::unique_ptr<KVIterator> iter;
+        auto code = this->prefix(spaceId, prefixes[index], &iter);
+        if (code != ResultCode::SUCCEEDED) {
+            return code;
+        }
+        if (iter && iter->valid()) {
+            (*kvs)[index] = std::make_pair(iter->key().str(), iter->val().str());
+        }
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
 void HBaseStore::asyncMultiPut(GraphSpaceID spaceId,
                                PartitionID partId,
                                std::vector<KV> keyValues,
@@ -65,6 +65,10 @@ public:
     // Connect to the HBase thrift server.
     void init();
 
+    NebulaKeyFormat keyFormat() const override {
+        return options_.keyFormat_;
+    }
+
     uint32_t capability() const override {
         return 0;
     }
@@ -97,7 +101,14 @@ public:
     ResultCode prefix(GraphSpaceID spaceId,
                       PartitionID  partId,
                       const std::string& prefix,
-                      std::unique_ptr<KVIterator>* iter) override;
+                      std::unique_ptr<KVIterator>* iter,
+                      bool canReadFromFollower = false) override;
+
+    ResultCode multiPrefixFirst(GraphSpaceID spaceId,
+                                PartitionID  partId,
+                                const std::vector<std::string>& prefixes,
+                                std::vector<KV>* kvs,
+                                bool canReadFromFollower = false) override;
 
     // async batch put.
     void asyncMultiPut(GraphSpaceID spaceId,
@@ -105,6 +116,13 @@ public:
                        std::vector<KV> keyValues,
                        KVCallback cb) override;
 
+    void asyncMultiMerge(GraphSpaceID,
+                         PartitionID,
+                         std::vector<KV>,
+                         KVCallback) override {
+        LOG(FATAL) << "Not supportted yet!";
+    }
+
     void asyncRemove(GraphSpaceID spaceId,
                      PartitionID partId,
                      const std::string& key,
@@ -133,6 +151,14 @@ public:
         LOG(FATAL) << "Not supportted yet!";
     }
 
+    void asyncAtomicOp(GraphSpaceID,
+                       PartitionID,
+                       std::string,
+                       raftex::AtomicOp,
+                       KVCallback) override {
+        LOG(FATAL) << "Not supportted yet!";
+    }
+
     ResultCode ingest(GraphSpaceID spaceId) override;
 
     int32_t allLeader(std::unordered_map<GraphSpaceID,
@@ -97,7 +97,8 @@ private:
     void setResponse(const cpp2::AppendLogResponse& r);
 
     thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient>& tcManager() {
-        static thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient> manager;
+        static thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient> manager(
+            "raftex_client", true);
         return manager;
     }
 
@@ -27,6 +27,9 @@ DEFINE_uint32(raft_heartbeat_interval_secs, 5,
 DEFINE_uint64(raft_snapshot_timeout, 60 * 5, "Max seconds between two snapshot requests");
 
 DEFINE_uint32(max_batch_size, 256, "The max number of logs in a batch");
+DEFINE_uint32(max_atomic_op_group_size, 64,
+              "The max number of atomic ops with different conflict keys which "
+              "could be evaluated and replicated together, 1 means no grouping");
 
 DEFINE_int32(wal_ttl, 86400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
@@ -54,10 +57,10 @@ public:
             , logs_(std::move(logs))
             , opCB_(std::move(opCB)) {
         leadByAtomicOp_ = processAtomicOp();
-        valid_ = idx_ < logs_.size();
+        valid_ = leadByAtomicOp_ || idx_ < logs_.size();
         hasNonAtomicOpLogs_ = !leadByAtomicOp_ && valid_;
         if (valid_) {
-            currLogType_ = lastLogType_ = logType();
+            currLogType_ = lastLogType_ = leadByAtomicOp_ ? LogType::ATOMIC_OP : logType();
         }
     }
 
@@ -79,35 +82,81 @@ public:
         return firstLogId_;
     }
 
+    // The results of the AtomicOps in the leading group, in the order they were
+    // appended. The first one is always SUCCEEDED when leadByAtomicOp() is true.
+    const std::vector<AppendLogResult>& atomicOpResults() const {
+        return opCodes_;
+    }
+
     // Return true if the current log is a AtomicOp, otherwise return false
+    //
+    // Consecutive AtomicOps carrying distinct conflict keys are evaluated together
+    // and the succeeded ones are written as one group of logs, so they share one
+    // round of WAL writing, replication and commit. The failed ops in front of the
+    // first succeeded one are reported through opCB_ right away, the others
+    // are reported via atomicOpResults() once the group is committed.
     bool processAtomicOp() {
+        opResults_.clear();
+        opCodes_.clear();
+        opIdx_ = 0;
+        bool groupable = false;
+        std::unordered_set<folly::StringPiece> conflictKeys;
         while (idx_ < logs_.size()) {
             auto& tup = logs_.at(idx_);
             auto logType = std::get<1>(tup);
             if (logType != LogType::ATOMIC_OP) {
                 // Not a AtomicOp
-                return false;
+                break;
             }
 
-            // Process AtomicOp log
-            CHECK(!!opCB_);
-            opResult_ = opCB_(std::move(std::get<3>(tup)));
-            if (opResult_.size() > 0) {
-                // AtomicOp Succeeded
-                return true;
-            } else {
-                // AtomicOp failed, move to the next log, but do not increment the logId_
+            if (opResults_.empty()) {
+                // Process the leading AtomicOp log
+                CHECK(!!opCB_);
+                auto result = opCB_(std::move(std::get<3>(tup)));
+                if (result.size() > 0) {
+                    // AtomicOp Succeeded
+                    opResults_.emplace_back(std::get<0>(tup), std::move(result));
+                    opCodes_.emplace_back(AppendLogResult::SUCCEEDED);
+                    groupable = !std::get<2>(tup).empty();
+                    conflictKeys.emplace(std::get<2>(tup));
+                }
+                // If AtomicOp failed, move to the next log, but do not increment the logId_
                 ++idx_;
+                continue;
+            }
+
+            // Try to put the AtomicOp into the current group
+            folly::StringPiece key = std::get<2>(tup);
+            if (!groupable
+                    || key.empty()
+                    || conflictKeys.count(key) > 0
+                    || opCodes_.size() >= FLAGS_max_atomic_op_group_size) {
+                break;
+            }
+            conflictKeys.emplace(key);
+            auto result = std::get<3>(tup)();
+            if (result.size() > 0) {
+                opResults_.emplace_back(std::get<0>(tup), std::move(result));
+                opCodes_.emplace_back(AppendLogResult::SUCCEEDED);
+            } else {
+                opCodes_.emplace_back(AppendLogResult::E_ATOMIC_OP_FAILURE);
             }
+            ++idx_;
         }
 
-        // Reached the end
-        return false;
+        return !opResults_.empty();
     }
 
     LogIterator& operator++() override {
-        ++idx_;
         ++logId_;
+        if (inOpGroup()) {
+            // idx_ already points to the first log after the group
+            if (++opIdx_ < opResults_.size()) {
+                return *this;
+            }
+        } else {
+            ++idx_;
+        }
         if (idx_ < logs_.size()) {
             currLogType_ = logType();
             valid_ = currLogType_ != LogType::ATOMIC_OP;
@@ -139,13 +188,17 @@ public:
 
     ClusterID logSource() const override {
         DCHECK(valid());
-        return std::get<0>(logs_.at(idx_));
+        if (inOpGroup()) {
+            return opResults_[opIdx_].first;
+        } else {
+            return std::get<0>(logs_.at(idx_));
+        }
     }
 
     folly::StringPiece logMsg() const override {
         DCHECK(valid());
-        if (currLogType_ == LogType::ATOMIC_OP) {
-            return opResult_;
+        if (inOpGroup()) {
+            return opResults_[opIdx_].second;
         } else {
             return std::get<2>(logs_.at(idx_));
         }
@@ -159,12 +212,16 @@ public:
     // Resume the iterator so that we can continue to process the remaining logs
     void resume() {
         CHECK(!valid_);
+        opResults_.clear();
+        opCodes_.clear();
+        opIdx_ = 0;
         if (!empty()) {
             leadByAtomicOp_ = processAtomicOp();
-            valid_ = idx_ < logs_.size();
+            valid_ = leadByAtomicOp_ || idx_ < logs_.size();
             hasNonAtomicOpLogs_ = !leadByAtomicOp_ && valid_;
             if (valid_) {
-                currLogType_ = lastLogType_ = logType();
+                currLogType_ = lastLogType_ =
+                    leadByAtomicOp_ ? LogType::ATOMIC_OP : logType();
             }
         }
     }
@@ -173,6 +230,11 @@ public:
         return  std::get<1>(logs_.at(idx_));
     }
 
+private:
+    bool inOpGroup() const {
+        return opIdx_ < opResults_.size();
+    }
+
 private:
     size_t idx_{0};
     bool leadByAtomicOp_{false};
@@ -180,7 +242,10 @@ private:
     bool valid_{true};
     LogType lastLogType_{LogType::NORMAL};
     LogType currLogType_{LogType::NORMAL};
-    std::string opResult_;
+    // <source, log> of the succeeded AtomicOps in the leading group
+    std::vector<std::pair<ClusterID, std::string>> opResults_;
+    size_t opIdx_{0};
+    std::vector<AppendLogResult> opCodes_;
     LogID firstLogId_;
     TermID termId_;
     LogID logId_;
@@ -530,8 +595,11 @@ folly::Future<AppendLogResult> RaftPart::appendAsync(ClusterID source,
 }
 
 
-folly::Future<AppendLogResult> RaftPart::atomicOpAsync(AtomicOp op) {
-    return appendLogAsync(clusterId_, LogType::ATOMIC_OP, "", std::move(op));
+folly::Future<AppendLogResult> RaftPart::atomicOpAsync(AtomicOp op,
+                                                       std::string conflictKey) {
+    // The log slot of an AtomicOp is not used until the op is evaluated,
+    // so it carries the conflict key
+    return appendLogAsync(clusterId_, LogType::ATOMIC_OP, std::move(conflictKey), std::move(op));
 }
 
 folly::Future<AppendLogResult> RaftPart::sendCommandAsync(std::string log) {
@@ -892,7 +960,9 @@ void RaftPart::processAppendLogResponses(
             sendingPromise_.setOneSharedValue(AppendLogResult::SUCCEEDED);
         }
         if (iter.leadByAtomicOp()) {
-            sendingPromise_.setOneSingleValue(AppendLogResult::SUCCEEDED);
+            for (auto code : iter.atomicOpResults()) {
+                sendingPromise_.setOneSingleValue(code);
+            }
         }
         // Step 5: Check whether need to continue
         // the log replication
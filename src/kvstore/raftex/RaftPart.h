@@ -126,6 +126,22 @@ public:
         return leader_;
     }
 
+    TermID termId() const {
+        std::lock_guard<std::mutex> g(raftLock_);
+        return term_;
+    }
+
+    LogID committedLogId() const {
+        std::lock_guard<std::mutex> g(raftLock_);
+        return committedLogId_;
+    }
+
+    // The time since the last message from the leader, in ms
+    uint64_t lastMsgRecvInMSec() const {
+        std::lock_guard<std::mutex> g(raftLock_);
+        return lastMsgRecvDur_.elapsedInMSec();
+    }
+
     std::shared_ptr<wal::FileBasedWal> wal() const {
         return wal_;
     }
@@ -168,8 +184,14 @@ public:
 
     /****************************************************************
      * Run the op atomically.
+     *
+     * The conflictKey identifies the data the op reads and writes,
+     * e.g. the vertex being updated. Consecutive ops with different
+     * non-empty conflict keys are evaluated one after another and
+     * replicated as one group, the ops without a conflict key are
+     * always replicated alone.
      ***************************************************************/
-    folly::Future<AppendLogResult> atomicOpAsync(AtomicOp op);
+    folly::Future<AppendLogResult> atomicOpAsync(AtomicOp op, std::string conflictKey = "");
 
     /**
      * Asynchronously send one command.
@@ -292,7 +314,8 @@ private:
     // resp -- AppendLogResponse
     using AppendLogResponses = std::vector<std::pair<size_t, cpp2::AppendLogResponse>>;
 
-    // <source, logType, log>
+    // <source, logType, log, op>
+    // For an AtomicOp, the log holds its conflict key
     using LogCache = std::vector<
         std::tuple<ClusterID,
                    LogType,
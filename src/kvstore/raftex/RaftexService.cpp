@@ -9,6 +9,8 @@
 #include <folly/ScopeGuard.h>
 #include "kvstore/raftex/RaftPart.h"
 
+DECLARE_int32(rpc_compression_min_bytes);
+
 namespace nebula {
 namespace raftex {
 
@@ -75,6 +77,7 @@ void RaftexService::initThriftServer(std::shared_ptr<folly::IOThreadPoolExecutor
                         apache::thrift::concurrency::ThreadManager>(workers));
     }
     server_->setStopWorkersOnStopListening(false);
+    server_->setMinCompressBytes(FLAGS_rpc_compression_min_bytes);
 }
 
 
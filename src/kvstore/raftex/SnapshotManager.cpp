@@ -6,11 +6,14 @@
 #include "kvstore/raftex/SnapshotManager.h"
 #include "base/NebulaKeyUtils.h"
 #include "kvstore/raftex/RaftPart.h"
+#include "time/WallClock.h"
 
 DEFINE_int32(snapshot_worker_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_io_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_send_retry_times, 3, "Retry times if send failed");
 DEFINE_int32(snapshot_send_timeout_ms, 60000, "Rpc timeout for sending snapshot");
+DEFINE_int32(snapshot_send_rate_limit_mb, 0,
+             "The bandwidth in MB/s for sending the snapshots on each host, 0 means no limit");
 
 namespace nebula {
 namespace raftex {
@@ -43,6 +46,11 @@ folly::Future<Status> SnapshotManager::sendSnapshot(std::shared_ptr<RaftPart> pa
                                            int64_t totalCount,
                                            int64_t totalSize,
                                            bool finished) mutable {
+            int64_t bytes = 0;
+            for (auto& row : data) {
+                bytes += row.size();
+            }
+            throttle(bytes);
             int retry = FLAGS_snapshot_send_retry_times;
             while (retry-- > 0) {
                 auto f = send(spaceId,
@@ -82,6 +90,23 @@ folly::Future<Status> SnapshotManager::sendSnapshot(std::shared_ptr<RaftPart> pa
     return fut;
 }
 
+void SnapshotManager::throttle(int64_t bytes) {
+    if (FLAGS_snapshot_send_rate_limit_mb <= 0) {
+        return;
+    }
+    int64_t waitMs = 0;
+    {
+        std::lock_guard<std::mutex> lg(lock_);
+        auto now = time::WallClock::fastNowInMilliSec();
+        nextSendTimeMs_ = std::max(nextSendTimeMs_, now);
+        waitMs = nextSendTimeMs_ - now;
+        nextSendTimeMs_ += bytes * 1000 / (FLAGS_snapshot_send_rate_limit_mb * 1024L * 1024L);
+    }
+    if (waitMs > 0) {
+        usleep(waitMs * 1000);
+    }
+}
+
 folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
                                                                 GraphSpaceID spaceId,
                                                                 PartitionID partId,
@@ -35,6 +35,9 @@ public:
                                        const HostAddr& dst);
 
 private:
+    // Wait until the bytes could be sent within the rate limit of all the snapshots
+    void throttle(int64_t bytes);
+
     folly::Future<raftex::cpp2::SendSnapshotResponse> send(
                                                    GraphSpaceID spaceId,
                                                    PartitionID partId,
@@ -55,7 +58,11 @@ private:
 private:
     std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
     std::unique_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
-    thrift::ThriftClientManager<raftex::cpp2::RaftexServiceAsyncClient> connManager_;
+    std::mutex lock_;
+    // The earliest time the next batch could be sent
+    int64_t nextSendTimeMs_ = 0;
+    thrift::ThriftClientManager<raftex::cpp2::RaftexServiceAsyncClient> connManager_{
+        "raftex_client", true};
 };
 
 }  // namespace raftex
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include "fs/TempDir.h"
+#include "kvstore/raftex/RaftexService.h"
+#include "kvstore/raftex/test/RaftexTestBase.h"
+#include "kvstore/raftex/test/TestShard.h"
+
+DEFINE_int32(outstanding_ops, 128, "The number of atomic ops in flight");
+DEFINE_int32(hot_keys, 1000, "The number of different conflict keys");
+
+DECLARE_uint32(max_atomic_op_group_size);
+
+namespace nebula {
+namespace raftex {
+
+std::shared_ptr<test::TestShard> gLeader;
+
+void run(int32_t iters, bool withConflictKey, uint32_t groupSize) {
+    FLAGS_max_atomic_op_group_size = groupSize;
+    std::vector<folly::Future<AppendLogResult>> futures;
+    futures.reserve(FLAGS_outstanding_ops);
+    int32_t i = 0;
+    while (i < iters) {
+        for (int32_t j = 0; j < FLAGS_outstanding_ops && i < iters; j++, i++) {
+            std::string key;
+            if (withConflictKey) {
+                key = folly::to<std::string>(i % FLAGS_hot_keys);
+            }
+            futures.emplace_back(gLeader->atomicOpAsync([i] () {
+                return folly::stringPrintf("Atomic Op %d", i);
+            }, std::move(key)));
+        }
+        for (auto& f : futures) {
+            CHECK(AppendLogResult::SUCCEEDED == std::move(f).get());
+        }
+        futures.clear();
+    }
+}
+
+BENCHMARK(atomic_op_no_conflict_key, iters) {
+    run(iters, false, 64);
+}
+
+BENCHMARK_RELATIVE(atomic_op_group_1, iters) {
+    run(iters, true, 1);
+}
+
+BENCHMARK_RELATIVE(atomic_op_group_16, iters) {
+    run(iters, true, 16);
+}
+
+BENCHMARK_RELATIVE(atomic_op_group_64, iters) {
+    run(iters, true, 64);
+}
+
+}  // namespace raftex
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+
+    nebula::fs::TempDir walRoot("/tmp/atomic_op_benchmark.XXXXXX");
+    std::shared_ptr<nebula::thread::GenericThreadPool> workers;
+    std::vector<std::string> wals;
+    std::vector<HostAddr> allHosts;
+    std::vector<std::shared_ptr<nebula::raftex::RaftexService>> services;
+    std::vector<std::shared_ptr<nebula::raftex::test::TestShard>> copies;
+    std::shared_ptr<nebula::raftex::test::TestShard> leader;
+    nebula::raftex::setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+    nebula::raftex::gLeader = leader;
+
+    folly::runBenchmarks();
+
+    nebula::raftex::gLeader.reset();
+    nebula::raftex::finishRaft(services, copies, workers, leader);
+    return 0;
+}
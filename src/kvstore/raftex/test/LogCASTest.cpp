@@ -155,6 +155,58 @@ TEST_F(LogCASTest, AllInvalidCAS) {
     }
 }
 
+
+TEST_F(LogCASTest, GroupedCASWithConflictKeys) {
+    // Append logs
+    LOG(INFO) << "=====> Start appending logs";
+    std::vector<std::string> msgs;
+    std::vector<folly::Future<AppendLogResult>> futures;
+    for (int i = 0; i < 10; ++i) {
+        auto key = folly::stringPrintf("key_%d", i);
+        if (i % 3 == 0) {
+            futures.emplace_back(leader_->atomicOpAsync(
+                [] () { return test::compareAndSet("FCAS Log");}, key));
+        } else {
+            auto log = folly::stringPrintf("CAS Log %d", i);
+            futures.emplace_back(leader_->atomicOpAsync(
+                [log] () { return test::compareAndSet("T" + log);}, key));
+            msgs.emplace_back(std::move(log));
+        }
+    }
+    LOG(INFO) << "<===== Finish appending logs";
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto res = std::move(futures[i]).get();
+        if (i % 3 == 0) {
+            EXPECT_EQ(AppendLogResult::E_ATOMIC_OP_FAILURE, res);
+        } else {
+            EXPECT_EQ(AppendLogResult::SUCCEEDED, res);
+        }
+    }
+    checkConsensus(copies_, 0, msgs.size() - 1, msgs);
+}
+
+
+TEST_F(LogCASTest, SameConflictKeyCAS) {
+    // Append logs
+    LOG(INFO) << "=====> Start appending logs";
+    std::vector<std::string> msgs;
+    std::vector<folly::Future<AppendLogResult>> futures;
+    appendLogs(0, 4, leader_, msgs);
+    for (int i = 5; i < 10; ++i) {
+        auto log = folly::stringPrintf("CAS Log %d", i);
+        futures.emplace_back(leader_->atomicOpAsync(
+            [log] () { return test::compareAndSet("T" + log);}, "same_key"));
+        msgs.emplace_back(std::move(log));
+    }
+    LOG(INFO) << "<===== Finish appending logs";
+
+    for (auto& f : futures) {
+        EXPECT_EQ(AppendLogResult::SUCCEEDED, std::move(f).get());
+    }
+    checkConsensus(copies_, 0, 9, msgs);
+}
+
 }  // namespace raftex
 }  // namespace nebula
 
@@ -830,6 +830,47 @@ TEST(NebulaStoreTest, ThreeCopiesCheckpointTest) {
     }
 }
 
+TEST(NebulaStoreTest, KeyFormatMismatchTest) {
+    fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+    auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+    auto newStore = [&](NebulaKeyFormat format) {
+        auto partMan = std::make_unique<MemPartManager>();
+        partMan->partsMap_[1][0] = PartMeta();
+        std::vector<std::string> paths;
+        paths.emplace_back(folly::stringPrintf("%s/disk1", rootPath.path()));
+        KVOptions options;
+        options.dataPaths_ = std::move(paths);
+        options.partMan_ = std::move(partMan);
+        options.keyFormat_ = format;
+        HostAddr local = {0, 0};
+        return std::make_unique<NebulaStore>(std::move(options),
+                                             ioThreadPool,
+                                             local,
+                                             getHandlers());
+    };
+    {
+        auto store = newStore(NebulaKeyFormat::kNative);
+        ASSERT_TRUE(store->init());
+        EXPECT_EQ(NebulaKeyFormat::kNative, store->keyFormat());
+        EXPECT_EQ(1, store->spaces_.size());
+    }
+    {
+        LOG(INFO) << "The data is in native format, the store should refuse to start";
+        auto store = newStore(NebulaKeyFormat::kOrdered);
+        ASSERT_FALSE(store->init());
+    }
+    {
+        LOG(INFO) << "Unknown key format";
+        auto store = newStore(static_cast<NebulaKeyFormat>(3));
+        ASSERT_FALSE(store->init());
+    }
+    {
+        auto store = newStore(NebulaKeyFormat::kNative);
+        ASSERT_TRUE(store->init());
+        EXPECT_EQ(1, store->spaces_.size());
+    }
+}
+
 TEST(NebulaStoreTest, AtomicOpBatchTest) {
     auto partMan = std::make_unique<MemPartManager>();
     auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
@@ -113,6 +113,38 @@ TEST(RocksEngineTest, PrefixTest) {
 }
 
 
+TEST(RocksEngineTest, MultiPrefixFirstTest) {
+    fs::TempDir rootPath("/tmp/rocksdb_engine_MultiPrefixFirstTest.XXXXXX");
+    auto engine = std::make_unique<RocksEngine>(0, rootPath.path());
+    std::vector<KV> data;
+    for (int32_t i = 0; i < 10;  i++) {
+        data.emplace_back(folly::stringPrintf("a_%d", i),
+                          folly::stringPrintf("val_%d", i));
+    }
+    for (int32_t i = 20; i < 40;  i++) {
+        data.emplace_back(folly::stringPrintf("c_%d", i),
+                          folly::stringPrintf("val_%d", i));
+    }
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+    // Not sorted, and with the missed and duplicated prefixes
+    std::vector<std::string> prefixes = {"c_3", "a", "b", "c_2", "a_5", "d", "c_3"};
+    std::vector<KV> kvs;
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->multiPrefixFirst(prefixes, &kvs));
+    ASSERT_EQ(prefixes.size(), kvs.size());
+    std::vector<KV> expected = {
+        {"c_30", "val_30"},
+        {"a_0", "val_0"},
+        {"", ""},
+        {"c_20", "val_20"},
+        {"a_5", "val_5"},
+        {"", ""},
+        {"c_30", "val_30"},
+    };
+    EXPECT_EQ(expected, kvs);
+}
+
+
 TEST(RocksEngineTest, RemoveTest) {
     fs::TempDir rootPath("/tmp/rocksdb_engine_RemoveTest.XXXXXX");
     auto engine = std::make_unique<RocksEngine>(0, rootPath.path());
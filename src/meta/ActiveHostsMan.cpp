@@ -10,22 +10,20 @@
 
 DEFINE_int32(expired_threshold_sec, 10 * 60,
                      "Hosts will be expired in this time if no heartbeat received");
+DEFINE_int32(host_info_persist_interval_secs, 60,
+             "The interval to persist the heartbeats of the known hosts in batch");
+DEFINE_int32(leader_info_expired_secs, 60,
+             "The leaders reported by a host are ignored if no heartbeat received in this time");
 
 namespace nebula {
 namespace meta {
 
-kvstore::ResultCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
-                                                   const HostAddr& hostAddr,
-                                                   const HostInfo& info) {
-    CHECK_NOTNULL(kv);
-    std::vector<kvstore::KV> data;
-    data.emplace_back(MetaServiceUtils::hostKey(hostAddr.first, hostAddr.second),
-                      HostInfo::encode(info));
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::spaceLock());
+kvstore::ResultCode ActiveHostsMan::persist(std::vector<kvstore::KV> data) {
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::hostLock());
     folly::Baton<true, std::atomic> baton;
     kvstore::ResultCode ret;
-    kv->asyncMultiPut(kDefaultSpaceId, kDefaultPartId, std::move(data),
-                            [&] (kvstore::ResultCode code) {
+    kv_->asyncMultiPut(kDefaultSpaceId, kDefaultPartId, std::move(data),
+                       [&] (kvstore::ResultCode code) {
         ret = code;
         baton.post();
     });
@@ -33,19 +31,86 @@ kvstore::ResultCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
     return ret;
 }
 
-std::vector<HostAddr> ActiveHostsMan::getActiveHosts(kvstore::KVStore* kv, int32_t expiredTTL) {
+kvstore::ResultCode ActiveHostsMan::updateHostInfo(const HostAddr& hostAddr,
+                                                   const HostInfo& info) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        hosts_[hostAddr] = info;
+        dirty_.erase(hostAddr);
+    }
+    std::vector<kvstore::KV> data;
+    data.emplace_back(MetaServiceUtils::hostKey(hostAddr.first, hostAddr.second),
+                      HostInfo::encode(info));
+    return persist(std::move(data));
+}
+
+kvstore::ResultCode ActiveHostsMan::reportHostInfo(const HostAddr& hostAddr,
+                                                   const HostInfo& info,
+                                                   LeaderInfos leaderInfos) {
+    // The read fails on the followers, so the hosts will turn to the new leader
+    std::string val;
+    auto ret = kv_->get(kDefaultSpaceId,
+                        kDefaultPartId,
+                        MetaServiceUtils::hostKey(hostAddr.first, hostAddr.second),
+                        &val);
+    if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            leaders_[hostAddr] = std::move(leaderInfos);
+        }
+        return updateHostInfo(hostAddr, info);
+    }
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+
+    std::vector<kvstore::KV> data;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        hosts_[hostAddr] = info;
+        leaders_[hostAddr] = std::move(leaderInfos);
+        dirty_.emplace(hostAddr);
+        auto now = time::WallClock::fastNowInMilliSec();
+        if (now - lastPersistTime_ < FLAGS_host_info_persist_interval_secs * 1000) {
+            return kvstore::ResultCode::SUCCEEDED;
+        }
+        lastPersistTime_ = now;
+        for (auto& host : dirty_) {
+            data.emplace_back(MetaServiceUtils::hostKey(host.first, host.second),
+                              HostInfo::encode(hosts_[host]));
+        }
+        dirty_.clear();
+    }
+    VLOG(1) << "Persist the heartbeats of " << data.size() << " hosts";
+    ret = persist(std::move(data));
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Persist the heartbeats failed, code " << static_cast<int32_t>(ret);
+    }
+    // The heartbeat itself has been recorded, it will be persisted in the next round
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+std::vector<HostAddr> ActiveHostsMan::getActiveHosts(int32_t expiredTTL) {
     std::vector<HostAddr> hosts;
     const auto& prefix = MetaServiceUtils::hostPrefix();
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto ret = kv->prefix(kDefaultSpaceId, kDefaultPartId, prefix, &iter);
+    auto ret = kv_->prefix(kDefaultSpaceId, kDefaultPartId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
         return hosts;
     }
     int64_t threshold = (expiredTTL == 0 ? FLAGS_expired_threshold_sec : expiredTTL) * 1000;
     auto now = time::WallClock::fastNowInMilliSec();
+    std::lock_guard<std::mutex> guard(lock_);
     while (iter->valid()) {
         auto host = MetaServiceUtils::parseHostKey(iter->key());
         HostInfo info = HostInfo::decode(iter->val());
+        // The heartbeats not persisted yet, the persisted one could be newer if
+        // it's written by another meta leader
+        auto it = hosts_.find(HostAddr(host.ip, host.port));
+        if (it != hosts_.end()
+                && it->second.lastHBTimeInMilliSec_ > info.lastHBTimeInMilliSec_) {
+            info = it->second;
+        }
         if (now - info.lastHBTimeInMilliSec_ < threshold) {
             hosts.emplace_back(host.ip, host.port);
         }
@@ -54,10 +119,72 @@ std::vector<HostAddr> ActiveHostsMan::getActiveHosts(kvstore::KVStore* kv, int32
     return hosts;
 }
 
-bool ActiveHostsMan::isLived(kvstore::KVStore* kv, const HostAddr& host) {
-    auto activeHosts = getActiveHosts(kv);
+bool ActiveHostsMan::isLived(const HostAddr& host) {
+    auto activeHosts = getActiveHosts();
     return std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end();
 }
 
+std::unordered_map<std::pair<GraphSpaceID, PartitionID>, std::pair<HostAddr, cpp2::LeaderInfo>>
+ActiveHostsMan::latestLeaders() {
+    std::unordered_map<std::pair<GraphSpaceID, PartitionID>,
+                       std::pair<HostAddr, cpp2::LeaderInfo>> partLeaders;
+    std::lock_guard<std::mutex> guard(lock_);
+    auto now = time::WallClock::fastNowInMilliSec();
+    for (auto& hostEntry : leaders_) {
+        auto hostIt = hosts_.find(hostEntry.first);
+        if (hostIt == hosts_.end()
+                || now - hostIt->second.lastHBTimeInMilliSec_
+                    >= FLAGS_leader_info_expired_secs * 1000) {
+            continue;
+        }
+        for (auto& spaceEntry : hostEntry.second) {
+            for (auto& leaderInfo : spaceEntry.second) {
+                auto key = std::make_pair(spaceEntry.first, leaderInfo.get_part_id());
+                auto it = partLeaders.find(key);
+                if (it == partLeaders.end()
+                        || it->second.second.get_term() < leaderInfo.get_term()) {
+                    partLeaders[key] = std::make_pair(hostEntry.first, leaderInfo);
+                }
+            }
+        }
+    }
+    return partLeaders;
+}
+
+HostLeaderMap ActiveHostsMan::getLeaderDist() {
+    HostLeaderMap hostLeaderMap;
+    auto partLeaders = latestLeaders();
+    if (partLeaders.empty()) {
+        return hostLeaderMap;
+    }
+    {
+        // The live hosts leading nothing could take over leaders as well
+        std::lock_guard<std::mutex> guard(lock_);
+        auto now = time::WallClock::fastNowInMilliSec();
+        for (auto& hostEntry : hosts_) {
+            if (now - hostEntry.second.lastHBTimeInMilliSec_
+                    < FLAGS_leader_info_expired_secs * 1000) {
+                hostLeaderMap[hostEntry.first];
+            }
+        }
+    }
+    for (auto& partEntry : partLeaders) {
+        auto& key = partEntry.first;
+        hostLeaderMap[partEntry.second.first][key.first].emplace_back(key.second);
+    }
+    return hostLeaderMap;
+}
+
+PartLoads ActiveHostsMan::getPartLoads() {
+    PartLoads loads;
+    for (auto& partEntry : latestLeaders()) {
+        auto& key = partEntry.first;
+        auto& leaderInfo = partEntry.second.second;
+        loads[key.first][key.second] = static_cast<int64_t>(leaderInfo.get_read_qps())
+                                      + leaderInfo.get_write_qps();
+    }
+    return loads;
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -10,10 +10,20 @@
 #include "base/Base.h"
 #include <gtest/gtest_prod.h>
 #include "kvstore/KVStore.h"
+#include "interface/gen-cpp2/meta_types.h"
 
 namespace nebula {
 namespace meta {
 
+using HostLeaderMap = std::unordered_map<HostAddr,
+                                         std::unordered_map<GraphSpaceID,
+                                                            std::vector<PartitionID>>>;
+
+using LeaderInfos = std::unordered_map<GraphSpaceID, std::vector<cpp2::LeaderInfo>>;
+
+// The requests per second served by the leader of each part
+using PartLoads = std::unordered_map<GraphSpaceID, std::unordered_map<PartitionID, int64_t>>;
+
 struct HostInfo {
     HostInfo() = default;
     explicit HostInfo(int64_t lastHBTimeInMilliSec)
@@ -43,20 +53,61 @@ struct HostInfo {
     }
 };
 
+/**
+ * The hosts known by the meta service, owned by its handler. The heartbeats and the leaders
+ * reported recently are kept in memory, so they live as long as the meta service.
+ * */
 class ActiveHostsMan final {
 public:
-    ~ActiveHostsMan() = default;
-
-    static kvstore::ResultCode updateHostInfo(kvstore::KVStore* kv,
-                                              const HostAddr& hostAddr,
-                                              const HostInfo& info);
-
-    static std::vector<HostAddr> getActiveHosts(kvstore::KVStore* kv, int32_t expiredTTL = 0);
+    explicit ActiveHostsMan(kvstore::KVStore* kv) : kv_(kv) {
+        CHECK_NOTNULL(kv_);
+    }
 
-    static bool isLived(kvstore::KVStore* kv, const HostAddr& host);
+    ~ActiveHostsMan() = default;
 
-protected:
-    ActiveHostsMan() = default;
+    kvstore::ResultCode updateHostInfo(const HostAddr& hostAddr, const HostInfo& info);
+
+    /**
+     * Called on each heartbeat. The host info and the leaders reported are kept in memory,
+     * only a new host is persisted at once, the others are persisted in batch every
+     * host_info_persist_interval_secs.
+     * */
+    kvstore::ResultCode reportHostInfo(const HostAddr& hostAddr,
+                                       const HostInfo& info,
+                                       LeaderInfos leaderInfos);
+
+    std::vector<HostAddr> getActiveHosts(int32_t expiredTTL = 0);
+
+    bool isLived(const HostAddr& host);
+
+    /**
+     * The leader distribution reported by the hosts recently, empty if none.
+     * The one of the latest term wins if a part is reported by several hosts.
+     * The hosts alive but leading nothing are included with no leaders.
+     * */
+    HostLeaderMap getLeaderDist();
+
+    /**
+     * The load of the parts reported along with the leaders, empty if none.
+     * */
+    PartLoads getPartLoads();
+
+private:
+    // The latest leader reported of each part
+    std::unordered_map<std::pair<GraphSpaceID, PartitionID>,
+                       std::pair<HostAddr, cpp2::LeaderInfo>>
+    latestLeaders();
+
+    kvstore::ResultCode persist(std::vector<kvstore::KV> data);
+
+private:
+    kvstore::KVStore*                           kv_{nullptr};
+    std::mutex                                  lock_;
+    std::unordered_map<HostAddr, HostInfo>      hosts_;
+    std::unordered_map<HostAddr, LeaderInfos>   leaders_;
+    // The hosts whose latest info is not persisted
+    std::unordered_set<HostAddr>                dirty_;
+    int64_t                                     lastPersistTime_{0};
 };
 
 }  // namespace meta
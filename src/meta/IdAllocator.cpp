@@ -0,0 +1,99 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "meta/IdAllocator.h"
+#include "meta/processors/Common.h"
+
+DEFINE_int32(meta_id_batch_size, 100, "The number of ids reserved by one write");
+
+namespace nebula {
+namespace meta {
+
+static const char kIdKey[] = "__id__";
+
+kvstore::ResultCode IdAllocator::allocate(int32_t* id) {
+    int32_t last = 0;
+    auto code = lastReserved(&last);
+    if (code != kvstore::ResultCode::SUCCEEDED) {
+        return code;
+    }
+    if (take(last, id)) {
+        return code;
+    }
+
+    std::lock_guard<std::mutex> guard(reserveLock_);
+    code = lastReserved(&last);
+    if (code != kvstore::ResultCode::SUCCEEDED) {
+        return code;
+    }
+    // Maybe another thread has reserved a new batch
+    if (take(last, id)) {
+        return code;
+    }
+    return reserve(last, id);
+}
+
+
+kvstore::ResultCode IdAllocator::lastReserved(int32_t* last) {
+    std::string val;
+    auto code = kvstore_->get(kDefaultSpaceId, kDefaultPartId, kIdKey, &val);
+    if (code == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+        *last = 0;
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    if (code == kvstore::ResultCode::SUCCEEDED) {
+        *last = *reinterpret_cast<const int32_t*>(val.c_str());
+    }
+    return code;
+}
+
+
+bool IdAllocator::take(int32_t last, int32_t* id) {
+    auto range = range_.load();
+    // The range is stale if the ids has been reserved by others, e.g. another leader
+    while (next(range) < end(range) && end(range) - 1 == last) {
+        if (range_.compare_exchange_weak(range, pack(next(range) + 1, end(range)))) {
+            *id = next(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+kvstore::ResultCode IdAllocator::reserve(int32_t last, int32_t* id) {
+    // Keep the end of the range, i.e. (last reserved + 1), in int32
+    auto reserved = std::min<int64_t>(static_cast<int64_t>(last)
+                                        + std::max(FLAGS_meta_id_batch_size, 1),
+                                      std::numeric_limits<int32_t>::max() - 1);
+    if (reserved <= last) {
+        LOG(ERROR) << "The ids are exhausted";
+        return kvstore::ResultCode::ERR_UNKNOWN;
+    }
+    auto newLast = static_cast<int32_t>(reserved);
+    std::vector<kvstore::KV> data;
+    data.emplace_back(kIdKey,
+                      std::string(reinterpret_cast<const char*>(&newLast), sizeof(newLast)));
+    folly::Baton<true, std::atomic> baton;
+    kvstore::ResultCode code;
+    kvstore_->asyncMultiPut(kDefaultSpaceId,
+                            kDefaultPartId,
+                            std::move(data),
+                            [&] (kvstore::ResultCode ret) {
+        code = ret;
+        baton.post();
+    });
+    baton.wait();
+    if (code != kvstore::ResultCode::SUCCEEDED) {
+        return code;
+    }
+    *id = last + 1;
+    range_.store(pack(last + 2, newLast + 1));
+    return code;
+}
+
+}  // namespace meta
+}  // namespace nebula
@@ -0,0 +1,63 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef META_IDALLOCATOR_H_
+#define META_IDALLOCATOR_H_
+
+#include "base/Base.h"
+#include "kvstore/KVStore.h"
+
+namespace nebula {
+namespace meta {
+
+/**
+ * Allocates the ids of the spaces, schemas, indexes and users.
+ *
+ * A batch of ids is reserved by one write of the last reserved id, then the ids
+ * are handed out from memory by CAS. The ids reserved but not used yet are skipped
+ * after a restart or a leader change, so the ids are unique and increasing,
+ * but not continuous.
+ */
+class IdAllocator final {
+public:
+    // Owned by the meta service, the only allocator of the meta data in the kvstore
+    explicit IdAllocator(kvstore::KVStore* kvstore) : kvstore_(kvstore) {}
+
+    kvstore::ResultCode allocate(int32_t* id);
+
+private:
+
+    // The last reserved id in the kvstore, 0 if none
+    kvstore::ResultCode lastReserved(int32_t* last);
+
+    // Take an id from the reserved range, if the range is still the latest reservation
+    bool take(int32_t last, int32_t* id);
+
+    kvstore::ResultCode reserve(int32_t last, int32_t* id);
+
+    static uint64_t pack(int32_t next, int32_t end) {
+        return static_cast<uint64_t>(next) << 32 | static_cast<uint32_t>(end);
+    }
+
+    static int32_t next(uint64_t range) {
+        return static_cast<int32_t>(range >> 32);
+    }
+
+    static int32_t end(uint64_t range) {
+        return static_cast<int32_t>(range & 0xFFFFFFFF);
+    }
+
+private:
+    kvstore::KVStore*       kvstore_{nullptr};
+    // The ids in [next, end) are reserved but not used yet
+    std::atomic<uint64_t>   range_{0};
+    // Only one thread reserves at a time
+    std::mutex              reserveLock_;
+};
+
+}  // namespace meta
+}  // namespace nebula
+#endif  // META_IDALLOCATOR_H_
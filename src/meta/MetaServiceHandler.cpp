@@ -9,6 +9,7 @@
 #include "meta/processors/partsMan/CreateSpaceProcessor.h"
 #include "meta/processors/partsMan/DropSpaceProcessor.h"
 #include "meta/processors/partsMan/ListSpacesProcessor.h"
+#include "meta/processors/partsMan/GetCatalogVersionProcessor.h"
 #include "meta/processors/partsMan/GetSpaceProcessor.h"
 #include "meta/processors/partsMan/ListHostsProcessor.h"
 #include "meta/processors/partsMan/ListPartsProcessor.h"
@@ -59,7 +60,9 @@ namespace meta {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createSpace(const cpp2::CreateSpaceReq& req) {
-    auto* processor = CreateSpaceProcessor::instance(kvstore_);
+    auto* processor = CreateSpaceProcessor::instance(kvstore_,
+                                                     idAllocator_.get(),
+                                                     activeHostsMan_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -75,6 +78,12 @@ MetaServiceHandler::future_listSpaces(const cpp2::ListSpacesReq& req) {
     RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::GetCatalogVersionResp>
+MetaServiceHandler::future_getCatalogVersion(const cpp2::GetCatalogVersionReq& req) {
+    auto* processor = GetCatalogVersionProcessor::instance(kvstore_);
+    RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::GetSpaceResp>
 MetaServiceHandler::future_getSpace(const cpp2::GetSpaceReq& req) {
     auto* processor = GetSpaceProcessor::instance(kvstore_);
@@ -83,13 +92,17 @@ MetaServiceHandler::future_getSpace(const cpp2::GetSpaceReq& req) {
 
 folly::Future<cpp2::ListHostsResp>
 MetaServiceHandler::future_listHosts(const cpp2::ListHostsReq& req) {
-    auto* processor = ListHostsProcessor::instance(kvstore_, adminClient_.get());
+    auto* processor = ListHostsProcessor::instance(kvstore_,
+                                                   activeHostsMan_.get(),
+                                                   adminClient_.get());
     RETURN_FUTURE(processor);
 }
 
 folly::Future<cpp2::ListPartsResp>
 MetaServiceHandler::future_listParts(const cpp2::ListPartsReq& req) {
-    auto* processor = ListPartsProcessor::instance(kvstore_, adminClient_.get());
+    auto* processor = ListPartsProcessor::instance(kvstore_,
+                                                   activeHostsMan_.get(),
+                                                   adminClient_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -137,7 +150,7 @@ MetaServiceHandler::future_removeRange(const cpp2::RemoveRangeReq& req) {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createTag(const cpp2::CreateTagReq& req) {
-    auto* processor = CreateTagProcessor::instance(kvstore_);
+    auto* processor = CreateTagProcessor::instance(kvstore_, idAllocator_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -167,7 +180,7 @@ MetaServiceHandler::future_listTags(const cpp2::ListTagsReq& req) {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createEdge(const cpp2::CreateEdgeReq& req) {
-    auto* processor = CreateEdgeProcessor::instance(kvstore_);
+    auto* processor = CreateEdgeProcessor::instance(kvstore_, idAllocator_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -197,7 +210,7 @@ MetaServiceHandler::future_listEdges(const cpp2::ListEdgesReq& req) {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createTagIndex(const cpp2::CreateTagIndexReq& req) {
-    auto* processor = CreateTagIndexProcessor::instance(kvstore_);
+    auto* processor = CreateTagIndexProcessor::instance(kvstore_, idAllocator_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -221,7 +234,7 @@ MetaServiceHandler::future_listTagIndexes(const cpp2::ListTagIndexesReq& req) {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createEdgeIndex(const cpp2::CreateEdgeIndexReq& req) {
-    auto* processor = CreateEdgeIndexProcessor::instance(kvstore_);
+    auto* processor = CreateEdgeIndexProcessor::instance(kvstore_, idAllocator_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -245,13 +258,14 @@ MetaServiceHandler::future_listEdgeIndexes(const cpp2::ListEdgeIndexesReq& req)
 
 folly::Future<cpp2::HBResp>
 MetaServiceHandler::future_heartBeat(const cpp2::HBReq& req) {
-    auto* processor = HBProcessor::instance(kvstore_, clusterId_, &heartBeatStat_);
+    auto* processor = HBProcessor::instance(kvstore_, activeHostsMan_.get(),
+                                            clusterId_, &heartBeatStat_);
     RETURN_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createUser(const cpp2::CreateUserReq& req) {
-    auto* processor = CreateUserProcessor::instance(kvstore_);
+    auto* processor = CreateUserProcessor::instance(kvstore_, idAllocator_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -311,13 +325,13 @@ MetaServiceHandler::future_checkPassword(const cpp2::CheckPasswordReq& req) {
 
 folly::Future<cpp2::BalanceResp>
 MetaServiceHandler::future_balance(const cpp2::BalanceReq& req) {
-    auto* processor = BalanceProcessor::instance(kvstore_);
+    auto* processor = BalanceProcessor::instance(kvstore_, activeHostsMan_.get());
     RETURN_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_leaderBalance(const cpp2::LeaderBalanceReq& req) {
-    auto* processor = LeaderBalanceProcessor::instance(kvstore_);
+    auto* processor = LeaderBalanceProcessor::instance(kvstore_, activeHostsMan_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -347,13 +361,13 @@ MetaServiceHandler::future_listConfigs(const cpp2::ListConfigsReq &req) {
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_createSnapshot(const cpp2::CreateSnapshotReq& req) {
-    auto* processor = CreateSnapshotProcessor::instance(kvstore_);
+    auto* processor = CreateSnapshotProcessor::instance(kvstore_, activeHostsMan_.get());
     RETURN_FUTURE(processor);
 }
 
 folly::Future<cpp2::ExecResp>
 MetaServiceHandler::future_dropSnapshot(const cpp2::DropSnapshotReq& req) {
-    auto* processor = DropSnapshotProcessor::instance(kvstore_);
+    auto* processor = DropSnapshotProcessor::instance(kvstore_, activeHostsMan_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -11,6 +11,8 @@
 #include <mutex>
 #include "interface/gen-cpp2/MetaService.h"
 #include "kvstore/KVStore.h"
+#include "meta/ActiveHostsMan.h"
+#include "meta/IdAllocator.h"
 #include "meta/processors/admin/AdminClient.h"
 #include "stats/Stats.h"
 
@@ -21,7 +23,9 @@ class MetaServiceHandler final : public cpp2::MetaServiceSvIf {
 public:
     explicit MetaServiceHandler(kvstore::KVStore* kv, ClusterID clusterId = 0)
         : kvstore_(kv), clusterId_(clusterId) {
-        adminClient_ = std::make_unique<AdminClient>(kvstore_);
+        activeHostsMan_ = std::make_unique<ActiveHostsMan>(kvstore_);
+        adminClient_ = std::make_unique<AdminClient>(kvstore_, activeHostsMan_.get());
+        idAllocator_ = std::make_unique<IdAllocator>(kvstore_);
         heartBeatStat_ = stats::Stats("meta", "heartbeat");
     }
 
@@ -37,6 +41,9 @@ public:
     folly::Future<cpp2::ListSpacesResp>
     future_listSpaces(const cpp2::ListSpacesReq& req) override;
 
+    folly::Future<cpp2::GetCatalogVersionResp>
+    future_getCatalogVersion(const cpp2::GetCatalogVersionReq& req) override;
+
     folly::Future<cpp2::GetSpaceResp>
     future_getSpace(const cpp2::GetSpaceReq& req) override;
 
@@ -199,7 +206,9 @@ public:
 private:
     kvstore::KVStore* kvstore_ = nullptr;
     ClusterID clusterId_{0};
+    std::unique_ptr<ActiveHostsMan> activeHostsMan_;
     std::unique_ptr<AdminClient> adminClient_;
+    std::unique_ptr<IdAllocator> idAllocator_;
     stats::Stats heartBeatStat_;
 };
 
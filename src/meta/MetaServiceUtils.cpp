@@ -7,6 +7,7 @@
 #include "meta/MetaServiceUtils.h"
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include "time/WallClock.h"
 
 namespace nebula {
 namespace meta {
@@ -24,6 +25,8 @@ const std::string kRolesTable       = "__roles__";          // NOLINT
 const std::string kConfigsTable     = "__configs__";        // NOLINT
 const std::string kDefaultTable     = "__default__";        // NOLINT
 const std::string kSnapshotsTable   = "__snapshots__";      // NOLINT
+const std::string kSpaceVersionsTable = "__space_versions__"; // NOLINT
+const std::string kCatalogVersionKey  = "__catalog_version__"; // NOLINT
 
 const std::string kHostOnline  = "Online";       // NOLINT
 const std::string kHostOffline = "Offline";      // NOLINT
@@ -60,6 +63,46 @@ std::string MetaServiceUtils::spaceName(folly::StringPiece rawVal) {
     return parseSpace(rawVal).get_space_name();
 }
 
+std::string MetaServiceUtils::spaceVersionKey(GraphSpaceID spaceId) {
+    std::string key;
+    key.reserve(kSpaceVersionsTable.size() + sizeof(GraphSpaceID));
+    key.append(kSpaceVersionsTable.data(), kSpaceVersionsTable.size());
+    key.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+    return key;
+}
+
+std::string MetaServiceUtils::spaceVersionVal(int64_t version) {
+    return std::string(reinterpret_cast<const char*>(&version), sizeof(int64_t));
+}
+
+const std::string& MetaServiceUtils::spaceVersionPrefix() {
+    return kSpaceVersionsTable;
+}
+
+const std::string& MetaServiceUtils::catalogVersionKey() {
+    return kCatalogVersionKey;
+}
+
+GraphSpaceID MetaServiceUtils::parseSpaceVersionKey(folly::StringPiece rawKey) {
+    return *reinterpret_cast<const GraphSpaceID*>(rawKey.data() + kSpaceVersionsTable.size());
+}
+
+int64_t MetaServiceUtils::parseSpaceVersion(folly::StringPiece rawVal) {
+    return *reinterpret_cast<const int64_t*>(rawVal.data());
+}
+
+int64_t MetaServiceUtils::nextSpaceVersion() {
+    // Based on the wall clock, so that the versions keep increasing after the leader changes
+    static std::atomic<int64_t> last{0};
+    auto now = time::WallClock::fastNowInMilliSec();
+    auto prev = last.load();
+    int64_t next;
+    do {
+        next = std::max(now, prev + 1);
+    } while (!last.compare_exchange_weak(prev, next));
+    return next;
+}
+
 std::string MetaServiceUtils::partKey(GraphSpaceID spaceId, PartitionID partId) {
     std::string key;
     key.reserve(128);
@@ -42,6 +42,24 @@ public:
 
     static std::string spaceName(folly::StringPiece rawVal);
 
+    // The catalog version of a space, bumped on each change of its parts or schemas
+    static std::string spaceVersionKey(GraphSpaceID spaceId);
+
+    static std::string spaceVersionVal(int64_t version);
+
+    static const std::string& spaceVersionPrefix();
+
+    // The version of the whole catalog, bumped along with the version of any space.
+    // Its value is encoded as the space versions.
+    static const std::string& catalogVersionKey();
+
+    static GraphSpaceID parseSpaceVersionKey(folly::StringPiece rawKey);
+
+    static int64_t parseSpaceVersion(folly::StringPiece rawVal);
+
+    // A new version of the space, which is increasing in the process
+    static int64_t nextSpaceVersion();
+
     static std::string partKey(GraphSpaceID spaceId, PartitionID partId);
 
     static std::string partVal(const std::vector<nebula::cpp2::HostAddr>& hosts);
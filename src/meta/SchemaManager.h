@@ -45,6 +45,9 @@ public:
 
     virtual StatusOr<std::vector<std::string>> getAllEdge(GraphSpaceID space) = 0;
 
+    // Whether the vertices and edges of the space are stored without version
+    virtual bool isSingleVersion(GraphSpaceID space) = 0;
+
     virtual void init(MetaClient *client = nullptr) = 0;
 
 protected:
@@ -103,5 +103,15 @@ StatusOr<std::vector<std::string>> ServerBasedSchemaManager::getAllEdge(GraphSpa
     return metaClient_->getAllEdgeFromCache(space);
 }
 
+bool ServerBasedSchemaManager::isSingleVersion(GraphSpaceID space) {
+    CHECK(metaClient_);
+    auto ret = metaClient_->isSingleVersion(space);
+    if (!ret.ok()) {
+        LOG(ERROR) << ret.status();
+        return false;
+    }
+    return ret.value();
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -44,6 +44,8 @@ public:
 
     StatusOr<std::vector<std::string>> getAllEdge(GraphSpaceID space) override;
 
+    bool isSingleVersion(GraphSpaceID space) override;
+
     void init(MetaClient *client) override;
 
 private:
@@ -134,7 +134,21 @@ bool MetaClient::loadData() {
         LOG(ERROR) << "The threads number in ioThreadPool should be greater than 0";
         return false;
     }
-    auto ret = listSpaces().get();
+    // Nothing to reload if the catalog is unchanged, which costs a single key read on metad
+    int64_t catalogVersion = 0;
+    auto versionRet = getCatalogVersion().get();
+    if (versionRet.ok()) {
+        catalogVersion = versionRet.value();
+        if (ready_ && catalogVersion != 0 && catalogVersion == catalogVersion_) {
+            VLOG(3) << "The catalog is unchanged, version " << catalogVersion;
+            return true;
+        }
+    } else {
+        // e.g. the metad is not upgraded yet, compare the versions of the spaces instead
+        VLOG(2) << "Get catalog version failed, status:" << versionRet.status();
+    }
+
+    auto ret = listSpacesWithVersions().get();
     if (!ret.ok()) {
         LOG(ERROR) << "List space failed, status:" << ret.status();
         return false;
@@ -148,38 +162,64 @@ bool MetaClient::loadData() {
     decltype(spaceEdgeIndexByType_)  spaceEdgeIndexByType;
     decltype(spaceAllEdgeMap_)      spaceAllEdgeMap;
 
-    for (auto space : ret.value()) {
+    const auto& versions = ret.value().get_versions();
+    std::unordered_set<GraphSpaceID> unchanged;
+    for (auto space : toSpaceIdName(ret.value().get_spaces())) {
         auto spaceId = space.first;
-        auto r = getPartsAlloc(spaceId).get();
-        if (!r.ok()) {
-            LOG(ERROR) << "Get parts allocation failed for spaceId " << spaceId
-                       << ", status " << r.status();
-            return false;
+        auto versionIt = versions.find(spaceId);
+        // The cache is only replaced by the loading thread, so it is read without the lock
+        auto oldIt = localCache_.find(spaceId);
+        if (versionIt != versions.end()
+                && oldIt != localCache_.end()
+                && oldIt->second->version_ == versionIt->second
+                && oldIt->second->spaceName == space.second) {
+            VLOG(3) << "Space " << spaceId << " is unchanged, version " << versionIt->second;
+            cache.emplace(spaceId, oldIt->second);
+            spaceIndexByName.emplace(space.second, spaceId);
+            unchanged.emplace(spaceId);
+            continue;
         }
 
-        auto spaceCache = std::make_shared<SpaceInfoCache>();
-        auto partsAlloc = r.value();
-        spaceCache->spaceName = space.second;
-        spaceCache->partsOnHost_ = reverse(partsAlloc);
-        spaceCache->partsAlloc_ = std::move(partsAlloc);
-        VLOG(2) << "Load space " << spaceId
-                << ", parts num:" << spaceCache->partsAlloc_.size();
-
-        // loadSchemas
-        if (!loadSchemas(spaceId,
-                         spaceCache,
-                         spaceTagIndexByName,
-                         spaceEdgeIndexByName,
-                         spaceEdgeIndexByType,
-                         spaceNewestTagVerMap,
-                         spaceNewestEdgeVerMap,
-                         spaceAllEdgeMap)) {
+        auto spaceCache = loadSpace(spaceId,
+                                    space.second,
+                                    spaceTagIndexByName,
+                                    spaceEdgeIndexByName,
+                                    spaceEdgeIndexByType,
+                                    spaceNewestTagVerMap,
+                                    spaceNewestEdgeVerMap,
+                                    spaceAllEdgeMap);
+        if (spaceCache == nullptr) {
             return false;
         }
-
+        // The spaces without a version, e.g. created before upgrading, are always reloaded
+        if (versionIt != versions.end()) {
+            spaceCache->version_ = versionIt->second;
+        }
         cache.emplace(spaceId, spaceCache);
         spaceIndexByName.emplace(space.second, spaceId);
     }
+
+    if (!unchanged.empty()) {
+        auto copyUnchanged = [&unchanged] (const auto& from, auto& to) {
+            for (auto& entry : from) {
+                if (unchanged.count(entry.first.first) > 0) {
+                    to.emplace(entry);
+                }
+            }
+        };
+        folly::RWSpinLock::ReadHolder holder(localCacheLock_);
+        copyUnchanged(spaceTagIndexByName_, spaceTagIndexByName);
+        copyUnchanged(spaceEdgeIndexByName_, spaceEdgeIndexByName);
+        copyUnchanged(spaceEdgeIndexByType_, spaceEdgeIndexByType);
+        copyUnchanged(spaceNewestTagVerMap_, spaceNewestTagVerMap);
+        copyUnchanged(spaceNewestEdgeVerMap_, spaceNewestEdgeVerMap);
+        for (auto spaceId : unchanged) {
+            auto it = spaceAllEdgeMap_.find(spaceId);
+            if (it != spaceAllEdgeMap_.end()) {
+                spaceAllEdgeMap.emplace(spaceId, it->second);
+            }
+        }
+    }
     decltype(localCache_) oldCache;
     {
         folly::RWSpinLock::WriteHolder holder(localCacheLock_);
@@ -194,10 +234,66 @@ bool MetaClient::loadData() {
         spaceAllEdgeMap_ = std::move(spaceAllEdgeMap);
     }
     diff(oldCache, localCache_);
+    // Read before listing the spaces, so the changes made during the loading are loaded next time
+    catalogVersion_ = catalogVersion;
     ready_ = true;
     return true;
 }
 
+std::shared_ptr<SpaceInfoCache>
+MetaClient::loadSpace(GraphSpaceID spaceId,
+                      const std::string& spaceName,
+                      SpaceTagNameIdMap &tagNameIdMap,
+                      SpaceEdgeNameTypeMap &edgeNameTypeMap,
+                      SpaceEdgeTypeNameMap &edgeTypeNameMap,
+                      SpaceNewestTagVerMap &newestTagVerMap,
+                      SpaceNewestEdgeVerMap &newestEdgeVerMap,
+                      SpaceAllEdgeMap &allEdgeMap) {
+    auto r = getPartsAlloc(spaceId).get();
+    if (!r.ok()) {
+        LOG(ERROR) << "Get parts allocation failed for spaceId " << spaceId
+                   << ", status " << r.status();
+        return nullptr;
+    }
+
+    auto spaceRet = getSpace(spaceName).get();
+    if (!spaceRet.ok()) {
+        LOG(ERROR) << "Get space properties failed for spaceId " << spaceId
+                   << ", status " << spaceRet.status();
+        return nullptr;
+    }
+
+    auto spaceCache = std::make_shared<SpaceInfoCache>();
+    auto partsAlloc = r.value();
+    spaceCache->spaceName = spaceName;
+    auto& properties = spaceRet.value().get_properties();
+    spaceCache->singleVersion_ = properties.get_single_version();
+    auto partitioner = toPartitioner(properties, partsAlloc.size());
+    if (!partitioner.ok()) {
+        LOG(ERROR) << "Invalid partitioner of spaceId " << spaceId
+                   << ", status " << partitioner.status();
+        return nullptr;
+    }
+    spaceCache->partitioner_ = std::move(partitioner).value();
+    spaceCache->partsOnHost_ = reverse(partsAlloc);
+    spaceCache->partsAlloc_ = std::move(partsAlloc);
+    VLOG(2) << "Load space " << spaceId
+            << ", parts num:" << spaceCache->partsAlloc_.size();
+
+    // loadSchemas
+    if (!loadSchemas(spaceId,
+                     spaceCache,
+                     tagNameIdMap,
+                     edgeNameTypeMap,
+                     edgeTypeNameMap,
+                     newestTagVerMap,
+                     newestEdgeVerMap,
+                     allEdgeMap)) {
+        return nullptr;
+    }
+    return spaceCache;
+}
+
 void MetaClient::addLoadDataTask() {
     size_t delayMS = FLAGS_load_data_interval_secs * 1000 + folly::Random::rand32(900);
     bgThread_->addDelayTask(delayMS, &MetaClient::loadDataThreadFunc, this);
@@ -318,6 +414,20 @@ MetaClient::reverse(const PartsAlloc& parts) {
     return hosts;
 }
 
+StatusOr<std::shared_ptr<const Partitioner>>
+MetaClient::toPartitioner(const cpp2::SpaceProperties& properties, int32_t partsNum) {
+    if (partsNum <= 0) {
+        return Status::Error("No parts");
+    }
+    switch (properties.get_partition_strategy()) {
+        case cpp2::PartitionStrategy::HASH:
+            return Partitioner::hash(partsNum);
+        case cpp2::PartitionStrategy::RANGE:
+            return Partitioner::range(partsNum, properties.get_range_bounds());
+    }
+    return Status::Error("Unknown partition strategy");
+}
+
 template<typename Request,
          typename RemoteFunc,
          typename RespGenerator,
@@ -559,11 +669,17 @@ void MetaClient::diff(const LocalCache& oldCache, const LocalCache& newCache) {
 folly::Future<StatusOr<GraphSpaceID>> MetaClient::createSpace(std::string name,
                                                               int32_t partsNum,
                                                               int32_t replicaFactor,
-                                                              bool ifNotExists) {
+                                                              bool ifNotExists,
+                                                              bool singleVersion,
+                                                              cpp2::PartitionStrategy strategy,
+                                                              std::vector<VertexID> rangeBounds) {
     cpp2::SpaceProperties properties;
     properties.set_space_name(std::move(name));
     properties.set_partition_num(partsNum);
     properties.set_replica_factor(replicaFactor);
+    properties.set_single_version(singleVersion);
+    properties.set_partition_strategy(strategy);
+    properties.set_range_bounds(std::move(rangeBounds));
     cpp2::CreateSpaceReq req;
     req.set_properties(std::move(properties));
     req.set_if_not_exists(ifNotExists);
@@ -589,6 +705,30 @@ folly::Future<StatusOr<std::vector<SpaceIdName>>> MetaClient::listSpaces() {
     return future;
 }
 
+folly::Future<StatusOr<cpp2::ListSpacesResp>> MetaClient::listSpacesWithVersions() {
+    cpp2::ListSpacesReq req;
+    folly::Promise<StatusOr<cpp2::ListSpacesResp>> promise;
+    auto future = promise.getFuture();
+    getResponse(std::move(req), [] (auto client, auto request) {
+                    return client->future_listSpaces(request);
+                }, [] (cpp2::ListSpacesResp&& resp) -> cpp2::ListSpacesResp {
+                    return std::move(resp);
+                }, std::move(promise));
+    return future;
+}
+
+folly::Future<StatusOr<int64_t>> MetaClient::getCatalogVersion() {
+    cpp2::GetCatalogVersionReq req;
+    folly::Promise<StatusOr<int64_t>> promise;
+    auto future = promise.getFuture();
+    getResponse(std::move(req), [] (auto client, auto request) {
+                    return client->future_getCatalogVersion(request);
+                }, [] (cpp2::GetCatalogVersionResp&& resp) -> int64_t {
+                    return resp.get_version();
+                }, std::move(promise));
+    return future;
+}
+
 folly::Future<StatusOr<cpp2::SpaceItem>>
 MetaClient::getSpace(std::string name) {
     cpp2::GetSpaceReq req;
@@ -925,6 +1065,24 @@ StatusOr<int32_t> MetaClient::partsNum(GraphSpaceID spaceId) {
     return it->second->partsAlloc_.size();
 }
 
+StatusOr<std::shared_ptr<const Partitioner>> MetaClient::partitioner(GraphSpaceID spaceId) {
+    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
+    auto it = localCache_.find(spaceId);
+    if (it == localCache_.end()) {
+        return Status::Error("Space not found, spaceid: %d", spaceId);
+    }
+    return it->second->partitioner_;
+}
+
+StatusOr<bool> MetaClient::isSingleVersion(GraphSpaceID spaceId) {
+    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
+    auto it = localCache_.find(spaceId);
+    if (it == localCache_.end()) {
+        return Status::Error("Space not found, spaceid: %d", spaceId);
+    }
+    return it->second->singleVersion_;
+}
+
 folly::Future<StatusOr<TagID>> MetaClient::createTagSchema(GraphSpaceID spaceId,
                                                            std::string name,
                                                            nebula::cpp2::Schema schema,
@@ -1334,6 +1492,14 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
     thriftHost.set_port(localHost_.second);
     req.set_host(std::move(thriftHost));
     req.set_cluster_id(clusterId_.load());
+    {
+        folly::RWSpinLock::ReadHolder holder(listenerLock_);
+        if (listener_ != nullptr) {
+            std::unordered_map<GraphSpaceID, std::vector<cpp2::LeaderInfo>> leaderInfos;
+            listener_->fetchLeaderInfo(leaderInfos);
+            req.set_leader_infos(std::move(leaderInfos));
+        }
+    }
     folly::Promise<StatusOr<bool>> promise;
     auto future = promise.getFuture();
     VLOG(1) << "Send heartbeat to " << leader_ << ", clusterId " << req.get_cluster_id();
@@ -10,10 +10,12 @@
 #include "base/Base.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/RWSpinLock.h>
+#include <folly/Optional.h>
 #include <gtest/gtest_prod.h>
 #include "gen-cpp2/MetaServiceAsyncClient.h"
 #include "base/Status.h"
 #include "base/StatusOr.h"
+#include "base/Partitioner.h"
 #include "thread/GenericWorker.h"
 #include "thrift/ThriftClientManager.h"
 #include "meta/SchemaProviderIf.h"
@@ -40,6 +42,10 @@ using EdgeIndexes = std::unordered_map<EdgeIndexID, std::shared_ptr<const cpp2::
 
 struct SpaceInfoCache {
     std::string spaceName;
+    // The catalog version on metad, the cache is reused until it changes
+    folly::Optional<int64_t> version_;
+    bool singleVersion_{false};
+    std::shared_ptr<const Partitioner> partitioner_;
     PartsAlloc partsAlloc_;
     std::unordered_map<HostAddr, std::vector<PartitionID>> partsOnHost_;
     TagSchemas tagSchemas_;
@@ -97,6 +103,10 @@ public:
     virtual void onPartAdded(const PartMeta& partMeta) = 0;
     virtual void onPartRemoved(GraphSpaceID spaceId, PartitionID partId) = 0;
     virtual void onPartUpdated(const PartMeta& partMeta) = 0;
+    // The parts led by the local host, reported to metad along with the heartbeat
+    virtual void fetchLeaderInfo(std::unordered_map<GraphSpaceID,
+                                                    std::vector<cpp2::LeaderInfo>>& leaderInfos)
+                                                    = 0;
 };
 
 class MetaClient {
@@ -108,6 +118,7 @@ class MetaClient {
     FRIEND_TEST(MetaClientTest, RetryOnceTest);
     FRIEND_TEST(MetaClientTest, RetryUntilLimitTest);
     FRIEND_TEST(MetaClientTest, RocksdbOptionsTest);
+    FRIEND_TEST(MetaClientTest, LoadUnchangedSpacesTest);
 
 public:
     explicit MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -144,11 +155,23 @@ public:
     folly::Future<StatusOr<GraphSpaceID>> createSpace(std::string name,
                                                       int32_t partsNum,
                                                       int32_t replicaFactor,
-                                                      bool ifNotExists = false);
+                                                      bool ifNotExists = false,
+                                                      bool singleVersion = false,
+                                                      cpp2::PartitionStrategy strategy
+                                                        = cpp2::PartitionStrategy::HASH,
+                                                      std::vector<VertexID> rangeBounds = {});
 
     folly::Future<StatusOr<std::vector<SpaceIdName>>>
     listSpaces();
 
+    // The spaces along with their catalog versions
+    folly::Future<StatusOr<cpp2::ListSpacesResp>>
+    listSpacesWithVersions();
+
+    // The version of the whole catalog, which is unchanged if no space is changed
+    folly::Future<StatusOr<int64_t>>
+    getCatalogVersion();
+
     folly::Future<StatusOr<cpp2::SpaceItem>>
     getSpace(std::string name);
 
@@ -317,6 +340,10 @@ public:
 
     StatusOr<int32_t> partsNum(GraphSpaceID spaceId);
 
+    StatusOr<std::shared_ptr<const Partitioner>> partitioner(GraphSpaceID spaceId);
+
+    StatusOr<bool> isSingleVersion(GraphSpaceID spaceId);
+
     StatusOr<std::shared_ptr<const SchemaProviderIf>>
     getTagSchemaFromCache(GraphSpaceID spaceId, TagID tagID, SchemaVer ver = -1);
 
@@ -372,6 +399,15 @@ protected:
                      SpaceNewestEdgeVerMap &newestEdgeVerMap,
                      SpaceAllEdgeMap &allEdgemap);
 
+    std::shared_ptr<SpaceInfoCache> loadSpace(GraphSpaceID spaceId,
+                                              const std::string& spaceName,
+                                              SpaceTagNameIdMap &tagNameIdMap,
+                                              SpaceEdgeNameTypeMap &edgeNameTypeMap,
+                                              SpaceEdgeTypeNameMap &edgeTypeNamemap,
+                                              SpaceNewestTagVerMap &newestTagVerMap,
+                                              SpaceNewestEdgeVerMap &newestEdgeVerMap,
+                                              SpaceAllEdgeMap &allEdgemap);
+
     bool loadIndexes(GraphSpaceID spaceId,
                      std::shared_ptr<SpaceInfoCache> cache);
 
@@ -379,6 +415,9 @@ protected:
 
     std::unordered_map<HostAddr, std::vector<PartitionID>> reverse(const PartsAlloc& parts);
 
+    StatusOr<std::shared_ptr<const Partitioner>>
+    toPartitioner(const cpp2::SpaceProperties& properties, int32_t partsNum);
+
     void updateActive() {
         folly::RWSpinLock::WriteHolder holder(hostLock_);
         active_ = addrs_[folly::Random::rand64(addrs_.size())];
@@ -441,6 +480,8 @@ private:
     SpaceNewestTagVerMap  spaceNewestTagVerMap_;
     SpaceNewestEdgeVerMap spaceNewestEdgeVerMap_;
     SpaceAllEdgeMap      spaceAllEdgeMap_;
+    // The catalog version of the local cache, only accessed by the loading thread
+    int64_t               catalogVersion_{0};
     folly::RWSpinLock     localCacheLock_;
     MetaChangedListener*  listener_{nullptr};
     folly::RWSpinLock     listenerLock_;
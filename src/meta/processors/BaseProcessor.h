@@ -14,8 +14,10 @@
 #include "base/StatusOr.h"
 #include "time/Duration.h"
 #include "kvstore/KVStore.h"
+#include "kvstore/LogEncoder.h"
 #include "meta/MetaServiceUtils.h"
 #include "meta/common/MetaCommon.h"
+#include "meta/IdAllocator.h"
 #include "network/NetworkUtils.h"
 #include "meta/processors/Common.h"
 #include "stats/Stats.h"
@@ -176,15 +178,39 @@ protected:
      **/
      void doMultiRemove(std::vector<std::string> keys);
 
+    /**
+     * Remove the keys and put the data in one batch.
+     **/
+    void doMultiRemoveAndPut(std::vector<std::string> keys, std::vector<kvstore::KV> data);
+
+    /**
+     * Add the kvs to bump the versions of the space and the whole catalog,
+     * put along with the changes of the space.
+     * */
+    void bumpVersions(GraphSpaceID spaceId, std::vector<kvstore::KV>& data) {
+        auto version = MetaServiceUtils::spaceVersionVal(MetaServiceUtils::nextSpaceVersion());
+        data.emplace_back(MetaServiceUtils::spaceVersionKey(spaceId), version);
+        data.emplace_back(MetaServiceUtils::catalogVersionKey(), std::move(version));
+    }
+
+    /**
+     * The kv to bump the version of the whole catalog only, e.g. on dropping a space.
+     * */
+    kvstore::KV catalogVersionKV() {
+        return std::make_pair(MetaServiceUtils::catalogVersionKey(),
+                              MetaServiceUtils::spaceVersionVal(
+                                  MetaServiceUtils::nextSpaceVersion()));
+    }
+
     /**
      * Get all hosts
      * */
     StatusOr<std::vector<nebula::cpp2::HostAddr>> allHosts();
 
     /**
-     * Get one auto-increment Id.
+     * Get one auto-increment Id from the allocator of the meta service.
      * */
-    ErrorOr<cpp2::ErrorCode, int32_t> autoIncrementId();
+    ErrorOr<cpp2::ErrorCode, int32_t> autoIncrementId(IdAllocator* idAllocator);
 
     /**
      * Check spaceId exist or not.
@@ -94,6 +94,32 @@ void BaseProcessor<RESP>::doMultiRemove(std::vector<std::string> keys) {
 }
 
 
+template<typename RESP>
+void BaseProcessor<RESP>::doMultiRemoveAndPut(std::vector<std::string> keys,
+                                              std::vector<kvstore::KV> data) {
+    kvstore::BatchHolder batch;
+    for (auto& key : keys) {
+        batch.remove(std::move(key));
+    }
+    for (auto& kv : data) {
+        batch.put(std::move(kv.first), std::move(kv.second));
+    }
+    auto encoded = kvstore::encodeBatchValue(batch.getBatch());
+    folly::Baton<true, std::atomic> baton;
+    kvstore_->asyncAtomicOp(kDefaultSpaceId,
+                            kDefaultPartId,
+                            [encoded = std::move(encoded)] () mutable {
+                                return std::move(encoded);
+                            },
+                            [this, &baton] (kvstore::ResultCode code) {
+        this->resp_.set_code(to(code));
+        baton.post();
+    });
+    baton.wait();
+    this->onFinished();
+}
+
+
 template<typename RESP>
 void BaseProcessor<RESP>::doRemoveRange(const std::string& start,
                                         const std::string& end) {
@@ -151,38 +177,14 @@ StatusOr<std::vector<nebula::cpp2::HostAddr>> BaseProcessor<RESP>::allHosts() {
 
 
 template<typename RESP>
-ErrorOr<cpp2::ErrorCode, int32_t> BaseProcessor<RESP>::autoIncrementId() {
-    folly::SharedMutex::WriteHolder holder(LockUtils::idLock());
-    static const std::string kIdKey = "__id__";
+ErrorOr<cpp2::ErrorCode, int32_t> BaseProcessor<RESP>::autoIncrementId(IdAllocator* idAllocator) {
+    CHECK_NOTNULL(idAllocator);
     int32_t id;
-    std::string val;
-    auto ret = kvstore_->get(kDefaultSpaceId, kDefaultPartId, kIdKey, &val);
-    if (ret != kvstore::ResultCode::SUCCEEDED) {
-        if (ret != kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
-            return to(ret);
-        }
-        id = 1;
-    } else {
-        id = *reinterpret_cast<const int32_t*>(val.c_str()) + 1;
-    }
-
-    std::vector<kvstore::KV> data;
-    data.emplace_back(kIdKey,
-                      std::string(reinterpret_cast<const char*>(&id), sizeof(id)));
-    folly::Baton<true, std::atomic> baton;
-    kvstore_->asyncMultiPut(kDefaultSpaceId,
-                            kDefaultPartId,
-                            std::move(data),
-                            [&] (kvstore::ResultCode code) {
-        ret = code;
-        baton.post();
-    });
-    baton.wait();
+    auto ret = idAllocator->allocate(&id);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
         return to(ret);
-    } else {
-        return id;
     }
+    return id;
 }
 
 
@@ -26,17 +26,28 @@ public:
         return l; \
     }
 
+// The schemas of different spaces are guarded by different stripes,
+// so the DDLs on one space don't block the others.
+#define GENERATE_SPACE_LOCK(Entry) \
+    static folly::SharedMutex& Entry##Lock(GraphSpaceID space) { \
+        static folly::SharedMutex l[kSpaceLockStripes]; \
+        return l[static_cast<uint32_t>(space) % kSpaceLockStripes]; \
+    }
+
+    static constexpr size_t kSpaceLockStripes = 64;
+
 GENERATE_LOCK(space);
-GENERATE_LOCK(id);
-GENERATE_LOCK(tag);
-GENERATE_LOCK(edge);
-GENERATE_LOCK(tagIndex);
-GENERATE_LOCK(edgeIndex);
+GENERATE_LOCK(host);
 GENERATE_LOCK(user);
 GENERATE_LOCK(config);
 GENERATE_LOCK(snapshot);
+GENERATE_SPACE_LOCK(tag);
+GENERATE_SPACE_LOCK(edge);
+GENERATE_SPACE_LOCK(tagIndex);
+GENERATE_SPACE_LOCK(edgeIndex);
 
 #undef GENERATE_LOCK
+#undef GENERATE_SPACE_LOCK
 };
 
 
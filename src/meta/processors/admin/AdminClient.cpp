@@ -38,7 +38,7 @@ folly::Future<Status> AdminClient::transLeader(GraphSpaceID spaceId,
     auto target = dst;
     if (dst == kRandomPeer) {
         for (auto& p : peers) {
-            if (p != leader && ActiveHostsMan::isLived(kv_, p)) {
+            if (p != leader && activeHostsMan_->isLived(p)) {
                 target = p;
                 break;
             }
@@ -210,6 +210,9 @@ folly::Future<Status> AdminClient::updateMeta(GraphSpaceID spaceId,
     std::vector<kvstore::KV> data;
     data.emplace_back(MetaServiceUtils::partKey(spaceId, partId),
                       MetaServiceUtils::partVal(thriftPeers));
+    auto version = MetaServiceUtils::spaceVersionVal(MetaServiceUtils::nextSpaceVersion());
+    data.emplace_back(MetaServiceUtils::spaceVersionKey(spaceId), version);
+    data.emplace_back(MetaServiceUtils::catalogVersionKey(), std::move(version));
     part->asyncMultiPut(std::move(data), [] (kvstore::ResultCode) {});
     part->sync([this, p = std::move(pro)] (kvstore::ResultCode code) mutable {
         // To avoid dead lock, we call future callback in ioThreadPool_
@@ -531,7 +534,7 @@ folly::Future<Status> AdminClient::getLeaderDist(HostLeaderMap* result) {
     }
     folly::Promise<Status> promise;
     auto future = promise.getFuture();
-    auto allHosts = ActiveHostsMan::getActiveHosts(kv_);
+    auto allHosts = activeHostsMan_->getActiveHosts();
 
     std::vector<folly::Future<StatusOr<storage::cpp2::GetLeaderResp>>> hostFutures;
     for (const auto& h : allHosts) {
@@ -568,7 +571,7 @@ folly::Future<Status> AdminClient::getLeaderDist(HostLeaderMap* result) {
 }
 
 folly::Future<Status> AdminClient::createSnapshot(GraphSpaceID spaceId, const std::string& name) {
-    auto allHosts = ActiveHostsMan::getActiveHosts(kv_);
+    auto allHosts = activeHostsMan_->getActiveHosts();
     storage::cpp2::CreateCPRequest req;
     req.set_space_id(spaceId);
     req.set_name(name);
@@ -603,7 +606,7 @@ folly::Future<Status> AdminClient::dropSnapshot(GraphSpaceID spaceId,
 
 folly::Future<Status> AdminClient::blockingWrites(GraphSpaceID spaceId,
                                                   storage::cpp2::EngineSignType sign) {
-    auto allHosts = ActiveHostsMan::getActiveHosts(kv_);
+    auto allHosts = activeHostsMan_->getActiveHosts();
     storage::cpp2::BlockingSignRequest req;
     req.set_space_id(spaceId);
     req.set_sign(sign);
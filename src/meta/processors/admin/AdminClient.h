@@ -13,14 +13,11 @@
 #include "thrift/ThriftClientManager.h"
 #include "gen-cpp2/StorageServiceAsyncClient.h"
 #include "kvstore/KVStore.h"
+#include "meta/ActiveHostsMan.h"
 
 namespace nebula {
 namespace meta {
 
-using HostLeaderMap = std::unordered_map<HostAddr,
-                                         std::unordered_map<GraphSpaceID,
-                                                            std::vector<PartitionID>>>;
-
 class FaultInjector {
 public:
     virtual ~FaultInjector() = default;
@@ -46,8 +43,9 @@ class AdminClient {
 public:
     AdminClient() = default;
 
-    explicit AdminClient(kvstore::KVStore* kv)
-        : kv_(kv) {
+    AdminClient(kvstore::KVStore* kv, ActiveHostsMan* activeHostsMan)
+        : kv_(kv)
+        , activeHostsMan_(activeHostsMan) {
         ioThreadPool_ = std::make_unique<folly::IOThreadPoolExecutor>(10);
         clientsMan_ = std::make_unique<
             thrift::ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>>();
@@ -144,6 +142,7 @@ private:
 private:
     std::unique_ptr<FaultInjector> injector_{nullptr};
     kvstore::KVStore* kv_ = nullptr;
+    ActiveHostsMan* activeHostsMan_ = nullptr;
     std::unique_ptr<folly::IOThreadPoolExecutor> ioThreadPool_{nullptr};
     std::unique_ptr<thrift::ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>>
     clientsMan_;
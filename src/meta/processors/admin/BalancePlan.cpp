@@ -10,6 +10,8 @@
 #include "meta/ActiveHostsMan.h"
 
 DEFINE_uint32(task_concurrency, 10, "The tasks number could be invoked simultaneously");
+DEFINE_uint32(max_tasks_per_src_host, 2, "The max number of parts moved out of a host at once");
+DEFINE_uint32(max_tasks_per_dst_host, 2, "The max number of parts moved into a host at once");
 
 namespace nebula {
 namespace meta {
@@ -23,94 +25,120 @@ void BalancePlan::dispatchTasks() {
     for (auto& task : tasks_) {
         partTasks[std::make_pair(task.spaceId_, task.partId_)].emplace_back(index++);
     }
-    buckets_.resize(std::min(partTasks.size(), (size_t)FLAGS_task_concurrency));
-    for (auto it = partTasks.begin(); it != partTasks.end(); it++) {
-        size_t minNum = tasks_.size();
-        int32_t i = 0, minIndex = 0;
-        for (auto& bucket : buckets_) {
-            if (bucket.size() < minNum) {
-                minNum = bucket.size();
-                minIndex = i;
+    buckets_.clear();
+    buckets_.reserve(partTasks.size());
+    for (auto& entry : partTasks) {
+        buckets_.emplace_back(std::move(entry.second));
+    }
+}
+
+std::vector<int32_t> BalancePlan::pickTasks() {
+    std::vector<int32_t> picked;
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+        auto taskIndex = buckets_[*it][bucketPos_[*it]];
+        auto& task = tasks_[taskIndex];
+        if (stopped_) {
+            task.ret_ = BalanceTask::Result::INVALID;
+        }
+        // The tasks finished or to be skipped don't move any data, so they are not limited
+        if (task.ret_ == BalanceTask::Result::IN_PROGRESS) {
+            if (running_ >= FLAGS_task_concurrency
+                    || (task.srcLived_
+                        && srcRunning_[task.src_] >= FLAGS_max_tasks_per_src_host)
+                    || dstRunning_[task.dst_] >= FLAGS_max_tasks_per_dst_host) {
+                ++it;
+                continue;
+            }
+            running_++;
+            if (task.srcLived_) {
+                srcRunning_[task.src_]++;
+            }
+            dstRunning_[task.dst_]++;
+            moving_[taskIndex] = true;
+        }
+        picked.emplace_back(taskIndex);
+        it = waiting_.erase(it);
+    }
+    return picked;
+}
+
+void BalancePlan::onTaskDone(size_t bucketIndex, int32_t taskIndex, bool failed) {
+    bool finished = false;
+    std::vector<int32_t> picked;
+    {
+        std::lock_guard<std::mutex> lg(lock_);
+        finishedTaskNum_++;
+        if (failed) {
+            status_ = Status::FAILED;
+        }
+        if (moving_[taskIndex]) {
+            auto& task = tasks_[taskIndex];
+            moving_[taskIndex] = false;
+            running_--;
+            if (task.srcLived_) {
+                srcRunning_[task.src_]--;
+            }
+            dstRunning_[task.dst_]--;
+        }
+        if (++bucketPos_[bucketIndex] < buckets_[bucketIndex].size()) {
+            if (failed) {
+                auto& task = tasks_[buckets_[bucketIndex][bucketPos_[bucketIndex]]];
+                LOG(INFO) << "Skip the task for the same partId " << task.partId_;
+                task.ret_ = BalanceTask::Result::FAILED;
             }
-            i++;
+            // Go on with the same part first
+            waiting_.push_front(bucketIndex);
         }
-        for (auto taskIndex : it->second) {
-            buckets_[minIndex].emplace_back(taskIndex);
+        if (finishedTaskNum_ == tasks_.size()) {
+            finished = true;
+            if (status_ == Status::IN_PROGRESS) {
+                status_ = Status::SUCCEEDED;
+                LOG(INFO) << "Balance " << id_ << " succeeded!";
+            } else {
+                LOG(INFO) << "Balance " << id_ << " failed!";
+            }
+        } else {
+            picked = pickTasks();
         }
     }
+    if (finished) {
+        CHECK(waiting_.empty());
+        saveInStore(true);
+        onFinished_();
+        return;
+    }
+    for (auto index : picked) {
+        tasks_[index].invoke();
+    }
 }
 
 void BalancePlan::invoke() {
     status_ = Status::IN_PROGRESS;
     dispatchTasks();
+    bucketPos_.assign(buckets_.size(), 0);
+    moving_.assign(tasks_.size(), false);
     for (size_t i = 0; i < buckets_.size(); i++) {
-        for (size_t j = 0; j < buckets_[i].size(); j++) {
-            auto taskIndex = buckets_[i][j];
-            tasks_[taskIndex].onFinished_ = [this, i, j]() {
-                bool finished = false;
-                bool stopped = false;
-                {
-                    std::lock_guard<std::mutex> lg(lock_);
-                    finishedTaskNum_++;
-                    if (finishedTaskNum_ == tasks_.size()) {
-                        finished = true;
-                        if (status_ == Status::IN_PROGRESS) {
-                            status_ = Status::SUCCEEDED;
-                            LOG(INFO) << "Balance " << id_ << " succeeded!";
-                        }
-                    }
-                    stopped = stopped_;
-                }
-                if (finished) {
-                    CHECK_EQ(j, this->buckets_[i].size() - 1);
-                    saveInStore(true);
-                    onFinished_();
-                } else if (j + 1 < this->buckets_[i].size()) {
-                    auto& task = this->tasks_[this->buckets_[i][j + 1]];
-                    if (stopped) {
-                        task.ret_ = BalanceTask::Result::INVALID;
-                    }
-                    task.invoke();
-                }
-            };  // onFinished
-            tasks_[taskIndex].onError_ = [this, i, j, taskIndex]() {
-                bool finished = false;
-                bool stopped = false;
-                {
-                    std::lock_guard<std::mutex> lg(lock_);
-                    finishedTaskNum_++;
-                    status_ = Status::FAILED;
-                    if (finishedTaskNum_ == tasks_.size()) {
-                        finished = true;
-                        LOG(INFO) << "Balance " << id_ << " failed!";
-                    }
-                    stopped = stopped_;
-                }
-                if (finished) {
-                    CHECK_EQ(j, this->buckets_[i].size() - 1);
-                    saveInStore(true);
-                    onFinished_();
-                } else if (j + 1 < this->buckets_[i].size()) {
-                    auto& task = this->tasks_[this->buckets_[i][j + 1]];
-                    if (tasks_[taskIndex].spaceId_ == task.spaceId_
-                            && tasks_[taskIndex].partId_ == task.partId_) {
-                        LOG(INFO) << "Skip the task for the same partId " << task.partId_;
-                        task.ret_ = BalanceTask::Result::FAILED;
-                    }
-                    if (stopped) {
-                        task.ret_ = BalanceTask::Result::INVALID;
-                    }
-                    task.invoke();
-                }
-            };  // onError
-        }  // for (auto j = 0; j < buckets_[i].size(); j++)
-    }  // for (auto i = 0; i < buckets_.size(); i++)
+        for (auto taskIndex : buckets_[i]) {
+            tasks_[taskIndex].onFinished_ = [this, i, taskIndex]() {
+                onTaskDone(i, taskIndex, false);
+            };
+            tasks_[taskIndex].onError_ = [this, i, taskIndex]() {
+                onTaskDone(i, taskIndex, true);
+            };
+        }
+    }
 
     saveInStore(true);
-    for (auto& bucket : buckets_) {
-        if (!bucket.empty()) {
-            tasks_[bucket[0]].invoke();
+    std::vector<int32_t> picked;
+    {
+        std::lock_guard<std::mutex> lg(lock_);
+        for (size_t i = 0; i < buckets_.size(); i++) {
+            waiting_.emplace_back(i);
         }
+        picked = pickTasks();
+    }
+    for (auto index : picked) {
+        tasks_[index].invoke();
     }
 }
 
@@ -177,12 +205,12 @@ bool BalancePlan::recovery(bool resume) {
                         task.ret_ = BalanceTask::Result::IN_PROGRESS;
                     }
                     task.status_ = BalanceTask::Status::START;
-                    if (ActiveHostsMan::isLived(kv_, task.src_)) {
+                    if (activeHostsMan_->isLived(task.src_)) {
                         task.srcLived_ = true;
                     } else {
                         task.srcLived_ = false;
                     }
-                    if (!ActiveHostsMan::isLived(kv_, task.dst_)) {
+                    if (!activeHostsMan_->isLived(task.dst_)) {
                         task.ret_ = BalanceTask::Result::INVALID;
                     }
                 }
@@ -23,6 +23,7 @@ class BalancePlan {
     FRIEND_TEST(BalanceTest, RecoveryTest);
     FRIEND_TEST(BalanceTest, DispatchTasksTest);
     FRIEND_TEST(BalanceTest, StopBalanceDataTest);
+    FRIEND_TEST(BalanceTest, ThrottleTasksTest);
 
 public:
     enum class Status : uint8_t {
@@ -37,14 +38,19 @@ public:
         FAILED             = 0x04,
     };
 
-    BalancePlan(BalanceID id, kvstore::KVStore* kv, AdminClient* client)
+    BalancePlan(BalanceID id,
+                kvstore::KVStore* kv,
+                ActiveHostsMan* activeHostsMan,
+                AdminClient* client)
         : id_(id)
         , kv_(kv)
+        , activeHostsMan_(activeHostsMan)
         , client_(client) {}
 
     BalancePlan(const BalancePlan& plan)
         : id_(plan.id_)
         , kv_(plan.kv_)
+        , activeHostsMan_(plan.activeHostsMan_)
         , client_(plan.client_)
         , tasks_(plan.tasks_)
         , finishedTaskNum_(plan.finishedTaskNum_)
@@ -92,6 +98,11 @@ private:
 
     void dispatchTasks();
 
+    // Pick the tasks which could be run now, called with lock_ held
+    std::vector<int32_t> pickTasks();
+
+    void onTaskDone(size_t bucketIndex, int32_t taskIndex, bool failed);
+
     static const std::string& prefix();
 
     static BalanceID id(const folly::StringPiece& rawKey);
@@ -101,6 +112,7 @@ private:
 private:
     BalanceID id_ = 0;
     kvstore::KVStore* kv_ = nullptr;
+    ActiveHostsMan* activeHostsMan_ = nullptr;
     AdminClient* client_ = nullptr;
     std::vector<BalanceTask> tasks_;
     std::mutex lock_;
@@ -109,9 +121,19 @@ private:
     Status status_ = Status::NOT_START;
     bool stopped_ = false;
 
-    // List of task index in tasks_;
+    // List of task index in tasks_, the tasks of one part are in the same bucket
+    // and run one by one.
     using Bucket = std::vector<int32_t>;
     std::vector<Bucket> buckets_;
+    // The position of the running or next task in each bucket
+    std::vector<size_t> bucketPos_;
+    // The buckets whose next task is waiting for running
+    std::list<size_t> waiting_;
+    // Whether the task is moving data, which takes the slots of its hosts
+    std::vector<bool> moving_;
+    uint32_t running_ = 0;
+    std::unordered_map<HostAddr, uint32_t> srcRunning_;
+    std::unordered_map<HostAddr, uint32_t> dstRunning_;
 };
 
 }  // namespace meta
@@ -24,7 +24,7 @@ void BalanceProcessor::process(const cpp2::BalanceReq& req) {
             onFinished();
             return;
         }
-        auto ret = Balancer::instance(kvstore_)->stop();
+        auto ret = Balancer::instance(kvstore_, activeHostsMan_)->stop();
         if (!ret.ok()) {
             resp_.set_code(cpp2::ErrorCode::E_NO_RUNNING_BALANCE_PLAN);
             onFinished();
@@ -36,7 +36,7 @@ void BalanceProcessor::process(const cpp2::BalanceReq& req) {
         return;
     }
     if (req.get_id() != nullptr) {
-        auto ret = Balancer::instance(kvstore_)->show(*req.get_id());
+        auto ret = Balancer::instance(kvstore_, activeHostsMan_)->show(*req.get_id());
         if (!ret.ok()) {
             resp_.set_code(cpp2::ErrorCode::E_BAD_BALANCE_PLAN);
             onFinished();
@@ -62,6 +62,9 @@ void BalanceProcessor::process(const cpp2::BalanceReq& req) {
                     t.set_result(cpp2::TaskResult::INVALID);
                     break;
             }
+            t.set_step(BalanceTask::statusName(task.status()));
+            t.set_start_time(task.startTimeMs());
+            t.set_end_time(task.endTimeMs());
             thriftTasks.emplace_back(std::move(t));
         }
         resp_.set_tasks(std::move(thriftTasks));
@@ -75,14 +78,14 @@ void BalanceProcessor::process(const cpp2::BalanceReq& req) {
                        std::back_inserter(hostDel),
                        [] (const auto& h) { return HostAddr(h.get_ip(), h.get_port()); });
     }
-    auto hosts = ActiveHostsMan::getActiveHosts(kvstore_);
+    auto hosts = activeHostsMan_->getActiveHosts();
     if (hosts.empty()) {
         LOG(ERROR) << "There is no active hosts";
         resp_.set_code(cpp2::ErrorCode::E_NO_HOSTS);
         onFinished();
         return;
     }
-    auto ret = Balancer::instance(kvstore_)->balance(std::move(hostDel));
+    auto ret = Balancer::instance(kvstore_, activeHostsMan_)->balance(std::move(hostDel));
     if (!ok(ret)) {
         resp_.set_code(error(ret));
         onFinished();
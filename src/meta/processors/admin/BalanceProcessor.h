@@ -16,15 +16,19 @@ namespace meta {
 
 class BalanceProcessor : public BaseProcessor<cpp2::BalanceResp> {
 public:
-    static BalanceProcessor* instance(kvstore::KVStore* kvstore) {
-        return new BalanceProcessor(kvstore);
+    static BalanceProcessor* instance(kvstore::KVStore* kvstore,
+                                      ActiveHostsMan* activeHostsMan) {
+        return new BalanceProcessor(kvstore, activeHostsMan);
     }
 
     void process(const cpp2::BalanceReq& req);
 
 private:
-    explicit BalanceProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::BalanceResp>(kvstore) {}
+    BalanceProcessor(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan)
+            : BaseProcessor<cpp2::BalanceResp>(kvstore)
+            , activeHostsMan_(activeHostsMan) {}
+
+    ActiveHostsMan* activeHostsMan_;
 };
 
 }  // namespace meta
@@ -194,7 +194,7 @@ void BalanceTask::invoke() {
         }
         case Status::END: {
             LOG(INFO) << taskIdStr_ <<  "Part has been moved successfully!";
-            endTimeMs_ = time::WallClock::fastNowInSec();
+            endTimeMs_ = time::WallClock::fastNowInMilliSec();
             SAVE_STATE();
             onFinished_();
             break;
@@ -234,6 +234,35 @@ bool BalanceTask::saveInStore() {
     return true;
 }
 
+// static
+const char* BalanceTask::statusName(Status status) {
+    switch (status) {
+        case Status::START:
+            return "START";
+        case Status::CHANGE_LEADER:
+            return "CHANGE_LEADER";
+        case Status::ADD_PART_ON_DST:
+            return "ADD_PART_ON_DST";
+        case Status::ADD_LEARNER:
+            return "ADD_LEARNER";
+        case Status::CATCH_UP_DATA:
+            return "CATCH_UP_DATA";
+        case Status::MEMBER_CHANGE_ADD:
+            return "MEMBER_CHANGE_ADD";
+        case Status::MEMBER_CHANGE_REMOVE:
+            return "MEMBER_CHANGE_REMOVE";
+        case Status::UPDATE_PART_META:
+            return "UPDATE_PART_META";
+        case Status::REMOVE_PART_ON_SRC:
+            return "REMOVE_PART_ON_SRC";
+        case Status::CHECK:
+            return "CHECK";
+        case Status::END:
+            return "END";
+    }
+    return "UNKNOWN";
+}
+
 std::string BalanceTask::taskKey() {
     std::string str;
     str.reserve(64);
@@ -27,6 +27,7 @@ class BalanceTask {
     FRIEND_TEST(BalanceTest, NormalTest);
     FRIEND_TEST(BalanceTest, RecoveryTest);
     FRIEND_TEST(BalanceTest, StopBalanceDataTest);
+    FRIEND_TEST(BalanceTest, ThrottleTasksTest);
 
 public:
     enum class Status : uint8_t {
@@ -81,6 +82,20 @@ public:
         return ret_;
     }
 
+    Status status() const {
+        return status_;
+    }
+
+    int64_t startTimeMs() const {
+        return startTimeMs_;
+    }
+
+    int64_t endTimeMs() const {
+        return endTimeMs_;
+    }
+
+    static const char* statusName(Status status);
+
 private:
     std::string buildTaskId() {
         return folly::stringPrintf("[%ld, %d:%d, %s:%d->%s:%d] ",
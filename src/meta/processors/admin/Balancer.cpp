@@ -14,6 +14,8 @@
 
 DEFINE_double(leader_balance_deviation, 0.05, "after leader balance, leader count should in range "
                                               "[avg * (1 - deviation), avg * (1 + deviation)]");
+DEFINE_bool(leader_balance_by_load, false, "Balance the leaders by the load reported of the parts "
+                                           "instead of the leader count");
 
 namespace nebula {
 namespace meta {
@@ -95,7 +97,8 @@ bool Balancer::recovery() {
             return true;
         }
         CHECK_EQ(1, corruptedPlans.size());
-        plan_ = std::make_unique<BalancePlan>(corruptedPlans[0], kv_, client_.get());
+        plan_ = std::make_unique<BalancePlan>(corruptedPlans[0], kv_, activeHostsMan_,
+                                              client_.get());
         plan_->onFinished_ = [this] () {
             auto self = plan_;
             {
@@ -136,7 +139,8 @@ cpp2::ErrorCode Balancer::buildBalancePlan(std::vector<HostAddr> hostDel) {
     if (!getAllSpaces(spaces, ret)) {
         return cpp2::ErrorCode::E_STORE_FAILURE;
     }
-    plan_ = std::make_unique<BalancePlan>(time::WallClock::fastNowInSec(), kv_, client_.get());
+    plan_ = std::make_unique<BalancePlan>(time::WallClock::fastNowInSec(), kv_,
+                                          activeHostsMan_, client_.get());
     for (auto spaceId : spaces) {
         auto taskRet = genTasks(spaceId, hostDel);
         if (!ok(taskRet)) {
@@ -174,7 +178,7 @@ Balancer::genTasks(GraphSpaceID spaceId, std::vector<HostAddr>& lost) {
         LOG(ERROR) << "Invalid space " << spaceId;
         return cpp2::ErrorCode::E_NOT_FOUND;
     }
-    auto activeHosts = ActiveHostsMan::getActiveHosts(kv_);
+    auto activeHosts = activeHostsMan_->getActiveHosts();
     std::vector<HostAddr> newlyAdded;
     calDiff(hostParts, activeHosts, newlyAdded, lost);
     decltype(hostParts) newHostParts(hostParts);
@@ -397,17 +401,28 @@ cpp2::ErrorCode Balancer::leaderBalance() {
 
     bool expected = false;
     if (inLeaderBalance_.compare_exchange_strong(expected, true)) {
-        hostLeaderMap_.reset(new HostLeaderMap);
-        auto status = client_->getLeaderDist(hostLeaderMap_.get()).get();
-
-        if (!status.ok() || hostLeaderMap_->empty()) {
-            inLeaderBalance_ = false;
-            return cpp2::ErrorCode::E_RPC_FAILURE;
+        // Use the leaders reported by the heartbeats, and ask the hosts only if none
+        hostLeaderMap_.reset(new HostLeaderMap(activeHostsMan_->getLeaderDist()));
+        if (hostLeaderMap_->empty()) {
+            auto status = client_->getLeaderDist(hostLeaderMap_.get()).get();
+            if (!status.ok() || hostLeaderMap_->empty()) {
+                inLeaderBalance_ = false;
+                return cpp2::ErrorCode::E_RPC_FAILURE;
+            }
         }
 
+        PartLoads partLoads;
+        if (FLAGS_leader_balance_by_load) {
+            partLoads = activeHostsMan_->getPartLoads();
+        }
         LeaderBalancePlan plan;
         for (const auto& space : spaces) {
-            buildLeaderBalancePlan(hostLeaderMap_.get(), space, plan);
+            auto loadIt = partLoads.find(space);
+            if (loadIt != partLoads.end()) {
+                buildLoadBalancePlan(hostLeaderMap_.get(), space, loadIt->second, plan);
+            } else {
+                buildLeaderBalancePlan(hostLeaderMap_.get(), space, plan);
+            }
             simplifyLeaderBalnacePlan(space, plan);
         }
         std::vector<folly::SemiFuture<Status>> futures;
@@ -438,31 +453,10 @@ Balancer::buildLeaderBalancePlan(HostLeaderMap* hostLeaderMap, GraphSpaceID spac
                                  LeaderBalancePlan& plan, bool useDeviation) {
     std::unordered_map<PartitionID, std::vector<HostAddr>> peersMap;
     std::unordered_map<HostAddr, std::vector<PartitionID>> leaderHostParts;
-    size_t leaderParts = 0;
-    {
-        // store peers of all paritions in peerMap
-        folly::SharedMutex::ReadHolder rHolder(LockUtils::spaceLock());
-        auto prefix = MetaServiceUtils::partPrefix(spaceId);
-        std::unique_ptr<kvstore::KVIterator> iter;
-        auto ret = kv_->prefix(kDefaultSpaceId, kDefaultPartId, prefix, &iter);
-        if (ret != kvstore::ResultCode::SUCCEEDED) {
-            LOG(ERROR) << "Access kvstore failed, spaceId " << spaceId;
-            return leaderHostParts;
-        }
-        while (iter->valid()) {
-            auto key = iter->key();
-            PartitionID partId;
-            memcpy(&partId, key.data() + prefix.size(), sizeof(PartitionID));
-            auto thriftPeers = MetaServiceUtils::parsePartVal(iter->val());
-            std::vector<HostAddr> peers;
-            peers.resize(thriftPeers.size());
-            std::transform(thriftPeers.begin(), thriftPeers.end(), peers.begin(),
-                           [] (const auto& h) { return HostAddr(h.get_ip(), h.get_port()); });
-            peersMap[partId] = std::move(peers);
-            ++leaderParts;
-            iter->next();
-        }
+    if (!getPartPeers(spaceId, peersMap)) {
+        return leaderHostParts;
     }
+    size_t leaderParts = peersMap.size();
 
     int32_t totalParts = 0;
     std::unordered_map<HostAddr, std::vector<PartitionID>> allHostParts;
@@ -522,6 +516,137 @@ Balancer::buildLeaderBalancePlan(HostLeaderMap* hostLeaderMap, GraphSpaceID spac
     return leaderHostParts;
 }
 
+std::unordered_map<HostAddr, std::vector<PartitionID>>
+Balancer::buildLoadBalancePlan(HostLeaderMap* hostLeaderMap, GraphSpaceID spaceId,
+                               const std::unordered_map<PartitionID, int64_t>& partLoads,
+                               LeaderBalancePlan& plan) {
+    std::unordered_map<PartitionID, std::vector<HostAddr>> peersMap;
+    std::unordered_map<HostAddr, std::vector<PartitionID>> leaderHostParts;
+    if (!getPartPeers(spaceId, peersMap)) {
+        return leaderHostParts;
+    }
+
+    int32_t totalParts = 0;
+    std::unordered_map<HostAddr, std::vector<PartitionID>> allHostParts;
+    getHostParts(spaceId, allHostParts, totalParts);
+
+    auto loadOf = [&partLoads] (PartitionID partId) -> int64_t {
+        auto it = partLoads.find(partId);
+        return it == partLoads.end() ? 0 : it->second;
+    };
+    // Only balance leader between hosts which have valid partition
+    std::unordered_map<HostAddr, int64_t> hostLoads;
+    int64_t totalLoad = 0;
+    for (const auto& host : *hostLeaderMap) {
+        if (!allHostParts[host.first].empty()) {
+            auto& leaders = leaderHostParts[host.first];
+            leaders = std::move((*hostLeaderMap)[host.first][spaceId]);
+            auto& hostLoad = hostLoads[host.first];
+            for (auto partId : leaders) {
+                hostLoad += loadOf(partId);
+            }
+            totalLoad += hostLoad;
+        }
+    }
+    // The live hosts leading nothing could take over leaders as well
+    for (const auto& host : activeHostsMan_->getActiveHosts()) {
+        if (!allHostParts[host].empty()) {
+            hostLoads.emplace(host, 0);
+            leaderHostParts[host];
+        }
+    }
+
+    if (hostLoads.empty()) {
+        LOG(ERROR) << "No active hosts";
+        return leaderHostParts;
+    }
+
+    double expected = static_cast<double>(totalLoad) / hostLoads.size()
+                    * (1 + FLAGS_leader_balance_deviation);
+    LOG(INFO) << "Build load balance plan, total load: " << totalLoad
+              << ", expected max load: " << expected;
+
+    while (true) {
+        // Always offload the busiest host, until it is not overloaded or can't be improved
+        auto busiest = std::max_element(hostLoads.begin(), hostLoads.end(),
+                                        [] (const auto& l, const auto& r) {
+                                            return l.second < r.second;
+                                        });
+        auto host = busiest->first;
+        auto hostLoad = busiest->second;
+        if (hostLoad <= expected) {
+            break;
+        }
+
+        // Find the transfer which makes the max load of the two hosts minimal
+        auto& hostLeaders = leaderHostParts[host];
+        auto bestPart = hostLeaders.end();
+        HostAddr bestPeer;
+        int64_t bestLoad = hostLoad;
+        for (auto it = hostLeaders.begin(); it != hostLeaders.end(); ++it) {
+            auto partLoad = loadOf(*it);
+            if (partLoad == 0) {
+                continue;
+            }
+            for (const auto& peer : peersMap[*it]) {
+                auto peerIt = hostLoads.find(peer);
+                if (peer == host || peerIt == hostLoads.end()) {
+                    continue;
+                }
+                auto maxLoad = std::max(hostLoad - partLoad, peerIt->second + partLoad);
+                if (maxLoad < bestLoad) {
+                    bestLoad = maxLoad;
+                    bestPart = it;
+                    bestPeer = peer;
+                }
+            }
+        }
+        if (bestPart == hostLeaders.end()) {
+            break;
+        }
+
+        auto partId = *bestPart;
+        auto partLoad = loadOf(partId);
+        hostLeaders.erase(bestPart);
+        leaderHostParts[bestPeer].emplace_back(partId);
+        hostLoads[host] -= partLoad;
+        hostLoads[bestPeer] += partLoad;
+        plan.emplace_back(spaceId, partId, host, bestPeer);
+        LOG(INFO) << "plan trans leader: " << spaceId << " " << partId << " from "
+                  << network::NetworkUtils::intToIPv4(host.first) << ":"
+                  << host.second << " to "
+                  << network::NetworkUtils::intToIPv4(bestPeer.first)
+                  << ":" << bestPeer.second << ", load " << partLoad;
+    }
+    return leaderHostParts;
+}
+
+bool Balancer::getPartPeers(GraphSpaceID spaceId,
+                            std::unordered_map<PartitionID, std::vector<HostAddr>>& peersMap) {
+    // store peers of all paritions in peerMap
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::spaceLock());
+    auto prefix = MetaServiceUtils::partPrefix(spaceId);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = kv_->prefix(kDefaultSpaceId, kDefaultPartId, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Access kvstore failed, spaceId " << spaceId;
+        return false;
+    }
+    while (iter->valid()) {
+        auto key = iter->key();
+        PartitionID partId;
+        memcpy(&partId, key.data() + prefix.size(), sizeof(PartitionID));
+        auto thriftPeers = MetaServiceUtils::parsePartVal(iter->val());
+        std::vector<HostAddr> peers;
+        peers.resize(thriftPeers.size());
+        std::transform(thriftPeers.begin(), thriftPeers.end(), peers.begin(),
+                       [] (const auto& h) { return HostAddr(h.get_ip(), h.get_port()); });
+        peersMap[partId] = std::move(peers);
+        iter->next();
+    }
+    return true;
+}
+
 int32_t Balancer::acquireLeaders(
         std::unordered_map<HostAddr, std::vector<PartitionID>>& allHostParts,
         std::unordered_map<HostAddr, std::vector<PartitionID>>& leaderHostParts,
@@ -52,13 +52,15 @@ class Balancer {
     FRIEND_TEST(BalanceTest, IntersectHostsLeaderBalancePlanTest);
     FRIEND_TEST(BalanceTest, LeaderBalanceTest);
     FRIEND_TEST(BalanceTest, ManyHostsLeaderBalancePlanTest);
+    FRIEND_TEST(BalanceTest, LoadLeaderBalancePlanTest);
     FRIEND_TEST(BalanceIntegrationTest, LeaderBalanceTest);
     FRIEND_TEST(BalanceIntegrationTest, BalanceTest);
 
 public:
-    static Balancer* instance(kvstore::KVStore* kv) {
-        static std::unique_ptr<AdminClient> client(new AdminClient(kv));
-        static std::unique_ptr<Balancer> balancer(new Balancer(kv, std::move(client)));
+    static Balancer* instance(kvstore::KVStore* kv, ActiveHostsMan* activeHostsMan) {
+        static std::unique_ptr<AdminClient> client(new AdminClient(kv, activeHostsMan));
+        static std::unique_ptr<Balancer> balancer(
+            new Balancer(kv, activeHostsMan, std::move(client)));
         return balancer.get();
     }
 
@@ -116,8 +118,11 @@ public:
     }
 
 private:
-    Balancer(kvstore::KVStore* kv, std::unique_ptr<AdminClient> client)
+    Balancer(kvstore::KVStore* kv,
+             ActiveHostsMan* activeHostsMan,
+             std::unique_ptr<AdminClient> client)
         : kv_(kv)
+        , activeHostsMan_(activeHostsMan)
         , client_(std::move(client)) {
         executor_.reset(new folly::CPUThreadPoolExecutor(1));
     }
@@ -167,6 +172,18 @@ private:
     buildLeaderBalancePlan(HostLeaderMap* hostLeaderMap, GraphSpaceID spaceId,
                            LeaderBalancePlan& plan, bool useDeviation = true);
 
+    /**
+     * Transfer the leaders to minimize the max load of the hosts, rather than to
+     * equalize the leader number of them.
+     * */
+    std::unordered_map<HostAddr, std::vector<PartitionID>>
+    buildLoadBalancePlan(HostLeaderMap* hostLeaderMap, GraphSpaceID spaceId,
+                         const std::unordered_map<PartitionID, int64_t>& partLoads,
+                         LeaderBalancePlan& plan);
+
+    bool getPartPeers(GraphSpaceID spaceId,
+                      std::unordered_map<PartitionID, std::vector<HostAddr>>& peersMap);
+
     void simplifyLeaderBalnacePlan(GraphSpaceID spaceId, LeaderBalancePlan& plan);
 
     int32_t acquireLeaders(std::unordered_map<HostAddr, std::vector<PartitionID>>& allHostParts,
@@ -189,6 +206,7 @@ private:
 private:
     std::atomic_bool running_{false};
     kvstore::KVStore* kv_ = nullptr;
+    ActiveHostsMan* activeHostsMan_ = nullptr;
     std::unique_ptr<AdminClient> client_{nullptr};
     // Current running plan.
     std::shared_ptr<BalancePlan> plan_{nullptr};
@@ -19,7 +19,7 @@ void CreateSnapshotProcessor::process(const cpp2::CreateSnapshotReq& req) {
     auto snapshot = genSnapshotName();
     folly::SharedMutex::WriteHolder wHolder(LockUtils::snapshotLock());
 
-    auto hosts = ActiveHostsMan::getActiveHosts(kvstore_);
+    auto hosts = activeHostsMan_->getActiveHosts();
     if (hosts.empty()) {
         LOG(ERROR) << "There is no active hosts";
         resp_.set_code(cpp2::ErrorCode::E_NO_HOSTS);
@@ -42,7 +42,8 @@ void CreateSnapshotProcessor::process(const cpp2::CreateSnapshotReq& req) {
     }
 
     // step 2 : Blocking all writes action for storage engines.
-    auto signRet = Snapshot::instance(kvstore_)->blockingWrites(SignType::BLOCK_ON);
+    auto signRet = Snapshot::instance(kvstore_, activeHostsMan_)
+                       ->blockingWrites(SignType::BLOCK_ON);
     if (signRet != cpp2::ErrorCode::SUCCEEDED) {
         LOG(ERROR) << "Send blocking sign to storage engine error";
         resp_.set_code(signRet);
@@ -52,7 +53,7 @@ void CreateSnapshotProcessor::process(const cpp2::CreateSnapshotReq& req) {
     }
 
     // step 3 : Create checkpoint for all storage engines and meta engine.
-    auto csRet = Snapshot::instance(kvstore_)->createSnapshot(snapshot);
+    auto csRet = Snapshot::instance(kvstore_, activeHostsMan_)->createSnapshot(snapshot);
     if (csRet != cpp2::ErrorCode::SUCCEEDED) {
         LOG(ERROR) << "Checkpoint create error on storage engine";
         resp_.set_code(csRet);
@@ -102,7 +103,8 @@ std::string CreateSnapshotProcessor::genSnapshotName() {
 }
 
 cpp2::ErrorCode CreateSnapshotProcessor::cancelWriteBlocking() {
-    auto signRet = Snapshot::instance(kvstore_)->blockingWrites(SignType::BLOCK_OFF);
+    auto signRet = Snapshot::instance(kvstore_, activeHostsMan_)
+                       ->blockingWrites(SignType::BLOCK_OFF);
     if (signRet != cpp2::ErrorCode::SUCCEEDED) {
         LOG(ERROR) << "Cancel write blocking error";
         return signRet;
@@ -9,24 +9,29 @@
 
 #include <gtest/gtest_prod.h>
 #include "meta/processors/BaseProcessor.h"
+#include "meta/ActiveHostsMan.h"
 
 namespace nebula {
 namespace meta {
 
 class CreateSnapshotProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateSnapshotProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateSnapshotProcessor(kvstore);
+    static CreateSnapshotProcessor* instance(kvstore::KVStore* kvstore,
+                                             ActiveHostsMan* activeHostsMan) {
+        return new CreateSnapshotProcessor(kvstore, activeHostsMan);
     }
     void process(const cpp2::CreateSnapshotReq& req);
 
     cpp2::ErrorCode cancelWriteBlocking();
 
 private:
-    explicit CreateSnapshotProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateSnapshotProcessor(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , activeHostsMan_(activeHostsMan) {}
 
     std::string genSnapshotName();
+
+    ActiveHostsMan* activeHostsMan_;
 };
 }  // namespace meta
 }  // namespace nebula
@@ -39,7 +39,8 @@ void DropSnapshotProcessor::process(const cpp2::DropSnapshotReq& req) {
     }
 
     std::vector<kvstore::KV> data;
-    auto dsRet = Snapshot::instance(kvstore_)->dropSnapshot(snapshot, std::move(peers.value()));
+    auto dsRet = Snapshot::instance(kvstore_, activeHostsMan_)
+                     ->dropSnapshot(snapshot, std::move(peers.value()));
     if (dsRet != cpp2::ErrorCode::SUCCEEDED) {
         LOG(ERROR) << "Drop snapshot error on storage engine";
         // Need update the snapshot status to invalid, maybe some storage engine drop done.
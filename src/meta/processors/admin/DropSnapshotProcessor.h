@@ -9,20 +9,25 @@
 
 #include <gtest/gtest_prod.h>
 #include "meta/processors/BaseProcessor.h"
+#include "meta/ActiveHostsMan.h"
 
 namespace nebula {
 namespace meta {
 
 class DropSnapshotProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static DropSnapshotProcessor* instance(kvstore::KVStore* kvstore) {
-        return new DropSnapshotProcessor(kvstore);
+    static DropSnapshotProcessor* instance(kvstore::KVStore* kvstore,
+                                           ActiveHostsMan* activeHostsMan) {
+        return new DropSnapshotProcessor(kvstore, activeHostsMan);
     }
     void process(const cpp2::DropSnapshotReq& req);
 
 private:
-    explicit DropSnapshotProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    DropSnapshotProcessor(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , activeHostsMan_(activeHostsMan) {}
+
+    ActiveHostsMan* activeHostsMan_;
 };
 }  // namespace meta
 }  // namespace nebula
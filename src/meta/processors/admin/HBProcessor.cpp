@@ -40,7 +40,7 @@ void HBProcessor::process(const cpp2::HBReq& req) {
 
     LOG(INFO) << "Receive heartbeat from " << host;
     HostInfo info(time::WallClock::fastNowInMilliSec());
-    auto ret = ActiveHostsMan::updateHostInfo(kvstore_, host, info);
+    auto ret = activeHostsMan_->reportHostInfo(host, info, req.get_leader_infos());
     resp_.set_code(to(ret));
     if (ret == kvstore::ResultCode::ERR_LEADER_CHANGED) {
         auto leaderRet = kvstore_->partLeader(kDefaultSpaceId, kDefaultPartId);
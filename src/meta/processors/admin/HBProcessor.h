@@ -9,6 +9,7 @@
 
 #include <gtest/gtest_prod.h>
 #include "meta/processors/BaseProcessor.h"
+#include "meta/ActiveHostsMan.h"
 
 
 namespace nebula {
@@ -19,18 +20,21 @@ class HBProcessor : public BaseProcessor<cpp2::HBResp> {
     FRIEND_TEST(MetaClientTest, HeartbeatTest);
 
 public:
-    static HBProcessor* instance(kvstore::KVStore* kvstore, ClusterID clusterId = 0,
-                                 stats::Stats* stats = nullptr) {
-        return new HBProcessor(kvstore, clusterId, stats);
+    static HBProcessor* instance(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan,
+                                 ClusterID clusterId = 0, stats::Stats* stats = nullptr) {
+        return new HBProcessor(kvstore, activeHostsMan, clusterId, stats);
     }
 
     void process(const cpp2::HBReq& req);
 
 private:
-    explicit HBProcessor(kvstore::KVStore* kvstore, ClusterID clusterId = 0,
-                         stats::Stats* stats = nullptr)
-            : BaseProcessor<cpp2::HBResp>(kvstore, stats), clusterId_(clusterId) {}
+    HBProcessor(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan,
+                ClusterID clusterId = 0, stats::Stats* stats = nullptr)
+            : BaseProcessor<cpp2::HBResp>(kvstore, stats)
+            , activeHostsMan_(activeHostsMan)
+            , clusterId_(clusterId) {}
 
+    ActiveHostsMan* activeHostsMan_;
     ClusterID clusterId_{0};
 };
 
@@ -13,7 +13,7 @@ namespace meta {
 
 void LeaderBalanceProcessor::process(const cpp2::LeaderBalanceReq& req) {
     UNUSED(req);
-    auto ret = Balancer::instance(kvstore_)->leaderBalance();
+    auto ret = Balancer::instance(kvstore_, activeHostsMan_)->leaderBalance();
     resp_.set_code(ret);
     onFinished();
 }
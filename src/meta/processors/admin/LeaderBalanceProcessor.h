@@ -9,21 +9,26 @@
 
 #include <gtest/gtest_prod.h>
 #include "meta/processors/BaseProcessor.h"
+#include "meta/ActiveHostsMan.h"
 
 namespace nebula {
 namespace meta {
 
 class LeaderBalanceProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static LeaderBalanceProcessor* instance(kvstore::KVStore* kvstore) {
-        return new LeaderBalanceProcessor(kvstore);
+    static LeaderBalanceProcessor* instance(kvstore::KVStore* kvstore,
+                                            ActiveHostsMan* activeHostsMan) {
+        return new LeaderBalanceProcessor(kvstore, activeHostsMan);
     }
 
     void process(const cpp2::LeaderBalanceReq& req);
 
 private:
-    explicit LeaderBalanceProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    LeaderBalanceProcessor(kvstore::KVStore* kvstore, ActiveHostsMan* activeHostsMan)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , activeHostsMan_(activeHostsMan) {}
+
+    ActiveHostsMan* activeHostsMan_;
 };
 
 }  // namespace meta
@@ -33,7 +33,7 @@ cpp2::ErrorCode Snapshot::createSnapshot(const std::string& name) {
 cpp2::ErrorCode Snapshot::dropSnapshot(const std::string& name,
                                        const std::vector<HostAddr> hosts) {
     // The drop checkpoint will be skip if original host has been lost.
-    auto activeHosts = ActiveHostsMan::getActiveHosts(kv_);
+    auto activeHosts = activeHostsMan_->getActiveHosts();
     std::vector<HostAddr> realHosts;
     for (auto& host : hosts) {
         if (std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end()) {
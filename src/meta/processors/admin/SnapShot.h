@@ -19,9 +19,10 @@ namespace meta {
 
 class Snapshot {
 public:
-    static Snapshot* instance(kvstore::KVStore* kv) {
-        static std::unique_ptr<AdminClient> client(new AdminClient(kv));
-        static std::unique_ptr<Snapshot> snapshot(new Snapshot(kv, std::move(client)));
+    static Snapshot* instance(kvstore::KVStore* kv, ActiveHostsMan* activeHostsMan) {
+        static std::unique_ptr<AdminClient> client(new AdminClient(kv, activeHostsMan));
+        static std::unique_ptr<Snapshot> snapshot(
+            new Snapshot(kv, activeHostsMan, std::move(client)));
         return snapshot.get();
     }
 
@@ -37,8 +38,11 @@ public:
     getLeaderParts(HostLeaderMap *hostLeaderMap, GraphSpaceID spaceId);
 
 private:
-    Snapshot(kvstore::KVStore* kv, std::unique_ptr<AdminClient> client)
+    Snapshot(kvstore::KVStore* kv,
+             ActiveHostsMan* activeHostsMan,
+             std::unique_ptr<AdminClient> client)
             : kv_(kv)
+            , activeHostsMan_(activeHostsMan)
             , client_(std::move(client)) {
         executor_.reset(new folly::CPUThreadPoolExecutor(1));
     }
@@ -47,6 +51,7 @@ private:
 
 private:
     kvstore::KVStore* kv_ = nullptr;
+    ActiveHostsMan* activeHostsMan_ = nullptr;
     std::unique_ptr<AdminClient> client_{nullptr};
     std::unique_ptr<folly::Executor> executor_;
 };
@@ -21,7 +21,7 @@ void CreateEdgeIndexProcessor::process(const cpp2::CreateEdgeIndexReq& req) {
         return;
     }
 
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeIndexLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeIndexLock(space));
     auto ret = getEdgeIndexID(space, indexName);
     if (ret.ok()) {
         LOG(ERROR) << "Create Edge Index Failed: " << indexName << " have existed";
@@ -75,7 +75,7 @@ void CreateEdgeIndexProcessor::process(const cpp2::CreateEdgeIndexReq& req) {
     indexFields.set_fields(std::move(edgeColumns));
 
     std::vector<kvstore::KV> data;
-    auto edgeIndexRet = autoIncrementId();
+    auto edgeIndexRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(edgeIndexRet)) {
         LOG(ERROR) << "Create edge index failed: Get edge index ID failed";
         resp_.set_code(nebula::error(edgeIndexRet));
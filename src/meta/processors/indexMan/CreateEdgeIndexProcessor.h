@@ -14,15 +14,18 @@ namespace meta {
 
 class CreateEdgeIndexProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateEdgeIndexProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateEdgeIndexProcessor(kvstore);
+    static CreateEdgeIndexProcessor* instance(kvstore::KVStore* kvstore, IdAllocator* idAllocator) {
+        return new CreateEdgeIndexProcessor(kvstore, idAllocator);
     }
 
     void process(const cpp2::CreateEdgeIndexReq& req);
 
 private:
-    explicit CreateEdgeIndexProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateEdgeIndexProcessor(kvstore::KVStore* kvstore, IdAllocator* idAllocator)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator) {}
+
+    IdAllocator* idAllocator_;
 };
 
 }  // namespace meta
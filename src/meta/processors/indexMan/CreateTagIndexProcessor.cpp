@@ -21,7 +21,7 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
         return;
     }
 
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagIndexLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagIndexLock(space));
     auto ret = getTagIndexID(space, indexName);
     if (ret.ok()) {
         LOG(ERROR) << "Create Tag Index Failed: " << indexName << " have existed";
@@ -76,7 +76,7 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
     indexFields.set_fields(std::move(tagColumns));
 
     std::vector<kvstore::KV> data;
-    auto tagIndexRet = autoIncrementId();
+    auto tagIndexRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(tagIndexRet)) {
         LOG(ERROR) << "Create tag index failed : Get tag index ID failed";
         resp_.set_code(nebula::error(tagIndexRet));
@@ -14,15 +14,18 @@ namespace meta {
 
 class CreateTagIndexProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateTagIndexProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateTagIndexProcessor(kvstore);
+    static CreateTagIndexProcessor* instance(kvstore::KVStore* kvstore, IdAllocator* idAllocator) {
+        return new CreateTagIndexProcessor(kvstore, idAllocator);
     }
 
     void process(const cpp2::CreateTagIndexReq& req);
 
 private:
-    explicit CreateTagIndexProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateTagIndexProcessor(kvstore::KVStore* kvstore, IdAllocator* idAllocator)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator) {}
+
+    IdAllocator* idAllocator_;
 };
 
 }  // namespace meta
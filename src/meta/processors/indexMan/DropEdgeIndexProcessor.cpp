@@ -13,7 +13,7 @@ void DropEdgeIndexProcessor::process(const cpp2::DropEdgeIndexReq& req) {
     auto spaceID = req.get_space_id();
     auto indexName = req.get_index_name();
     CHECK_SPACE_ID_AND_RETURN(spaceID);
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeIndexLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeIndexLock(spaceID));
 
     auto edgeIndexID = getEdgeIndexID(spaceID, indexName);
     if (!edgeIndexID.ok()) {
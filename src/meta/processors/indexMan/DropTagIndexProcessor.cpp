@@ -13,7 +13,7 @@ void DropTagIndexProcessor::process(const cpp2::DropTagIndexReq& req) {
     auto spaceID = req.get_space_id();
     auto indexName = req.get_index_name();
     CHECK_SPACE_ID_AND_RETURN(spaceID);
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagIndexLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagIndexLock(spaceID));
 
     auto tagIndexID = getTagIndexID(spaceID, indexName);
     if (!tagIndexID.ok()) {
@@ -11,7 +11,7 @@ namespace meta {
 
 void ListEdgeIndexesProcessor::process(const cpp2::ListEdgeIndexesReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeIndexLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeIndexLock(req.get_space_id()));
     auto spaceId = req.get_space_id();
     auto prefix = MetaServiceUtils::edgeIndexPrefix(spaceId);
 
@@ -12,7 +12,7 @@ namespace meta {
 void ListTagIndexesProcessor::process(const cpp2::ListTagIndexesReq& req) {
     auto space = req.get_space_id();
     CHECK_SPACE_ID_AND_RETURN(space);
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagIndexLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagIndexLock(space));
     auto prefix = MetaServiceUtils::tagIndexPrefix(space);
 
     std::unique_ptr<kvstore::KVIterator> iter;
@@ -6,6 +6,7 @@
 
 #include "meta/processors/partsMan/CreateSpaceProcessor.h"
 #include "meta/ActiveHostsMan.h"
+#include "base/Partitioner.h"
 
 DEFINE_int32(default_parts_num, 100, "The default number of parts when a space is created");
 DEFINE_int32(default_replica_factor, 1, "The default replica factor when a space is created");
@@ -33,7 +34,7 @@ void CreateSpaceProcessor::process(const cpp2::CreateSpaceReq& req) {
         return;
     }
     CHECK_EQ(Status::SpaceNotFound(), spaceRet.status());
-    auto hosts = ActiveHostsMan::getActiveHosts(kvstore_);
+    auto hosts = activeHostsMan_->getActiveHosts();
     if (hosts.empty()) {
         LOG(ERROR) << "Create Space Failed : No Hosts!";
         resp_.set_code(cpp2::ErrorCode::E_NO_HOSTS);
@@ -41,7 +42,7 @@ void CreateSpaceProcessor::process(const cpp2::CreateSpaceReq& req) {
         return;
     }
 
-    auto idRet = autoIncrementId();
+    auto idRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(idRet)) {
         LOG(ERROR) << "Create Space Failed : Get space id failed";
         resp_.set_code(nebula::error(idRet));
@@ -62,6 +63,17 @@ void CreateSpaceProcessor::process(const cpp2::CreateSpaceReq& req) {
         // Set the default value back to the struct, which will be written to storage
         properties.set_replica_factor(replicaFactor);
     }
+    if (properties.get_partition_strategy() == cpp2::PartitionStrategy::RANGE) {
+        auto partitioner = Partitioner::range(partitionNum, properties.get_range_bounds());
+        if (!partitioner.ok()) {
+            LOG(ERROR) << "Create Space Failed : " << partitioner.status();
+            resp_.set_code(cpp2::ErrorCode::E_INVALID_PARM);
+            onFinished();
+            return;
+        }
+        // Keep the bounds in storage, in case they are split evenly
+        properties.set_range_bounds(partitioner.value()->bounds());
+    }
     VLOG(3) << "Create space " << spaceName << ", id " << spaceId;
     if ((int32_t)hosts.size() < replicaFactor) {
         LOG(ERROR) << "Not enough hosts existed for replica "
@@ -81,6 +93,7 @@ void CreateSpaceProcessor::process(const cpp2::CreateSpaceReq& req) {
         data.emplace_back(MetaServiceUtils::partKey(spaceId, partId),
                           MetaServiceUtils::partVal(partHosts));
     }
+    bumpVersions(spaceId, data);
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     resp_.set_id(to(spaceId, EntryType::SPACE));
     doPut(std::move(data));
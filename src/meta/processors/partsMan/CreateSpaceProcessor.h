@@ -8,14 +8,17 @@
 #define META_CREATESPACEPROCESSOR_H_
 
 #include "meta/processors/BaseProcessor.h"
+#include "meta/ActiveHostsMan.h"
 
 namespace nebula {
 namespace meta {
 
 class CreateSpaceProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateSpaceProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateSpaceProcessor(kvstore);
+    static CreateSpaceProcessor* instance(kvstore::KVStore* kvstore,
+                                          IdAllocator* idAllocator,
+                                          ActiveHostsMan* activeHostsMan) {
+        return new CreateSpaceProcessor(kvstore, idAllocator, activeHostsMan);
     }
 
     void process(const cpp2::CreateSpaceReq& req);
@@ -27,8 +30,15 @@ protected:
                                             int32_t replicaFactor);
 
 private:
-    explicit CreateSpaceProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateSpaceProcessor(kvstore::KVStore* kvstore,
+                         IdAllocator* idAllocator,
+                         ActiveHostsMan* activeHostsMan)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator)
+            , activeHostsMan_(activeHostsMan) {}
+
+    IdAllocator* idAllocator_;
+    ActiveHostsMan* activeHostsMan_;
 };
 
 }  // namespace meta
@@ -40,11 +40,14 @@ void DropSpaceProcessor::process(const cpp2::DropSpaceReq& req) {
 
     deleteKeys.emplace_back(MetaServiceUtils::indexSpaceKey(req.get_space_name()));
     deleteKeys.emplace_back(MetaServiceUtils::spaceKey(spaceId));
+    deleteKeys.emplace_back(MetaServiceUtils::spaceVersionKey(spaceId));
 
     // delete related role data.
     // TODO(boshengchen) delete related role data under the space
     // TODO(YT) delete Tag/Edge under the space
-    doMultiRemove(std::move(deleteKeys));
+    std::vector<kvstore::KV> data;
+    data.emplace_back(catalogVersionKV());
+    doMultiRemoveAndPut(std::move(deleteKeys), std::move(data));
     // TODO(YT) delete part files of the space
 }
 
@@ -0,0 +1,37 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "meta/processors/partsMan/GetCatalogVersionProcessor.h"
+
+namespace nebula {
+namespace meta {
+
+void GetCatalogVersionProcessor::process(const cpp2::GetCatalogVersionReq& req) {
+    UNUSED(req);
+    std::string val;
+    auto ret = kvstore_->get(kDefaultSpaceId,
+                             kDefaultPartId,
+                             MetaServiceUtils::catalogVersionKey(),
+                             &val);
+    if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+        // No DDL since upgrading, the clients should reload everything
+        resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
+        resp_.set_version(0);
+        onFinished();
+        return;
+    }
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        resp_.set_code(to(ret));
+        onFinished();
+        return;
+    }
+    resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
+    resp_.set_version(MetaServiceUtils::parseSpaceVersion(val));
+    onFinished();
+}
+
+}  // namespace meta
+}  // namespace nebula
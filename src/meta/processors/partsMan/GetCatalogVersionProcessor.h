@@ -0,0 +1,31 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef META_GETCATALOGVERSIONPROCESSOR_H_
+#define META_GETCATALOGVERSIONPROCESSOR_H_
+
+#include "meta/processors/BaseProcessor.h"
+
+namespace nebula {
+namespace meta {
+
+class GetCatalogVersionProcessor : public BaseProcessor<cpp2::GetCatalogVersionResp> {
+public:
+    static GetCatalogVersionProcessor* instance(kvstore::KVStore* kvstore) {
+        return new GetCatalogVersionProcessor(kvstore);
+    }
+
+    void process(const cpp2::GetCatalogVersionReq& req);
+
+private:
+    explicit GetCatalogVersionProcessor(kvstore::KVStore* kvstore)
+            : BaseProcessor<cpp2::GetCatalogVersionResp>(kvstore) {}
+};
+
+}  // namespace meta
+}  // namespace nebula
+
+#endif  // META_GETCATALOGVERSIONPROCESSOR_H_
@@ -145,14 +145,16 @@ StatusOr<std::vector<cpp2::HostItem>> ListHostsProcessor::allHostsWithStatus(
 void ListHostsProcessor::getLeaderDist(
                                 std::vector<cpp2::HostItem>& hostItems,
                                 std::unordered_map<GraphSpaceID, std::string>& spaceIdNameMap) {
-    if (adminClient_ == nullptr) {
-        return;
-    }
-    HostLeaderMap hostLeaderMap;
-    auto ret = adminClient_->getLeaderDist(&hostLeaderMap).get();
-    if (!ret.ok()) {
-        LOG(ERROR) << "Get leader distribution failed";
-        return;
+    auto hostLeaderMap = activeHostsMan_->getLeaderDist();
+    if (hostLeaderMap.empty()) {
+        if (adminClient_ == nullptr) {
+            return;
+        }
+        auto ret = adminClient_->getLeaderDist(&hostLeaderMap).get();
+        if (!ret.ok()) {
+            LOG(ERROR) << "Get leader distribution failed";
+            return;
+        }
     }
     for (auto& hostEntry : hostLeaderMap) {
         auto hostAddr = toThriftHost(hostEntry.first);
@@ -16,15 +16,19 @@ namespace meta {
 class ListHostsProcessor : public BaseProcessor<cpp2::ListHostsResp> {
 public:
     static ListHostsProcessor* instance(kvstore::KVStore* kvstore,
+                                        ActiveHostsMan* activeHostsMan,
                                         AdminClient* adminClient = nullptr) {
-        return new ListHostsProcessor(kvstore, adminClient);
+        return new ListHostsProcessor(kvstore, activeHostsMan, adminClient);
     }
 
     void process(const cpp2::ListHostsReq& req);
 
 private:
-    explicit ListHostsProcessor(kvstore::KVStore* kvstore, AdminClient* adminClient)
+    ListHostsProcessor(kvstore::KVStore* kvstore,
+                       ActiveHostsMan* activeHostsMan,
+                       AdminClient* adminClient)
             : BaseProcessor<cpp2::ListHostsResp>(kvstore)
+            , activeHostsMan_(activeHostsMan)
             , adminClient_(adminClient) {}
 
     /**
@@ -39,6 +43,7 @@ private:
     void getLeaderDist(std::vector<cpp2::HostItem>& hostItems,
                        std::unordered_map<GraphSpaceID, std::string>& spaceIdNameMap);
 
+    ActiveHostsMan* activeHostsMan_;
     AdminClient* adminClient_;
 };
 
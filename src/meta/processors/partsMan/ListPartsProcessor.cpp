@@ -30,7 +30,7 @@ void ListPartsProcessor::process(const cpp2::ListPartsReq& req) {
         partItem.set_peers(std::move(partEntry.second));
         std::vector<nebula::cpp2::HostAddr> losts;
         for (auto& host : partItem.get_peers()) {
-            if (!ActiveHostsMan::isLived(this->kvstore_, HostAddr(host.ip, host.port))) {
+            if (!activeHostsMan_->isLived(HostAddr(host.ip, host.port))) {
                 losts.emplace_back();
                 losts.back().set_ip(host.ip);
                 losts.back().set_port(host.port);
@@ -16,15 +16,19 @@ namespace meta {
 class ListPartsProcessor : public BaseProcessor<cpp2::ListPartsResp> {
 public:
     static ListPartsProcessor* instance(kvstore::KVStore* kvstore,
+                                        ActiveHostsMan* activeHostsMan,
                                         AdminClient* adminClient = nullptr) {
-        return new ListPartsProcessor(kvstore, adminClient);
+        return new ListPartsProcessor(kvstore, activeHostsMan, adminClient);
     }
 
     void process(const cpp2::ListPartsReq& req);
 
 private:
-    explicit ListPartsProcessor(kvstore::KVStore* kvstore, AdminClient* adminClient)
+    ListPartsProcessor(kvstore::KVStore* kvstore,
+                       ActiveHostsMan* activeHostsMan,
+                       AdminClient* adminClient)
             : BaseProcessor<cpp2::ListPartsResp>(kvstore)
+            , activeHostsMan_(activeHostsMan)
             , adminClient_(adminClient) {}
 
 
@@ -35,6 +39,7 @@ private:
     void getLeaderDist(std::vector<cpp2::PartItem>& partItems);
 
 private:
+    ActiveHostsMan*                                     activeHostsMan_;
     AdminClient*                                        adminClient_;
     GraphSpaceID                                        spaceId_;
 };
@@ -30,7 +30,24 @@ void ListSpacesProcessor::process(const cpp2::ListSpacesReq& req) {
                             spaceName);
         iter->next();
     }
+
+    std::unordered_map<GraphSpaceID, int64_t> versions;
+    ret = kvstore_->prefix(kDefaultSpaceId,
+                           kDefaultPartId,
+                           MetaServiceUtils::spaceVersionPrefix(),
+                           &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        resp_.set_code(to(ret));
+        onFinished();
+        return;
+    }
+    while (iter->valid()) {
+        versions.emplace(MetaServiceUtils::parseSpaceVersionKey(iter->key()),
+                         MetaServiceUtils::parseSpaceVersion(iter->val()));
+        iter->next();
+    }
     resp_.set_spaces(std::move(spaces));
+    resp_.set_versions(std::move(versions));
     onFinished();
 }
 
@@ -11,7 +11,7 @@ namespace meta {
 
 void AlterEdgeProcessor::process(const cpp2::AlterEdgeReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock(req.get_space_id()));
     auto ret = getEdgeType(req.get_space_id(), req.get_edge_name());
     if (!ret.ok()) {
         resp_.set_code(to(ret.status()));
@@ -72,6 +72,7 @@ void AlterEdgeProcessor::process(const cpp2::AlterEdgeReq& req) {
     LOG(INFO) << "Alter edge " << req.get_edge_name() << ", edgeType " << edgeType;
     data.emplace_back(MetaServiceUtils::schemaEdgeKey(req.get_space_id(), edgeType, version),
                       MetaServiceUtils::schemaEdgeVal(req.get_edge_name(), schema));
+    bumpVersions(req.get_space_id(), data);
     resp_.set_id(to(edgeType, EntryType::EDGE));
     doPut(std::move(data));
 }
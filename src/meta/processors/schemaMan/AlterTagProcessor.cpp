@@ -11,7 +11,7 @@ namespace meta {
 
 void AlterTagProcessor::process(const cpp2::AlterTagReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock(req.get_space_id()));
     auto ret = getTagId(req.get_space_id(), req.get_tag_name());
     if (!ret.ok()) {
         resp_.set_code(to(ret.status()));
@@ -72,6 +72,7 @@ void AlterTagProcessor::process(const cpp2::AlterTagReq& req) {
     LOG(INFO) << "Alter Tag " << req.get_tag_name() << ", tagId " << tagId;
     data.emplace_back(MetaServiceUtils::schemaTagKey(req.get_space_id(), tagId, version),
                       MetaServiceUtils::schemaTagVal(req.get_tag_name(), schema));
+    bumpVersions(req.get_space_id(), data);
     resp_.set_id(to(tagId, EntryType::TAG));
     doPut(std::move(data));
 }
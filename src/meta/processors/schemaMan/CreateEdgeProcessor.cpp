@@ -15,7 +15,7 @@ void CreateEdgeProcessor::process(const cpp2::CreateEdgeReq& req) {
     {
         // if there is an edge of the same name
         // TODO: there exists race condition, we should address it in the future
-        folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock());
+        folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock(req.get_space_id()));
         auto conflictRet = getTagId(req.get_space_id(), edgeName);
         if (conflictRet.ok()) {
             LOG(ERROR) << "Failed to create edge `" << edgeName
@@ -27,7 +27,7 @@ void CreateEdgeProcessor::process(const cpp2::CreateEdgeReq& req) {
         }
     }
 
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock(req.get_space_id()));
     auto ret = getEdgeType(req.get_space_id(), edgeName);
     if (ret.ok()) {
         cpp2::ErrorCode ec;
@@ -42,7 +42,7 @@ void CreateEdgeProcessor::process(const cpp2::CreateEdgeReq& req) {
         return;
     }
 
-    auto edgeTypeRet = autoIncrementId();
+    auto edgeTypeRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(edgeTypeRet)) {
         LOG(ERROR) << "Create edge failed : Get edge type id failed";
         resp_.set_code(nebula::error(edgeTypeRet));
@@ -119,6 +119,7 @@ void CreateEdgeProcessor::process(const cpp2::CreateEdgeReq& req) {
     LOG(INFO) << "Create Edge " << edgeName << ", edgeType " << edgeType;
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     resp_.set_id(to(edgeType, EntryType::EDGE));
+    bumpVersions(req.get_space_id(), data);
     doPut(std::move(data));
 }
 
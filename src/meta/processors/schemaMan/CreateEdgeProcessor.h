@@ -14,15 +14,18 @@ namespace meta {
 
 class CreateEdgeProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateEdgeProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateEdgeProcessor(kvstore);
+    static CreateEdgeProcessor* instance(kvstore::KVStore* kvstore, IdAllocator* idAllocator) {
+        return new CreateEdgeProcessor(kvstore, idAllocator);
     }
 
     void process(const cpp2::CreateEdgeReq& req);
 
 private:
-    explicit CreateEdgeProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateEdgeProcessor(kvstore::KVStore* kvstore, IdAllocator* idAllocator)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator) {}
+
+    IdAllocator* idAllocator_;
 };
 
 }  // namespace meta
@@ -15,7 +15,7 @@ void CreateTagProcessor::process(const cpp2::CreateTagReq& req) {
     {
         // if there is an edge of the same name
         // TODO: there exists race condition, we should address it in the future
-        folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock());
+        folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock(req.get_space_id()));
         auto conflictRet = getEdgeType(req.get_space_id(), tagName);
         if (conflictRet.ok()) {
             LOG(ERROR) << "Failed to create tag `" << tagName
@@ -27,7 +27,7 @@ void CreateTagProcessor::process(const cpp2::CreateTagReq& req) {
         }
     }
 
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock(req.get_space_id()));
     auto ret = getTagId(req.get_space_id(), tagName);
     if (ret.ok()) {
         cpp2::ErrorCode ec;
@@ -43,7 +43,7 @@ void CreateTagProcessor::process(const cpp2::CreateTagReq& req) {
         return;
     }
 
-    auto tagRet = autoIncrementId();
+    auto tagRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(tagRet)) {
         LOG(ERROR) << "Create tag failed : Get tag id failed";
         resp_.set_code(nebula::error(tagRet));
@@ -122,6 +122,7 @@ void CreateTagProcessor::process(const cpp2::CreateTagReq& req) {
     LOG(INFO) << "Create Tag " << tagName << ", TagID " << tagId;
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     resp_.set_id(to(tagId, EntryType::TAG));
+    bumpVersions(req.get_space_id(), data);
     doPut(std::move(data));
 }
 
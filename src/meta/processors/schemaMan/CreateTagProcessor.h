@@ -19,15 +19,18 @@ public:
      *  The user should get instance when needed and don't care about the instance deleted.
      *  The instance should be destroyed inside when onFinished method invoked
      */
-    static CreateTagProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateTagProcessor(kvstore);
+    static CreateTagProcessor* instance(kvstore::KVStore* kvstore, IdAllocator* idAllocator) {
+        return new CreateTagProcessor(kvstore, idAllocator);
     }
 
     void process(const cpp2::CreateTagReq& req);
 
 private:
-    explicit CreateTagProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateTagProcessor(kvstore::KVStore* kvstore, IdAllocator* idAllocator)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator) {}
+
+    IdAllocator* idAllocator_;
 };
 
 }  // namespace meta
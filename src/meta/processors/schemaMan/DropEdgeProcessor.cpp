@@ -11,7 +11,7 @@ namespace meta {
 
 void DropEdgeProcessor::process(const cpp2::DropEdgeReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::edgeLock(req.get_space_id()));
     auto ret = getEdgeKeys(req.get_space_id(), req.get_edge_name());
     if (!ret.ok()) {
         resp_.set_code(cpp2::ErrorCode::E_NOT_FOUND);
@@ -20,7 +20,9 @@ void DropEdgeProcessor::process(const cpp2::DropEdgeReq& req) {
     }
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     LOG(INFO) << "Drop Edge " << req.get_edge_name();
-    doMultiRemove(std::move(ret.value()));
+    std::vector<kvstore::KV> data;
+    bumpVersions(req.get_space_id(), data);
+    doMultiRemoveAndPut(std::move(ret.value()), std::move(data));
 }
 
 StatusOr<std::vector<std::string>> DropEdgeProcessor::getEdgeKeys(GraphSpaceID id,
@@ -11,7 +11,7 @@ namespace meta {
 
 void DropTagProcessor::process(const cpp2::DropTagReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock());
+    folly::SharedMutex::WriteHolder wHolder(LockUtils::tagLock(req.get_space_id()));
     auto ret = getTagKeys(req.get_space_id(), req.get_tag_name());
     if (!ret.ok()) {
         LOG(ERROR) << "Drop Tag Failed : " << req.get_tag_name() << " not found";
@@ -21,7 +21,9 @@ void DropTagProcessor::process(const cpp2::DropTagReq& req) {
     }
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     LOG(INFO) << "Drop Tag " << req.get_tag_name();
-    doMultiRemove(std::move(ret.value()));
+    std::vector<kvstore::KV> data;
+    bumpVersions(req.get_space_id(), data);
+    doMultiRemoveAndPut(std::move(ret.value()), std::move(data));
 }
 
 StatusOr<std::vector<std::string>> DropTagProcessor::getTagKeys(GraphSpaceID id,
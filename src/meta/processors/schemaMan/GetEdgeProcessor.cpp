@@ -11,7 +11,7 @@ namespace meta {
 
 void GetEdgeProcessor::process(const cpp2::GetEdgeReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock(req.get_space_id()));
     auto edgeTypeRet = getEdgeType(req.get_space_id(), req.get_edge_name());
     if (!edgeTypeRet.ok()) {
         resp_.set_code(to(edgeTypeRet.status()));
@@ -11,7 +11,7 @@ namespace meta {
 
 void GetTagProcessor::process(const cpp2::GetTagReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagLock(req.get_space_id()));
     auto tagIdRet = getTagId(req.get_space_id(), req.get_tag_name());
     if (!tagIdRet.ok()) {
         resp_.set_code(to(tagIdRet.status()));
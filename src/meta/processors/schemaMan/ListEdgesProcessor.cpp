@@ -11,7 +11,7 @@ namespace meta {
 
 void ListEdgesProcessor::process(const cpp2::ListEdgesReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::edgeLock(req.get_space_id()));
     auto spaceId = req.get_space_id();
     auto prefix = MetaServiceUtils::schemaEdgesPrefix(spaceId);
     std::unique_ptr<kvstore::KVIterator> iter;
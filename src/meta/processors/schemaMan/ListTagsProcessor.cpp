@@ -11,7 +11,7 @@ namespace meta {
 
 void ListTagsProcessor::process(const cpp2::ListTagsReq& req) {
     CHECK_SPACE_ID_AND_RETURN(req.get_space_id());
-    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagLock());
+    folly::SharedMutex::ReadHolder rHolder(LockUtils::tagLock(req.get_space_id()));
     auto spaceId = req.get_space_id();
     auto prefix = MetaServiceUtils::schemaTagsPrefix(spaceId);
     std::unique_ptr<kvstore::KVIterator> iter;
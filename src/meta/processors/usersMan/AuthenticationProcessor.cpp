@@ -25,7 +25,7 @@ void CreateUserProcessor::process(const cpp2::CreateUserReq& req) {
         return;
     }
 
-    auto userRet = autoIncrementId();
+    auto userRet = autoIncrementId(idAllocator_);
     if (!nebula::ok(userRet)) {
         LOG(ERROR) << "Create User Failed : Get user id failed";
         resp_.set_code(nebula::error(userRet));
@@ -14,15 +14,18 @@ namespace meta {
 
 class CreateUserProcessor : public BaseProcessor<cpp2::ExecResp> {
 public:
-    static CreateUserProcessor* instance(kvstore::KVStore* kvstore) {
-        return new CreateUserProcessor(kvstore);
+    static CreateUserProcessor* instance(kvstore::KVStore* kvstore, IdAllocator* idAllocator) {
+        return new CreateUserProcessor(kvstore, idAllocator);
     }
 
     void process(const cpp2::CreateUserReq& req);
 
 private:
-    explicit CreateUserProcessor(kvstore::KVStore* kvstore)
-            : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+    CreateUserProcessor(kvstore::KVStore* kvstore, IdAllocator* idAllocator)
+            : BaseProcessor<cpp2::ExecResp>(kvstore)
+            , idAllocator_(idAllocator) {}
+
+    IdAllocator* idAllocator_;
 };
 
 
@@ -19,14 +19,15 @@ TEST(ActiveHostsManTest, NormalTest) {
     fs::TempDir rootPath("/tmp/ActiveHostsManTest.XXXXXX");
     FLAGS_expired_threshold_sec = 2;
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     auto now = time::WallClock::fastNowInMilliSec();
-    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(0, 0), HostInfo(now));
-    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(0, 1), HostInfo(now));
-    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(0, 2), HostInfo(now));
-    ASSERT_EQ(3, ActiveHostsMan::getActiveHosts(kv.get()).size());
+    activeHostsMan.updateHostInfo(HostAddr(0, 0), HostInfo(now));
+    activeHostsMan.updateHostInfo(HostAddr(0, 1), HostInfo(now));
+    activeHostsMan.updateHostInfo(HostAddr(0, 2), HostInfo(now));
+    ASSERT_EQ(3, activeHostsMan.getActiveHosts().size());
 
-    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(0, 0), HostInfo(now + 2000));
-    ASSERT_EQ(3, ActiveHostsMan::getActiveHosts(kv.get()).size());
+    activeHostsMan.updateHostInfo(HostAddr(0, 0), HostInfo(now + 2000));
+    ASSERT_EQ(3, activeHostsMan.getActiveHosts().size());
     {
         const auto& prefix = MetaServiceUtils::hostPrefix();
         std::unique_ptr<kvstore::KVIterator> iter;
@@ -49,7 +50,7 @@ TEST(ActiveHostsManTest, NormalTest) {
     }
 
     sleep(3);
-    ASSERT_EQ(1, ActiveHostsMan::getActiveHosts(kv.get()).size());
+    ASSERT_EQ(1, activeHostsMan.getActiveHosts().size());
 }
 
 }  // namespace meta
@@ -119,7 +119,8 @@ TEST(AdminClientTest, SimpleTest) {
     network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
     fs::TempDir rootPath("/tmp/AdminTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
-    auto client = std::make_unique<AdminClient>(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
+    auto client = std::make_unique<AdminClient>(kv.get(), &activeHostsMan);
 
     {
         LOG(INFO) << "Test transLeader...";
@@ -199,7 +200,8 @@ TEST(AdminClientTest, RetryTest) {
     }
 
     LOG(INFO) << "Now test interfaces with retry to leader!";
-    auto client = std::make_unique<AdminClient>(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
+    auto client = std::make_unique<AdminClient>(kv.get(), &activeHostsMan);
     {
         LOG(INFO) << "Test transLeader, return ok if target is not leader";
         folly::Baton<true, std::atomic> baton;
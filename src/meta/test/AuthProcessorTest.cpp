@@ -236,6 +236,8 @@ TEST(AuthProcessorTest, PasswordTest) {
 TEST(AuthProcessorTest, GrantRevokeTest) {
     fs::TempDir rootPath("/tmp/GrantRevokeTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     auto ret = TestUtils::createUser(kv.get(), false, "user1", "pwd",
                                       false, 1, 2, 3, 4);
     ASSERT_TRUE(ret.ok());
@@ -280,7 +282,7 @@ TEST(AuthProcessorTest, GrantRevokeTest) {
         sp.set_partition_num(1);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(sp));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
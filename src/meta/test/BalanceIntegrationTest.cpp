@@ -19,6 +19,7 @@ DECLARE_int32(load_data_interval_secs);
 DECLARE_int32(heartbeat_interval_secs);
 DECLARE_uint32(raft_heartbeat_interval_secs);
 DECLARE_int32(expired_threshold_sec);
+DECLARE_int32(host_info_persist_interval_secs);
 
 namespace nebula {
 namespace meta {
@@ -28,6 +29,8 @@ TEST(BalanceIntegrationTest, BalanceTest) {
     FLAGS_heartbeat_interval_secs = 1;
     FLAGS_raft_heartbeat_interval_secs = 1;
     FLAGS_expired_threshold_sec = 3;
+    // The balancer below only sees the heartbeats persisted by the meta server
+    FLAGS_host_info_persist_interval_secs = 0;
     fs::TempDir rootPath("/tmp/balance_integration_test.XXXXXX");
     IPv4 localIp;
     network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
@@ -40,8 +43,10 @@ TEST(BalanceIntegrationTest, BalanceTest) {
                                                              kClusterId);
     localMetaPort = metaServerContext->port_;
 
-    auto adminClient = std::make_unique<AdminClient>(metaServerContext->kvStore_.get());
-    Balancer balancer(metaServerContext->kvStore_.get(), std::move(adminClient));
+    ActiveHostsMan activeHostsMan(metaServerContext->kvStore_.get());
+    auto adminClient = std::make_unique<AdminClient>(metaServerContext->kvStore_.get(),
+                                                     &activeHostsMan);
+    Balancer balancer(metaServerContext->kvStore_.get(), &activeHostsMan, std::move(adminClient));
 
     auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(10);
     std::vector<HostAddr> metaAddr = {HostAddr(localIp, localMetaPort)};
@@ -262,8 +267,10 @@ TEST(BalanceIntegrationTest, LeaderBalanceTest) {
                                                              kClusterId);
     localMetaPort = metaServerContext->port_;
 
-    auto adminClient = std::make_unique<AdminClient>(metaServerContext->kvStore_.get());
-    Balancer balancer(metaServerContext->kvStore_.get(), std::move(adminClient));
+    ActiveHostsMan activeHostsMan(metaServerContext->kvStore_.get());
+    auto adminClient = std::make_unique<AdminClient>(metaServerContext->kvStore_.get(),
+                                                     &activeHostsMan);
+    Balancer balancer(metaServerContext->kvStore_.get(), &activeHostsMan, std::move(adminClient));
 
     auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(10);
     std::vector<HostAddr> metaAddr = {HostAddr(localIp, localMetaPort)};
@@ -12,6 +12,7 @@
 #include "meta/processors/partsMan/CreateSpaceProcessor.h"
 
 DECLARE_uint32(task_concurrency);
+DECLARE_uint32(max_tasks_per_src_host);
 DECLARE_int32(expired_threshold_sec);
 DECLARE_double(leader_balance_deviation);
 
@@ -29,6 +30,49 @@ public:
     }
 };
 
+// Hold the tasks in catching up data until they are released
+class TestFaultInjectorWithHold : public TestFaultInjector {
+public:
+    explicit TestFaultInjectorWithHold(std::vector<Status> sts)
+        : TestFaultInjector(std::move(sts)) {}
+
+    folly::Future<Status> waitingForCatchUpData() override {
+        std::lock_guard<std::mutex> lg(lock_);
+        held_.emplace_back();
+        maxHeld_ = std::max(maxHeld_, held_.size());
+        return held_.back().getFuture();
+    }
+
+    size_t held() {
+        std::lock_guard<std::mutex> lg(lock_);
+        return held_.size();
+    }
+
+    size_t maxHeld() {
+        std::lock_guard<std::mutex> lg(lock_);
+        return maxHeld_;
+    }
+
+    bool releaseOne() {
+        folly::Promise<Status> p;
+        {
+            std::lock_guard<std::mutex> lg(lock_);
+            if (held_.empty()) {
+                return false;
+            }
+            p = std::move(held_.front());
+            held_.pop_front();
+        }
+        p.setValue(Status::OK());
+        return true;
+    }
+
+private:
+    std::mutex lock_;
+    std::list<folly::Promise<Status>> held_;
+    size_t maxHeld_ = 0;
+};
+
 TEST(BalanceTaskTest, SimpleTest) {
     {
         std::vector<Status> sts(9, Status::OK());
@@ -201,7 +245,7 @@ TEST(BalanceTest, BalancePartsTest) {
 TEST(BalanceTest, DispatchTasksTest) {
     {
         FLAGS_task_concurrency = 10;
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         for (int i = 0; i < 20; i++) {
             BalanceTask task(0, 0, 0, HostAddr(i, 0), HostAddr(i, 1), true, nullptr, nullptr);
             plan.addTask(std::move(task));
@@ -214,7 +258,7 @@ TEST(BalanceTest, DispatchTasksTest) {
     }
     {
         FLAGS_task_concurrency = 10;
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         for (int i = 0; i < 5; i++) {
             BalanceTask task(0, 0, i, HostAddr(i, 0), HostAddr(i, 1), true, nullptr, nullptr);
             plan.addTask(std::move(task));
@@ -227,7 +271,7 @@ TEST(BalanceTest, DispatchTasksTest) {
     }
     {
         FLAGS_task_concurrency = 20;
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         for (int i = 0; i < 5; i++) {
             BalanceTask task(0, 0, i, HostAddr(i, 0), HostAddr(i, 1), true, nullptr, nullptr);
             plan.addTask(std::move(task));
@@ -248,10 +292,51 @@ TEST(BalanceTest, DispatchTasksTest) {
     }
 }
 
+TEST(BalanceTest, ThrottleTasksTest) {
+    FLAGS_task_concurrency = 10;
+    FLAGS_max_tasks_per_src_host = 2;
+    BalancePlan plan(0L, nullptr, nullptr, nullptr);
+    std::vector<Status> sts(9, Status::OK());
+    auto* injector = new TestFaultInjectorWithHold(std::move(sts));
+    auto client = std::make_unique<AdminClient>(std::unique_ptr<FaultInjector>(injector));
+    // All parts are moved out of the same host
+    for (int i = 0; i < 6; i++) {
+        BalanceTask task(0, 0, i, HostAddr(0, 0), HostAddr(i, 1), true, nullptr, nullptr);
+        task.client_ = client.get();
+        plan.addTask(std::move(task));
+    }
+    folly::Baton<true, std::atomic> b;
+    plan.onFinished_ = [&plan, &b] () {
+        ASSERT_EQ(BalancePlan::Status::SUCCEEDED, plan.status_);
+        ASSERT_EQ(6, plan.finishedTaskNum_);
+        b.post();
+    };
+    plan.invoke();
+    while (injector->held() < 2) {
+        usleep(1000);
+    }
+    usleep(100 * 1000);
+    ASSERT_EQ(2, injector->held());
+    int32_t notStarted = 0;
+    for (auto& task : plan.tasks_) {
+        if (task.status_ == BalanceTask::Status::START) {
+            notStarted++;
+        }
+    }
+    ASSERT_EQ(4, notStarted);
+
+    while (!b.try_wait()) {
+        if (!injector->releaseOne()) {
+            usleep(1000);
+        }
+    }
+    ASSERT_EQ(2, injector->maxHeld());
+}
+
 TEST(BalanceTest, BalancePlanTest) {
     {
         LOG(INFO) << "Test with all tasks succeeded, only one bucket!";
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         std::vector<Status> sts(9, Status::OK());
         std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
         auto client = std::make_unique<AdminClient>(std::move(injector));
@@ -276,7 +361,7 @@ TEST(BalanceTest, BalancePlanTest) {
     }
     {
         LOG(INFO) << "Test with all tasks succeeded, 10 buckets!";
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         std::vector<Status> sts(9, Status::OK());
         std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
         auto client = std::make_unique<AdminClient>(std::move(injector));
@@ -303,7 +388,7 @@ TEST(BalanceTest, BalancePlanTest) {
     }
     {
         LOG(INFO) << "Test with one task failed, 10 buckets";
-        BalancePlan plan(0L, nullptr, nullptr);
+        BalancePlan plan(0L, nullptr, nullptr, nullptr);
         std::unique_ptr<AdminClient> client1, client2;
         {
             std::vector<Status> sts(9, Status::OK());
@@ -346,6 +431,8 @@ TEST(BalanceTest, BalancePlanTest) {
 TEST(BalanceTest, NormalTest) {
     fs::TempDir rootPath("/tmp/BalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 1;
     TestUtils::createSomeHosts(kv.get());
     {
@@ -355,7 +442,7 @@ TEST(BalanceTest, NormalTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -365,7 +452,7 @@ TEST(BalanceTest, NormalTest) {
     std::vector<Status> sts(9, Status::OK());
     std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
     auto ret = balancer.balance();
     ASSERT_EQ(cpp2::ErrorCode::E_BALANCED, error(ret));
 
@@ -433,6 +520,8 @@ TEST(BalanceTest, NormalTest) {
 TEST(BalanceTest, SpecifyHostTest) {
     fs::TempDir rootPath("/tmp/BalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 1;
     TestUtils::createSomeHosts(kv.get(), {{0, 0}, {1, 1}, {2, 2}, {3, 3}});
     {
@@ -442,7 +531,7 @@ TEST(BalanceTest, SpecifyHostTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -452,7 +541,7 @@ TEST(BalanceTest, SpecifyHostTest) {
     std::vector<Status> sts(9, Status::OK());
     std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
 
     sleep(1);
     LOG(INFO) << "Now, we remove host {3, 3}";
@@ -518,6 +607,8 @@ TEST(BalanceTest, SpecifyHostTest) {
 TEST(BalanceTest, SpecifyMultiHostTest) {
     fs::TempDir rootPath("/tmp/BalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 1;
     TestUtils::createSomeHosts(kv.get(), {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}});
     {
@@ -527,7 +618,7 @@ TEST(BalanceTest, SpecifyMultiHostTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -541,7 +632,7 @@ TEST(BalanceTest, SpecifyMultiHostTest) {
     std::vector<Status> sts(9, Status::OK());
     std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
 
     sleep(1);
     LOG(INFO) << "Now, we want to remove host {2, 2}/{3, 3}";
@@ -612,6 +703,8 @@ TEST(BalanceTest, SpecifyMultiHostTest) {
 TEST(BalanceTest, RecoveryTest) {
     fs::TempDir rootPath("/tmp/BalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 1;
     TestUtils::createSomeHosts(kv.get());
     {
@@ -621,7 +714,7 @@ TEST(BalanceTest, RecoveryTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -645,7 +738,7 @@ TEST(BalanceTest, RecoveryTest) {
 
     std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
     auto ret = balancer.balance();
     CHECK(ok(ret));
     auto balanceId = value(ret);
@@ -764,6 +857,8 @@ TEST(BalanceTest, StopBalanceDataTest) {
     FLAGS_task_concurrency = 1;
     fs::TempDir rootPath("/tmp/BalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 1;
     TestUtils::createSomeHosts(kv.get());
     {
@@ -773,7 +868,7 @@ TEST(BalanceTest, StopBalanceDataTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -786,7 +881,7 @@ TEST(BalanceTest, StopBalanceDataTest) {
     std::vector<Status> sts(9, Status::OK());
     std::unique_ptr<FaultInjector> injector(new TestFaultInjectorWithSleep(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
     auto ret = balancer.balance();
     CHECK(ok(ret));
     auto balanceId = value(ret);
@@ -895,13 +990,14 @@ void verifyLeaderBalancePlan(std::unordered_map<HostAddr, std::vector<PartitionI
 TEST(BalanceTest, SimpleLeaderBalancePlanTest) {
     fs::TempDir rootPath("/tmp/SimpleLeaderBalancePlanTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     std::vector<HostAddr> hosts = {{0, 0}, {1, 1}, {2, 2}};
     TestUtils::createSomeHosts(kv.get(), hosts);
     // 9 partition in space 1, 3 replica, 3 hosts
     TestUtils::assembleSpace(kv.get(), 1, 9, 3, 3);
 
-    std::unique_ptr<AdminClient> client(new AdminClient(kv.get()));
-    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), std::move(client)));
+    std::unique_ptr<AdminClient> client(new AdminClient(kv.get(), &activeHostsMan));
+    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), &activeHostsMan, std::move(client)));
     {
         HostLeaderMap hostLeaderMap;
         hostLeaderMap[HostAddr(0, 0)][1] = {1, 2, 3, 4, 5};
@@ -957,13 +1053,14 @@ TEST(BalanceTest, SimpleLeaderBalancePlanTest) {
 TEST(BalanceTest, IntersectHostsLeaderBalancePlanTest) {
     fs::TempDir rootPath("/tmp/IntersectHostsLeaderBalancePlanTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     std::vector<HostAddr> hosts = {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
     TestUtils::createSomeHosts(kv.get(), hosts);
     // 7 partition in space 1, 3 replica, 6 hosts, so not all hosts have intersection parts
     TestUtils::assembleSpace(kv.get(), 1, 7, 3, 6);
 
-    std::unique_ptr<AdminClient> client(new AdminClient(kv.get()));
-    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), std::move(client)));
+    std::unique_ptr<AdminClient> client(new AdminClient(kv.get(), &activeHostsMan));
+    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), &activeHostsMan, std::move(client)));
     {
         HostLeaderMap hostLeaderMap;
         hostLeaderMap[HostAddr(0, 0)][1] = {4, 5, 6};
@@ -1034,6 +1131,7 @@ TEST(BalanceTest, IntersectHostsLeaderBalancePlanTest) {
 TEST(BalanceTest, ManyHostsLeaderBalancePlanTest) {
     fs::TempDir rootPath("/tmp/SimpleLeaderBalancePlanTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     FLAGS_expired_threshold_sec = 600;
 
     int partCount = 99999;
@@ -1050,8 +1148,8 @@ TEST(BalanceTest, ManyHostsLeaderBalancePlanTest) {
     int32_t minLoad = std::floor(avgLoad * (1 - FLAGS_leader_balance_deviation));
     int32_t maxLoad = std::ceil(avgLoad * (1 + FLAGS_leader_balance_deviation));
 
-    std::unique_ptr<AdminClient> client(new AdminClient(kv.get()));
-    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), std::move(client)));
+    std::unique_ptr<AdminClient> client(new AdminClient(kv.get(), &activeHostsMan));
+    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), &activeHostsMan, std::move(client)));
     // chcek several times if they are balanced
     for (int count = 0; count < 1; count++) {
         HostLeaderMap hostLeaderMap;
@@ -1073,9 +1171,105 @@ TEST(BalanceTest, ManyHostsLeaderBalancePlanTest) {
     }
 }
 
+TEST(BalanceTest, LoadLeaderBalancePlanTest) {
+    fs::TempDir rootPath("/tmp/LoadLeaderBalancePlanTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
+    FLAGS_expired_threshold_sec = 600;
+
+    int partCount = 1000;
+    int replica = 3;
+    int hostCount = 10;
+    std::vector<HostAddr> hosts;
+    for (int i = 0; i < hostCount; i++) {
+        hosts.emplace_back(i, i);
+    }
+    TestUtils::createSomeHosts(kv.get(), hosts);
+    TestUtils::assembleSpace(kv.get(), 1, partCount, replica, hostCount);
+
+    // The traffic of the parts differs by 100x
+    std::mt19937 rng(1161);
+    std::vector<int64_t> candidates = {1, 1, 1, 10, 100};
+    auto maxPartLoad = *std::max_element(candidates.begin(), candidates.end());
+    std::unordered_map<PartitionID, int64_t> partLoads;
+    int64_t totalLoad = 0;
+    for (int partId = 1; partId <= partCount; partId++) {
+        auto load = candidates[folly::Random::rand32(candidates.size(), rng)];
+        partLoads[partId] = load;
+        totalLoad += load;
+    }
+    auto maxLoadOf = [&partLoads] (const auto& leaderHostParts) {
+        int64_t maxLoad = 0;
+        for (const auto& hostEntry : leaderHostParts) {
+            int64_t load = 0;
+            for (auto partId : hostEntry.second) {
+                load += partLoads[partId];
+            }
+            maxLoad = std::max(maxLoad, load);
+        }
+        return maxLoad;
+    };
+
+    // The plan stops once no single transfer lowers the max load, which leaves the busiest
+    // host at most about one part over the expected load
+    auto bound = static_cast<double>(totalLoad) / hostCount
+               * (1 + FLAGS_leader_balance_deviation) + maxPartLoad;
+
+    std::unique_ptr<AdminClient> client(new AdminClient(kv.get(), &activeHostsMan));
+    std::unique_ptr<Balancer> balancer(new Balancer(kv.get(), &activeHostsMan, std::move(client)));
+    for (int count = 0; count < 3; count++) {
+        HostLeaderMap hostLeaderMap;
+        for (int partId = 1; partId <= partCount; partId++) {
+            auto leader = hosts[(partId + folly::Random::rand32(replica, rng)) % hostCount];
+            hostLeaderMap[leader][1].emplace_back(partId);
+        }
+        // Balance the leader number first, which is what we do without the loads
+        LeaderBalancePlan countPlan;
+        auto countLeaders = balancer->buildLeaderBalancePlan(&hostLeaderMap, 1, countPlan);
+        auto countMaxLoad = maxLoadOf(countLeaders);
+
+        HostLeaderMap countLeaderMap;
+        for (auto& hostEntry : countLeaders) {
+            countLeaderMap[hostEntry.first][1] = hostEntry.second;
+        }
+        LeaderBalancePlan plan;
+        auto leaderParts = balancer->buildLoadBalancePlan(&countLeaderMap, 1, partLoads, plan);
+        auto maxLoad = maxLoadOf(leaderParts);
+        LOG(INFO) << "Max load " << countMaxLoad << " -> " << maxLoad
+                  << " after " << plan.size() << " transfers, total load " << totalLoad;
+        EXPECT_LT(maxLoad, countMaxLoad);
+        EXPECT_LE(maxLoad, bound);
+
+        // Every part is still led by one of its peers
+        int32_t leaderNum = 0;
+        for (const auto& hostEntry : leaderParts) {
+            for (auto partId : hostEntry.second) {
+                auto offset = (hostEntry.first.first - partId % hostCount + hostCount) % hostCount;
+                EXPECT_LT(offset, replica);
+                leaderNum++;
+            }
+        }
+        EXPECT_EQ(partCount, leaderNum);
+    }
+
+    // The live host leading nothing takes over leaders as well
+    HostLeaderMap hostLeaderMap;
+    for (int partId = 1; partId <= partCount; partId++) {
+        auto offset = partId % hostCount == 0 ? 1 : 0;
+        hostLeaderMap[hosts[(partId + offset) % hostCount]][1].emplace_back(partId);
+    }
+    ASSERT_EQ(hostLeaderMap.end(), hostLeaderMap.find(hosts[0]));
+    LeaderBalancePlan plan;
+    auto leaderParts = balancer->buildLoadBalancePlan(&hostLeaderMap, 1, partLoads, plan);
+    EXPECT_FALSE(leaderParts[hosts[0]].empty());
+    EXPECT_LE(maxLoadOf(leaderParts), bound);
+}
+
 TEST(BalanceTest, LeaderBalanceTest) {
     fs::TempDir rootPath("/tmp/LeaderBalanceTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     std::vector<HostAddr> hosts = {{0, 0}, {1, 1}, {2, 2}};
     TestUtils::createSomeHosts(kv.get(), hosts);
     TestUtils::assembleSpace(kv.get(), 1, 9, 3, 3);
@@ -1086,7 +1280,7 @@ TEST(BalanceTest, LeaderBalanceTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1098,7 +1292,7 @@ TEST(BalanceTest, LeaderBalanceTest) {
     std::unique_ptr<FaultInjector> injector(new TestFaultInjector(std::move(sts)));
     auto client = std::make_unique<AdminClient>(std::move(injector));
 
-    Balancer balancer(kv.get(), std::move(client));
+    Balancer balancer(kv.get(), &activeHostsMan, std::move(client));
     auto ret = balancer.leaderBalance();
     ASSERT_EQ(ret, cpp2::ErrorCode::SUCCEEDED);
 }
@@ -13,6 +13,7 @@
 #include "meta/processors/admin/HBProcessor.h"
 
 DECLARE_bool(hosts_whitelist_enabled);
+DECLARE_int32(host_info_persist_interval_secs);
 
 namespace nebula {
 namespace meta {
@@ -23,6 +24,7 @@ using apache::thrift::FragileConstructor::FRAGILE;
 TEST(HBProcessorTest, HBTest) {
     fs::TempDir rootPath("/tmp/HBTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     const ClusterID kClusterId = 10;
     {
         for (auto i = 0; i < 5; i++) {
@@ -32,16 +34,16 @@ TEST(HBProcessorTest, HBTest) {
             thriftHost.set_port(i);
             req.set_host(std::move(thriftHost));
             req.set_cluster_id(kClusterId);
-            auto* processor = HBProcessor::instance(kv.get(), kClusterId);
+            auto* processor = HBProcessor::instance(kv.get(), &activeHostsMan, kClusterId);
             auto f = processor->getFuture();
             processor->process(req);
             auto resp = std::move(f).get();
             ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
         }
-        auto hosts = ActiveHostsMan::getActiveHosts(kv.get(), 1);
+        auto hosts = activeHostsMan.getActiveHosts(1);
         ASSERT_EQ(5, hosts.size());
         sleep(3);
-        ASSERT_EQ(0, ActiveHostsMan::getActiveHosts(kv.get(), 1).size());
+        ASSERT_EQ(0, activeHostsMan.getActiveHosts(1).size());
 
         LOG(INFO) << "Test for invalid host!";
         cpp2::HBReq req;
@@ -50,7 +52,7 @@ TEST(HBProcessorTest, HBTest) {
         thriftHost.set_port(11);
         req.set_host(std::move(thriftHost));
         req.set_cluster_id(1);
-        auto* processor = HBProcessor::instance(kv.get());
+        auto* processor = HBProcessor::instance(kv.get(), &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -58,6 +60,94 @@ TEST(HBProcessorTest, HBTest) {
     }
 }
 
+TEST(HBProcessorTest, LeaderReportTest) {
+    gflags::FlagSaver saver;
+    fs::TempDir rootPath("/tmp/LeaderReportTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
+    FLAGS_host_info_persist_interval_secs = 3600;
+    const ClusterID kClusterId = 10;
+    auto heartbeat = [&] (int32_t host, LeaderInfos leaderInfos) {
+        cpp2::HBReq req;
+        nebula::cpp2::HostAddr thriftHost;
+        thriftHost.set_ip(host);
+        thriftHost.set_port(host);
+        req.set_host(std::move(thriftHost));
+        req.set_cluster_id(kClusterId);
+        req.set_leader_infos(std::move(leaderInfos));
+        auto* processor = HBProcessor::instance(kv.get(), &activeHostsMan, kClusterId);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    };
+    auto leaderInfo = [] (PartitionID part, int64_t term) {
+        cpp2::LeaderInfo info;
+        info.set_part_id(part);
+        info.set_term(term);
+        info.set_committed_log_id(100);
+        return info;
+    };
+
+    heartbeat(1, {{1, {leaderInfo(1, 1), leaderInfo(2, 1)}}});
+    heartbeat(2, {{1, {leaderInfo(3, 1)}}});
+    // The new leader of part 2
+    heartbeat(2, {{1, {leaderInfo(2, 2), leaderInfo(3, 1)}}});
+    // A host leading nothing
+    heartbeat(3, {});
+
+    auto hostLeaderMap = activeHostsMan.getLeaderDist();
+    ASSERT_EQ(3, hostLeaderMap.size());
+    ASSERT_EQ(std::vector<PartitionID>{1}, hostLeaderMap[HostAddr(1, 1)][1]);
+    auto parts = hostLeaderMap[HostAddr(2, 2)][1];
+    std::sort(parts.begin(), parts.end());
+    ASSERT_EQ((std::vector<PartitionID>{2, 3}), parts);
+    ASSERT_NE(hostLeaderMap.end(), hostLeaderMap.find(HostAddr(3, 3)));
+    ASSERT_TRUE(hostLeaderMap[HostAddr(3, 3)].empty());
+
+    // Only the first heartbeat of a host is persisted at once
+    std::string val;
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED,
+              kv->get(kDefaultSpaceId, kDefaultPartId, MetaServiceUtils::hostKey(2, 2), &val));
+    auto persisted = HostInfo::decode(val);
+    sleep(2);
+    heartbeat(2, {});
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED,
+              kv->get(kDefaultSpaceId, kDefaultPartId, MetaServiceUtils::hostKey(2, 2), &val));
+    ASSERT_EQ(persisted, HostInfo::decode(val));
+    // But the liveness is in memory
+    auto hosts = activeHostsMan.getActiveHosts(1);
+    ASSERT_EQ(std::vector<HostAddr>{HostAddr(2, 2)}, hosts);
+
+    // The persisted heartbeat wins if it's newer than the one in memory
+    auto now = time::WallClock::fastNowInMilliSec();
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED,
+              activeHostsMan.reportHostInfo(HostAddr(4, 4), HostInfo(now - 5000), {}));
+    hosts = activeHostsMan.getActiveHosts(1);
+    ASSERT_EQ(std::vector<HostAddr>{HostAddr(2, 2)}, hosts);
+    std::vector<kvstore::KV> data;
+    data.emplace_back(MetaServiceUtils::hostKey(4, 4), HostInfo::encode(HostInfo(now)));
+    folly::Baton<true, std::atomic> baton;
+    kv->asyncMultiPut(kDefaultSpaceId, kDefaultPartId, std::move(data),
+                      [&baton] (kvstore::ResultCode code) {
+        ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+        baton.post();
+    });
+    baton.wait();
+    hosts = activeHostsMan.getActiveHosts(1);
+    std::sort(hosts.begin(), hosts.end());
+    ASSERT_EQ((std::vector<HostAddr>{HostAddr(2, 2), HostAddr(4, 4)}), hosts);
+
+    // The reported leaders live as long as the meta service receiving them,
+    // another one over the same store only knows the persisted heartbeats
+    {
+        ActiveHostsMan another(kv.get());
+        ASSERT_TRUE(another.getLeaderDist().empty());
+        ASSERT_TRUE(another.getPartLoads().empty());
+    }
+    ASSERT_EQ(3, activeHostsMan.getLeaderDist().size());
+}
+
 }  // namespace meta
 }  // namespace nebula
 
@@ -1000,6 +1000,12 @@ public:
         partChanged++;
     }
 
+    void fetchLeaderInfo(std::unordered_map<GraphSpaceID,
+                                            std::vector<cpp2::LeaderInfo>>& leaderInfos)
+                                            override {
+        UNUSED(leaderInfos);
+    }
+
     HostAddr getLocalHost() {
         return HostAddr(0, 0);
     }
@@ -1063,6 +1069,117 @@ TEST(MetaClientTest, DiffTest) {
     ASSERT_EQ(9, listener->partNum);
 }
 
+// Serves the requests by the real handler, counting the ones loading the spaces
+class CountingMetaService : public cpp2::MetaServiceSvIf {
+public:
+    explicit CountingMetaService(kvstore::KVStore* kv)
+        : handler_(std::make_unique<MetaServiceHandler>(kv)) {}
+
+    folly::Future<cpp2::ExecResp>
+    future_createSpace(const cpp2::CreateSpaceReq& req) override {
+        return handler_->future_createSpace(req);
+    }
+
+    folly::Future<cpp2::ExecResp>
+    future_createTag(const cpp2::CreateTagReq& req) override {
+        return handler_->future_createTag(req);
+    }
+
+    folly::Future<cpp2::GetCatalogVersionResp>
+    future_getCatalogVersion(const cpp2::GetCatalogVersionReq& req) override {
+        catalogVersionReqs_++;
+        return handler_->future_getCatalogVersion(req);
+    }
+
+    folly::Future<cpp2::ListSpacesResp>
+    future_listSpaces(const cpp2::ListSpacesReq& req) override {
+        listSpacesReqs_++;
+        return handler_->future_listSpaces(req);
+    }
+
+    folly::Future<cpp2::GetSpaceResp>
+    future_getSpace(const cpp2::GetSpaceReq& req) override {
+        getSpaceReqs_++;
+        return handler_->future_getSpace(req);
+    }
+
+    folly::Future<cpp2::GetPartsAllocResp>
+    future_getPartsAlloc(const cpp2::GetPartsAllocReq& req) override {
+        getPartsAllocReqs_++;
+        return handler_->future_getPartsAlloc(req);
+    }
+
+    folly::Future<cpp2::ListTagsResp>
+    future_listTags(const cpp2::ListTagsReq& req) override {
+        return handler_->future_listTags(req);
+    }
+
+    folly::Future<cpp2::ListEdgesResp>
+    future_listEdges(const cpp2::ListEdgesReq& req) override {
+        return handler_->future_listEdges(req);
+    }
+
+    std::atomic<int32_t> catalogVersionReqs_{0};
+    std::atomic<int32_t> listSpacesReqs_{0};
+    std::atomic<int32_t> getSpaceReqs_{0};
+    std::atomic<int32_t> getPartsAllocReqs_{0};
+
+private:
+    std::unique_ptr<MetaServiceHandler> handler_;
+};
+
+TEST(MetaClientTest, LoadUnchangedSpacesTest) {
+    fs::TempDir rootPath("/tmp/LoadUnchangedSpacesTest.XXXXXX");
+    auto sc = std::make_unique<test::ServerContext>();
+    sc->kvStore_ = TestUtils::initKV(rootPath.path());
+    auto handler = std::make_shared<CountingMetaService>(sc->kvStore_.get());
+    sc->mockCommon("meta", 0, handler);
+    TestUtils::registerHB(sc->kvStore_.get(), {{0, 0}, {1, 1}, {2, 2}});
+
+    auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    IPv4 localIp;
+    network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
+    auto client = std::make_shared<MetaClient>(threadPool,
+                                               std::vector<HostAddr>{HostAddr(localIp, sc->port_)});
+    auto space1 = client->createSpace("space_1", 3, 1).get();
+    ASSERT_TRUE(space1.ok()) << space1.status();
+    auto space2 = client->createSpace("space_2", 3, 1).get();
+    ASSERT_TRUE(space2.ok()) << space2.status();
+
+    ASSERT_TRUE(client->loadData());
+    ASSERT_EQ(1, handler->catalogVersionReqs_.load());
+    ASSERT_EQ(1, handler->listSpacesReqs_.load());
+    ASSERT_EQ(2, handler->getSpaceReqs_.load());
+    ASSERT_EQ(2, handler->getPartsAllocReqs_.load());
+
+    // Only the catalog version is checked if nothing changed
+    for (auto i = 0; i < 3; i++) {
+        ASSERT_TRUE(client->loadData());
+    }
+    ASSERT_EQ(4, handler->catalogVersionReqs_.load());
+    ASSERT_EQ(1, handler->listSpacesReqs_.load());
+    ASSERT_EQ(2, handler->getSpaceReqs_.load());
+    ASSERT_EQ(2, handler->getPartsAllocReqs_.load());
+
+    // Only the changed space is fetched again
+    nebula::cpp2::Schema schema;
+    schema.columns.emplace_back(TestUtils::columnDef(0, SupportedType::INT));
+    auto tagRet = client->createTagSchema(space1.value(), "tag_1", schema).get();
+    ASSERT_TRUE(tagRet.ok()) << tagRet.status();
+    ASSERT_TRUE(client->loadData());
+    ASSERT_EQ(5, handler->catalogVersionReqs_.load());
+    ASSERT_EQ(2, handler->listSpacesReqs_.load());
+    ASSERT_EQ(3, handler->getSpaceReqs_.load());
+    ASSERT_EQ(3, handler->getPartsAllocReqs_.load());
+
+    auto tagId = client->getTagIDByNameFromCache(space1.value(), "tag_1");
+    ASSERT_TRUE(tagId.ok()) << tagId.status();
+    ASSERT_EQ(tagRet.value(), tagId.value());
+    auto spaceId = client->getSpaceIdByNameFromCache("space_2");
+    ASSERT_TRUE(spaceId.ok()) << spaceId.status();
+    ASSERT_EQ(space2.value(), spaceId.value());
+}
+
 TEST(MetaClientTest, HeartbeatTest) {
     FLAGS_load_data_interval_secs = 5;
     FLAGS_heartbeat_interval_secs = 1;
@@ -1096,7 +1213,8 @@ TEST(MetaClientTest, HeartbeatTest) {
         }
     }
     sleep(FLAGS_heartbeat_interval_secs + 1);
-    ASSERT_EQ(1, ActiveHostsMan::getActiveHosts(sc->kvStore_.get()).size());
+    ActiveHostsMan activeHostsMan(sc->kvStore_.get());
+    ASSERT_EQ(1, activeHostsMan.getActiveHosts().size());
 }
 
 
@@ -0,0 +1,102 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include "fs/TempDir.h"
+#include "meta/test/TestUtils.h"
+#include "meta/processors/partsMan/CreateSpaceProcessor.h"
+#include "meta/processors/schemaMan/CreateTagProcessor.h"
+
+DEFINE_int32(spaces, 16, "The number of spaces");
+DEFINE_int32(ddl_threads, 16, "The threads issuing the DDLs concurrently");
+
+std::unique_ptr<nebula::kvstore::KVStore> gKV;
+std::unique_ptr<nebula::meta::IdAllocator> gIdAllocator;
+std::unique_ptr<nebula::meta::ActiveHostsMan> gActiveHostsMan;
+std::atomic<int64_t> gTagSeq{0};
+
+namespace nebula {
+namespace meta {
+
+void setUp(const char* path) {
+    gKV = TestUtils::initKV(path);
+    gIdAllocator = std::make_unique<IdAllocator>(gKV.get());
+    gActiveHostsMan = std::make_unique<ActiveHostsMan>(gKV.get());
+    TestUtils::createSomeHosts(gKV.get());
+    for (auto i = 0; i < FLAGS_spaces; i++) {
+        cpp2::SpaceProperties properties;
+        properties.set_space_name(folly::stringPrintf("space_%d", i));
+        properties.set_partition_num(1);
+        properties.set_replica_factor(1);
+        cpp2::CreateSpaceReq req;
+        req.set_properties(std::move(properties));
+        auto* processor = CreateSpaceProcessor::instance(gKV.get(),
+                                                         gIdAllocator.get(),
+                                                         gActiveHostsMan.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        CHECK_EQ(cpp2::ErrorCode::SUCCEEDED, std::move(f).get().get_code());
+    }
+}
+
+void createTag(GraphSpaceID spaceId) {
+    cpp2::CreateTagReq req;
+    req.set_space_id(spaceId);
+    req.set_tag_name(folly::stringPrintf("tag_%ld", gTagSeq++));
+    nebula::cpp2::Schema schema;
+    schema.columns.emplace_back(TestUtils::columnDef(0, nebula::cpp2::SupportedType::INT));
+    req.set_schema(std::move(schema));
+    auto* processor = CreateTagProcessor::instance(gKV.get(), gIdAllocator.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    CHECK_EQ(cpp2::ErrorCode::SUCCEEDED, std::move(f).get().get_code());
+}
+
+// Every thread creates the tags in the space picked by `space'
+template <typename SpaceOf>
+void concurrentCreateTags(size_t iters, SpaceOf space) {
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < FLAGS_ddl_threads; t++) {
+        threads.emplace_back([iters, t, &space] {
+            for (size_t i = t; i < iters; i += FLAGS_ddl_threads) {
+                createTag(space(t));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+}  // namespace meta
+}  // namespace nebula
+
+BENCHMARK(create_tags_in_one_space, iters) {
+    nebula::meta::concurrentCreateTags(iters, [] (int32_t) { return 1; });
+}
+
+BENCHMARK_RELATIVE(create_tags_across_spaces, iters) {
+    nebula::meta::concurrentCreateTags(iters, [] (int32_t t) {
+        return t % FLAGS_spaces + 1;
+    });
+}
+
+/*************************
+ * End of benchmarks
+ ************************/
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    nebula::fs::TempDir rootPath("/tmp/MetaDDLBenchmark.XXXXXX");
+    nebula::meta::setUp(rootPath.path());
+    folly::runBenchmarks();
+    gActiveHostsMan.reset();
+    gIdAllocator.reset();
+    gKV.reset();
+    return 0;
+}
@@ -8,8 +8,10 @@
 #include <gtest/gtest.h>
 #include <folly/String.h>
 #include <fstream>
+#include <numeric>
 #include "fs/TempDir.h"
 #include "meta/test/TestUtils.h"
+#include "meta/IdAllocator.h"
 #include "meta/processors/partsMan/CreateSpaceProcessor.h"
 #include "meta/processors/partsMan/ListSpacesProcessor.h"
 #include "meta/processors/partsMan/ListSpacesProcessor.h"
@@ -17,6 +19,7 @@
 #include "meta/processors/partsMan/DropSpaceProcessor.h"
 #include "meta/processors/partsMan/GetSpaceProcessor.h"
 #include "meta/processors/partsMan/GetPartsAllocProcessor.h"
+#include "meta/processors/partsMan/GetCatalogVersionProcessor.h"
 #include "meta/processors/schemaMan/CreateTagProcessor.h"
 #include "meta/processors/schemaMan/CreateEdgeProcessor.h"
 #include "meta/processors/schemaMan/DropTagProcessor.h"
@@ -53,6 +56,7 @@ TEST(ProcessorTest, ListHostsTest) {
     fs::TempDir rootPath("/tmp/ListHostsTest.XXXXXX");
     FLAGS_expired_threshold_sec = 1;
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     std::vector<HostAddr> hosts;
     for (auto i = 0; i < 10; i++) {
         hosts.emplace_back(i, i);
@@ -61,7 +65,7 @@ TEST(ProcessorTest, ListHostsTest) {
         // after received heartbeat, host status will become online
         meta::TestUtils::registerHB(kv.get(), hosts);
         cpp2::ListHostsReq req;
-        auto* processor = ListHostsProcessor::instance(kv.get());
+        auto* processor = ListHostsProcessor::instance(kv.get(), &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -76,7 +80,7 @@ TEST(ProcessorTest, ListHostsTest) {
         // host info expired
         sleep(FLAGS_expired_threshold_sec + 1);
         cpp2::ListHostsReq req;
-        auto* processor = ListHostsProcessor::instance(kv.get());
+        auto* processor = ListHostsProcessor::instance(kv.get(), &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -92,6 +96,7 @@ TEST(ProcessorTest, ListHostsTest) {
 TEST(ProcessorTest, ListPartsTest) {
     fs::TempDir rootPath("/tmp/ListPartsTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    ActiveHostsMan activeHostsMan(kv.get());
     std::vector<HostAddr> hosts = {{0, 0}, {1, 1}, {2, 2}};
     TestUtils::createSomeHosts(kv.get(), hosts);
     // 9 partition in space 1, 3 replica, 3 hosts
@@ -99,7 +104,7 @@ TEST(ProcessorTest, ListPartsTest) {
     {
         cpp2::ListPartsReq req;
         req.set_space_id(1);
-        auto* processor = ListPartsProcessor::instance(kv.get());
+        auto* processor = ListPartsProcessor::instance(kv.get(), &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -125,7 +130,7 @@ TEST(ProcessorTest, ListPartsTest) {
     {
         cpp2::ListPartsReq req;
         req.set_space_id(1);
-        auto* processor = ListPartsProcessor::instance(kv.get(), client.get());
+        auto* processor = ListPartsProcessor::instance(kv.get(), &activeHostsMan, client.get());
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -168,6 +173,8 @@ TEST(ProcessorTest, ListPartsTest) {
 TEST(ProcessorTest, SpaceTest) {
     fs::TempDir rootPath("/tmp/CreateSpaceTest.XXXXXX");
     auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     auto hostsNum = TestUtils::createSomeHosts(kv.get());
 
     {
@@ -177,7 +184,7 @@ TEST(ProcessorTest, SpaceTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -249,9 +256,206 @@ TEST(ProcessorTest, SpaceTest) {
     }
 }
 
+TEST(ProcessorTest, RangePartitionSpaceTest) {
+    fs::TempDir rootPath("/tmp/RangePartitionSpaceTest.XXXXXX");
+    auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
+    TestUtils::createSomeHosts(kv.get());
+
+    {
+        cpp2::SpaceProperties properties;
+        properties.set_space_name("bad_bounds");
+        properties.set_partition_num(3);
+        properties.set_replica_factor(1);
+        properties.set_partition_strategy(cpp2::PartitionStrategy::RANGE);
+        properties.set_range_bounds({200, 100});
+        cpp2::CreateSpaceReq req;
+        req.set_properties(std::move(properties));
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::E_INVALID_PARM, resp.code);
+    }
+    {
+        cpp2::SpaceProperties properties;
+        properties.set_space_name("even_range");
+        properties.set_partition_num(4);
+        properties.set_replica_factor(1);
+        properties.set_partition_strategy(cpp2::PartitionStrategy::RANGE);
+        cpp2::CreateSpaceReq req;
+        req.set_properties(std::move(properties));
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    }
+    {
+        cpp2::GetSpaceReq req;
+        req.set_space_name("even_range");
+        auto* processor = GetSpaceProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+        auto& properties = resp.item.properties;
+        ASSERT_EQ(cpp2::PartitionStrategy::RANGE, properties.partition_strategy);
+        // The evenly split bounds are kept
+        std::vector<VertexID> expected = {std::numeric_limits<int64_t>::min() / 2,
+                                          0,
+                                          std::numeric_limits<int64_t>::max() / 2 + 1};
+        ASSERT_EQ(expected, properties.range_bounds);
+    }
+}
+
+TEST(ProcessorTest, SpaceVersionTest) {
+    fs::TempDir rootPath("/tmp/SpaceVersionTest.XXXXXX");
+    auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
+    TestUtils::createSomeHosts(kv.get());
+
+    auto listVersions = [&kv] () {
+        cpp2::ListSpacesReq req;
+        auto* processor = ListSpacesProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+        return resp.versions;
+    };
+    auto catalogVersion = [&kv] () {
+        cpp2::GetCatalogVersionReq req;
+        auto* processor = GetCatalogVersionProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+        return resp.version;
+    };
+    ASSERT_EQ(0, catalogVersion());
+    {
+        cpp2::SpaceProperties properties;
+        properties.set_space_name("default_space");
+        properties.set_partition_num(1);
+        properties.set_replica_factor(1);
+        cpp2::CreateSpaceReq req;
+        req.set_properties(std::move(properties));
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    }
+    auto versions = listVersions();
+    ASSERT_EQ(1, versions.size());
+    auto version = versions[1];
+    // Unchanged without any DDL
+    ASSERT_EQ(version, listVersions()[1]);
+    ASSERT_EQ(version, catalogVersion());
+
+    nebula::cpp2::Schema schema;
+    decltype(schema.columns) cols;
+    cols.emplace_back(TestUtils::columnDef(0, SupportedType::INT));
+    schema.set_columns(std::move(cols));
+    {
+        cpp2::CreateTagReq req;
+        req.set_space_id(1);
+        req.set_tag_name("default_tag");
+        req.set_schema(schema);
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    }
+    ASSERT_LT(version, listVersions()[1]);
+    version = listVersions()[1];
+    ASSERT_EQ(version, catalogVersion());
+    {
+        cpp2::DropTagReq req;
+        req.set_space_id(1);
+        req.set_tag_name("default_tag");
+        auto* processor = DropTagProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    }
+    ASSERT_LT(version, listVersions()[1]);
+    version = listVersions()[1];
+    ASSERT_EQ(version, catalogVersion());
+    {
+        std::string val;
+        ASSERT_EQ(kvstore::ResultCode::ERR_KEY_NOT_FOUND,
+                  kv->get(kDefaultSpaceId, kDefaultPartId,
+                          MetaServiceUtils::indexTagKey(1, "default_tag"), &val));
+    }
+    {
+        cpp2::DropSpaceReq req;
+        req.set_space_name("default_space");
+        auto* processor = DropSpaceProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.code);
+    }
+    ASSERT_TRUE(listVersions().empty());
+    // Dropping a space changes the catalog as well
+    ASSERT_LT(version, catalogVersion());
+}
+
+TEST(ProcessorTest, IdAllocatorTest) {
+    fs::TempDir rootPath("/tmp/IdAllocatorTest.XXXXXX");
+    auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator allocator(kv.get());
+
+    std::vector<std::vector<int32_t>> ids(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ids.size(); t++) {
+        threads.emplace_back([&allocator, &ids, t] {
+            for (auto i = 0; i < 250; i++) {
+                int32_t id;
+                ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, allocator.allocate(&id));
+                ids[t].emplace_back(id);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::vector<int32_t> all;
+    for (auto& threadIds : ids) {
+        ASSERT_TRUE(std::is_sorted(threadIds.begin(), threadIds.end()));
+        all.insert(all.end(), threadIds.begin(), threadIds.end());
+    }
+    std::sort(all.begin(), all.end());
+    std::vector<int32_t> expected(1000);
+    std::iota(expected.begin(), expected.end(), 1);
+    ASSERT_EQ(expected, all);
+
+    // Only the last reserved id is written
+    std::string val;
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, kv->get(0, 0, "__id__", &val));
+    ASSERT_EQ(1000, *reinterpret_cast<const int32_t*>(val.data()));
+
+    // Another allocator of the kvstore, e.g. after the meta service restarts,
+    // continues after the ids reserved by the former one
+    IdAllocator restarted(kv.get());
+    int32_t id;
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, restarted.allocate(&id));
+    ASSERT_EQ(1001, id);
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, allocator.allocate(&id));
+    ASSERT_LT(1001, id);
+}
+
 TEST(ProcessorTest, CreateTagTest) {
     fs::TempDir rootPath("/tmp/CreateTagTest.XXXXXX");
     auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     TestUtils::createSomeHosts(kv.get());
 
     {
@@ -262,7 +466,7 @@ TEST(ProcessorTest, CreateTagTest) {
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -277,7 +481,7 @@ TEST(ProcessorTest, CreateTagTest) {
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -296,7 +500,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(0);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -308,7 +512,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -321,7 +525,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -333,7 +537,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(2);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -346,7 +550,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_edge_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -364,7 +568,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_tag_name("tag_ttl");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -384,7 +588,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_tag_name("tag_with_default");
         req.set_schema(std::move(schemaWithDefault));
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -411,7 +615,7 @@ TEST(ProcessorTest, CreateTagTest) {
         req.set_space_id(1);
         req.set_tag_name("tag_type_mismatche");
         req.set_schema(std::move(schemaWithDefault));
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -423,6 +627,8 @@ TEST(ProcessorTest, CreateTagTest) {
 TEST(ProcessorTest, CreateEdgeTest) {
     fs::TempDir rootPath("/tmp/CreateEdgeTest.XXXXXX");
     auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     TestUtils::createSomeHosts(kv.get());
 
     {
@@ -433,7 +639,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -449,7 +655,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -468,7 +674,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(0);
         req.set_edge_name("default_edge");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -480,7 +686,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_edge_name("default_edge");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -493,7 +699,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_edge_name("default_edge");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -505,7 +711,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(2);
         req.set_edge_name("default_edge");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -518,7 +724,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_tag_name("default_edge");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -536,7 +742,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_edge_name("edge_ttl");
         req.set_schema(schema);
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -556,7 +762,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_edge_name("edge_with_defaule");
         req.set_schema(std::move(schemaWithDefault));
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -583,7 +789,7 @@ TEST(ProcessorTest, CreateEdgeTest) {
         req.set_space_id(1);
         req.set_edge_name("edge_type_mismatche");
         req.set_schema(std::move(schemaWithDefault));
-        auto* processor = CreateEdgeProcessor::instance(kv.get());
+        auto* processor = CreateEdgeProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -594,6 +800,8 @@ TEST(ProcessorTest, CreateEdgeTest) {
 TEST(ProcessorTest, KVOperationTest) {
     fs::TempDir rootPath("/tmp/KVOperationTest.XXXXXX");
     auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     TestUtils::createSomeHosts(kv.get());
 
     {
@@ -604,7 +812,7 @@ TEST(ProcessorTest, KVOperationTest) {
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1562,6 +1770,8 @@ TEST(ProcessorTest, AlterEdgeTest) {
 TEST(ProcessorTest, SameNameTagsTest) {
     fs::TempDir rootPath("/tmp/SameNameTagsTest.XXXXXX");
     auto kv = TestUtils::initKV(rootPath.path());
+    IdAllocator idAllocator(kv.get());
+    ActiveHostsMan activeHostsMan(kv.get());
     TestUtils::createSomeHosts(kv.get());
 
     {
@@ -1571,7 +1781,7 @@ TEST(ProcessorTest, SameNameTagsTest) {
         properties.set_replica_factor(3);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1585,7 +1795,7 @@ TEST(ProcessorTest, SameNameTagsTest) {
         properties.set_replica_factor(1);
         cpp2::CreateSpaceReq req;
         req.set_properties(std::move(properties));
-        auto* processor = CreateSpaceProcessor::instance(kv.get());
+        auto* processor = CreateSpaceProcessor::instance(kv.get(), &idAllocator, &activeHostsMan);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1605,7 +1815,7 @@ TEST(ProcessorTest, SameNameTagsTest) {
         req.set_space_id(1);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1617,7 +1827,7 @@ TEST(ProcessorTest, SameNameTagsTest) {
         req.set_space_id(2);
         req.set_tag_name("default_tag");
         req.set_schema(schema);
-        auto* processor = CreateTagProcessor::instance(kv.get());
+        auto* processor = CreateTagProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1670,6 +1880,7 @@ TEST(ProcessorTest, SameNameTagsTest) {
 TEST(ProcessorTest, TagIndexTest) {
     fs::TempDir rootPath("/tmp/TagIndexTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
     TestUtils::createSomeHosts(kv.get());
     ASSERT_TRUE(TestUtils::assembleSpace(kv.get(), 1, 1));
     TestUtils::mockTag(kv.get(), 2);
@@ -1683,7 +1894,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("single_field_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1699,7 +1910,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("multi_field_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1716,7 +1927,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("multi_tag_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1732,7 +1943,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("tag_not_exist_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1748,7 +1959,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("field_not_exist_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1765,7 +1976,7 @@ TEST(ProcessorTest, TagIndexTest) {
         req.set_space_id(1);
         req.set_index_name("single_field_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto* processor = CreateTagIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1908,6 +2119,7 @@ TEST(ProcessorTest, TagIndexTest) {
 TEST(ProcessorTest, EdgeIndexTest) {
     fs::TempDir rootPath("/tmp/EdgeIndexTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    IdAllocator idAllocator(kv.get());
     TestUtils::createSomeHosts(kv.get());
     ASSERT_TRUE(TestUtils::assembleSpace(kv.get(), 1, 1));
     TestUtils::mockEdge(kv.get(), 2);
@@ -1922,7 +2134,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_index_name("single_field_index");
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1939,7 +2151,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_index_name("multi_field_index");
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1955,7 +2167,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_space_id(1);
         req.set_index_name("edge_not_exist_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1971,7 +2183,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_space_id(1);
         req.set_index_name("field_not_exist_index");
         req.set_properties(std::move(properties));
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -1989,7 +2201,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_index_name("multi_edge_index");
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -2006,7 +2218,7 @@ TEST(ProcessorTest, EdgeIndexTest) {
         req.set_index_name("single_field_index");
         req.set_properties(std::move(properties));
 
-        auto* processor = CreateEdgeIndexProcessor::instance(kv.get());
+        auto* processor = CreateEdgeIndexProcessor::instance(kv.get(), &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -199,9 +199,10 @@ public:
     }
 
     static void registerHB(kvstore::KVStore* kv, const std::vector<HostAddr>& hosts) {
+        ActiveHostsMan activeHostsMan(kv);
         auto now = time::WallClock::fastNowInMilliSec();
         for (auto& h : hosts) {
-            auto ret = ActiveHostsMan::updateHostInfo(kv, h, HostInfo(now));
+            auto ret = activeHostsMan.updateHostInfo(h, HostInfo(now));
             CHECK_EQ(ret, kvstore::ResultCode::SUCCEEDED);
         }
      }
@@ -220,7 +221,8 @@ public:
         registerHB(kv, hosts);
         {
             cpp2::ListHostsReq req;
-            auto* processor = ListHostsProcessor::instance(kv);
+            ActiveHostsMan activeHostsMan(kv);
+            auto* processor = ListHostsProcessor::instance(kv, &activeHostsMan);
             auto f = processor->getFuture();
             processor->process(req);
             auto resp = std::move(f).get();
@@ -361,7 +363,9 @@ public:
         user.set_max_connections_per_hour(maxConnections);
         user.set_max_user_connections(maxConnectors);
         req.set_user(std::move(user));
-        auto* processor = CreateUserProcessor::instance(kv);
+        // Continues after the ids reserved by the other allocators of the kvstore
+        IdAllocator idAllocator(kv);
+        auto* processor = CreateUserProcessor::instance(kv, &idAllocator);
         auto f = processor->getFuture();
         processor->process(req);
         auto resp = std::move(f).get();
@@ -48,6 +48,15 @@ std::string SpaceOptItem::toString() const {
             return folly::stringPrintf("partition_num = %ld", boost::get<int64_t>(optValue_));
         case REPLICA_FACTOR:
             return folly::stringPrintf("replica_factor = %ld", boost::get<int64_t>(optValue_));
+        case SINGLE_VERSION:
+            return folly::stringPrintf("single_version = %s",
+                                       boost::get<bool>(optValue_) ? "true" : "false");
+        case PARTITION_STRATEGY:
+            return folly::stringPrintf("partition_strategy = \"%s\"",
+                                       boost::get<std::string>(optValue_).c_str());
+        case RANGE_BOUNDS:
+            return folly::stringPrintf("range_bounds = \"%s\"",
+                                       boost::get<std::string>(optValue_).c_str());
         default:
              FLOG_FATAL("Space parameter illegal");
     }
@@ -69,10 +69,10 @@ inline std::ostream& operator<<(std::ostream &os, ShowSentence::ShowType type) {
 
 class SpaceOptItem final {
 public:
-    using Value = boost::variant<int64_t, std::string>;
+    using Value = boost::variant<int64_t, std::string, bool>;
 
     enum OptionType : uint8_t {
-        PARTITION_NUM, REPLICA_FACTOR
+        PARTITION_NUM, REPLICA_FACTOR, SINGLE_VERSION, PARTITION_STRATEGY, RANGE_BOUNDS
     };
 
     SpaceOptItem(OptionType op, std::string val) {
@@ -85,6 +85,11 @@ public:
         optValue_ = val;
     }
 
+    SpaceOptItem(OptionType op, bool val) {
+        optType_ = op;
+        optValue_ = val;
+    }
+
     int64_t asInt() {
         return boost::get<int64_t>(optValue_);
     }
@@ -101,6 +106,10 @@ public:
         return optValue_.which() == 1;
     }
 
+    bool isBool() {
+        return optValue_.which() == 2;
+    }
+
     int64_t get_partition_num() {
         if (isInt()) {
             return asInt();
@@ -119,6 +128,34 @@ public:
         }
     }
 
+    bool get_single_version() {
+        if (isBool()) {
+            return boost::get<bool>(optValue_);
+        } else {
+            LOG(ERROR) << "single_version value illegal.";
+            return false;
+        }
+    }
+
+    std::string get_partition_strategy() {
+        if (isString()) {
+            return asString();
+        } else {
+            LOG(ERROR) << "partition_strategy value illegal.";
+            return "";
+        }
+    }
+
+    // The bounds are separated by comma, e.g. "1000,2000,3000"
+    std::string get_range_bounds() {
+        if (isString()) {
+            return asString();
+        } else {
+            LOG(ERROR) << "range_bounds value illegal.";
+            return "";
+        }
+    }
+
     OptionType getOptType() {
         return optType_;
     }
@@ -15,7 +15,7 @@ namespace nebula {
 
 class GQLParser {
 public:
-    GQLParser() : parser_(scanner_, error_, &sentences_) {
+    GQLParser() : parser_(scanner_, error_, &sentences_, &params_) {
         // Callback invoked by GraphScanner
         auto readBuffer = [this] (char *buf, int maxSize) -> int {
             // Reach the end
@@ -55,14 +55,18 @@ public:
                 delete sentences_;
                 sentences_ = nullptr;
             }
+            params_.clear();
             return Status::SyntaxError(error_);
         }
 
         if (sentences_ == nullptr) {
+            params_.clear();
             return Status::StatementEmpty();
         }
         auto *sentences = sentences_;
         sentences_ = nullptr;
+        sentences->setParameters(std::move(params_));
+        params_.clear();
         return sentences;
     }
 
@@ -74,6 +78,7 @@ private:
     nebula::GraphParser             parser_;
     std::string                     error_;
     SequentialSentences            *sentences_ = nullptr;
+    std::vector<PrimaryExpression*> params_;
 };
 
 }   // namespace nebula
@@ -12,6 +12,11 @@ namespace nebula {
 std::string SequentialSentences::toString() const {
     std::string buf;
     buf.reserve(1024);
+    if (mode_ == Mode::kExplain) {
+        buf += "EXPLAIN ";
+    } else if (mode_ == Mode::kProfile) {
+        buf += "PROFILE ";
+    }
     auto i = 0UL;
     buf += sentences_[i++]->toString();
     for ( ; i < sentences_.size(); i++) {
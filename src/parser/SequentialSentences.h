@@ -22,6 +22,14 @@ class SequentialExecutor;
 
 class SequentialSentences final {
 public:
+    enum class Mode : uint8_t {
+        kNormal,
+        // Show the executors without executing them
+        kExplain,
+        // Execute and show the statistics of each executor instead of the results
+        kProfile,
+    };
+
     explicit SequentialSentences(Sentence *sentence) {
         sentences_.emplace_back(sentence);
     }
@@ -40,9 +48,32 @@ public:
 
     std::string toString() const;
 
+    /**
+     * The placeholders `?' of prepared statements in order of appearance,
+     * their values are bound before each execution.
+     */
+    void setParameters(std::vector<PrimaryExpression*> params) {
+        params_ = std::move(params);
+    }
+
+    const std::vector<PrimaryExpression*>& parameters() const {
+        return params_;
+    }
+
+    void setMode(Mode mode) {
+        mode_ = mode;
+    }
+
+    Mode mode() const {
+        return mode_;
+    }
+
 private:
     friend class nebula::graph::SequentialExecutor;
     std::vector<std::unique_ptr<Sentence>>      sentences_;
+    // Owned by the sentences
+    std::vector<PrimaryExpression*>             params_;
+    Mode                                        mode_{Mode::kNormal};
 };
 
 
@@ -8,6 +8,7 @@
 %parse-param { nebula::GraphScanner& scanner }
 %parse-param { std::string &errmsg }
 %parse-param { nebula::SequentialSentences** sentences }
+%parse-param { std::vector<nebula::PrimaryExpression*>* params }
 
 %code requires {
 #include <iostream>
@@ -100,7 +101,8 @@ class GraphScanner;
 %token KW_EDGE KW_EDGES KW_STEPS KW_OVER KW_UPTO KW_REVERSELY KW_SPACE KW_DELETE KW_FIND
 %token KW_INT KW_BIGINT KW_DOUBLE KW_STRING KW_BOOL KW_TAG KW_TAGS KW_UNION KW_INTERSECT KW_MINUS
 %token KW_NO KW_OVERWRITE KW_IN KW_DESCRIBE KW_DESC KW_SHOW KW_HOSTS KW_PARTS KW_TIMESTAMP KW_ADD
-%token KW_PARTITION_NUM KW_REPLICA_FACTOR KW_DROP KW_REMOVE KW_SPACES KW_INGEST KW_UUID
+%token KW_PARTITION_NUM KW_REPLICA_FACTOR KW_SINGLE_VERSION KW_PARTITION_STRATEGY KW_RANGE_BOUNDS
+%token KW_DROP KW_REMOVE KW_SPACES KW_INGEST KW_UUID
 %token KW_IF KW_NOT KW_EXISTS KW_WITH KW_FIRSTNAME KW_LASTNAME KW_EMAIL KW_PHONE KW_USER KW_USERS
 %token KW_PASSWORD KW_CHANGE KW_ROLE KW_GOD KW_ADMIN KW_GUEST KW_GRANT KW_REVOKE KW_ON
 %token KW_ROLES KW_BY KW_DOWNLOAD KW_HDFS
@@ -114,11 +116,12 @@ class GraphScanner;
 %token KW_SHORTEST KW_PATH
 %token KW_IS KW_NULL
 %token KW_SNAPSHOT KW_SNAPSHOTS
+%token KW_EXPLAIN KW_PROFILE
 
 /* symbols */
 %token L_PAREN R_PAREN L_BRACKET R_BRACKET L_BRACE R_BRACE COMMA
 %token PIPE OR AND XOR LT LE GT GE EQ NE PLUS MINUS MUL DIV MOD NOT NEG ASSIGN
-%token DOT COLON SEMICOLON L_ARROW R_ARROW AT
+%token DOT COLON SEMICOLON L_ARROW R_ARROW AT QM
 %token ID_PROP TYPE_PROP SRC_ID_PROP DST_ID_PROP RANK_PROP INPUT_REF DST_REF SRC_REF
 
 /* token type specification */
@@ -221,7 +224,7 @@ class GraphScanner;
 %type <boolval> opt_if_not_exists
 
 
-%start sentences
+%start query
 
 %%
 
@@ -257,6 +260,8 @@ unreserved_keyword
      | KW_BIT_AND            { $$ = new std::string("bit_and"); }
      | KW_BIT_OR             { $$ = new std::string("bit_or"); }
      | KW_BIT_XOR            { $$ = new std::string("bit_xor"); }
+     | KW_EXPLAIN            { $$ = new std::string("explain"); }
+     | KW_PROFILE            { $$ = new std::string("profile"); }
      ;
 
 agg_function
@@ -311,6 +316,12 @@ primary_expression
     | function_call_expression {
         $$ = $1;
     }
+    | QM {
+        // The placeholder of prepared statements
+        auto *param = new PrimaryExpression();
+        params->emplace_back(param);
+        $$ = param;
+    }
     ;
 
 input_ref_expression
@@ -576,6 +587,11 @@ vid
     | uuid_expression {
         $$ = $1;
     }
+    | QM {
+        auto *param = new PrimaryExpression();
+        params->emplace_back(param);
+        $$ = param;
+    }
     ;
 
 unary_integer
@@ -1551,6 +1567,17 @@ space_opt_item
     | KW_REPLICA_FACTOR ASSIGN INTEGER {
         $$ = new SpaceOptItem(SpaceOptItem::REPLICA_FACTOR, $3);
     }
+    | KW_SINGLE_VERSION ASSIGN BOOL {
+        $$ = new SpaceOptItem(SpaceOptItem::SINGLE_VERSION, $3);
+    }
+    | KW_PARTITION_STRATEGY ASSIGN STRING {
+        $$ = new SpaceOptItem(SpaceOptItem::PARTITION_STRATEGY, *$3);
+        delete $3;
+    }
+    | KW_RANGE_BOUNDS ASSIGN STRING {
+        $$ = new SpaceOptItem(SpaceOptItem::RANGE_BOUNDS, *$3);
+        delete $3;
+    }
     // TODO(YT) Create Spaces for different engines
     // KW_ENGINE_TYPE ASSIGN name_label
     ;
@@ -1823,6 +1850,21 @@ sentences
     }
     ;
 
+query
+    : sentences {
+    }
+    | KW_EXPLAIN sentences {
+        if ($2 != nullptr) {
+            $2->setMode(SequentialSentences::Mode::kExplain);
+        }
+    }
+    | KW_PROFILE sentences {
+        if ($2 != nullptr) {
+            $2->setMode(SequentialSentences::Mode::kProfile);
+        }
+    }
+    ;
+
 
 %%
 
@@ -116,6 +116,26 @@ TEST(Parser, SpaceOperation) {
         auto result = parser.parse(query);
         ASSERT_TRUE(result.ok()) << result.status();
     }
+    {
+        GQLParser parser;
+        std::string query = "CREATE SPACE default_space(partition_num=9, replica_factor=3, "
+                            "single_version=true)";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "CREATE SPACE default_space(single_version=1)";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        GQLParser parser;
+        std::string query = "CREATE SPACE default_space(partition_num=3, "
+                            "partition_strategy=\"range\", range_bounds=\"100,200\")";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
     {
         GQLParser parser;
         std::string query = "USE default_space";
@@ -1524,4 +1544,68 @@ TEST(Parser, Return) {
         ASSERT_TRUE(result.ok()) << result.status();
     }
 }
+
+TEST(Parser, Parameters) {
+    {
+        GQLParser parser;
+        std::string query = "GO FROM ? OVER like WHERE like.likeness > ? "
+                            "YIELD like._dst, ? + 1";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        auto sentences = std::move(result).value();
+        ASSERT_EQ(3, sentences->parameters().size());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_TRUE(result.value()->parameters().empty());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER ?";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
+}
+
+TEST(Parser, ExplainAndProfile) {
+    {
+        GQLParser parser;
+        std::string query = "EXPLAIN GO FROM 1 OVER like; YIELD 1";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        auto sentences = std::move(result).value();
+        ASSERT_EQ(SequentialSentences::Mode::kExplain, sentences->mode());
+        ASSERT_EQ(2, sentences->sentences().size());
+    }
+    {
+        GQLParser parser;
+        std::string query = "PROFILE GO FROM 1 OVER like | YIELD $-.id";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(SequentialSentences::Mode::kProfile, result.value()->mode());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(SequentialSentences::Mode::kNormal, result.value()->mode());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like; PROFILE GO FROM 1 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        // Still available as names
+        GQLParser parser;
+        std::string query = "CREATE TAG profile(explain string)";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+}
 }   // namespace nebula
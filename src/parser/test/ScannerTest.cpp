@@ -262,6 +262,13 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("REPLICA_FACTOR", TokenType::KW_REPLICA_FACTOR),
         CHECK_SEMANTIC_TYPE("replica_factor", TokenType::KW_REPLICA_FACTOR),
         CHECK_SEMANTIC_TYPE("Replica_factor", TokenType::KW_REPLICA_FACTOR),
+        CHECK_SEMANTIC_TYPE("SINGLE_VERSION", TokenType::KW_SINGLE_VERSION),
+        CHECK_SEMANTIC_TYPE("single_version", TokenType::KW_SINGLE_VERSION),
+        CHECK_SEMANTIC_TYPE("Single_version", TokenType::KW_SINGLE_VERSION),
+        CHECK_SEMANTIC_TYPE("PARTITION_STRATEGY", TokenType::KW_PARTITION_STRATEGY),
+        CHECK_SEMANTIC_TYPE("partition_strategy", TokenType::KW_PARTITION_STRATEGY),
+        CHECK_SEMANTIC_TYPE("RANGE_BOUNDS", TokenType::KW_RANGE_BOUNDS),
+        CHECK_SEMANTIC_TYPE("range_bounds", TokenType::KW_RANGE_BOUNDS),
         CHECK_SEMANTIC_TYPE("DROP", TokenType::KW_DROP),
         CHECK_SEMANTIC_TYPE("drop", TokenType::KW_DROP),
         CHECK_SEMANTIC_TYPE("Drop", TokenType::KW_DROP),
@@ -406,6 +413,12 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("SNAPSHOTS", TokenType::KW_SNAPSHOTS),
         CHECK_SEMANTIC_TYPE("Snapshots", TokenType::KW_SNAPSHOTS),
         CHECK_SEMANTIC_TYPE("snapshots", TokenType::KW_SNAPSHOTS),
+        CHECK_SEMANTIC_TYPE("EXPLAIN", TokenType::KW_EXPLAIN),
+        CHECK_SEMANTIC_TYPE("Explain", TokenType::KW_EXPLAIN),
+        CHECK_SEMANTIC_TYPE("explain", TokenType::KW_EXPLAIN),
+        CHECK_SEMANTIC_TYPE("PROFILE", TokenType::KW_PROFILE),
+        CHECK_SEMANTIC_TYPE("Profile", TokenType::KW_PROFILE),
+        CHECK_SEMANTIC_TYPE("profile", TokenType::KW_PROFILE),
 
         CHECK_SEMANTIC_TYPE("_type", TokenType::TYPE_PROP),
         CHECK_SEMANTIC_TYPE("_id", TokenType::ID_PROP),
@@ -35,7 +35,8 @@ public:
                            stats::Stats* stats = nullptr)
             : kvstore_(kvstore)
             , schemaMan_(schemaMan)
-            , stats_(stats) {}
+            , stats_(stats)
+            , keyFormat_(kvstore != nullptr ? kvstore->keyFormat() : NebulaKeyFormat::kNative) {}
 
     virtual ~BaseProcessor() = default;
 
@@ -73,6 +74,11 @@ protected:
 
     cpp2::ErrorCode to(kvstore::ResultCode code);
 
+    // Keys of the single version space have no version suffix
+    bool isSingleVersion(GraphSpaceID spaceId) const {
+        return schemaMan_ != nullptr && schemaMan_->isSingleVersion(spaceId);
+    }
+
     void pushResultCode(cpp2::ErrorCode code, PartitionID partId) {
         if (code != cpp2::ErrorCode::SUCCEEDED) {
             cpp2::ResultCode thriftRet;
@@ -128,6 +134,8 @@ protected:
     kvstore::KVStore*                               kvstore_ = nullptr;
     meta::SchemaManager*                            schemaMan_ = nullptr;
     stats::Stats*                                   stats_ = nullptr;
+    // The vertex and edge keys are generated in the format of the kvstore
+    NebulaKeyFormat                                 keyFormat_;
     RESP                                            resp_;
     folly::Promise<RESP>                            promise_;
     cpp2::ResponseCommon                            result_;
@@ -18,8 +18,9 @@ namespace storage {
 
 class StorageCompactionFilter final : public kvstore::KVFilter {
 public:
-    explicit StorageCompactionFilter(meta::SchemaManager* schemaMan)
-        : schemaMan_(schemaMan) {
+    StorageCompactionFilter(meta::SchemaManager* schemaMan, NebulaKeyFormat keyFormat)
+        : schemaMan_(schemaMan)
+        , keyFormat_(keyFormat) {
         CHECK_NOTNULL(schemaMan_);
     }
 
@@ -39,7 +40,8 @@ public:
                 VLOG(3) << "TTL invalid for key " << key;
                 return true;
             }
-            if (filterVersions(key)) {
+            // Decide by the key itself, the space may be missing from the meta cache
+            if (NebulaKeyUtils::hasVersion(key, keyFormat_) && filterVersions(key)) {
                 VLOG(3) << "Extra versions has been filtered!";
                 return true;
             }
@@ -55,15 +57,15 @@ public:
     }
 
     bool schemaValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
-        if (NebulaKeyUtils::isVertex(key)) {
-            auto tagId = NebulaKeyUtils::getTagId(key);
+        if (NebulaKeyUtils::isVertex(key, keyFormat_)) {
+            auto tagId = NebulaKeyUtils::getTagId(key, keyFormat_);
             auto ret = schemaMan_->getNewestTagSchemaVer(spaceId, tagId);
             if (ret.ok() && ret.value() == -1) {
                 VLOG(3) << "Space " << spaceId << ", Tag " << tagId << " invalid";
                 return false;
             }
-        } else if (NebulaKeyUtils::isEdge(key)) {
-            auto edgeType = NebulaKeyUtils::getEdgeType(key);
+        } else if (NebulaKeyUtils::isEdge(key, keyFormat_)) {
+            auto edgeType = NebulaKeyUtils::getEdgeType(key, keyFormat_);
             if (edgeType < 0) {
                 edgeType = -edgeType;
             }
@@ -98,18 +100,21 @@ public:
 private:
     mutable std::string lastKeyWithNoVerison_;
     meta::SchemaManager* schemaMan_ = nullptr;
+    NebulaKeyFormat keyFormat_;
 };
 
 class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterFactory {
 public:
     StorageCompactionFilterFactory(meta::SchemaManager* schemaMan,
+                                   NebulaKeyFormat keyFormat,
                                    GraphSpaceID spaceId,
                                    int32_t customFilterIntervalSecs):
         KVCompactionFilterFactory(spaceId, customFilterIntervalSecs),
-        schemaMan_(schemaMan) {}
+        schemaMan_(schemaMan),
+        keyFormat_(keyFormat) {}
 
     std::unique_ptr<kvstore::KVFilter> createKVFilter() override {
-        return std::make_unique<StorageCompactionFilter>(schemaMan_);
+        return std::make_unique<StorageCompactionFilter>(schemaMan_, keyFormat_);
     }
 
     const char* Name() const override {
@@ -118,24 +123,30 @@ public:
 
 private:
     meta::SchemaManager* schemaMan_ = nullptr;
+    NebulaKeyFormat keyFormat_;
 };
 
 class StorageCompactionFilterFactoryBuilder : public kvstore::CompactionFilterFactoryBuilder {
 public:
-    explicit StorageCompactionFilterFactoryBuilder(meta::SchemaManager* schemaMan)
-        : schemaMan_(schemaMan) {}
+    explicit StorageCompactionFilterFactoryBuilder(
+            meta::SchemaManager* schemaMan,
+            NebulaKeyFormat keyFormat = NebulaKeyFormat::kNative)
+        : schemaMan_(schemaMan)
+        , keyFormat_(keyFormat) {}
 
     virtual ~StorageCompactionFilterFactoryBuilder() = default;
 
     std::shared_ptr<kvstore::KVCompactionFilterFactory>
     buildCfFactory(GraphSpaceID spaceId, int32_t customFilterIntervalSecs) override {
         return std::make_shared<StorageCompactionFilterFactory>(schemaMan_,
+                                                                keyFormat_,
                                                                 spaceId,
                                                                 customFilterIntervalSecs);
     }
 
 private:
     meta::SchemaManager* schemaMan_ = nullptr;
+    NebulaKeyFormat keyFormat_;
 };
 
 
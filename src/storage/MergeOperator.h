@@ -9,12 +9,176 @@
 
 #include "base/Base.h"
 #include <rocksdb/merge_operator.h>
+#include "base/NebulaKeyUtils.h"
+#include "dataman/RowReader.h"
+#include "dataman/RowUpdater.h"
+#include "meta/SchemaManager.h"
 
 namespace nebula {
 namespace storage {
 
+enum class MergeOpType : uint8_t {
+    SET   = 0x01,
+    ADD   = 0x02,
+    MAX   = 0x03,
+    MIN   = 0x04,
+};
+
+struct MergeItem {
+    MergeOpType     type;
+    std::string     prop;
+    VariantType     value;
+};
+
+/**
+ * The operand of NebulaOperator, a list of field updates which will be applied
+ * in order to a RowWriter-encoded row.
+ *
+ * spaceId | number of items (uint32_t) | items...
+ * item:  op type (1 byte) | prop length (uint32_t) | prop | value type (1 byte) | value
+ * */
+class MergeOperand final {
+public:
+    static std::string encode(GraphSpaceID spaceId, const std::vector<MergeItem>& items) {
+        std::string encoded;
+        encoded.reserve(sizeof(GraphSpaceID) + sizeof(uint32_t) + items.size() * 32);
+        encoded.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+        uint32_t num = items.size();
+        encoded.append(reinterpret_cast<const char*>(&num), sizeof(uint32_t));
+        for (auto& item : items) {
+            encoded.append(reinterpret_cast<const char*>(&item.type), sizeof(MergeOpType));
+            appendString(encoded, item.prop);
+            char vType = static_cast<char>(item.value.which());
+            encoded.append(&vType, 1);
+            switch (item.value.which()) {
+                case VAR_INT64: {
+                    auto v = boost::get<int64_t>(item.value);
+                    encoded.append(reinterpret_cast<const char*>(&v), sizeof(int64_t));
+                    break;
+                }
+                case VAR_DOUBLE: {
+                    auto v = boost::get<double>(item.value);
+                    encoded.append(reinterpret_cast<const char*>(&v), sizeof(double));
+                    break;
+                }
+                case VAR_BOOL: {
+                    char v = boost::get<bool>(item.value) ? 1 : 0;
+                    encoded.append(&v, 1);
+                    break;
+                }
+                case VAR_STR: {
+                    appendString(encoded, boost::get<std::string>(item.value));
+                    break;
+                }
+            }
+        }
+        return encoded;
+    }
+
+    // Return false if the operand is malformed
+    static bool decode(folly::StringPiece operand,
+                       GraphSpaceID& spaceId,
+                       std::vector<MergeItem>& items) {
+        const char* p = operand.begin();
+        const char* end = operand.end();
+        if (!read(p, end, spaceId)) {
+            return false;
+        }
+        uint32_t num = 0;
+        if (!read(p, end, num)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            MergeItem item;
+            char vType = 0;
+            if (!read(p, end, item.type) || !readString(p, end, item.prop) || !read(p, end, vType)) {
+                return false;
+            }
+            switch (vType) {
+                case VAR_INT64: {
+                    int64_t v = 0;
+                    if (!read(p, end, v)) {
+                        return false;
+                    }
+                    item.value = v;
+                    break;
+                }
+                case VAR_DOUBLE: {
+                    double v = 0.0;
+                    if (!read(p, end, v)) {
+                        return false;
+                    }
+                    item.value = v;
+                    break;
+                }
+                case VAR_BOOL: {
+                    char v = 0;
+                    if (!read(p, end, v)) {
+                        return false;
+                    }
+                    item.value = (v != 0);
+                    break;
+                }
+                case VAR_STR: {
+                    std::string v;
+                    if (!readString(p, end, v)) {
+                        return false;
+                    }
+                    item.value = std::move(v);
+                    break;
+                }
+                default:
+                    return false;
+            }
+            items.emplace_back(std::move(item));
+        }
+        return p == end;
+    }
+
+private:
+    static void appendString(std::string& encoded, const std::string& str) {
+        uint32_t len = str.size();
+        encoded.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
+        encoded.append(str.data(), len);
+    }
+
+    template<typename T>
+    static bool read(const char*& p, const char* end, T& v) {
+        if (p + sizeof(T) > end) {
+            return false;
+        }
+        memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    static bool readString(const char*& p, const char* end, std::string& str) {
+        uint32_t len = 0;
+        if (!read(p, end, len) || p + len > end) {
+            return false;
+        }
+        str.assign(p, len);
+        p += len;
+        return true;
+    }
+};
+
+
+/**
+ * Merge operator for the data keys, which applies the MergeOperand on the row
+ * without a read-modify-write from the processors. If the key does not exist,
+ * the operand will be applied on an empty row encoded with the newest schema.
+ * The processors only write the operands which could be applied without conversion.
+ * */
 class NebulaOperator : public rocksdb::MergeOperator {
 public:
+    explicit NebulaOperator(meta::SchemaManager* schemaMan,
+                            NebulaKeyFormat keyFormat = NebulaKeyFormat::kNative)
+        : schemaMan_(schemaMan)
+        , keyFormat_(keyFormat) {
+        CHECK_NOTNULL(schemaMan_);
+    }
+
     const char* Name() const override {
         return "NebulaMergeOperator";
     }
@@ -22,27 +186,156 @@ public:
 private:
     bool FullMergeV2(const MergeOperationInput& merge_in,
                      MergeOperationOutput* merge_out) const override {
-        UNUSED(merge_in);
-        UNUSED(merge_out);
-        LOG(ERROR) << "NebulaMergeOperator not supported yet";
-        return false;
+        GraphSpaceID spaceId = -1;
+        std::vector<MergeItem> items;
+        for (auto& operand : merge_in.operand_list) {
+            if (!MergeOperand::decode(folly::StringPiece(operand.data(), operand.size()),
+                                      spaceId,
+                                      items)) {
+                LOG(ERROR) << "Malformed merge operand";
+                return false;
+            }
+        }
+
+        auto key = folly::StringPiece(merge_in.key.data(), merge_in.key.size());
+        folly::StringPiece row;
+        if (merge_in.existing_value != nullptr) {
+            row = folly::StringPiece(merge_in.existing_value->data(),
+                                     merge_in.existing_value->size());
+        }
+        auto updater = getUpdater(spaceId, key, row);
+        if (updater == nullptr) {
+            // The operands can't be dropped silently, fail the merge so they are kept
+            LOG(ERROR) << "Can't find the schema for key " << folly::hexlify(key)
+                       << " in space " << spaceId;
+            return false;
+        }
+        for (auto& item : items) {
+            if (!apply(updater.get(), item)) {
+                // Skip the bad item, so the other ones could still be applied
+                LOG(ERROR) << "Failed to merge prop " << item.prop
+                           << " of key " << folly::hexlify(key);
+            }
+        }
+        updater->encodeTo(merge_out->new_value);
+        return true;
     }
 
     bool PartialMerge(const rocksdb::Slice& key, const rocksdb::Slice& left_operand,
                       const rocksdb::Slice& right_operand, std::string* new_value,
                       rocksdb::Logger* logger) const override {
         UNUSED(key);
-        UNUSED(left_operand);
-        UNUSED(right_operand);
-        UNUSED(new_value);
         UNUSED(logger);
-        LOG(ERROR) << "NebulaMergeOperator not supported yet";
+        // The items are applied in order, so the operands could just be concatenated
+        GraphSpaceID spaceId = -1;
+        std::vector<MergeItem> items;
+        if (!MergeOperand::decode(folly::StringPiece(left_operand.data(), left_operand.size()),
+                                  spaceId,
+                                  items)
+                || !MergeOperand::decode(folly::StringPiece(right_operand.data(),
+                                                            right_operand.size()),
+                                         spaceId,
+                                         items)) {
+            return false;
+        }
+        *new_value = MergeOperand::encode(spaceId, items);
+        return true;
+    }
+
+    std::unique_ptr<RowUpdater> getUpdater(GraphSpaceID spaceId,
+                                           folly::StringPiece key,
+                                           folly::StringPiece row) const {
+        std::unique_ptr<RowReader> reader;
+        std::shared_ptr<const meta::SchemaProviderIf> schema;
+        if (NebulaKeyUtils::isVertex(key, keyFormat_)) {
+            auto tagId = NebulaKeyUtils::getTagId(key, keyFormat_);
+            if (!row.empty()) {
+                reader = RowReader::getTagPropReader(schemaMan_, row, spaceId, tagId);
+            } else {
+                schema = schemaMan_->getTagSchema(spaceId, tagId);
+            }
+        } else if (NebulaKeyUtils::isEdge(key, keyFormat_)) {
+            auto edgeType = NebulaKeyUtils::getEdgeType(key, keyFormat_);
+            if (!row.empty()) {
+                reader = RowReader::getEdgePropReader(schemaMan_, row, spaceId, edgeType);
+            } else {
+                schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
+            }
+        }
+        if (reader != nullptr) {
+            schema = reader->getSchema();
+        }
+        if (schema == nullptr) {
+            return nullptr;
+        }
+        auto writerSchema = std::const_pointer_cast<meta::SchemaProviderIf>(schema);
+        if (reader != nullptr) {
+            return std::make_unique<RowUpdater>(std::move(reader), std::move(writerSchema));
+        }
+        return std::make_unique<RowUpdater>(std::move(writerSchema));
+    }
+
+    static bool apply(RowUpdater* updater, const MergeItem& item) {
+        const auto& prop = item.prop;
+        if (item.type == MergeOpType::SET) {
+            switch (item.value.which()) {
+                case VAR_INT64:
+                    return updater->setInt(prop, boost::get<int64_t>(item.value))
+                        == ResultType::SUCCEEDED;
+                case VAR_DOUBLE:
+                    return updater->setDouble(prop, boost::get<double>(item.value))
+                        == ResultType::SUCCEEDED;
+                case VAR_BOOL:
+                    return updater->setBool(prop, boost::get<bool>(item.value))
+                        == ResultType::SUCCEEDED;
+                case VAR_STR:
+                    return updater->setString(prop, boost::get<std::string>(item.value))
+                        == ResultType::SUCCEEDED;
+            }
+            return false;
+        }
+
+        if (item.value.which() == VAR_INT64) {
+            int64_t curr = 0;
+            if (updater->getInt(prop, curr) != ResultType::SUCCEEDED) {
+                // Not set yet, start from the default value
+                curr = 0;
+            }
+            return updater->setInt(prop, calculate(item.type, curr,
+                                                   boost::get<int64_t>(item.value)))
+                == ResultType::SUCCEEDED;
+        } else if (item.value.which() == VAR_DOUBLE) {
+            double curr = 0.0;
+            if (updater->getDouble(prop, curr) != ResultType::SUCCEEDED) {
+                curr = 0.0;
+            }
+            return updater->setDouble(prop, calculate(item.type, curr,
+                                                      boost::get<double>(item.value)))
+                == ResultType::SUCCEEDED;
+        }
         return false;
     }
+
+    template<typename T>
+    static T calculate(MergeOpType type, T curr, T operand) {
+        switch (type) {
+            case MergeOpType::ADD:
+                return curr + operand;
+            case MergeOpType::MAX:
+                return std::max(curr, operand);
+            case MergeOpType::MIN:
+                return std::min(curr, operand);
+            default:
+                return operand;
+        }
+    }
+
+private:
+    meta::SchemaManager* schemaMan_ = nullptr;
+    NebulaKeyFormat      keyFormat_;
 };
 
 
 }  // namespace storage
 }  // namespace nebula
 #endif  // KVSTORE_MERGEOPERATOR_H_
-
@@ -15,6 +15,7 @@
 #include "kvstore/PartManager.h"
 #include "webservice/WebService.h"
 #include "storage/CompactionFilter.h"
+#include "storage/MergeOperator.h"
 #include "hdfs/HdfsCommandHelper.h"
 #include "thread/GenericThreadPool.h"
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
@@ -25,6 +26,11 @@ DEFINE_bool(reuse_port, true, "Whether to turn on the SO_REUSEPORT option");
 DEFINE_int32(num_io_threads, 16, "Number of IO threads");
 DEFINE_int32(num_worker_threads, 32, "Number of workers");
 DEFINE_int32(storage_http_thread_num, 3, "Number of storage daemon's http thread");
+DEFINE_int32(key_format_version, 1,
+             "The format of vertex and edge keys, 1 for native integers, "
+             "2 for big-endian integers ordered by id. Switching an existing "
+             "data path needs the offline key_format_upgrader");
+DECLARE_int32(rpc_compression_min_bytes);
 
 namespace nebula {
 namespace storage {
@@ -35,7 +41,10 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
     options.partMan_ = std::make_unique<kvstore::MetaServerBasedPartManager>(
                                                 localHost_,
                                                 metaClient_.get());
-    options.cffBuilder_ = std::make_unique<StorageCompactionFilterFactoryBuilder>(schemaMan_.get());
+    options.keyFormat_ = static_cast<NebulaKeyFormat>(FLAGS_key_format_version);
+    options.cffBuilder_ = std::make_unique<StorageCompactionFilterFactoryBuilder>(
+        schemaMan_.get(), options.keyFormat_);
+    options.mergeOp_ = std::make_shared<NebulaOperator>(schemaMan_.get(), options.keyFormat_);
     if (FLAGS_store_type == "nebula") {
         auto nbStore = std::make_unique<kvstore::NebulaStore>(std::move(options),
                                                               ioThreadPool_,
@@ -135,6 +144,7 @@ bool StorageServer::start() {
         tfServer_->setThreadManager(workers_);
         tfServer_->setInterface(std::move(handler));
         tfServer_->setStopWorkersOnStopListening(false);
+        tfServer_->setMinCompressBytes(FLAGS_rpc_compression_min_bytes);
         tfServer_->serve();  // Will wait until the server shuts down
     } catch (const std::exception& e) {
         LOG(ERROR) << "Start thrift server failed, error:" << e.what();
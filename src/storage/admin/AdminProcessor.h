@@ -12,6 +12,7 @@
 #include "kvstore/Part.h"
 #include "storage/StorageFlags.h"
 #include "storage/BaseProcessor.h"
+#include "time/WallClock.h"
 #include <folly/executors/Async.h>
 
 namespace nebula {
@@ -255,11 +256,16 @@ public:
                                                                req.get_target().get_port()));
 
         folly::async([this, part, peer, spaceId, partId] {
-            int retry = FLAGS_waiting_catch_up_retry_times;
-            while (retry-- > 0) {
+            // Poll with a growing interval, so that the small parts are done quickly,
+            // while the overall timeout is still retry times * interval.
+            int64_t maxIntervalMs = FLAGS_waiting_catch_up_interval_in_secs * 1000L;
+            auto deadline = time::WallClock::fastNowInMilliSec()
+                          + FLAGS_waiting_catch_up_retry_times * maxIntervalMs;
+            int64_t intervalMs = std::min(100L, maxIntervalMs);
+            while (true) {
                 auto res = part->isCatchedUp(peer);
                 LOG(INFO) << "Waiting for catching up data, peer " << peer
-                          << ", remaining " << retry << " retry times"
+                          << ", next check in " << intervalMs << "ms"
                           << ", result " << static_cast<int32_t>(res);
                 switch (res) {
                     case raftex::AppendLogResult::SUCCEEDED:
@@ -281,7 +287,12 @@ public:
                         LOG(INFO) << "Unknown error " << static_cast<int32_t>(res);
                         break;
                 }
-                sleep(FLAGS_waiting_catch_up_interval_in_secs);
+                auto now = time::WallClock::fastNowInMilliSec();
+                if (now >= deadline) {
+                    break;
+                }
+                usleep(std::min(intervalMs, deadline - now) * 1000);
+                intervalMs = std::min(intervalMs * 2, maxIntervalMs);
             }
             this->pushResultCode(cpp2::ErrorCode::E_RETRY_EXHAUSTED, partId);
             onFinished();
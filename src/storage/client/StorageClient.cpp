@@ -6,12 +6,18 @@
 
 #include "base/Base.h"
 #include "storage/client/StorageClient.h"
-
-#define ID_HASH(id, numShards) \
-    ((static_cast<uint64_t>(id)) % numShards + 1)
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 
 
 DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
+DEFINE_bool(storage_client_hedge, false,
+            "Send a hedged getNeighbors request to the other replicas, "
+            "if a host doesn't respond in the p95 latency");
+DEFINE_int32(storage_client_hedge_min_delay_ms, 10,
+             "The min delay before sending a hedged request");
+DEFINE_int32(storage_client_handler_threads, 4,
+             "The threads handling the storage responses out of the IO threads, "
+             "0 to handle them in the IO threads");
 
 namespace nebula {
 namespace storage {
@@ -22,8 +28,33 @@ StorageClient::StorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> thread
         : ioThreadPool_(threadPool)
         , client_(client) {
     clientsMan_
-        = std::make_unique<thrift::ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>>();
+        = std::make_unique<thrift::ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>>(
+            "storage_client", true);
     stats_ = std::make_unique<stats::Stats>(serviceName, "storageClient");
+    if (FLAGS_storage_client_handler_threads > 0) {
+        handlerPool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+            FLAGS_storage_client_handler_threads,
+            std::make_shared<folly::NamedThreadFactory>("storage-client-handler"));
+    }
+    ioQueueStatId_ = stats::StatsManager::registerStats("storage_client_io_queue_us");
+    handlerQueueStatId_ = stats::StatsManager::registerStats("storage_client_handler_queue_us");
+    hedgesStatId_ = stats::StatsManager::registerStats("storage_client_hedges");
+    hedgeWinsStatId_ = stats::StatsManager::registerStats("storage_client_hedge_wins");
+}
+
+
+void LatencyTracker::add(int64_t latencyUs) {
+    std::lock_guard<std::mutex> g(lock_);
+    samples_[count_ % samples_.size()] = latencyUs;
+    count_++;
+    // Recalculate the p95 every 64 samples, once the window is full
+    if (count_ < samples_.size() || count_ % 64 != 0) {
+        return;
+    }
+    auto sorted = samples_;
+    auto nth = sorted.begin() + sorted.size() * 95 / 100;
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    p95_.store(*nth, std::memory_order_relaxed);
 }
 
 
@@ -35,6 +66,33 @@ StorageClient::~StorageClient() {
 }
 
 
+std::shared_ptr<std::atomic<int64_t>> StorageClient::inflightCounter(const HostAddr& host) {
+    {
+        folly::RWSpinLock::ReadHolder rh(inflightLock_);
+        auto it = inflight_.find(host);
+        if (it != inflight_.end()) {
+            return it->second;
+        }
+    }
+    folly::RWSpinLock::WriteHolder wh(inflightLock_);
+    auto& counter = inflight_[host];
+    if (counter == nullptr) {
+        counter = std::make_shared<std::atomic<int64_t>>(0);
+    }
+    return counter;
+}
+
+
+std::unordered_map<HostAddr, int64_t> StorageClient::inflightRequests() const {
+    std::unordered_map<HostAddr, int64_t> result;
+    folly::RWSpinLock::ReadHolder rh(inflightLock_);
+    for (auto& host : inflight_) {
+        result.emplace(host.first, host.second->load());
+    }
+    return result;
+}
+
+
 folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::addVertices(
         GraphSpaceID space,
         std::vector<cpp2::Vertex> vertices,
@@ -106,7 +164,8 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<cpp2::PropDef> returnCols,
-        folly::EventBase* evb) {
+        folly::EventBase* evb,
+        bool distinctDst) {
     auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
 
     if (!status.ok()) {
@@ -125,13 +184,17 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         req.set_edge_types(edgeTypes);
         req.set_filter(filter);
         req.set_return_columns(returnCols);
+        req.set_distinct_dst(distinctDst);
+        req.set_timeout_ms(FLAGS_storage_client_timeout_ms);
     }
 
     return collectResponse(
         evb, std::move(requests),
         [](cpp2::StorageServiceAsyncClient* client, const cpp2::GetNeighborsRequest& r) {
             return client->future_getBound(r);
-        });
+        },
+        true,
+        true);
 }
 
 
@@ -166,7 +229,9 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryStatsResponse>> StorageClient::n
         evb, std::move(requests),
         [](cpp2::StorageServiceAsyncClient* client, const cpp2::GetNeighborsRequest& r) {
             return client->future_boundStats(r);
-        });
+        },
+        false,
+        true);
 }
 
 
@@ -462,15 +527,11 @@ folly::Future<StatusOr<cpp2::GetUUIDResp>> StorageClient::getUUID(
 }
 
 StatusOr<PartitionID> StorageClient::partId(GraphSpaceID spaceId, int64_t id) const {
-    auto status = partsNum(spaceId);
+    auto status = partitioner(spaceId);
     if (!status.ok()) {
         return Status::Error("Space not found, spaceid: %d", spaceId);
     }
-
-    auto parts = status.value();
-    auto s = ID_HASH(id, parts);
-    CHECK_GE(s, 0U);
-    return s;
+    return status.value()->partId(id);
 }
 
 folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>>
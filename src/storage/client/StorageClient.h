@@ -12,10 +12,12 @@
 #include <gtest/gtest_prod.h>
 #include <folly/futures/Future.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "gen-cpp2/StorageServiceAsyncClient.h"
 #include "meta/client/MetaClient.h"
 #include "thrift/ThriftClientManager.h"
 #include "stats/Stats.h"
+#include "time/Duration.h"
 
 namespace nebula {
 namespace storage {
@@ -38,10 +40,21 @@ public:
         return maxLatency_;
     }
 
-    void setLatency(int32_t latency) {
+    // The latency reported by the host, and the one from sending the request to
+    // receiving the response
+    void setLatency(HostAddr host, int32_t latency, int32_t e2eLatency) {
         if (latency > maxLatency_) {
             maxLatency_ = latency;
         }
+        hostLatency_.emplace_back(host, latency, e2eLatency);
+    }
+
+    const std::vector<std::tuple<HostAddr, int32_t, int32_t>>& hostLatency() const {
+        return hostLatency_;
+    }
+
+    size_t totalReqsSent() const {
+        return totalReqsSent_;
     }
 
     void markFailure() {
@@ -51,6 +64,9 @@ public:
 
     // A value between [0, 100], representing a precentage
     int32_t completeness() const {
+        if (totalReqsSent_ == 0) {
+            return 100;
+        }
         return (totalReqsSent_ - failedReqs_) * 100 / totalReqsSent_;
     }
 
@@ -69,10 +85,33 @@ private:
     Result result_{Result::ALL_SUCCEEDED};
     std::unordered_map<PartitionID, storage::cpp2::ErrorCode> failedParts_;
     int32_t maxLatency_{0};
+    std::vector<std::tuple<HostAddr, int32_t, int32_t>> hostLatency_;
     std::vector<Response> responses_;
 };
 
 
+/**
+ * The recent latencies of the requests, to decide when to hedge them
+ */
+class LatencyTracker final {
+public:
+    explicit LatencyTracker(size_t window = 1024) : samples_(window, 0) {}
+
+    void add(int64_t latencyUs);
+
+    // The p95 of the recent latencies in us, 0 if there are not enough samples yet
+    int64_t p95() const {
+        return p95_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::mutex lock_;
+    std::vector<int64_t> samples_;
+    size_t count_{0};
+    std::atomic<int64_t> p95_{0};
+};
+
+
 /**
  * A wrapper class for storage thrift API
  *
@@ -80,6 +119,8 @@ private:
  */
 class StorageClient {
     FRIEND_TEST(StorageClientTest, LeaderChangeTest);
+    FRIEND_TEST(StorageClientTest, HedgeTest);
+    FRIEND_TEST(StorageClientTest, HedgeAfterTimeoutTest);
 
 public:
     StorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -115,7 +156,8 @@ public:
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<storage::cpp2::PropDef> returnCols,
-        folly::EventBase* evb = nullptr);
+        folly::EventBase* evb = nullptr,
+        bool distinctDst = false);
 
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryStatsResponse>> neighborStats(
         GraphSpaceID space,
@@ -175,6 +217,9 @@ public:
         const std::string& name,
         folly::EventBase* evb = nullptr);
 
+    // The number of the requests sent to each host and not responded yet
+    std::unordered_map<HostAddr, int64_t> inflightRequests() const;
+
 protected:
     // Calculate the partition id for the given vertex id
     StatusOr<PartitionID> partId(GraphSpaceID spaceId, int64_t id) const;
@@ -211,6 +256,35 @@ protected:
         }
     }
 
+    std::shared_ptr<std::atomic<int64_t>> inflightCounter(const HostAddr& host);
+
+    // Handle the response of one host, and fulfill the promise if it's the last one
+    template<class Context, class Response>
+    void handleResponse(std::shared_ptr<Context> context,
+                        const HostAddr& host,
+                        GraphSpaceID spaceId,
+                        const time::Duration& duration,
+                        folly::Try<Response>&& val);
+
+    // Send the request of the host to the other replicas of its parts
+    template<class Context, class Request, class Hedge>
+    void sendHedge(std::shared_ptr<Context> context,
+                   std::shared_ptr<Hedge> hedge,
+                   const HostAddr& host,
+                   GraphSpaceID spaceId,
+                   folly::EventBase* evb,
+                   const time::Duration& duration);
+
+    // Where the responses are handled, the IO thread if there is no handler pool
+    folly::Executor* handlerExecutor(folly::EventBase* evb) const {
+        if (handlerPool_ != nullptr) {
+            return handlerPool_.get();
+        }
+        return evb;
+    }
+
+    // The `scan' requests, whose responses are large, are sent through the separate
+    // connections from the point requests
     template<class Request,
              class RemoteFunc,
              class Response =
@@ -221,7 +295,9 @@ protected:
     folly::SemiFuture<StorageRpcResponse<Response>> collectResponse(
         folly::EventBase* evb,
         std::unordered_map<HostAddr, Request> requests,
-        RemoteFunc&& remoteFunc);
+        RemoteFunc&& remoteFunc,
+        bool hedgeable = false,
+        bool scan = false);
 
     template<class Request,
              class RemoteFunc,
@@ -271,9 +347,9 @@ protected:
         return clusters;
     }
 
-    virtual StatusOr<int32_t> partsNum(GraphSpaceID spaceId) const {
+    virtual StatusOr<std::shared_ptr<const Partitioner>> partitioner(GraphSpaceID spaceId) const {
         CHECK(client_ != nullptr);
-        return client_->partsNum(spaceId);
+        return client_->partitioner(spaceId);
     }
 
     virtual StatusOr<PartMeta> getPartMeta(GraphSpaceID spaceId, PartitionID partId) const {
@@ -289,6 +365,18 @@ private:
     mutable folly::RWSpinLock leadersLock_;
     mutable std::unordered_map<std::pair<GraphSpaceID, PartitionID>, HostAddr> leaders_;
     std::unique_ptr<stats::Stats> stats_;
+    // Handle the responses out of the IO threads, nullptr if disabled
+    std::unique_ptr<folly::CPUThreadPoolExecutor> handlerPool_;
+    mutable folly::RWSpinLock inflightLock_;
+    std::unordered_map<HostAddr, std::shared_ptr<std::atomic<int64_t>>> inflight_;
+    // The time waiting for the IO thread before sending, and the time
+    // waiting for the handler after receiving, in us
+    int32_t ioQueueStatId_{0};
+    int32_t handlerQueueStatId_{0};
+    // The latencies of the hedgeable requests
+    LatencyTracker latencies_;
+    int32_t hedgesStatId_{0};
+    int32_t hedgeWinsStatId_{0};
 };
 
 }   // namespace storage
@@ -9,12 +9,40 @@
 #include <folly/Try.h>
 
 DECLARE_int32(storage_client_timeout_ms);
+DECLARE_bool(storage_client_hedge);
+DECLARE_int32(storage_client_hedge_min_delay_ms);
 
 namespace nebula {
 namespace storage {
 
 namespace {
 
+// The request of one host and its hedge, whichever completes first wins
+struct HedgeState {
+    std::mutex lock;
+    bool done{false};
+
+    // Return true if it's the first one
+    bool claim() {
+        std::lock_guard<std::mutex> g(lock);
+        if (done) {
+            return false;
+        }
+        done = true;
+        return true;
+    }
+};
+
+template<class Request>
+void prepareHedge(Request&, int32_t) {
+}
+
+// The hedged request could be served by the followers
+inline void prepareHedge(cpp2::GetNeighborsRequest& req, int32_t timeoutMs) {
+    req.set_timeout_ms(timeoutMs);
+    req.set_read_follower(true);
+}
+
 template<class Request, class RemoteFunc, class Response>
 struct ResponseContext {
 public:
@@ -61,6 +89,8 @@ public:
 
 public:
     folly::Promise<StorageRpcResponse<Response>> promise;
+    // Guard the resp, which is filled by the handlers of all the hosts
+    std::mutex respLock;
     StorageRpcResponse<Response> resp;
     RemoteFunc serverMethod;
 
@@ -78,87 +108,73 @@ template<class Request, class RemoteFunc, class Response>
 folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
         folly::EventBase* evb,
         std::unordered_map<HostAddr, Request> requests,
-        RemoteFunc&& remoteFunc) {
-    auto context = std::make_shared<ResponseContext<Request, RemoteFunc, Response>>(
-        requests.size(), std::move(remoteFunc));
+        RemoteFunc&& remoteFunc,
+        bool hedgeable,
+        bool scan) {
+    using Context = ResponseContext<Request, RemoteFunc, Response>;
+    auto context = std::make_shared<Context>(requests.size(), std::move(remoteFunc));
 
-    if (evb == nullptr) {
-        DCHECK(!!ioThreadPool_);
-        evb = ioThreadPool_->getEventBase();
-    }
+    DCHECK(evb != nullptr || !!ioThreadPool_);
 
     time::Duration duration;
+    int64_t hedgeDelayMs = 0;
+    if (hedgeable && FLAGS_storage_client_hedge && latencies_.p95() > 0) {
+        hedgeDelayMs = std::max<int64_t>(FLAGS_storage_client_hedge_min_delay_ms,
+                                         latencies_.p95() / 1000);
+    }
     for (auto& req : requests) {
         auto& host = req.first;
         auto spaceId = req.second.get_space_id();
         auto res = context->insertRequest(host, std::move(req.second));
         DCHECK(res.second);
+        // Unless the caller asks for one, spread the requests of the hosts over
+        // the IO threads, so that a large fan out doesn't occupy a single one.
+        auto* ioEvb = evb != nullptr ? evb : ioThreadPool_->getEventBase();
+        auto inflight = inflightCounter(host);
+        std::shared_ptr<HedgeState> hedge;
+        if (hedgeDelayMs > 0) {
+            hedge = std::make_shared<HedgeState>();
+        }
+        // Only the time waiting for the IO thread, not the time to enqueue the others
+        time::Duration queued;
         // Invoke the remote method
-        folly::via(evb, [this, evb, context, host, spaceId, res, duration] () mutable {
-            auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
+        folly::via(ioEvb, [this, ioEvb, context, host, spaceId, res, duration, queued, inflight,
+                           hedgeable, scan, hedge, hedgeDelayMs] () mutable {
+            stats::StatsManager::addValue(ioQueueStatId_, queued.elapsedInUSec());
+            auto picked = clientsMan_->pick(host, ioEvb, false,
+                                            FLAGS_storage_client_timeout_ms, scan);
+            auto outstanding = picked.outstanding;
+            VLOG(3) << "Send request to " << host << ", in flight " << ++(*inflight);
+            ++(*outstanding);
             // Result is a pair of <Request&, bool>
-            context->serverMethod(client.get(), *res.first)
-            // Future process code will be executed on the IO thread
-            // Since all requests are sent using the same eventbase, all then-callback
-            // will be executed on the same IO thread
-            .via(evb).then([this, context, host, spaceId, duration] (folly::Try<Response>&& val) {
-                auto& r = context->findRequest(host);
-                if (val.hasException()) {
-                    LOG(ERROR) << "Request to " << host << " failed: " << val.exception().what();
-                    for (auto& part : r.parts) {
-                        VLOG(3) << "Exception! Failed part " << part.first;
-                        context->resp.failedParts().emplace(
-                            part.first,
-                            storage::cpp2::ErrorCode::E_RPC_FAILURE);
-                        invalidLeader(spaceId, part.first);
-                    }
-                    context->resp.markFailure();
-                } else {
-                    auto resp = std::move(val.value());
-                    auto& result = resp.get_result();
-                    bool hasFailure{false};
-                    for (auto& code : result.get_failed_codes()) {
-                        VLOG(3) << "Failure! Failed part " << code.get_part_id()
-                                << ", failed code " << static_cast<int32_t>(code.get_code());
-                        hasFailure = true;
-                        if (code.get_code() == storage::cpp2::ErrorCode::E_LEADER_CHANGED) {
-                            auto* leader = code.get_leader();
-                            if (leader != nullptr
-                                    && leader->get_ip() != 0
-                                    && leader->get_port() != 0) {
-                                updateLeader(spaceId,
-                                             code.get_part_id(),
-                                             HostAddr(leader->get_ip(), leader->get_port()));
-                            }
-                        } else if (code.get_code() == storage::cpp2::ErrorCode::E_PART_NOT_FOUND
-                                || code.get_code() == storage::cpp2::ErrorCode::E_SPACE_NOT_FOUND) {
-                            invalidLeader(spaceId, code.get_part_id());
-                        } else {
-                            // Simply keep the result
-                            context->resp.failedParts().emplace(code.get_part_id(),
-                                                                code.get_code());
-                        }
-                    }
-                    if (hasFailure) {
-                        context->resp.markFailure();
-                    }
-
-                    // Adjust the latency
-                    auto latency = result.get_latency_in_us();
-                    context->resp.setLatency(latency);
-
-                    // Keep the response
-                    context->resp.responses().emplace_back(std::move(resp));
+            context->serverMethod(picked.client.get(), *res.first)
+            .via(ioEvb).then([inflight, outstanding, client = picked.client] (
+                    folly::Try<Response>&& val) {
+                --(*inflight);
+                --(*outstanding);
+                // Process the response out of the IO thread
+                return std::make_pair(time::Duration(), std::move(val));
+            })
+            .via(handlerExecutor(ioEvb))
+            .thenValue([this, context, host, spaceId, duration, hedgeable, hedge] (
+                    std::pair<time::Duration, folly::Try<Response>>&& received) {
+                stats::StatsManager::addValue(handlerQueueStatId_,
+                                              received.first.elapsedInUSec());
+                if (hedgeable && received.second.hasValue()) {
+                    latencies_.add(duration.elapsedInUSec());
                 }
-
-                if (context->removeRequest(host)) {
-                    // Received all responses
-                    stats::Stats::addStatsValue(stats_.get(),
-                                                context->resp.succeeded(),
-                                                duration.elapsedInUSec());
-                    context->promise.setValue(std::move(context->resp));
+                if (hedge != nullptr && !hedge->claim()) {
+                    // The hedged request has won
+                    return;
                 }
+                handleResponse(context, host, spaceId, duration, std::move(received.second));
             });
+
+            if (hedge != nullptr) {
+                ioEvb->runAfterDelay([this, context, hedge, host, spaceId, ioEvb, duration] () {
+                    sendHedge<Context, Request>(context, hedge, host, spaceId, ioEvb, duration);
+                }, hedgeDelayMs);
+            }
         });  // via
     }  // for
 
@@ -174,6 +190,150 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
 }
 
 
+template<class Context, class Response>
+void StorageClient::handleResponse(std::shared_ptr<Context> context,
+                                   const HostAddr& host,
+                                   GraphSpaceID spaceId,
+                                   const time::Duration& duration,
+                                   folly::Try<Response>&& val) {
+    auto& r = context->findRequest(host);
+    // The responses of different hosts could be handled concurrently
+    std::unique_lock<std::mutex> respLock(context->respLock);
+    if (val.hasException()) {
+        LOG(ERROR) << "Request to " << host << " failed: " << val.exception().what();
+        for (auto& part : r.parts) {
+            VLOG(3) << "Exception! Failed part " << part.first;
+            context->resp.failedParts().emplace(
+                part.first,
+                storage::cpp2::ErrorCode::E_RPC_FAILURE);
+            invalidLeader(spaceId, part.first);
+        }
+        context->resp.markFailure();
+    } else {
+        auto resp = std::move(val.value());
+        auto& result = resp.get_result();
+        bool hasFailure{false};
+        for (auto& code : result.get_failed_codes()) {
+            VLOG(3) << "Failure! Failed part " << code.get_part_id()
+                    << ", failed code " << static_cast<int32_t>(code.get_code());
+            hasFailure = true;
+            if (code.get_code() == storage::cpp2::ErrorCode::E_LEADER_CHANGED) {
+                auto* leader = code.get_leader();
+                if (leader != nullptr
+                        && leader->get_ip() != 0
+                        && leader->get_port() != 0) {
+                    updateLeader(spaceId,
+                                 code.get_part_id(),
+                                 HostAddr(leader->get_ip(), leader->get_port()));
+                }
+            } else if (code.get_code() == storage::cpp2::ErrorCode::E_PART_NOT_FOUND
+                    || code.get_code() == storage::cpp2::ErrorCode::E_SPACE_NOT_FOUND) {
+                invalidLeader(spaceId, code.get_part_id());
+            } else {
+                // Simply keep the result
+                context->resp.failedParts().emplace(code.get_part_id(),
+                                                    code.get_code());
+            }
+        }
+        if (hasFailure) {
+            context->resp.markFailure();
+        }
+
+        // Adjust the latency
+        auto latency = result.get_latency_in_us();
+        context->resp.setLatency(host, latency, duration.elapsedInUSec());
+
+        // Keep the response
+        context->resp.responses().emplace_back(std::move(resp));
+    }
+    respLock.unlock();
+
+    if (context->removeRequest(host)) {
+        // Received all responses
+        stats::Stats::addStatsValue(stats_.get(),
+                                    context->resp.succeeded(),
+                                    duration.elapsedInUSec());
+        context->promise.setValue(std::move(context->resp));
+    }
+}
+
+
+template<class Context, class Request, class Hedge>
+void StorageClient::sendHedge(std::shared_ptr<Context> context,
+                              std::shared_ptr<Hedge> hedge,
+                              const HostAddr& host,
+                              GraphSpaceID spaceId,
+                              folly::EventBase* evb,
+                              const time::Duration& duration) {
+    int64_t remainingMs = FLAGS_storage_client_timeout_ms
+                        - static_cast<int64_t>(duration.elapsedInMSec());
+    std::unordered_map<HostAddr, Request> requests;
+    {
+        // Hold the lock, so that the request is not removed before copied
+        std::lock_guard<std::mutex> g(hedge->lock);
+        if (hedge->done || remainingMs <= 0) {
+            return;
+        }
+        auto& r = context->findRequest(host);
+        for (auto& part : r.parts) {
+            auto partMeta = getPartMeta(spaceId, part.first);
+            if (!partMeta.ok()) {
+                return;
+            }
+            auto& peers = partMeta.value().peers_;
+            auto it = std::find_if(peers.begin(), peers.end(), [&host] (const auto& peer) {
+                return peer != host;
+            });
+            if (it == peers.end()) {
+                // No other replica to hedge to
+                return;
+            }
+            auto& req = requests[*it];
+            if (req.parts.empty()) {
+                req = r;
+                req.parts.clear();
+                prepareHedge(req, static_cast<int32_t>(remainingMs));
+            }
+            req.parts.emplace(part.first, part.second);
+        }
+    }
+
+    VLOG(2) << "Hedge the request to " << host << " to " << requests.size() << " hosts";
+    stats::StatsManager::addValue(hedgesStatId_);
+    auto remoteFunc = context->serverMethod;
+    // Only the scan requests are hedged
+    collectResponse(evb, std::move(requests), std::move(remoteFunc), false, true)
+        .via(handlerExecutor(evb))
+        .thenValue([this, context, host, hedge, duration] (auto&& hedgeResp) {
+            if (!hedgeResp.succeeded() || !hedgeResp.failedParts().empty()) {
+                // Leave it to the original request
+                return;
+            }
+            if (!hedge->claim()) {
+                return;
+            }
+            stats::StatsManager::addValue(hedgeWinsStatId_);
+            {
+                std::lock_guard<std::mutex> g(context->respLock);
+                for (auto& latency : hedgeResp.hostLatency()) {
+                    context->resp.setLatency(std::get<0>(latency),
+                                             std::get<1>(latency),
+                                             std::get<2>(latency));
+                }
+                for (auto& resp : hedgeResp.responses()) {
+                    context->resp.responses().emplace_back(std::move(resp));
+                }
+            }
+            if (context->removeRequest(host)) {
+                stats::Stats::addStatsValue(stats_.get(),
+                                            context->resp.succeeded(),
+                                            duration.elapsedInUSec());
+                context->promise.setValue(std::move(context->resp));
+            }
+        });
+}
+
+
 template<class Request, class RemoteFunc, class Response>
 folly::Future<StatusOr<Response>> StorageClient::getResponse(
         folly::EventBase* evb,
@@ -189,13 +349,19 @@ folly::Future<StatusOr<Response>> StorageClient::getResponse(
     folly::via(evb, [evb, request = std::move(request), remoteFunc = std::move(remoteFunc),
                      pro = std::move(pro), duration, this] () mutable {
         auto host = request.first;
-        auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
+        auto picked = clientsMan_->pick(host, evb, false, FLAGS_storage_client_timeout_ms);
         auto spaceId = request.second.get_space_id();
         auto partId = request.second.get_part_id();
+        auto inflight = inflightCounter(host);
+        auto outstanding = picked.outstanding;
+        ++(*inflight);
+        ++(*outstanding);
         LOG(INFO) << "Send request to storage " << host;
-        remoteFunc(client.get(), std::move(request.second)).via(evb)
-             .then([spaceId, partId, p = std::move(pro),
-                    duration, this] (folly::Try<Response>&& t) mutable {
+        remoteFunc(picked.client.get(), std::move(request.second)).via(evb)
+             .then([spaceId, partId, p = std::move(pro), duration, inflight, outstanding,
+                    client = picked.client, this] (folly::Try<Response>&& t) mutable {
+            --(*inflight);
+            --(*outstanding);
             // exception occurred during RPC
             if (t.hasException()) {
                 stats::Stats::addStatsValue(stats_.get(), false, duration.elapsedInUSec());
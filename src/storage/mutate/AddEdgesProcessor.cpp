@@ -18,6 +18,7 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
         std::numeric_limits<int64_t>::max() - time::WallClock::fastNowInMicroSec();
     // Switch version to big-endian, make sure the key is in ordered.
     version = folly::Endian::big(version);
+    auto singleVersion = isSingleVersion(spaceId);
 
     callingNum_ = req.parts.size();
     CHECK_NOTNULL(kvstore_);
@@ -28,8 +29,11 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
             VLOG(4) << "PartitionID: " << partId << ", VertexID: " << edge.key.src
                     << ", EdgeType: " << edge.key.edge_type << ", EdgeRanking: " << edge.key.ranking
                     << ", VertexID: " << edge.key.dst << ", EdgeVersion: " << version;
-            auto key = NebulaKeyUtils::edgeKey(partId, edge.key.src, edge.key.edge_type,
-                                               edge.key.ranking, edge.key.dst, version);
+            auto key = singleVersion
+                ? NebulaKeyUtils::edgeKey(partId, edge.key.src, edge.key.edge_type,
+                                          edge.key.ranking, edge.key.dst, keyFormat_)
+                : NebulaKeyUtils::edgeKey(partId, edge.key.src, edge.key.edge_type,
+                                          edge.key.ranking, edge.key.dst, version, keyFormat_);
             data.emplace_back(std::move(key), std::move(edge.get_props()));
         });
         doPut(spaceId, partId, std::move(data));
@@ -23,6 +23,7 @@ void AddVerticesProcessor::process(const cpp2::AddVerticesRequest& req) {
 
     const auto& partVertices = req.get_parts();
     auto spaceId = req.get_space_id();
+    auto singleVersion = isSingleVersion(spaceId);
     callingNum_ = partVertices.size();
     CHECK_NOTNULL(kvstore_);
     std::for_each(partVertices.begin(), partVertices.end(), [&](auto& pv) {
@@ -34,8 +35,10 @@ void AddVerticesProcessor::process(const cpp2::AddVerticesRequest& req) {
             std::for_each(tags.begin(), tags.end(), [&](auto& tag) {
                 VLOG(3) << "PartitionID: " << partId << ", VertexID: " << v.get_id()
                         << ", TagID: " << tag.get_tag_id() << ", TagVersion: " << version;
-                auto key = NebulaKeyUtils::vertexKey(partId, v.get_id(),
-                                                     tag.get_tag_id(), version);
+                auto key = singleVersion
+                    ? NebulaKeyUtils::vertexKey(partId, v.get_id(), tag.get_tag_id(), keyFormat_)
+                    : NebulaKeyUtils::vertexKey(partId, v.get_id(), tag.get_tag_id(), version,
+                                                keyFormat_);
                 data.emplace_back(std::move(key), std::move(tag.get_props()));
                 if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
                     vertexCache_->evict(std::make_pair(v.get_id(), tag.get_tag_id()), partId);
@@ -17,22 +17,34 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
         callingNum_ += partEdges.second.size();
     });
     CHECK_NOTNULL(kvstore_);
+    auto singleVersion = isSingleVersion(spaceId);
 
     std::for_each(req.parts.begin(), req.parts.end(), [&](auto &partEdges) {
         auto partId = partEdges.first;
         std::for_each(partEdges.second.begin(), partEdges.second.end(), [&](auto &edgeKey) {
+            if (singleVersion) {
+                doRemove(spaceId, partId, {NebulaKeyUtils::edgeKey(partId,
+                                                                   edgeKey.src,
+                                                                   edgeKey.edge_type,
+                                                                   edgeKey.ranking,
+                                                                   edgeKey.dst,
+                                                                   keyFormat_)});
+                return;
+            }
             auto start = NebulaKeyUtils::edgeKey(partId,
                                                  edgeKey.src,
                                                  edgeKey.edge_type,
                                                  edgeKey.ranking,
                                                  edgeKey.dst,
-                                                 0);
+                                                 0,
+                                                 keyFormat_);
             auto end = NebulaKeyUtils::edgeKey(partId,
                                                edgeKey.src,
                                                edgeKey.edge_type,
                                                edgeKey.ranking,
                                                edgeKey.dst,
-                                               std::numeric_limits<int64_t>::max());
+                                               std::numeric_limits<int64_t>::max(),
+                                               keyFormat_);
             doRemoveRange(spaceId, partId, start, end);
         });
     });
@@ -17,7 +17,7 @@ void DeleteVertexProcessor::process(const cpp2::DeleteVertexRequest& req) {
     auto spaceId = req.get_space_id();
     auto partId = req.get_part_id();
     auto vId = req.get_vid();
-    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId);
+    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, keyFormat_);
     std::vector<std::string> keys;
     keys.reserve(32);
     std::unique_ptr<kvstore::KVIterator> iter;
@@ -30,8 +30,8 @@ void DeleteVertexProcessor::process(const cpp2::DeleteVertexRequest& req) {
     while (iter->valid()) {
         auto key = iter->key();
         if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
-            if (NebulaKeyUtils::isVertex(key)) {
-                auto tagId = NebulaKeyUtils::getTagId(key);
+            if (NebulaKeyUtils::isVertex(key, keyFormat_)) {
+                auto tagId = NebulaKeyUtils::getTagId(key, keyFormat_);
                 VLOG(3) << "Evict vertex cache for vId " << vId << ", tagId " << tagId;
                 vertexCache_->evict(std::make_pair(vId, tagId), partId);
             }
@@ -94,7 +94,7 @@ kvstore::ResultCode UpdateEdgeProcessor::collectVertexProps(
                             const VertexID vId,
                             const TagID tagId,
                             const std::vector<PropContext>& props) {
-    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId);
+    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId, keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = this->kvstore_->prefix(this->spaceId_, partId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -131,7 +131,7 @@ kvstore::ResultCode UpdateEdgeProcessor::collectEdgesProps(
                             const PartitionID partId,
                             const cpp2::EdgeKey& edgeKey) {
     auto prefix = NebulaKeyUtils::prefix(partId, edgeKey.src, edgeKey.edge_type,
-                                         edgeKey.ranking, edgeKey.dst);
+                                         edgeKey.ranking, edgeKey.dst, keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = kvstore_->prefix(this->spaceId_, partId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -163,8 +163,13 @@ kvstore::ResultCode UpdateEdgeProcessor::collectEdgesProps(
         resp_.set_upsert(true);
         int64_t ms = time::WallClock::fastNowInMicroSec();
         auto now = std::numeric_limits<int64_t>::max() - ms;
-        key_ = NebulaKeyUtils::edgeKey(partId, edgeKey.src, edgeKey.edge_type,
-                                       edgeKey.ranking, edgeKey.dst, now);
+        if (this->isSingleVersion(this->spaceId_)) {
+            key_ = NebulaKeyUtils::edgeKey(partId, edgeKey.src, edgeKey.edge_type,
+                                           edgeKey.ranking, edgeKey.dst, keyFormat_);
+        } else {
+            key_ = NebulaKeyUtils::edgeKey(partId, edgeKey.src, edgeKey.edge_type,
+                                           edgeKey.ranking, edgeKey.dst, now, keyFormat_);
+        }
         const auto constSchema = this->schemaMan_->getEdgeSchema(this->spaceId_,
                                                                  edgeKey.edge_type);
         if (constSchema == nullptr) {
@@ -408,8 +413,11 @@ void UpdateEdgeProcessor::process(const cpp2::UpdateEdgeRequest& req) {
             << ", src: " << edgeKey.get_src() << ", edge_type: " << edgeKey.get_edge_type()
             << ", dst: " << edgeKey.get_dst() << ", ranking: " << edgeKey.get_ranking();
     CHECK_NOTNULL(kvstore_);
-    this->kvstore_->asyncAtomicOp(this->spaceId_, partId,
-        [&, this] () -> std::string {
+    // The filter could read the tags of the source vertex, so the updates
+    // on the same source vertex should not be replicated together
+    auto conflictKey = NebulaKeyUtils::vertexPrefix(partId, edgeKey.get_src(), keyFormat_);
+    this->kvstore_->asyncAtomicOp(this->spaceId_, partId, std::move(conflictKey),
+        [partId, edgeKey, this] () -> std::string {
             if (checkFilter(partId, edgeKey)) {
                 return updateAndWriteBack();
             }
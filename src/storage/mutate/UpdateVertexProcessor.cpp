@@ -10,6 +10,10 @@
 #include "dataman/RowWriter.h"
 #include "kvstore/LogEncoder.h"
 
+DEFINE_bool(enable_update_by_merge, false,
+            "Write the upsert of single version spaces which only sets constants or adds "
+            "constants to the props as a rocksdb merge, instead of a read-modify-write atomic op");
+
 namespace nebula {
 namespace storage {
 
@@ -86,7 +90,7 @@ kvstore::ResultCode UpdateVertexProcessor::collectVertexProps(
                             const VertexID vId,
                             const TagID tagId,
                             const std::vector<PropContext>& props) {
-    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId);
+    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId, keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = this->kvstore_->prefix(this->spaceId_, partId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -141,7 +145,11 @@ kvstore::ResultCode UpdateVertexProcessor::collectVertexProps(
         auto& tagUpdater = tagUpdaters_[tagId];
         int64_t ms = time::WallClock::fastNowInMicroSec();
         auto now = std::numeric_limits<int64_t>::max() - ms;
-        tagUpdater->key = NebulaKeyUtils::vertexKey(partId, vId, tagId, now);
+        if (this->isSingleVersion(this->spaceId_)) {
+            tagUpdater->key = NebulaKeyUtils::vertexKey(partId, vId, tagId, keyFormat_);
+        } else {
+            tagUpdater->key = NebulaKeyUtils::vertexKey(partId, vId, tagId, now, keyFormat_);
+        }
         tagUpdater->updater = std::move(updater);
     } else {
         VLOG(3) << "Missed partId " << partId << ", vId " << vId << ", tagId " << tagId;
@@ -269,6 +277,136 @@ std::string UpdateVertexProcessor::updateAndWriteBack() {
 }
 
 
+StatusOr<MergeItem> UpdateVertexProcessor::toMergeItem(const TagID tagId,
+                                                       const cpp2::UpdateItem& item) {
+    auto expRet = Expression::decode(item.get_value());
+    if (!expRet.ok()) {
+        return expRet.status();
+    }
+    auto exp = std::move(expRet).value();
+    auto schema = this->schemaMan_->getTagSchema(this->spaceId_, tagId);
+    if (schema == nullptr) {
+        return Status::Error("Tag schema not found");
+    }
+    if (schema->getFieldIndex(item.get_prop()) < 0) {
+        return Status::Error("Prop not found");
+    }
+    auto type = schema->getFieldType(item.get_prop()).get_type();
+    Getters getters;
+    if (exp->kind() == Expression::kPrimary) {
+        auto value = exp->eval(getters);
+        if (!value.ok()) {
+            return value.status();
+        }
+        // The operand must be applied by the merge operator without any conversion
+        auto v = std::move(value).value();
+        bool matched = false;
+        switch (v.which()) {
+            case VAR_INT64:
+                matched = type == nebula::cpp2::SupportedType::INT
+                       || type == nebula::cpp2::SupportedType::TIMESTAMP;
+                break;
+            case VAR_DOUBLE:
+                matched = type == nebula::cpp2::SupportedType::DOUBLE
+                       || type == nebula::cpp2::SupportedType::FLOAT;
+                break;
+            case VAR_BOOL:
+                matched = type == nebula::cpp2::SupportedType::BOOL;
+                break;
+            case VAR_STR:
+                matched = type == nebula::cpp2::SupportedType::STRING;
+                break;
+        }
+        if (!matched) {
+            return Status::Error("Type mismatch");
+        }
+        return MergeItem{MergeOpType::SET, item.get_prop(), std::move(v)};
+    }
+    if (exp->kind() != Expression::kArithmetic) {
+        return Status::Error("Not a blind update");
+    }
+
+    // Only `prop + constant', `constant + prop' and `prop - constant' are supported
+    auto* arith = static_cast<const ArithmeticExpression*>(exp.get());
+    auto isSelf = [&item] (const Expression* e) {
+        if (e->kind() != Expression::kSourceProp) {
+            return false;
+        }
+        auto* srcProp = static_cast<const SourcePropertyExpression*>(e);
+        return *srcProp->alias() == item.get_name() && *srcProp->prop() == item.get_prop();
+    };
+    const Expression* constant = nullptr;
+    if (arith->op() == ArithmeticExpression::ADD && isSelf(arith->left())) {
+        constant = arith->right();
+    } else if (arith->op() == ArithmeticExpression::ADD && isSelf(arith->right())) {
+        constant = arith->left();
+    } else if (arith->op() == ArithmeticExpression::SUB && isSelf(arith->left())) {
+        constant = arith->right();
+    }
+    if (constant == nullptr || constant->kind() != Expression::kPrimary) {
+        return Status::Error("Not a blind update");
+    }
+    auto value = constant->eval(getters);
+    if (!value.ok()) {
+        return value.status();
+    }
+    auto delta = std::move(value).value();
+
+    // The type of the delta should be the same as the prop, so the result is the same
+    // with the one calculated by expression
+    bool negative = arith->op() == ArithmeticExpression::SUB;
+    if (delta.which() == VAR_INT64
+            && (type == nebula::cpp2::SupportedType::INT
+                || type == nebula::cpp2::SupportedType::TIMESTAMP)) {
+        auto v = boost::get<int64_t>(delta);
+        return MergeItem{MergeOpType::ADD, item.get_prop(), negative ? -v : v};
+    }
+    if (delta.which() == VAR_DOUBLE
+            && (type == nebula::cpp2::SupportedType::DOUBLE
+                || type == nebula::cpp2::SupportedType::FLOAT)) {
+        auto v = boost::get<double>(delta);
+        return MergeItem{MergeOpType::ADD, item.get_prop(), negative ? -v : v};
+    }
+    return Status::Error("Type mismatch");
+}
+
+
+bool UpdateVertexProcessor::buildMergeItems(const cpp2::UpdateVertexRequest& req) {
+    if (!req.get_filter().empty() || !req.get_return_columns().empty()) {
+        return false;
+    }
+    for (auto& item : updateItems_) {
+        auto tagRet = this->schemaMan_->toTagID(this->spaceId_, item.get_name());
+        if (!tagRet.ok()) {
+            return false;
+        }
+        auto tagId = tagRet.value();
+        auto mergeItem = toMergeItem(tagId, item);
+        if (!mergeItem.ok()) {
+            VLOG(3) << "Can't update " << item.get_name() << "." << item.get_prop()
+                    << " by merge: " << mergeItem.status();
+            mergeItems_.clear();
+            return false;
+        }
+        mergeItems_[tagId].emplace_back(std::move(mergeItem).value());
+    }
+    return true;
+}
+
+
+std::vector<kvstore::KV> UpdateVertexProcessor::buildMergeOperands(const PartitionID partId,
+                                                                   const VertexID vId) {
+    // The key of a single version space is known without reading it, the row is
+    // inserted by the merge operator if it does not exist yet.
+    std::vector<kvstore::KV> data;
+    for (auto& tagItem : mergeItems_) {
+        data.emplace_back(NebulaKeyUtils::vertexKey(partId, vId, tagItem.first, keyFormat_),
+                          MergeOperand::encode(this->spaceId_, tagItem.second));
+    }
+    return data;
+}
+
+
 cpp2::ErrorCode UpdateVertexProcessor::checkAndBuildContexts(
         const cpp2::UpdateVertexRequest& req) {
     if (this->expCtx_ == nullptr) {
@@ -368,30 +506,52 @@ void UpdateVertexProcessor::process(const cpp2::UpdateVertexRequest& req) {
     VLOG(3) << "Update vertex, spaceId: " << this->spaceId_
             << ", partId: " << partId << ", vId: " << vId;
     CHECK_NOTNULL(kvstore_);
-    this->kvstore_->asyncAtomicOp(this->spaceId_, partId,
-        [&, this] () -> std::string {
+    auto callback = [this, partId, vId, req] (kvstore::ResultCode code) {
+        while (true) {
+            if (code == kvstore::ResultCode::SUCCEEDED) {
+                // Evict again, the cache may be filled by reads before the write applied
+                if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
+                    for (auto tagId : updateTagIds_) {
+                        vertexCache_->evict(std::make_pair(vId, tagId), partId);
+                    }
+                }
+                onProcessFinished(req.get_return_columns().size());
+                break;
+            }
+            LOG(ERROR) << "Fail to update vertex, spaceId: " << this->spaceId_
+                       << ", partId: " << partId << ", vId: " << vId;
+            if (code == kvstore::ResultCode::ERR_LEADER_CHANGED) {
+                handleLeaderChanged(this->spaceId_, partId);
+                break;
+            }
+            this->pushResultCode(to(code), partId);
+            break;
+        }
+        this->onFinished();
+    };
+
+    // An upsert could be written blindly as a merge, only if the key is deterministic.
+    // The update of a missing vertex must fail, so it's always read before written.
+    if (FLAGS_enable_update_by_merge
+            && insertable_
+            && this->isSingleVersion(this->spaceId_)
+            && buildMergeItems(req)) {
+        this->kvstore_->asyncMultiMerge(this->spaceId_, partId,
+                                        buildMergeOperands(partId, vId),
+                                        std::move(callback));
+        return;
+    }
+
+    // Updates on different vertices of the part could be replicated together
+    auto conflictKey = NebulaKeyUtils::vertexPrefix(partId, vId, keyFormat_);
+    this->kvstore_->asyncAtomicOp(this->spaceId_, partId, std::move(conflictKey),
+        [partId, vId, this] () -> std::string {
             if (checkFilter(partId, vId)) {
                 return updateAndWriteBack();
             }
             return std::string("");
         },
-        [this, partId, vId, req] (kvstore::ResultCode code) {
-            while (true) {
-                if (code == kvstore::ResultCode::SUCCEEDED) {
-                    onProcessFinished(req.get_return_columns().size());
-                    break;
-                }
-                LOG(ERROR) << "Fail to update vertex, spaceId: " << this->spaceId_
-                           << ", partId: " << partId << ", vId: " << vId;
-                if (code == kvstore::ResultCode::ERR_LEADER_CHANGED) {
-                    handleLeaderChanged(this->spaceId_, partId);
-                    break;
-                }
-                this->pushResultCode(to(code), partId);
-                break;
-            }
-            this->onFinished();
-        });
+        std::move(callback));
 }
 
 }  // namespace storage
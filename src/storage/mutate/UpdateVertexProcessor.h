@@ -10,6 +10,7 @@
 #include "storage/query/QueryBaseProcessor.h"
 #include "dataman/RowReader.h"
 #include "dataman/RowUpdater.h"
+#include "storage/MergeOperator.h"
 
 namespace nebula {
 namespace storage {
@@ -58,6 +59,12 @@ private:
 
     std::string updateAndWriteBack();
 
+    bool buildMergeItems(const cpp2::UpdateVertexRequest& req);
+
+    StatusOr<MergeItem> toMergeItem(const TagID tagId, const cpp2::UpdateItem& item);
+
+    std::vector<kvstore::KV> buildMergeOperands(const PartitionID partId, const VertexID vId);
+
 private:
     bool                                                            insertable_{false};
     std::vector<storage::cpp2::UpdateItem>                          updateItems_;
@@ -65,6 +72,8 @@ private:
     std::set<TagID>                                                 updateTagIds_;
     std::unordered_map<std::pair<TagID, std::string>, VariantType>  tagFilters_;
     std::unordered_map<TagID, std::unique_ptr<KeyUpdaterPair>>      tagUpdaters_;
+    // Items of each updated tag, when the update could be written as merge
+    std::map<TagID, std::vector<MergeItem>>                         mergeItems_;
 };
 
 }  // namespace storage
@@ -8,11 +8,14 @@
 #define STORAGE_QUERY_QUERYBASEPROCESSOR_H_
 
 #include "base/Base.h"
+#include <folly/Optional.h>
 #include "storage/BaseProcessor.h"
 #include "storage/Collector.h"
 #include "filter/Expressions.h"
+#include "filter/CompiledExpression.h"
 #include "storage/CommonUtils.h"
 #include "stats/Stats.h"
+#include "time/WallClock.h"
 
 namespace nebula {
 namespace storage {
@@ -32,8 +35,56 @@ struct Bucket {
     std::vector<std::pair<PartitionID, VertexID>> vertices_;
 };
 
+/**
+ * The field indexes of the props in the schema of the rows, which are resolved
+ * once for all the rows of the same schema version, instead of looking up the
+ * props by name in each row.
+ * */
+struct FieldIndexes {
+    // Resolve the indexes again if the rows are of another schema
+    void resolve(std::shared_ptr<const meta::SchemaProviderIf> rowSchema,
+                 const std::vector<PropContext>& props) {
+        if (schema == rowSchema) {
+            return;
+        }
+        schema = std::move(rowSchema);
+        indexes.clear();
+        for (auto& prop : props) {
+            indexes.emplace_back(schema->getFieldIndex(prop.prop_.get_name()));
+        }
+    }
+
+    // Held, so that a schema released and another one allocated at the same
+    // address could never be taken as the resolved one
+    std::shared_ptr<const meta::SchemaProviderIf>   schema;
+    std::vector<int64_t>                            indexes;
+};
+
 using OneVertexResp = std::tuple<PartitionID, VertexID, kvstore::ResultCode>;
 
+/**
+ * Where to load the value of a slot in the compiled filter from, for one edge type.
+ * */
+struct SlotSource {
+    enum class Type : uint8_t {
+        // The slot can't be resolved on the edge type, the filter will fail
+        INVALID,
+        SRC,
+        DST,
+        RANK,
+        TYPE,
+        PROP,
+        TAG_FILTER,
+    };
+
+    Type                type = Type::INVALID;
+    // For PROP, the prop name and its field index in the schema of the current row
+    const std::string*  prop = nullptr;
+    int64_t             index = -1;
+    // For TAG_FILTER, the value in FilterContext
+    const VariantType*  value = nullptr;
+};
+
 template<typename REQ, typename RESP>
 class QueryBaseProcessor : public BaseProcessor<RESP> {
 public:
@@ -69,12 +120,14 @@ protected:
 
     /**
      * collect props in one row, you could define custom behavior by implement your own collector.
+     * The fieldIndexes should be kept along the rows of the same props if given.
      * */
     void collectProps(RowReader* reader,
                       folly::StringPiece key,
                       const std::vector<PropContext>& props,
                       FilterContext* fcontext,
-                      Collector* collector);
+                      Collector* collector,
+                      FieldIndexes* fieldIndexes = nullptr);
 
     virtual kvstore::ResultCode processVertex(PartitionID partId, VertexID vId) = 0;
 
@@ -105,19 +158,52 @@ protected:
 
     folly::Future<std::vector<OneVertexResp>> asyncProcessBucket(Bucket bucket);
 
+    /**
+     * Process the vertices of one bucket, one by one through processVertex by default.
+     * */
+    virtual std::vector<OneVertexResp> processBucket(const Bucket& bucket);
+
+    /**
+     * Read the latest rows of all the tags of the vertices, with one batched read per part
+     * instead of one prefix scan per vertex and tag. The row of vertices[i] on tagContexts_[j]
+     * is put into rows[i * tagContexts_.size() + j], none if not found, and the vertices
+     * of the failed parts get their codes in codes.
+     * */
+    void readTagRows(const std::vector<std::pair<PartitionID, VertexID>>& vertices,
+                     std::vector<folly::Optional<std::string>>& rows,
+                     std::vector<kvstore::ResultCode>& codes);
+
     int32_t getBucketsNum(int32_t verticesNum, int32_t minVerticesPerBucket, int32_t handlerNum);
 
     bool checkExp(const Expression* exp);
 
+    void resolveSlots(EdgeType edgeType,
+                      FilterContext* fcontext,
+                      std::vector<SlotSource>& sources);
+
+    TypedValue loadSlot(const SlotSource& source,
+                        RowReader* reader,
+                        folly::StringPiece key);
+
+    // The client has given up the request
+    bool expired() const {
+        return deadline_ > 0 && time::WallClock::fastNowInMilliSec() >= deadline_;
+    }
+
 protected:
     GraphSpaceID  spaceId_;
     std::unique_ptr<ExpressionContext> expCtx_;
     std::unique_ptr<Expression> exp_;
+    // The compiled exp_, nullptr if it is not compilable
+    std::unique_ptr<CompiledExpression> compiledExp_;
     std::vector<TagContext> tagContexts_;
     std::unordered_map<EdgeType, std::vector<PropContext>> edgeContexts_;
     folly::Executor* executor_ = nullptr;
     VertexCache* vertexCache_ = nullptr;
     std::unordered_map<std::string, EdgeType> edgeMap_;
+    // In ms, 0 for no deadline
+    int64_t deadline_ = 0;
+    bool readFollower_ = false;
 };
 
 }  // namespace storage
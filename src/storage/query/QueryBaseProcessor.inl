@@ -164,6 +164,12 @@ cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkAndBuildContexts(const REQ&
         }
         expCtx_ = std::make_unique<ExpressionContext>();
         exp_->setContext(expCtx_.get());
+        auto compiled = CompiledExpression::compile(exp_.get());
+        if (compiled.ok()) {
+            compiledExp_ = std::move(compiled).value();
+        } else {
+            VLOG(3) << "Fall back to interpret the filter: " << compiled.status();
+        }
     }
     return cpp2::ErrorCode::SUCCEEDED;
 }
@@ -308,34 +314,56 @@ void QueryBaseProcessor<REQ, RESP>::collectProps(RowReader* reader,
                                                  folly::StringPiece key,
                                                  const std::vector<PropContext>& props,
                                                  FilterContext* fcontext,
-                                                 Collector* collector) {
-    for (auto& prop : props) {
+                                                 Collector* collector,
+                                                 FieldIndexes* fieldIndexes) {
+    const meta::SchemaProviderIf* schema = nullptr;
+    if (reader != nullptr) {
+        schema = reader->getSchema().get();
+        if (fieldIndexes != nullptr) {
+            fieldIndexes->resolve(reader->getSchema(), props);
+        }
+    }
+    for (size_t i = 0; i < props.size(); i++) {
+        auto& prop = props[i];
         if (!key.empty()) {
             switch (prop.pikType_) {
                 case PropContext::PropInKeyType::NONE:
                     break;
-                case PropContext::PropInKeyType::SRC:
-                    VLOG(3) << "collect _src, value = " << NebulaKeyUtils::getSrcId(key);
-                    collector->collectVid(NebulaKeyUtils::getSrcId(key), prop);
+                case PropContext::PropInKeyType::SRC: {
+                    auto src = NebulaKeyUtils::getSrcId(key, this->keyFormat_);
+                    VLOG(3) << "collect _src, value = " << src;
+                    collector->collectVid(src, prop);
                     continue;
-                case PropContext::PropInKeyType::DST:
-                    VLOG(3) << "collect _dst, value = " << NebulaKeyUtils::getDstId(key);
-                    collector->collectVid(NebulaKeyUtils::getDstId(key), prop);
+                }
+                case PropContext::PropInKeyType::DST: {
+                    auto dst = NebulaKeyUtils::getDstId(key, this->keyFormat_);
+                    VLOG(3) << "collect _dst, value = " << dst;
+                    collector->collectVid(dst, prop);
                     continue;
-                case PropContext::PropInKeyType::TYPE:
-                    VLOG(3) << "collect _type, value = " << NebulaKeyUtils::getEdgeType(key);
-                    collector->collectInt64(static_cast<int64_t>(NebulaKeyUtils::getEdgeType(key)),
-                                            prop);
+                }
+                case PropContext::PropInKeyType::TYPE: {
+                    auto type = NebulaKeyUtils::getEdgeType(key, this->keyFormat_);
+                    VLOG(3) << "collect _type, value = " << type;
+                    collector->collectInt64(static_cast<int64_t>(type), prop);
                     continue;
-                case PropContext::PropInKeyType::RANK:
-                    VLOG(3) << "collect _rank, value = " << NebulaKeyUtils::getRank(key);
-                    collector->collectInt64(NebulaKeyUtils::getRank(key), prop);
+                }
+                case PropContext::PropInKeyType::RANK: {
+                    auto rank = NebulaKeyUtils::getRank(key, this->keyFormat_);
+                    VLOG(3) << "collect _rank, value = " << rank;
+                    collector->collectInt64(rank, prop);
                     continue;
+                }
             }
         }
         if (reader != nullptr) {
             const auto& name = prop.prop_.get_name();
-            auto res = RowReader::getPropByName(reader, name);
+            auto index = fieldIndexes != nullptr ? fieldIndexes->indexes[i]
+                                                 : schema->getFieldIndex(name);
+            if (index < 0) {
+                VLOG(1) << "Skip the unknown prop " << name;
+                continue;
+            }
+            auto res = RowReader::getPropByIndex(reader, index);
             if (!ok(res)) {
                 VLOG(1) << "Skip the bad value for prop " << name;
                 continue;
@@ -386,9 +414,9 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectVertexProps(
             VLOG(3) << "Miss cache for vId " << vId << ", tagId " << tagId;
         }
     }
-    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId);
+    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagId, this->keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter, readFollower_);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
         VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret) << ", spaceId " << spaceId_;
         return ret;
@@ -418,9 +446,9 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                                                const std::vector<PropContext>& props,
                                                FilterContext* fcontext,
                                                EdgeProcessor proc) {
-    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, edgeType);
+    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, edgeType, this->keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter, readFollower_);
     if (ret != kvstore::ResultCode::SUCCEEDED || !iter) {
         return ret;
     }
@@ -428,22 +456,53 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
     VertexID    lastDstId = 0;
     bool        firstLoop = true;
     int         cnt = 0;
+    // There is only one version for each edge in single version space
+    bool        singleVersion = this->isSingleVersion(spaceId_);
     Getters getters;
+    std::vector<SlotSource> sources;
+    std::vector<TypedValue> slots;
+    const meta::SchemaProviderIf* lastSchema = nullptr;
+    if (compiledExp_ != nullptr && edgeType > 0) {
+        resolveSlots(edgeType, fcontext, sources);
+        slots.resize(sources.size());
+    }
     for (; iter->valid() && cnt < FLAGS_max_edge_returned_per_vertex; iter->next()) {
         auto key = iter->key();
         auto val = iter->val();
-        auto rank = NebulaKeyUtils::getRank(key);
-        auto dstId = NebulaKeyUtils::getDstId(key);
-        if (!firstLoop && rank == lastRank && lastDstId == dstId) {
-            VLOG(3) << "Only get the latest version for each edge.";
-            continue;
+        if (!singleVersion) {
+            auto rank = NebulaKeyUtils::getRank(key, this->keyFormat_);
+            auto dstId = NebulaKeyUtils::getDstId(key, this->keyFormat_);
+            if (!firstLoop && rank == lastRank && lastDstId == dstId) {
+                VLOG(3) << "Only get the latest version for each edge.";
+                continue;
+            }
+            lastRank = rank;
+            lastDstId = dstId;
         }
-        lastRank = rank;
-        lastDstId = dstId;
         std::unique_ptr<RowReader> reader;
         if (edgeType > 0 && !val.empty()) {
             reader = RowReader::getEdgePropReader(this->schemaMan_, val, spaceId_, edgeType);
-            if (exp_ != nullptr) {
+            if (compiledExp_ != nullptr) {
+                if (reader != nullptr && reader->getSchema().get() != lastSchema) {
+                    // The field indexes only change along with the schema version
+                    lastSchema = reader->getSchema().get();
+                    for (auto& source : sources) {
+                        if (source.type == SlotSource::Type::PROP) {
+                            source.index = lastSchema->getFieldIndex(*source.prop);
+                        }
+                    }
+                }
+                for (size_t i = 0; i < sources.size(); i++) {
+                    slots[i] = loadSlot(sources[i], reader.get(), key);
+                }
+                if (compiledExp_->filter(slots.data())
+                        == CompiledExpression::FilterResult::kFalse) {
+                    VLOG(1) << "Filter the edge " << vId << "-> "
+                            << NebulaKeyUtils::getDstId(key, this->keyFormat_) << "@"
+                            << NebulaKeyUtils::getRank(key, this->keyFormat_) << ":" << edgeType;
+                    continue;
+                }
+            } else if (exp_ != nullptr) {
                 getters.getAliasProp = [this, edgeType, &reader, &key](const std::string& edgeName,
                                            const std::string& prop) -> OptVariantType {
                     auto edgeFound = this->edgeMap_.find(edgeName);
@@ -456,13 +515,14 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                     }
 
                     if (prop == _SRC) {
-                        return NebulaKeyUtils::getSrcId(key);
+                        return NebulaKeyUtils::getSrcId(key, this->keyFormat_);
                     } else if (prop == _DST) {
-                        return NebulaKeyUtils::getDstId(key);
+                        return NebulaKeyUtils::getDstId(key, this->keyFormat_);
                     } else if (prop == _RANK) {
-                        return NebulaKeyUtils::getRank(key);
+                        return NebulaKeyUtils::getRank(key, this->keyFormat_);
                     } else if (prop == _TYPE) {
-                        return static_cast<int64_t>(NebulaKeyUtils::getEdgeType(key));
+                        return static_cast<int64_t>(
+                            NebulaKeyUtils::getEdgeType(key, this->keyFormat_));
                     }
 
                     auto res = RowReader::getPropByName(reader.get(), prop);
@@ -471,8 +531,8 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                     }
                     return value(std::move(res));
                 };
-                getters.getEdgeRank = [&] () -> VariantType {
-                    return rank;
+                getters.getEdgeRank = [this, &key] () -> VariantType {
+                    return NebulaKeyUtils::getRank(key, this->keyFormat_);
                 };
                 getters.getSrcTagProp = [&fcontext] (const std::string& tag,
                                                      const std::string& prop) -> OptVariantType {
@@ -486,8 +546,9 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                 };
                 auto value = exp_->eval(getters);
                 if (value.ok() && !Expression::asBool(value.value())) {
-                    VLOG(1) << "Filter the edge "
-                            << vId << "-> " << dstId << "@" << rank << ":" << edgeType;
+                    VLOG(1) << "Filter the edge " << vId << "-> "
+                            << NebulaKeyUtils::getDstId(key, this->keyFormat_) << "@"
+                            << NebulaKeyUtils::getRank(key, this->keyFormat_) << ":" << edgeType;
                     continue;
                 }
             }
@@ -501,24 +562,158 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
     return ret;
 }
 
+template<typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::resolveSlots(EdgeType edgeType,
+                                                 FilterContext* fcontext,
+                                                 std::vector<SlotSource>& sources) {
+    const auto& slots = compiledExp_->slots();
+    sources.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        const auto& slot = slots[i];
+        auto& source = sources[i];
+        if (slot.kind == Expression::kAliasProp) {
+            auto edgeFound = edgeMap_.find(slot.alias);
+            if (edgeFound == edgeMap_.end() || edgeFound->second != edgeType) {
+                // Same as the getters, the edge is kept if the filter is on other edges
+                continue;
+            }
+            if (slot.prop == _SRC) {
+                source.type = SlotSource::Type::SRC;
+            } else if (slot.prop == _DST) {
+                source.type = SlotSource::Type::DST;
+            } else if (slot.prop == _RANK) {
+                source.type = SlotSource::Type::RANK;
+            } else if (slot.prop == _TYPE) {
+                source.type = SlotSource::Type::TYPE;
+            } else {
+                source.type = SlotSource::Type::PROP;
+                source.prop = &slot.prop;
+            }
+        } else if (slot.kind == Expression::kSourceProp && fcontext != nullptr) {
+            auto it = fcontext->tagFilters_.find(std::make_pair(slot.alias, slot.prop));
+            if (it != fcontext->tagFilters_.end()) {
+                source.type = SlotSource::Type::TAG_FILTER;
+                source.value = &it->second;
+            }
+        }
+    }
+}
+
+template<typename REQ, typename RESP>
+TypedValue QueryBaseProcessor<REQ, RESP>::loadSlot(const SlotSource& source,
+                                                   RowReader* reader,
+                                                   folly::StringPiece key) {
+    switch (source.type) {
+        case SlotSource::Type::SRC:
+            return TypedValue::ofInt(NebulaKeyUtils::getSrcId(key, this->keyFormat_));
+        case SlotSource::Type::DST:
+            return TypedValue::ofInt(NebulaKeyUtils::getDstId(key, this->keyFormat_));
+        case SlotSource::Type::RANK:
+            return TypedValue::ofInt(NebulaKeyUtils::getRank(key, this->keyFormat_));
+        case SlotSource::Type::TYPE:
+            return TypedValue::ofInt(NebulaKeyUtils::getEdgeType(key, this->keyFormat_));
+        case SlotSource::Type::TAG_FILTER:
+            return TypedValue::ofVariant(*source.value);
+        case SlotSource::Type::PROP:
+            break;
+        case SlotSource::Type::INVALID:
+            return TypedValue();
+    }
+
+    return TypedValue::ofField(reader, source.index);
+}
+
 template<typename REQ, typename RESP>
 folly::Future<std::vector<OneVertexResp>>
 QueryBaseProcessor<REQ, RESP>::asyncProcessBucket(Bucket bucket) {
     folly::Promise<std::vector<OneVertexResp>> pro;
     auto f = pro.getFuture();
     executor_->add([this, p = std::move(pro), b = std::move(bucket)] () mutable {
-        std::vector<OneVertexResp> codes;
-        codes.reserve(b.vertices_.size());
-        for (auto& pv : b.vertices_) {
-            codes.emplace_back(pv.first,
-                               pv.second,
-                               processVertex(pv.first, pv.second));
-        }
-        p.setValue(std::move(codes));
+        p.setValue(processBucket(b));
     });
     return f;
 }
 
+template<typename REQ, typename RESP>
+std::vector<OneVertexResp> QueryBaseProcessor<REQ, RESP>::processBucket(const Bucket& bucket) {
+    std::vector<OneVertexResp> codes;
+    codes.reserve(bucket.vertices_.size());
+    for (auto& pv : bucket.vertices_) {
+        if (expired()) {
+            codes.emplace_back(pv.first, pv.second, kvstore::ResultCode::ERR_DEADLINE_EXCEEDED);
+            continue;
+        }
+        codes.emplace_back(pv.first,
+                           pv.second,
+                           processVertex(pv.first, pv.second));
+    }
+    return codes;
+}
+
+template<typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::readTagRows(
+                            const std::vector<std::pair<PartitionID, VertexID>>& vertices,
+                            std::vector<folly::Optional<std::string>>& rows,
+                            std::vector<kvstore::ResultCode>& codes) {
+    auto tagNum = tagContexts_.size();
+    rows.clear();
+    rows.resize(vertices.size() * tagNum);
+    codes.assign(vertices.size(), kvstore::ResultCode::SUCCEEDED);
+    bool useCache = FLAGS_enable_vertex_cache && vertexCache_ != nullptr;
+
+    // The prefixes of each part to read, along with the slots in rows
+    std::unordered_map<PartitionID,
+                       std::pair<std::vector<std::string>, std::vector<size_t>>> parts;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto partId = vertices[i].first;
+        auto vId = vertices[i].second;
+        for (size_t j = 0; j < tagNum; j++) {
+            auto tagId = tagContexts_[j].tagId_;
+            if (useCache) {
+                auto result = vertexCache_->get(std::make_pair(vId, tagId), partId);
+                if (result.ok()) {
+                    VLOG(3) << "Hit cache for vId " << vId << ", tagId " << tagId;
+                    rows[i * tagNum + j] = std::move(result).value();
+                    continue;
+                }
+            }
+            auto& part = parts[partId];
+            part.first.emplace_back(
+                NebulaKeyUtils::vertexPrefix(partId, vId, tagId, this->keyFormat_));
+            part.second.emplace_back(i * tagNum + j);
+        }
+    }
+
+    for (auto& part : parts) {
+        auto partId = part.first;
+        auto& prefixes = part.second.first;
+        auto& slots = part.second.second;
+        std::vector<kvstore::KV> kvs;
+        auto ret = this->kvstore_->multiPrefixFirst(spaceId_, partId, prefixes, &kvs,
+                                                    readFollower_);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret) << ", spaceId " << spaceId_
+                    << ", partId " << partId;
+            for (auto slot : slots) {
+                codes[slot / tagNum] = ret;
+            }
+            continue;
+        }
+        for (size_t k = 0; k < kvs.size(); k++) {
+            if (kvs[k].first.empty()) {
+                continue;
+            }
+            auto slot = slots[k];
+            if (useCache) {
+                auto& v = vertices[slot / tagNum];
+                vertexCache_->insert(std::make_pair(v.second, tagContexts_[slot % tagNum].tagId_),
+                                     kvs[k].second, partId);
+            }
+            rows[slot] = std::move(kvs[k].second);
+        }
+    }
+}
+
 template<typename REQ, typename RESP>
 int32_t QueryBaseProcessor<REQ, RESP>::getBucketsNum(int32_t verticesNum,
                                                      int32_t minVerticesPerBucket,
@@ -560,6 +755,10 @@ template<typename REQ, typename RESP>
 void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req) {
     CHECK_NOTNULL(executor_);
     spaceId_ = req.get_space_id();
+    if (req.get_timeout_ms() > 0) {
+        deadline_ = time::WallClock::fastNowInMilliSec() + req.get_timeout_ms();
+    }
+    readFollower_ = req.get_read_follower();
     int32_t returnColumnsNum = req.get_return_columns().size();
     VLOG(3) << "Receive request, spaceId " << spaceId_ << ", return cols " << returnColumnsNum;
     tagContexts_.reserve(returnColumnsNum);
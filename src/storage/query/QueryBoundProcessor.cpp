@@ -20,12 +20,17 @@ kvstore::ResultCode QueryBoundProcessor::processEdgeImpl(const PartitionID partI
                                                          FilterContext& fcontext,
                                                          cpp2::VertexData& vdata) {
     RowSetWriter rsWriter;
+    FieldIndexes fieldIndexes;
     auto ret = collectEdgeProps(
         partId, vId, edgeType, props, &fcontext,
         [&, this](RowReader* reader, folly::StringPiece k, const std::vector<PropContext>& p) {
+            if (distinctDst_
+                    && !firstEdgeToDst(edgeType, NebulaKeyUtils::getDstId(k, keyFormat_))) {
+                return;
+            }
             RowWriter writer(rsWriter.schema());
             PropsCollector collector(&writer);
-            this->collectProps(reader, k, p, &fcontext, &collector);
+            this->collectProps(reader, k, p, &fcontext, &collector, &fieldIndexes);
             rsWriter.addRow(writer);
         });
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -40,6 +45,12 @@ kvstore::ResultCode QueryBoundProcessor::processEdgeImpl(const PartitionID partI
     return ret;
 }
 
+bool QueryBoundProcessor::firstEdgeToDst(EdgeType edgeType, VertexID dstId) {
+    // The buckets are processed concurrently
+    std::lock_guard<std::mutex> lg(dstLock_);
+    return visitedDst_[edgeType].emplace(dstId).second;
+}
+
 kvstore::ResultCode QueryBoundProcessor::processEdge(PartitionID partId, VertexID vId,
                                                      FilterContext& fcontext,
                                                      cpp2::VertexData& vdata) {
@@ -110,6 +121,57 @@ kvstore::ResultCode QueryBoundProcessor::processVertex(PartitionID partId, Verte
     return kvstore::ResultCode::SUCCEEDED;
 }
 
+std::vector<OneVertexResp> QueryBoundProcessor::processBucket(const Bucket& bucket) {
+    if (!onlyVertexProps_ || tagContexts_.empty() || expired()) {
+        return QueryBaseProcessor::processBucket(bucket);
+    }
+    std::vector<folly::Optional<std::string>> rows;
+    std::vector<kvstore::ResultCode> codes;
+    readTagRows(bucket.vertices_, rows, codes);
+
+    auto tagNum = tagContexts_.size();
+    std::vector<OneVertexResp> resps;
+    resps.reserve(bucket.vertices_.size());
+    std::vector<cpp2::VertexData> vertices;
+    vertices.reserve(bucket.vertices_.size());
+    for (size_t i = 0; i < bucket.vertices_.size(); i++) {
+        auto partId = bucket.vertices_[i].first;
+        auto vId = bucket.vertices_[i].second;
+        resps.emplace_back(partId, vId, codes[i]);
+        if (codes[i] != kvstore::ResultCode::SUCCEEDED) {
+            continue;
+        }
+        FilterContext fcontext;
+        std::vector<cpp2::TagData> td;
+        for (size_t j = 0; j < tagNum; j++) {
+            auto& row = rows[i * tagNum + j];
+            if (!row.hasValue()) {
+                VLOG(3) << "Missed partId " << partId << ", vId " << vId
+                        << ", tagId " << tagContexts_[j].tagId_;
+                continue;
+            }
+            auto& tc = tagContexts_[j];
+            auto reader = RowReader::getTagPropReader(this->schemaMan_, *row, spaceId_, tc.tagId_);
+            RowWriter writer;
+            PropsCollector collector(&writer);
+            collectProps(reader.get(), "", tc.props_, &fcontext, &collector);
+            if (writer.size() > 1) {
+                td.emplace_back(apache::thrift::FragileConstructor::FRAGILE,
+                                tc.tagId_,
+                                writer.encode());
+            }
+        }
+        cpp2::VertexData vResp;
+        vResp.set_vertex_id(vId);
+        vResp.set_tag_data(std::move(td));
+        vertices.emplace_back(std::move(vResp));
+    }
+
+    std::lock_guard<std::mutex> lg(this->lock_);
+    std::move(vertices.begin(), vertices.end(), std::back_inserter(vertices_));
+    return resps;
+}
+
 void QueryBoundProcessor::onProcessFinished(int32_t retNum) {
     (void)retNum;
     resp_.set_vertices(std::move(vertices_));
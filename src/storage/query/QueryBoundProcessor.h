@@ -28,6 +28,11 @@ public:
         return new QueryBoundProcessor(kvstore, schemaMan, stats, executor, cache);
     }
 
+    void process(const cpp2::GetNeighborsRequest& req) {
+        distinctDst_ = req.get_distinct_dst();
+        QueryBaseProcessor<cpp2::GetNeighborsRequest, cpp2::QueryResponse>::process(req);
+    }
+
 protected:
     explicit QueryBoundProcessor(kvstore::KVStore* kvstore,
                                  meta::SchemaManager* schemaMan,
@@ -39,6 +44,9 @@ protected:
 
     kvstore::ResultCode processVertex(PartitionID partId, VertexID vId) override;
 
+    // Read the tags of all the vertices in one batch if only the vertex props are requested
+    std::vector<OneVertexResp> processBucket(const Bucket& bucket) override;
+
     void onProcessFinished(int32_t retNum) override;
 
 private:
@@ -51,9 +59,16 @@ private:
                                         const std::vector<PropContext>& props,
                                         FilterContext& fcontext, cpp2::VertexData& vdata);
 
+    // Return true if it is the first edge to the dst of the edge type in this request
+    bool firstEdgeToDst(EdgeType edgeType, VertexID dstId);
+
 protected:
     // Indicate the request only get vertex props.
     bool onlyVertexProps_ = false;
+    // Only return one edge for each dst of each edge type
+    bool distinctDst_ = false;
+    std::mutex dstLock_;
+    std::unordered_map<EdgeType, std::unordered_set<VertexID>> visitedDst_;
 };
 
 }  // namespace storage
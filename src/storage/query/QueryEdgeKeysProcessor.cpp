@@ -18,7 +18,7 @@ void QueryEdgeKeysProcessor::process(const cpp2::EdgeKeyRequest& req) {
     CHECK_NOTNULL(kvstore_);
 
     std::vector<cpp2::EdgeKey> edges;
-    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId);
+    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = this->kvstore_->prefix(spaceId, partId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -34,11 +34,11 @@ void QueryEdgeKeysProcessor::process(const cpp2::EdgeKeyRequest& req) {
     }
     while (iter->valid()) {
         auto key = iter->key();
-        if (NebulaKeyUtils::isEdge(key)) {
-            auto src = NebulaKeyUtils::getSrcId(key);
-            auto dst = NebulaKeyUtils::getDstId(key);
-            auto edgeType = NebulaKeyUtils::getEdgeType(key);
-            auto rank = NebulaKeyUtils::getRank(key);
+        if (NebulaKeyUtils::isEdge(key, keyFormat_)) {
+            auto src = NebulaKeyUtils::getSrcId(key, keyFormat_);
+            auto dst = NebulaKeyUtils::getDstId(key, keyFormat_);
+            auto edgeType = NebulaKeyUtils::getEdgeType(key, keyFormat_);
+            auto rank = NebulaKeyUtils::getRank(key, keyFormat_);
             cpp2::EdgeKey edge;
             edge.set_src(src);
             edge.set_edge_type(edgeType);
@@ -18,9 +18,10 @@ kvstore::ResultCode QueryEdgePropsProcessor::collectEdgesProps(
                                        PartitionID partId,
                                        const cpp2::EdgeKey& edgeKey,
                                        std::vector<PropContext>& props,
+                                       FieldIndexes& fieldIndexes,
                                        RowSetWriter& rsWriter) {
     auto prefix = NebulaKeyUtils::prefix(partId, edgeKey.src, edgeKey.edge_type,
-                                         edgeKey.ranking, edgeKey.dst);
+                                         edgeKey.ranking, edgeKey.dst, keyFormat_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = kvstore_->prefix(spaceId_, partId, prefix, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -34,7 +35,7 @@ kvstore::ResultCode QueryEdgePropsProcessor::collectEdgesProps(
                                                    iter->val(),
                                                    spaceId_,
                                                    edgeKey.edge_type);
-        this->collectProps(reader.get(), iter->key(), props, nullptr, &collector);
+        this->collectProps(reader.get(), iter->key(), props, nullptr, &collector, &fieldIndexes);
         rsWriter.addRow(writer);
 
         iter->next();
@@ -62,12 +63,14 @@ void QueryEdgePropsProcessor::process(const cpp2::EdgePropRequest& req) {
 
     int32_t returnColumnsNum = req.get_return_columns().size() + edgeSize;
     RowSetWriter rsWriter;
+    std::unordered_map<EdgeType, FieldIndexes> fieldIndexes;
     std::for_each(req.get_parts().begin(), req.get_parts().end(), [&](auto& partE) {
         auto partId = partE.first;
         kvstore::ResultCode ret = kvstore::ResultCode::SUCCEEDED;
         for (auto& edgeKey : partE.second) {
             for (auto& ec : edgeContexts_) {
-                ret = this->collectEdgesProps(partId, edgeKey, ec.second, rsWriter);
+                ret = this->collectEdgesProps(partId, edgeKey, ec.second,
+                                              fieldIndexes[ec.first], rsWriter);
                 if (ret != kvstore::ResultCode::SUCCEEDED) {
                     break;
                 }
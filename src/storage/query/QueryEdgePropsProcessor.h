@@ -34,6 +34,7 @@ private:
     kvstore::ResultCode collectEdgesProps(PartitionID partId,
                                           const cpp2::EdgeKey& edgeKey,
                                           std::vector<PropContext>& props,
+                                          FieldIndexes& fieldIndexes,
                                           RowSetWriter& rsWriter);
 
     kvstore::ResultCode processVertex(PartitionID, VertexID) override {
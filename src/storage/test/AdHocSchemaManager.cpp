@@ -169,5 +169,20 @@ StatusOr<std::string> AdHocSchemaManager::toEdgeName(GraphSpaceID space, EdgeTyp
     }
     return "";
 }
+
+void AdHocSchemaManager::setSingleVersion(GraphSpaceID space, bool singleVersion) {
+    folly::RWSpinLock::WriteHolder wh(spaceLock_);
+    if (singleVersion) {
+        singleVersionSpaces_.emplace(space);
+    } else {
+        singleVersionSpaces_.erase(space);
+    }
+}
+
+bool AdHocSchemaManager::isSingleVersion(GraphSpaceID space) {
+    folly::RWSpinLock::ReadHolder rh(spaceLock_);
+    return singleVersionSpaces_.find(space) != singleVersionSpaces_.end();
+}
+
 }  // namespace storage
 }  // namespace nebula
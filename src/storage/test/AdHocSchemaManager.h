@@ -31,6 +31,8 @@ public:
 
     void removeTagSchema(GraphSpaceID space, TagID tag);
 
+    void setSingleVersion(GraphSpaceID space, bool singleVersion);
+
     std::shared_ptr<const nebula::meta::SchemaProviderIf>
     getTagSchema(GraphSpaceID space,
                  TagID tag,
@@ -60,6 +62,8 @@ public:
         LOG(FATAL) << "Unimplemented";
     }
 
+    bool isSingleVersion(GraphSpaceID space) override;
+
     void init(nebula::meta::MetaClient *) override {
     }
 
@@ -78,6 +82,7 @@ protected:
 
     folly::RWSpinLock spaceLock_;
     std::set<GraphSpaceID> spaces_;
+    std::set<GraphSpaceID> singleVersionSpaces_;
     // Key: spaceId + tagName,  Val: tagId
     std::unordered_map<std::string, TagID> tagNameToId_;
 };
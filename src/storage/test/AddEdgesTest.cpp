@@ -64,6 +64,62 @@ TEST(AddEdgesTest, SimpleTest) {
     }
 }
 
+TEST(AddEdgesTest, SingleVersionTest) {
+    fs::TempDir rootPath("/tmp/AddEdgesSingleVersionTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = std::make_unique<AdHocSchemaManager>();
+    schemaMan->setSingleVersion(0, true);
+
+    auto addEdges = [&] (int32_t round) {
+        auto* processor = AddEdgesProcessor::instance(kv.get(), schemaMan.get(), nullptr);
+        cpp2::AddEdgesRequest req;
+        req.space_id = 0;
+        req.overwritable = true;
+        for (auto partId = 0; partId < 3; partId++) {
+            std::vector<cpp2::Edge> edges;
+            for (auto srcId = partId * 10; srcId < 10 * (partId + 1); srcId++) {
+                cpp2::EdgeKey key;
+                key.set_src(srcId);
+                key.set_edge_type(101);
+                key.set_ranking(srcId * 100 + 2);
+                key.set_dst(srcId * 100 + 3);
+                edges.emplace_back();
+                edges.back().set_key(std::move(key));
+                edges.back().set_props(folly::stringPrintf("%d_%d_%d", partId, srcId, round));
+            }
+            req.parts.emplace(partId, std::move(edges));
+        }
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    };
+
+    LOG(INFO) << "Write the same edges twice...";
+    addEdges(0);
+    addEdges(1);
+
+    LOG(INFO) << "Check only the latest value is kept in place...";
+    for (auto partId = 0; partId < 3; partId++) {
+        for (auto srcId = 10 * partId; srcId < 10 * (partId + 1); srcId++) {
+            auto prefix = NebulaKeyUtils::edgePrefix(partId, srcId, 101);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
+            int num = 0;
+            while (iter->valid()) {
+                EXPECT_EQ(NebulaKeyUtils::edgeKey(partId, srcId, 101,
+                                                  srcId * 100 + 2, srcId * 100 + 3),
+                          iter->key());
+                EXPECT_EQ(srcId * 100 + 3, NebulaKeyUtils::getDstId(iter->key()));
+                EXPECT_EQ(folly::stringPrintf("%d_%d_1", partId, srcId), iter->val());
+                num++;
+                iter->next();
+            }
+            EXPECT_EQ(1, num);
+        }
+    }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -11,6 +11,8 @@
 #include "fs/TempDir.h"
 #include "storage/test/TestUtils.h"
 #include "storage/mutate/AddVerticesProcessor.h"
+#include "storage/query/QueryVertexPropsProcessor.h"
+#include "dataman/RowWriter.h"
 
 namespace nebula {
 namespace storage {
@@ -66,6 +68,100 @@ TEST(AddVerticesTest, SimpleTest) {
     }
 }
 
+TEST(AddVerticesTest, SingleVersionTest) {
+    fs::TempDir rootPath("/tmp/AddVerticesSingleVersionTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = TestUtils::mockSchemaMan();
+    static_cast<AdHocSchemaManager*>(schemaMan.get())->setSingleVersion(0, true);
+
+    auto addVertices = [&] (int64_t round) {
+        auto* processor = AddVerticesProcessor::instance(kv.get(), schemaMan.get(), nullptr);
+        cpp2::AddVerticesRequest req;
+        req.space_id = 0;
+        req.overwritable = true;
+        for (auto partId = 0; partId < 3; partId++) {
+            std::vector<cpp2::Vertex> vertices;
+            for (auto vertexId = partId * 10; vertexId < 10 * (partId + 1); vertexId++) {
+                std::vector<cpp2::Tag> tags;
+                for (auto tagId = 3001; tagId < 3010; tagId++) {
+                    RowWriter writer;
+                    for (int64_t numInt = 0; numInt < 3; numInt++) {
+                        writer << vertexId + numInt + round;
+                    }
+                    for (auto numString = 3; numString < 6; numString++) {
+                        writer << folly::stringPrintf("tag_string_col_%d_%ld", numString, round);
+                    }
+                    tags.emplace_back(apache::thrift::FragileConstructor::FRAGILE,
+                                      tagId,
+                                      writer.encode());
+                }
+                vertices.emplace_back(apache::thrift::FragileConstructor::FRAGILE,
+                                      vertexId,
+                                      std::move(tags));
+            }
+            req.parts.emplace(partId, std::move(vertices));
+        }
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    };
+
+    LOG(INFO) << "Write the same vertices twice...";
+    addVertices(0);
+    addVertices(1);
+
+    LOG(INFO) << "Check only the latest value is kept in place...";
+    for (auto partId = 0; partId < 3; partId++) {
+        for (auto vertexId = 10 * partId; vertexId < 10 * (partId + 1); vertexId++) {
+            auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertexId);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
+            TagID tagId = 3001;
+            while (iter->valid()) {
+                EXPECT_EQ(NebulaKeyUtils::vertexKey(partId, vertexId, tagId), iter->key());
+                EXPECT_EQ(tagId, NebulaKeyUtils::getTagId(iter->key()));
+                tagId++;
+                iter->next();
+            }
+            EXPECT_EQ(3010, tagId);
+        }
+    }
+
+    LOG(INFO) << "Read the vertices back...";
+    cpp2::VertexPropRequest req;
+    req.set_space_id(0);
+    decltype(req.parts) tmpIds;
+    for (auto partId = 0; partId < 3; partId++) {
+        for (auto vertexId = partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            tmpIds[partId].emplace_back(vertexId);
+        }
+    }
+    req.set_parts(std::move(tmpIds));
+    decltype(req.return_columns) tmpColumns;
+    tmpColumns.emplace_back(TestUtils::vertexPropDef("tag_3001_col_0", 3001));
+    tmpColumns.emplace_back(TestUtils::vertexPropDef("tag_3005_col_4", 3005));
+    req.set_return_columns(std::move(tmpColumns));
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    auto* processor = QueryVertexPropsProcessor::instance(kv.get(),
+                                                          schemaMan.get(),
+                                                          nullptr,
+                                                          executor.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    EXPECT_EQ(30, resp.vertices.size());
+    auto* vschema = resp.get_vertex_schema();
+    ASSERT_TRUE(vschema != nullptr);
+    for (auto& vp : resp.vertices) {
+        checkTagData<int64_t>(vp.tag_data, 3001, "tag_3001_col_0", vschema, vp.vertex_id + 1);
+        checkTagData<std::string>(vp.tag_data, 3005, "tag_3005_col_4", vschema,
+                                  "tag_string_col_4_1");
+    }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
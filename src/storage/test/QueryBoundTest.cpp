@@ -21,12 +21,14 @@ DECLARE_int32(min_vertices_per_bucket);
 namespace nebula {
 namespace storage {
 
-void mockData(kvstore::KVStore* kv) {
+void mockData(kvstore::KVStore* kv, bool singleVersion = false) {
     for (auto partId = 0; partId < 3; partId++) {
         std::vector<kvstore::KV> data;
         for (auto vertexId = partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
             for (auto tagId = 3001; tagId < 3010; tagId++) {
-                auto key = NebulaKeyUtils::vertexKey(partId, vertexId, tagId, 0);
+                auto key = singleVersion
+                    ? NebulaKeyUtils::vertexKey(partId, vertexId, tagId)
+                    : NebulaKeyUtils::vertexKey(partId, vertexId, tagId, 0);
                 RowWriter writer;
                 for (uint64_t numInt = 0; numInt < 3; numInt++) {
                     writer << (vertexId + tagId + numInt);
@@ -41,11 +43,13 @@ void mockData(kvstore::KVStore* kv) {
             for (auto dstId = 10001; dstId <= 10007; dstId++) {
                 VLOG(3) << "Write part " << partId << ", vertex " << vertexId << ", dst " << dstId;
                 // Write multi versions,  we should get the latest version.
+                // In single version space, the later version overwrites the former one.
                 for (auto version = 0; version < 3; version++) {
                     for (auto edgeType = 101; edgeType < 110; edgeType++) {
-                        auto key =
-                            NebulaKeyUtils::edgeKey(partId, vertexId, edgeType, 0, dstId,
-                                                    std::numeric_limits<int>::max() - version);
+                        auto key = singleVersion
+                            ? NebulaKeyUtils::edgeKey(partId, vertexId, edgeType, 0, dstId)
+                            : NebulaKeyUtils::edgeKey(partId, vertexId, edgeType, 0, dstId,
+                                                      std::numeric_limits<int>::max() - version);
                         RowWriter writer(nullptr);
                         for (uint64_t numInt = 0; numInt < 10; numInt++) {
                             writer << (dstId + numInt);
@@ -63,9 +67,10 @@ void mockData(kvstore::KVStore* kv) {
                 VLOG(3) << "Write part " << partId << ", vertex " << vertexId << ", src " << srcId;
                 for (auto version = 0; version < 3; version++) {
                     for (auto edgeType = 101; edgeType < 110; edgeType++) {
-                        auto key =
-                            NebulaKeyUtils::edgeKey(partId, vertexId, -edgeType, 0, srcId,
-                                                    std::numeric_limits<int>::max() - version);
+                        auto key = singleVersion
+                            ? NebulaKeyUtils::edgeKey(partId, vertexId, -edgeType, 0, srcId)
+                            : NebulaKeyUtils::edgeKey(partId, vertexId, -edgeType, 0, srcId,
+                                                      std::numeric_limits<int>::max() - version);
                         data.emplace_back(std::move(key), "");
                     }
                 }
@@ -225,6 +230,42 @@ TEST(QueryBoundTest, OutBoundSimpleTest) {
     checkResponse(resp, 30, 12, 10001, 7, true);
 }
 
+TEST(QueryBoundTest, SingleVersionTest) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    LOG(INFO) << "Prepare meta...";
+    auto schemaMan = TestUtils::mockSchemaMan();
+    static_cast<AdHocSchemaManager*>(schemaMan.get())->setSingleVersion(0, true);
+    mockData(kv.get(), true);
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    {
+        LOG(INFO) << "Out bound edges...";
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {101, 102};
+        buildRequest(req, et);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(), nullptr,
+                                                        executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        checkResponse(resp, 30, 12, 10001, 7, true);
+    }
+    {
+        LOG(INFO) << "In bound edges...";
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {-101};
+        buildRequest(req, et);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(), nullptr,
+                                                        executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        checkResponse(resp, 30, 2, 20001, 5, false);
+    }
+}
+
 TEST(QueryBoundTest, inBoundSimpleTest) {
     fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
     LOG(INFO) << "Prepare meta...";
@@ -474,6 +515,42 @@ TEST(QueryBoundTest, MultiEdgeQueryTest) {
     checkResponse(resp, 30, 12, 10001, 7, true);
 }
 
+TEST(QueryBoundTest, DeadlineTest) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    LOG(INFO) << "Prepare meta...";
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    cpp2::GetNeighborsRequest req;
+    std::vector<EdgeType> et = {101};
+    buildRequest(req, et);
+    req.set_timeout_ms(10);
+
+    LOG(INFO) << "Test the request expired before processed...";
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(1);
+    // Hold the only worker, so no vertex is processed before the deadline
+    folly::Baton<true, std::atomic> baton;
+    executor->add([&baton] () {
+        baton.wait();
+    });
+    auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(), nullptr,
+                                                    executor.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    usleep(50 * 1000);
+    baton.post();
+    auto resp = std::move(f).get();
+
+    LOG(INFO) << "Check the results...";
+    ASSERT_EQ(3, resp.result.failed_codes.size());
+    for (auto& code : resp.result.failed_codes) {
+        EXPECT_EQ(cpp2::ErrorCode::E_DEADLINE_EXCEEDED, code.get_code());
+    }
+    EXPECT_EQ(0, resp.vertices.size());
+}
+
 TEST(QueryBoundTest, MaxEdgesReturenedTest) {
     int old_max_edge_returned = FLAGS_max_edge_returned_per_vertex;
     FLAGS_max_edge_returned_per_vertex = 5;
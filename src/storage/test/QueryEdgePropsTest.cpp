@@ -148,6 +148,34 @@ TEST(QueryEdgePropsTest, SimpleTest) {
     checkResponse(resp);
 }
 
+TEST(QueryEdgePropsTest, FieldIndexesTest) {
+    std::vector<PropContext> props(2);
+    props[0].prop_.name = "col_1";
+    props[1].prop_.name = "col_12";
+    FieldIndexes fieldIndexes;
+    std::weak_ptr<const meta::SchemaProviderIf> oldSchema;
+    {
+        auto schema = TestUtils::genEdgeSchemaProvider(10, 10);
+        fieldIndexes.resolve(schema, props);
+        EXPECT_EQ(std::vector<int64_t>({1, 12}), fieldIndexes.indexes);
+        oldSchema = schema;
+
+        // Not resolved again for the rows of the same schema
+        fieldIndexes.indexes[0] = 0;
+        fieldIndexes.resolve(schema, props);
+        EXPECT_EQ(0, fieldIndexes.indexes[0]);
+        fieldIndexes.indexes[0] = 1;
+    }
+    // Still held, so no other schema could be allocated at its address
+    EXPECT_FALSE(oldSchema.expired());
+
+    // The rows of another schema, which doesn't have col_12
+    auto schema = TestUtils::genEdgeSchemaProvider(5, 5);
+    fieldIndexes.resolve(schema, props);
+    EXPECT_EQ(std::vector<int64_t>({1, -1}), fieldIndexes.indexes);
+    EXPECT_TRUE(oldSchema.expired());
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -14,10 +14,15 @@
 #include "dataman/RowWriter.h"
 #include "dataman/RowSetReader.h"
 #include "network/NetworkUtils.h"
+#include "stats/StatsManager.h"
 
 DECLARE_string(meta_server_addrs);
 DECLARE_int32(load_data_interval_secs);
 DECLARE_int32(heartbeat_interval_secs);
+DECLARE_int32(storage_client_timeout_ms);
+DECLARE_bool(storage_client_hedge);
+DECLARE_int32(storage_client_hedge_min_delay_ms);
+DECLARE_int32(rpc_connections_per_host);
 
 namespace nebula {
 namespace storage {
@@ -326,6 +331,10 @@ TEST(StorageClientTest, VerticesInterfacesTest) {
             ASSERT_EQ(resp.get_id(), vIds[i]);
         }
     }
+    // All the requests have been responded
+    for (auto& host : client->inflightRequests()) {
+        EXPECT_EQ(0, host.second) << host.first;
+    }
     LOG(INFO) << "Stop meta client";
     mClient->stop();
     LOG(INFO) << "Stop data server...";
@@ -375,8 +384,8 @@ public:
     explicit TestStorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool)
         : StorageClient(ioThreadPool, nullptr) {}
 
-    StatusOr<int32_t> partsNum(GraphSpaceID) const override {
-        return parts_.size();
+    StatusOr<std::shared_ptr<const Partitioner>> partitioner(GraphSpaceID) const override {
+        return Partitioner::hash(parts_.size());
     }
 
     StatusOr<PartMeta> getPartMeta(GraphSpaceID, PartitionID partId) const override {
@@ -414,6 +423,206 @@ TEST(StorageClientTest, LeaderChangeTest) {
     ASSERT_EQ(HostAddr(localIp, 10010), tsc.leaders_[std::make_pair(1, 1)]);
 }
 
+// Hold the requests until released, but answer the hedged ones at once
+class TestStorageServiceSlow : public storage::cpp2::StorageServiceSvIf {
+public:
+    folly::Future<cpp2::QueryResponse>
+    future_getBound(const cpp2::GetNeighborsRequest& req) override {
+        std::lock_guard<std::mutex> g(lock_);
+        timeouts_.emplace_back(req.get_timeout_ms());
+        if (req.get_read_follower()) {
+            hedged_++;
+            return folly::makeFuture(cpp2::QueryResponse());
+        }
+        pending_.emplace_back();
+        return pending_.back().getFuture();
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> g(lock_);
+        for (auto& p : pending_) {
+            p.setValue(cpp2::QueryResponse());
+        }
+        pending_.clear();
+    }
+
+    std::mutex lock_;
+    std::vector<folly::Promise<cpp2::QueryResponse>> pending_;
+    std::vector<int32_t> timeouts_;
+    std::atomic<int32_t> hedged_{0};
+};
+
+TEST(StorageClientTest, HedgeTest) {
+    gflags::FlagSaver saver;
+    FLAGS_storage_client_hedge = true;
+    FLAGS_storage_client_hedge_min_delay_ms = 10;
+    IPv4 localIp;
+    network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
+
+    auto leaderHandler = std::make_shared<TestStorageServiceSlow>();
+    auto leaderSc = std::make_unique<test::ServerContext>();
+    leaderSc->mockCommon("storage", 0, leaderHandler);
+    auto followerHandler = std::make_shared<TestStorageServiceSlow>();
+    auto followerSc = std::make_unique<test::ServerContext>();
+    followerSc->mockCommon("storage", 0, followerHandler);
+    HostAddr leader(localIp, leaderSc->port_);
+    HostAddr follower(localIp, followerSc->port_);
+
+    auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    {
+        TestStorageClient tsc(threadPool);
+        PartMeta pm;
+        pm.spaceId_ = 1;
+        pm.partId_ = 1;
+        pm.peers_ = {leader, follower};
+        tsc.parts_.emplace(1, std::move(pm));
+        tsc.updateLeader(1, 1, leader);
+        // The p95 is 1ms, so the hedge is sent after the min delay
+        for (int i = 0; i < 1024; i++) {
+            tsc.latencies_.add(1000);
+        }
+
+        auto resp = tsc.getNeighbors(1, {1, 2, 3}, {0}, "", {}).via(threadPool.get()).get();
+        // The leader holds the request, the hedged one to the follower wins
+        ASSERT_TRUE(resp.succeeded());
+        ASSERT_EQ(1, resp.responses().size());
+        ASSERT_EQ(1, resp.hostLatency().size());
+        EXPECT_EQ(follower, std::get<0>(resp.hostLatency()[0]));
+        EXPECT_EQ(1, followerHandler->hedged_);
+        EXPECT_EQ(0, leaderHandler->hedged_);
+
+        // The deadline is propagated, and the hedge only gets the remaining time
+        ASSERT_EQ(1, leaderHandler->timeouts_.size());
+        EXPECT_EQ(FLAGS_storage_client_timeout_ms, leaderHandler->timeouts_[0]);
+        ASSERT_EQ(1, followerHandler->timeouts_.size());
+        EXPECT_GT(followerHandler->timeouts_[0], 0);
+        EXPECT_LE(followerHandler->timeouts_[0],
+                  FLAGS_storage_client_timeout_ms - FLAGS_storage_client_hedge_min_delay_ms);
+
+        // The late response of the leader is dropped
+        leaderHandler->release();
+        usleep(100 * 1000);
+    }
+}
+
+TEST(StorageClientTest, HedgeAfterTimeoutTest) {
+    gflags::FlagSaver saver;
+    FLAGS_storage_client_hedge = true;
+    FLAGS_storage_client_hedge_min_delay_ms = 100;
+    FLAGS_storage_client_timeout_ms = 50;
+    IPv4 localIp;
+    network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
+
+    auto leaderHandler = std::make_shared<TestStorageServiceSlow>();
+    auto leaderSc = std::make_unique<test::ServerContext>();
+    leaderSc->mockCommon("storage", 0, leaderHandler);
+    auto followerHandler = std::make_shared<TestStorageServiceSlow>();
+    auto followerSc = std::make_unique<test::ServerContext>();
+    followerSc->mockCommon("storage", 0, followerHandler);
+    HostAddr leader(localIp, leaderSc->port_);
+    HostAddr follower(localIp, followerSc->port_);
+
+    auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    {
+        TestStorageClient tsc(threadPool);
+        PartMeta pm;
+        pm.spaceId_ = 1;
+        pm.partId_ = 1;
+        pm.peers_ = {leader, follower};
+        tsc.parts_.emplace(1, std::move(pm));
+        tsc.updateLeader(1, 1, leader);
+        for (int i = 0; i < 1024; i++) {
+            tsc.latencies_.add(1000);
+        }
+
+        // The request times out before the hedge delay, and no hedge is sent after that
+        auto resp = tsc.getNeighbors(1, {1, 2, 3}, {0}, "", {}).via(threadPool.get()).get();
+        ASSERT_FALSE(resp.succeeded());
+        ASSERT_EQ(1, resp.failedParts().size());
+        EXPECT_EQ(cpp2::ErrorCode::E_RPC_FAILURE, resp.failedParts()[1]);
+        usleep(200 * 1000);
+        EXPECT_EQ(0, followerHandler->hedged_);
+        EXPECT_TRUE(followerHandler->timeouts_.empty());
+
+        leaderHandler->release();
+        usleep(100 * 1000);
+    }
+}
+
+TEST(StorageClientTest, InflightSaturationTest) {
+    gflags::FlagSaver saver;
+    FLAGS_rpc_connections_per_host = 2;
+    IPv4 localIp;
+    network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
+
+    auto handler = std::make_shared<TestStorageServiceSlow>();
+    auto sc = std::make_unique<test::ServerContext>();
+    sc->mockCommon("storage", 0, handler);
+    HostAddr host(localIp, sc->port_);
+
+    auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(2);
+    {
+        TestStorageClient tsc(threadPool);
+        PartMeta pm;
+        pm.spaceId_ = 1;
+        pm.partId_ = 1;
+        pm.peers_ = {host};
+        tsc.parts_.emplace(1, std::move(pm));
+        tsc.updateLeader(1, 1, host);
+
+        auto queued = [] {
+            return stats::StatsManager::readValue("storage_client_io_queue_us.count.60").value();
+        };
+        auto queuedBefore = queued();
+        // Far more requests than the connections, all held by the server
+        constexpr int32_t kRequests = 64;
+        std::vector<folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>>> futures;
+        for (int32_t i = 0; i < kRequests; i++) {
+            futures.emplace_back(tsc.getNeighbors(1, {1, 2, 3}, {0}, "", {}));
+        }
+        for (int i = 0; i < 100; i++) {
+            {
+                std::lock_guard<std::mutex> g(handler->lock_);
+                if (handler->pending_.size() == kRequests) {
+                    break;
+                }
+            }
+            usleep(10 * 1000);
+        }
+        {
+            std::lock_guard<std::mutex> g(handler->lock_);
+            ASSERT_EQ(kRequests, handler->pending_.size());
+        }
+        // Every request is in flight, though they share a few connections
+        auto inflight = tsc.inflightRequests();
+        ASSERT_EQ(1, inflight.count(host));
+        EXPECT_EQ(kRequests, inflight[host]);
+        // The time waiting for the IO thread is recorded once per request
+        EXPECT_EQ(kRequests, queued() - queuedBefore);
+
+        handler->release();
+        for (auto& f : futures) {
+            EXPECT_TRUE(std::move(f).get().succeeded());
+        }
+        EXPECT_EQ(0, tsc.inflightRequests()[host]);
+    }
+}
+
+TEST(StorageClientTest, LatencyTrackerTest) {
+    LatencyTracker tracker(100);
+    for (int64_t i = 0; i < 99; i++) {
+        tracker.add(i);
+    }
+    // Not enough samples
+    EXPECT_EQ(0, tracker.p95());
+    // The p95 is recalculated every 64 samples
+    for (int64_t i = 99; i < 128; i++) {
+        tracker.add(i);
+    }
+    // The window holds 28..127
+    EXPECT_EQ(123, tracker.p95());
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -36,7 +36,8 @@ public:
             HostAddr localhost = {0, 0},
             meta::MetaClient* mClient = nullptr,
             bool useMetaServer = false,
-            std::unique_ptr<kvstore::CompactionFilterFactoryBuilder> cffBuilder = nullptr) {
+            std::unique_ptr<kvstore::CompactionFilterFactoryBuilder> cffBuilder = nullptr,
+            std::shared_ptr<rocksdb::MergeOperator> mergeOp = nullptr) {
         auto ioPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
         auto workers = apache::thrift::concurrency::PriorityThreadManager::newPriorityThreadManager(
                                  1, true /*stats*/);
@@ -68,6 +69,7 @@ public:
         // Prepare KVStore
         options.dataPaths_ = std::move(paths);
         options.cffBuilder_ = std::move(cffBuilder);
+        options.mergeOp_ = std::move(mergeOp);
         auto store = std::make_unique<kvstore::NebulaStore>(std::move(options),
                                                             ioPool,
                                                             localhost,
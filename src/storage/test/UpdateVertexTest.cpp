@@ -15,6 +15,8 @@
 #include "dataman/RowSetReader.h"
 #include "dataman/RowReader.h"
 
+DECLARE_bool(enable_update_by_merge);
+
 namespace nebula {
 namespace storage {
 
@@ -391,6 +393,112 @@ TEST(UpdateVertexTest, Invalid_Filter_Test) {
                     == resp.result.failed_codes[0].code);
 }
 
+
+TEST(UpdateVertexTest, Merge_Update_Test) {
+    gflags::FlagSaver saver;
+    FLAGS_enable_update_by_merge = true;
+    fs::TempDir rootPath("/tmp/UpdateVertexTest.XXXXXX");
+    LOG(INFO) << "Prepare meta...";
+    auto schemaMan = TestUtils::mockSchemaMan();
+    GraphSpaceID spaceId = 0;
+    PartitionID partId = 0;
+    VertexID vertexId = 1;
+    // The upsert is only written as merge in single version spaces
+    static_cast<AdHocSchemaManager*>(schemaMan.get())->setSingleVersion(spaceId, true);
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(
+        rootPath.path(), 6, {0, 0}, nullptr, false, nullptr,
+        std::make_shared<NebulaOperator>(schemaMan.get()));
+    {
+        std::vector<kvstore::KV> data;
+        RowWriter writer;
+        for (int64_t numInt = 0; numInt < 3; numInt++) {
+            writer << 3001 + numInt;
+        }
+        for (auto numString = 3; numString < 6; numString++) {
+            writer << folly::stringPrintf("tag_string_col_%d", numString);
+        }
+        data.emplace_back(NebulaKeyUtils::vertexKey(partId, vertexId, 3001), writer.encode());
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(spaceId, partId, std::move(data), [&] (kvstore::ResultCode code) {
+            CHECK_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    auto getProp = [&] (TagID tagId, const std::string& prop) -> VariantType {
+        std::string val;
+        auto ret = kv->get(spaceId, partId,
+                           NebulaKeyUtils::vertexKey(partId, vertexId, tagId), &val);
+        CHECK_EQ(kvstore::ResultCode::SUCCEEDED, ret);
+        auto reader = RowReader::getTagPropReader(schemaMan.get(), val, spaceId, tagId);
+        auto res = RowReader::getPropByName(reader.get(), prop);
+        CHECK(ok(res));
+        return value(std::move(res));
+    };
+
+    LOG(INFO) << "Build UpdateVertexRequest...";
+    cpp2::UpdateVertexRequest req;
+    req.set_space_id(spaceId);
+    req.set_vertex_id(vertexId);
+    req.set_part_id(partId);
+    req.set_filter("");
+    std::vector<cpp2::UpdateItem> items;
+    // int: 3001.tag_3001_col_0 = $^.3001.tag_3001_col_0 + 10
+    cpp2::UpdateItem item1;
+    item1.set_name("3001");
+    item1.set_prop("tag_3001_col_0");
+    ArithmeticExpression val1(
+        new SourcePropertyExpression(new std::string("3001"), new std::string("tag_3001_col_0")),
+        ArithmeticExpression::Operator::ADD,
+        new PrimaryExpression(10L));
+    item1.set_value(Expression::encode(&val1));
+    items.emplace_back(item1);
+    // string: 3001.tag_3001_col_3 = tag_string_col_3_new
+    cpp2::UpdateItem item2;
+    item2.set_name("3001");
+    item2.set_prop("tag_3001_col_3");
+    PrimaryExpression val2(std::string("tag_string_col_3_new"));
+    item2.set_value(Expression::encode(&val2));
+    items.emplace_back(item2);
+    // int: 3009.tag_3009_col_1 = $^.3009.tag_3009_col_1 - 1, the tag will be inserted
+    cpp2::UpdateItem item3;
+    item3.set_name("3009");
+    item3.set_prop("tag_3009_col_1");
+    ArithmeticExpression val3(
+        new SourcePropertyExpression(new std::string("3009"), new std::string("tag_3009_col_1")),
+        ArithmeticExpression::Operator::SUB,
+        new PrimaryExpression(1L));
+    item3.set_value(Expression::encode(&val3));
+    items.emplace_back(item3);
+    req.set_update_items(std::move(items));
+    req.set_insertable(true);
+
+    auto update = [&] (const cpp2::UpdateVertexRequest& request) {
+        auto* processor = UpdateVertexProcessor::instance(kv.get(), schemaMan.get(), nullptr);
+        auto f = processor->getFuture();
+        processor->process(request);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    };
+
+    LOG(INFO) << "Upsert twice by merge...";
+    update(req);
+    update(req);
+
+    LOG(INFO) << "Check the results...";
+    EXPECT_EQ(3001 + 20, boost::get<int64_t>(getProp(3001, "tag_3001_col_0")));
+    EXPECT_EQ("tag_string_col_3_new", boost::get<std::string>(getProp(3001, "tag_3001_col_3")));
+    EXPECT_EQ("tag_string_col_4", boost::get<std::string>(getProp(3001, "tag_3001_col_4")));
+    EXPECT_EQ(-2, boost::get<int64_t>(getProp(3009, "tag_3009_col_1")));
+
+    LOG(INFO) << "The update is read before written, applied on top of the merged row...";
+    req.set_insertable(false);
+    update(req);
+    EXPECT_EQ(3001 + 30, boost::get<int64_t>(getProp(3001, "tag_3001_col_0")));
+    EXPECT_EQ(-3, boost::get<int64_t>(getProp(3009, "tag_3009_col_1")));
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -0,0 +1,150 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include "fs/TempDir.h"
+#include "storage/test/TestUtils.h"
+#include "storage/query/QueryVertexPropsProcessor.h"
+#include "base/NebulaKeyUtils.h"
+#include "dataman/RowWriter.h"
+#include "storage/test/AdHocSchemaManager.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+DEFINE_int32(vertices, 10000, "vertices requested per part");
+DEFINE_int32(versions, 3, "versions of each vertex tag");
+DECLARE_bool(enable_vertex_cache);
+
+std::unique_ptr<nebula::kvstore::KVStore> gKV;
+std::unique_ptr<nebula::storage::AdHocSchemaManager> schema;
+
+namespace nebula {
+namespace storage {
+
+constexpr PartitionID kPart = 0;
+constexpr TagID kTag = 3001;
+
+void mockData(kvstore::KVStore* kv) {
+    std::vector<kvstore::KV> data;
+    // Only the even vertices exist
+    for (auto vertexId = 0; vertexId < FLAGS_vertices * 2; vertexId += 2) {
+        for (auto version = 0; version < FLAGS_versions; version++) {
+            auto key = NebulaKeyUtils::vertexKey(kPart, vertexId, kTag,
+                                                 std::numeric_limits<int>::max() - version);
+            RowWriter writer;
+            for (int64_t numInt = 0; numInt < 3; numInt++) {
+                writer << numInt + version;
+            }
+            for (auto numString = 3; numString < 6; numString++) {
+                writer << folly::stringPrintf("tag_string_col_%d_%d", numString, version);
+            }
+            data.emplace_back(std::move(key), writer.encode());
+        }
+    }
+    kv->asyncMultiPut(0, kPart, std::move(data), [] (kvstore::ResultCode code) {
+        CHECK_EQ(code, kvstore::ResultCode::SUCCEEDED);
+    });
+}
+
+void setUp(const char* path) {
+    gKV = TestUtils::initKV(path);
+    schema.reset(new storage::AdHocSchemaManager());
+    schema->addTagSchema(0 /*space id*/, kTag, TestUtils::genTagSchemaProvider(kTag, 3, 3));
+    mockData(gKV.get());
+}
+
+std::vector<std::string> prefixes() {
+    std::vector<std::string> result;
+    result.reserve(FLAGS_vertices);
+    // Half of the vertices are missed, in the reverse order
+    for (auto vertexId = FLAGS_vertices - 1; vertexId >= 0; vertexId--) {
+        result.emplace_back(NebulaKeyUtils::vertexPrefix(kPart, vertexId, kTag));
+    }
+    return result;
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+BENCHMARK(prefix_per_vertex, iters) {
+    std::vector<std::string> prefixes;
+    BENCHMARK_SUSPEND {
+        prefixes = nebula::storage::prefixes();
+    }
+    for (decltype(iters) i = 0; i < iters; i++) {
+        size_t found = 0;
+        for (auto& prefix : prefixes) {
+            std::unique_ptr<nebula::kvstore::KVIterator> iter;
+            auto ret = gKV->prefix(0, nebula::storage::kPart, prefix, &iter);
+            CHECK_EQ(nebula::kvstore::ResultCode::SUCCEEDED, ret);
+            if (iter && iter->valid()) {
+                folly::doNotOptimizeAway(iter->val().str());
+                found++;
+            }
+        }
+        CHECK_EQ(prefixes.size() / 2, found);
+    }
+}
+
+BENCHMARK_RELATIVE(multi_prefix_first, iters) {
+    std::vector<std::string> prefixes;
+    BENCHMARK_SUSPEND {
+        prefixes = nebula::storage::prefixes();
+    }
+    for (decltype(iters) i = 0; i < iters; i++) {
+        std::vector<nebula::kvstore::KV> kvs;
+        auto ret = gKV->multiPrefixFirst(0, nebula::storage::kPart, prefixes, &kvs);
+        CHECK_EQ(nebula::kvstore::ResultCode::SUCCEEDED, ret);
+        folly::doNotOptimizeAway(kvs);
+    }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(query_vertex_props, iters) {
+    nebula::storage::cpp2::VertexPropRequest req;
+    BENCHMARK_SUSPEND {
+        req.set_space_id(0);
+        decltype(req.parts) tmpIds;
+        for (auto vertexId = 0; vertexId < FLAGS_vertices; vertexId++) {
+            tmpIds[nebula::storage::kPart].push_back(vertexId);
+        }
+        req.set_parts(std::move(tmpIds));
+        decltype(req.return_columns) tmpColumns;
+        for (int i = 0; i < 6; i += 2) {
+            tmpColumns.emplace_back(nebula::storage::TestUtils::vertexPropDef(
+                folly::stringPrintf("tag_%d_col_%d", nebula::storage::kTag, i),
+                nebula::storage::kTag));
+        }
+        req.set_return_columns(std::move(tmpColumns));
+    }
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(10);
+    for (decltype(iters) i = 0; i < iters; i++) {
+        auto* processor = nebula::storage::QueryVertexPropsProcessor::instance(gKV.get(),
+                                                                               schema.get(),
+                                                                               nullptr,
+                                                                               executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        CHECK_EQ(static_cast<size_t>(FLAGS_vertices), resp.vertices.size());
+    }
+}
+
+/*************************
+ * End of benchmarks
+ ************************/
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    FLAGS_enable_vertex_cache = false;
+    nebula::fs::TempDir rootPath("/tmp/VertexPropsBenchmark.XXXXXX");
+    nebula::storage::setUp(rootPath.path());
+    folly::runBenchmarks();
+    gKV.reset();
+    return 0;
+}
@@ -5,11 +5,15 @@
  */
 
 #include "base/NebulaKeyUtils.h"
+#include "base/Partitioner.h"
 #include <rocksdb/db.h>
 
 DEFINE_string(path, "", "rocksdb instance path");
 DEFINE_int64(vertex_id, 0, "Specify the vertex id");
 DEFINE_int64(parts_num, 100, "Specify the parts number");
+DEFINE_string(range_bounds, "",
+              "The range bounds separated by comma, if the space is range partitioned");
+DEFINE_int32(key_format_version, 1, "The key format of the instance, 1: native, 2: ordered");
 
 namespace nebula {
 
@@ -26,9 +30,10 @@ public:
         if (!iter) {
             LOG(FATAL) << "null iterator!";
         }
+        auto format = static_cast<NebulaKeyFormat>(FLAGS_key_format_version);
         if (FLAGS_vertex_id != 0) {
-            auto partId = FLAGS_vertex_id % FLAGS_parts_num + 1;
-            auto prefix = NebulaKeyUtils::edgePrefix(partId, FLAGS_vertex_id);
+            auto partId = partitioner()->partId(FLAGS_vertex_id);
+            auto prefix = NebulaKeyUtils::edgePrefix(partId, FLAGS_vertex_id, format);
             iter->Seek(prefix);
         } else {
             iter->SeekToFirst();
@@ -36,8 +41,9 @@ public:
         size_t count = 0;
         while (iter->Valid()) {
             auto key = folly::StringPiece(iter->key().data(), iter->key().size());
-            if (NebulaKeyUtils::isEdge(key)) {
-                LOG(INFO) << NebulaKeyUtils::getSrcId(key) << "," << NebulaKeyUtils::getDstId(key);
+            if (NebulaKeyUtils::isEdge(key, format)) {
+                LOG(INFO) << NebulaKeyUtils::getSrcId(key, format) << ","
+                          << NebulaKeyUtils::getDstId(key, format);
                 count++;
             }
             iter->Next();
@@ -52,6 +58,22 @@ public:
             delete db;
         }
     }
+
+private:
+    static std::shared_ptr<const Partitioner> partitioner() {
+        if (FLAGS_range_bounds.empty()) {
+            return Partitioner::hash(FLAGS_parts_num);
+        }
+        std::vector<folly::StringPiece> pieces;
+        folly::split(",", FLAGS_range_bounds, pieces, true);
+        std::vector<int64_t> bounds;
+        for (auto& piece : pieces) {
+            bounds.emplace_back(folly::to<int64_t>(folly::trimWhitespace(piece)));
+        }
+        auto ret = Partitioner::range(FLAGS_parts_num, std::move(bounds));
+        CHECK(ret.ok()) << ret.status();
+        return ret.value();
+    }
 };
 
 }  // namespace nebula
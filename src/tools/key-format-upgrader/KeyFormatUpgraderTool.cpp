@@ -0,0 +1,210 @@
+/* Copyright (c) 2019 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/NebulaKeyUtils.h"
+#include "fs/FileUtils.h"
+#include <rocksdb/db.h>
+
+DEFINE_string(src_path, "", "The data path of rocksdb instance in native key format, "
+                            "e.g. ${data_path}/nebula/${space_id}/data");
+DEFINE_string(dst_path, "", "The path of rocksdb instance in ordered key format");
+DEFINE_string(wal_path, "", "The wal path of the space, e.g. ${data_path}/nebula/${space_id}/wal, "
+                            "by default it is the sibling wal directory of src_path");
+DEFINE_int32(batch_size, 1024, "The number of keys written in one batch");
+
+namespace nebula {
+
+/**
+ * Rewrite the vertex and edge keys from NebulaKeyFormat::kNative into
+ * NebulaKeyFormat::kOrdered, the other keys are copied as they are.
+ *
+ * The wal is NOT converted: the logs keep the keys in native format, and
+ * replaying them after the upgrade would write native keys into an ordered
+ * store. So the tool refuses to run unless every wal file of the space is
+ * empty. The procedure on each replica is:
+ *   1. Stop the writes and wait until all replicas have caught up
+ *   2. Stop the storaged
+ *   3. Remove the wal files of the space, all logs have been committed into
+ *      rocksdb, and the raft part restarts from the committed log id
+ *   4. Run the tool, replace the data path with the new one
+ *   5. Restart the storaged with --key_format_version=2
+ * */
+class KeyFormatUpgrader {
+public:
+    static bool checkWal(const std::string& walPath) {
+        if (!fs::FileUtils::exist(walPath)) {
+            return true;
+        }
+        auto parts = fs::FileUtils::listAllDirsInDir(walPath.c_str(), true);
+        for (auto& part : parts) {
+            auto files = fs::FileUtils::listAllFilesInDir(part.c_str(), true, "*.wal");
+            for (auto& file : files) {
+                if (fs::FileUtils::fileSize(file.c_str()) > 0) {
+                    LOG(ERROR) << "The wal " << file << " is not empty, the logs in it "
+                               << "can't be converted, remove the wal first";
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool upgrade(const std::string& srcPath, const std::string& dstPath) {
+        LOG(INFO) << "open rocksdb on " << srcPath;
+        rocksdb::DB* src = nullptr;
+        rocksdb::Options options;
+        auto status = rocksdb::DB::OpenForReadOnly(options, srcPath, &src);
+        if (!status.ok()) {
+            LOG(ERROR) << "Open " << srcPath << " failed: " << status.ToString();
+            return false;
+        }
+        std::unique_ptr<rocksdb::DB> srcDb(src);
+
+        auto formatKey = NebulaKeyUtils::systemKeyFormatKey();
+        std::string formatVal;
+        status = srcDb->Get(rocksdb::ReadOptions(), formatKey, &formatVal);
+        if (status.ok() && formatVal != folly::to<std::string>(
+                static_cast<uint32_t>(NebulaKeyFormat::kNative))) {
+            LOG(ERROR) << srcPath << " is not in native key format: " << formatVal;
+            return false;
+        }
+
+        LOG(INFO) << "open rocksdb on " << dstPath;
+        rocksdb::DB* dst = nullptr;
+        options.create_if_missing = true;
+        options.error_if_exists = true;
+        status = rocksdb::DB::Open(options, dstPath, &dst);
+        if (!status.ok()) {
+            LOG(ERROR) << "Open " << dstPath << " failed: " << status.ToString();
+            return false;
+        }
+        std::unique_ptr<rocksdb::DB> dstDb(dst);
+
+        std::unique_ptr<rocksdb::Iterator> iter(srcDb->NewIterator(rocksdb::ReadOptions()));
+        rocksdb::WriteBatch batch;
+        size_t vertices = 0, edges = 0, others = 0;
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+            auto key = folly::StringPiece(iter->key().data(), iter->key().size());
+            auto val = iter->value();
+            if (NebulaKeyUtils::isSystemKeyFormat(key)) {
+                continue;
+            }
+            if (isVertexLen(key.size())
+                    && NebulaKeyUtils::isVertex(key, NebulaKeyFormat::kNative)) {
+                batch.Put(convertVertexKey(key), val);
+                vertices++;
+            } else if (isEdgeLen(key.size())
+                    && NebulaKeyUtils::isEdge(key, NebulaKeyFormat::kNative)) {
+                batch.Put(convertEdgeKey(key), val);
+                edges++;
+            } else {
+                batch.Put(iter->key(), val);
+                others++;
+            }
+            if (static_cast<int32_t>(batch.Count()) >= FLAGS_batch_size) {
+                if (!write(dstDb.get(), &batch)) {
+                    return false;
+                }
+            }
+        }
+        if (!iter->status().ok()) {
+            LOG(ERROR) << "Scan " << srcPath << " failed: " << iter->status().ToString();
+            return false;
+        }
+        batch.Put(formatKey, folly::to<std::string>(
+            static_cast<uint32_t>(NebulaKeyFormat::kOrdered)));
+        if (!write(dstDb.get(), &batch)) {
+            return false;
+        }
+        LOG(INFO) << "Upgrade done, vertices " << vertices << ", edges " << edges
+                  << ", others " << others;
+        return true;
+    }
+
+private:
+    static std::string convertVertexKey(folly::StringPiece key) {
+        const char* p = key.data();
+        std::string newKey;
+        newKey.reserve(key.size());
+        newKey.append(p, sizeof(PartitionID));
+        p += sizeof(PartitionID);
+        p = convert<VertexID>(newKey, p);
+        p = convert<TagID>(newKey, p);
+        // The version, keys of single version spaces have none
+        newKey.append(p, key.end() - p);
+        return newKey;
+    }
+
+    static std::string convertEdgeKey(folly::StringPiece key) {
+        const char* p = key.data();
+        std::string newKey;
+        newKey.reserve(key.size());
+        newKey.append(p, sizeof(PartitionID));
+        p += sizeof(PartitionID);
+        p = convert<VertexID>(newKey, p);
+        p = convert<EdgeType>(newKey, p);
+        p = convert<EdgeRanking>(newKey, p);
+        p = convert<VertexID>(newKey, p);
+        newKey.append(p, key.end() - p);
+        return newKey;
+    }
+
+    template<typename T>
+    static const char* convert(std::string& newKey, const char* p) {
+        auto v = NebulaKeyUtils::decodeInt<T>(p, NebulaKeyFormat::kNative);
+        NebulaKeyUtils::encodeInt(newKey, v, NebulaKeyFormat::kOrdered);
+        return p + sizeof(T);
+    }
+
+    static bool isVertexLen(size_t len) {
+        return len == kVertexLen || len == kVertexLen - sizeof(TagVersion);
+    }
+
+    static bool isEdgeLen(size_t len) {
+        return len == kEdgeLen || len == kEdgeLen - sizeof(EdgeVersion);
+    }
+
+    static bool write(rocksdb::DB* db, rocksdb::WriteBatch* batch) {
+        auto status = db->Write(rocksdb::WriteOptions(), batch);
+        if (!status.ok()) {
+            LOG(ERROR) << "Write failed: " << status.ToString();
+            return false;
+        }
+        batch->Clear();
+        return true;
+    }
+
+private:
+    static constexpr size_t kVertexLen = sizeof(PartitionID) + sizeof(VertexID)
+                                       + sizeof(TagID) + sizeof(TagVersion);
+
+    static constexpr size_t kEdgeLen = sizeof(PartitionID) + sizeof(VertexID)
+                                     + sizeof(EdgeType) + sizeof(EdgeRanking)
+                                     + sizeof(VertexID) + sizeof(EdgeVersion);
+};
+
+}  // namespace nebula
+
+int main(int argc, char *argv[]) {
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    if (FLAGS_src_path.empty() || FLAGS_dst_path.empty()) {
+        LOG(ERROR) << "Specify the src_path and dst_path!";
+        return -1;
+    }
+    auto walPath = FLAGS_wal_path;
+    if (walPath.empty()) {
+        auto srcPath = folly::StringPiece(FLAGS_src_path);
+        srcPath.removeSuffix("/");
+        auto pos = srcPath.rfind('/');
+        walPath = (pos == std::string::npos ? std::string(".")
+                                            : srcPath.subpiece(0, pos).str()) + "/wal";
+    }
+    if (!nebula::KeyFormatUpgrader::checkWal(walPath)) {
+        return -1;
+    }
+    return nebula::KeyFormatUpgrader::upgrade(FLAGS_src_path, FLAGS_dst_path) ? 0 : -1;
+}